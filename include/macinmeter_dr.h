@@ -0,0 +1,109 @@
+/*
+ * MacinMeter DR Tool - C ABI
+ *
+ * 进程内动态范围（DR）分析接口，对应 Rust 源码 src/ffi.rs。
+ * In-process dynamic range (DR) analysis API; mirrors src/ffi.rs.
+ *
+ * 约定 / Conventions:
+ * - 句柄不透明，由 mm_dr_session_destroy 释放 / Opaque handles, released by mm_dr_session_destroy
+ * - 所有缓冲区由调用方持有 / All buffers are caller-owned
+ * - 返回 MM_DR_OK(0) 表示成功，负值为错误码 / 0 on success, negative error codes otherwise
+ * - 错误详情为线程局部 / Error details are thread-local (mm_dr_last_error_message)
+ * - 单个句柄非线程安全 / A single handle is not thread-safe
+ * - 库内 panic 被捕获并返回 MM_DR_ERR_PANIC，前提是以展开模式构建动态库：
+ *   cargo build --profile release-ffi --lib
+ *   默认 release 配置为 panic = "abort"，panic 会直接终止宿主进程。
+ *   Internal panics are caught and returned as MM_DR_ERR_PANIC only when the library is
+ *   built with unwinding (cargo build --profile release-ffi --lib); the default release
+ *   profile uses panic = "abort", where a panic terminates the host process.
+ */
+
+#ifndef MACINMETER_DR_H
+#define MACINMETER_DR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MM_DR_ABI_VERSION 1u
+
+/* 单文件最大声道数（建议的结果缓冲容量）/ Max channels per file (suggested result capacity) */
+#define MM_DR_MAX_CHANNELS 32u
+
+#define MM_DR_OK 0
+#define MM_DR_ERR_NULL_POINTER (-1)
+#define MM_DR_ERR_INVALID_INPUT (-2)
+#define MM_DR_ERR_FORMAT (-3)
+#define MM_DR_ERR_DECODING (-4)
+#define MM_DR_ERR_CALCULATION (-5)
+#define MM_DR_ERR_IO (-6)
+#define MM_DR_ERR_RESOURCE (-7)
+#define MM_DR_ERR_BUFFER_TOO_SMALL (-8)
+#define MM_DR_ERR_SESSION_FINISHED (-9)
+/* 推送或结算中 panic 时会话随之结束 / A session that panics while pushing or finishing is finished */
+#define MM_DR_ERR_PANIC (-10)
+
+typedef struct MmDrSession MmDrSession;
+
+typedef struct MmDrChannelResult {
+    uint32_t channel;
+    double dr_value;
+    double rms;
+    double peak;
+    double primary_peak;
+    double secondary_peak;
+    uint64_t sample_count;
+} MmDrChannelResult;
+
+typedef struct MmDrSummary {
+    int32_t official_dr;
+    double precise_dr;
+    uint32_t sample_rate;
+    uint32_t channels;
+    uint32_t bits_per_sample; /* 会话：已推送样本的最大位宽（f32 计 32）/ session: widest pushed sample (f32 = 32) */
+    uint64_t frame_count;
+    int32_t is_partial;
+} MmDrSummary;
+
+typedef struct MmDrFileOptions {
+    int32_t parallel_decoding; /* 默认 1 / default 1 */
+    uint32_t parallel_threads; /* 0 = 默认 / default */
+    int32_t exclude_lfe;       /* 默认 0 / default 0 */
+} MmDrFileOptions;
+
+uint32_t mm_dr_abi_version(void);
+
+/* 返回完整消息长度（不含NUL），超长截断 / Returns full length (without NUL); truncates */
+size_t mm_dr_last_error_message(char *buffer, size_t capacity);
+
+/* 失败返回 NULL / Returns NULL on failure */
+MmDrSession *mm_dr_session_create(uint32_t sample_rate, uint32_t channels);
+void mm_dr_session_destroy(MmDrSession *handle);
+
+/* sample_count 为交错样本总数，须为声道数整数倍 / Total interleaved samples, multiple of channels */
+int32_t mm_dr_session_push_f32(MmDrSession *handle, const float *samples, size_t sample_count);
+int32_t mm_dr_session_push_i16(MmDrSession *handle, const int16_t *samples, size_t sample_count);
+/* bits_per_sample: 24（低24位有效 / low 24 bits）或 / or 32 */
+int32_t mm_dr_session_push_i32(MmDrSession *handle, const int32_t *samples, size_t sample_count,
+                               uint32_t bits_per_sample);
+
+/* summary 可为 NULL / summary may be NULL */
+int32_t mm_dr_session_snapshot(const MmDrSession *handle, MmDrChannelResult *out, size_t capacity,
+                               size_t *out_len, MmDrSummary *summary);
+/* 缓冲不足或结算失败时会话保持可用 / Session stays usable if finishing fails (e.g. MM_DR_ERR_BUFFER_TOO_SMALL) */
+int32_t mm_dr_session_finish(MmDrSession *handle, MmDrChannelResult *out, size_t capacity,
+                             size_t *out_len, MmDrSummary *summary);
+
+/* path: UTF-8；options 可为 NULL / options may be NULL */
+int32_t mm_dr_analyze_file(const char *path, const MmDrFileOptions *options,
+                           MmDrChannelResult *out, size_t capacity, size_t *out_len,
+                           MmDrSummary *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MACINMETER_DR_H */
@@ -295,6 +295,123 @@ pub fn fallback_lfe_indices(channel_count: u16) -> Vec<usize> {
     }
 }
 
+/// WAVEFORMATEXTENSIBLE 扬声器位（dwChannelMask）
+///
+/// FFmpeg `AV_CH_*` 与 symphonia `Channels` 的低 18 位与之相同；
+/// 三者的交错声道顺序均按掩码置位从低到高排列。
+pub mod speaker {
+    pub const FRONT_LEFT: u64 = 0x1;
+    pub const FRONT_RIGHT: u64 = 0x2;
+    pub const FRONT_CENTER: u64 = 0x4;
+    pub const LOW_FREQUENCY: u64 = 0x8;
+    pub const BACK_LEFT: u64 = 0x10;
+    pub const BACK_RIGHT: u64 = 0x20;
+    pub const FRONT_LEFT_OF_CENTER: u64 = 0x40;
+    pub const FRONT_RIGHT_OF_CENTER: u64 = 0x80;
+    pub const BACK_CENTER: u64 = 0x100;
+    pub const SIDE_LEFT: u64 = 0x200;
+    pub const SIDE_RIGHT: u64 = 0x400;
+    pub const TOP_CENTER: u64 = 0x800;
+    pub const TOP_FRONT_LEFT: u64 = 0x1000;
+    pub const TOP_FRONT_CENTER: u64 = 0x2000;
+    pub const TOP_FRONT_RIGHT: u64 = 0x4000;
+    pub const TOP_BACK_LEFT: u64 = 0x8000;
+    pub const TOP_BACK_CENTER: u64 = 0x10000;
+    pub const TOP_BACK_RIGHT: u64 = 0x20000;
+}
+
+/// 由声道掩码推导BS.1770环绕声道（加权 1.41）的交错下标
+///
+/// BS.1770-4 只对水平面方位角 60°~120° 的声道加权 1.41：存在侧环绕（SL/SR，±90°）时
+/// 只有侧环绕计入（7.1 的后环绕位于 ±135°~150°）；否则后环绕即 5.1 的 Ls/Rs（±110°）。
+/// 高度声道、中置、宽声道等其余位一律按 1.0 计。
+pub fn surround_indices_from_mask(mask: u64) -> Vec<usize> {
+    let side = [speaker::SIDE_LEFT, speaker::SIDE_RIGHT];
+    let back = [speaker::BACK_LEFT, speaker::BACK_RIGHT];
+    let bits = if side.iter().any(|&bit| mask & bit != 0) {
+        side
+    } else {
+        back
+    };
+    bits.into_iter()
+        .filter(|&bit| mask & bit != 0)
+        .map(|bit| (mask & (bit - 1)).count_ones() as usize)
+        .collect()
+}
+
+/// FFmpeg 布局描述 → 声道掩码
+///
+/// 支持常见布局名（FFmpeg 原生声道顺序，如 "7.1" = FL FR FC LFE BL BR SL SR）
+/// 与 ffprobe 的标签序列（如 "FL+FR+FC+LFE+SL+SR"）；无法识别时返回 None。
+pub fn mask_from_ffmpeg_layout(layout_str: &str) -> Option<u64> {
+    use speaker::*;
+
+    const FIVE_ONE_BACK: u64 =
+        FRONT_LEFT | FRONT_RIGHT | FRONT_CENTER | LOW_FREQUENCY | BACK_LEFT | BACK_RIGHT;
+    const FIVE_ONE_SIDE: u64 =
+        FRONT_LEFT | FRONT_RIGHT | FRONT_CENTER | LOW_FREQUENCY | SIDE_LEFT | SIDE_RIGHT;
+    const SEVEN_ONE: u64 = FIVE_ONE_BACK | SIDE_LEFT | SIDE_RIGHT;
+    const TOP_FRONT: u64 = TOP_FRONT_LEFT | TOP_FRONT_RIGHT;
+    const TOP_BACK: u64 = TOP_BACK_LEFT | TOP_BACK_RIGHT;
+
+    let normalized = layout_str.trim().to_lowercase().replace(' ', "");
+    if normalized.contains('+') {
+        return normalized.split('+').try_fold(0u64, |mask, label| {
+            let bit = match label.to_uppercase().as_str() {
+                "FL" => FRONT_LEFT,
+                "FR" => FRONT_RIGHT,
+                "FC" => FRONT_CENTER,
+                "LFE" => LOW_FREQUENCY,
+                "BL" => BACK_LEFT,
+                "BR" => BACK_RIGHT,
+                "FLC" => FRONT_LEFT_OF_CENTER,
+                "FRC" => FRONT_RIGHT_OF_CENTER,
+                "BC" => BACK_CENTER,
+                "SL" => SIDE_LEFT,
+                "SR" => SIDE_RIGHT,
+                "TC" => TOP_CENTER,
+                "TFL" => TOP_FRONT_LEFT,
+                "TFC" => TOP_FRONT_CENTER,
+                "TFR" => TOP_FRONT_RIGHT,
+                "TBL" => TOP_BACK_LEFT,
+                "TBC" => TOP_BACK_CENTER,
+                "TBR" => TOP_BACK_RIGHT,
+                _ => return None,
+            };
+            Some(mask | bit)
+        });
+    }
+
+    Some(match normalized.as_str() {
+        "mono" => FRONT_CENTER,
+        "stereo" => FRONT_LEFT | FRONT_RIGHT,
+        "5.0" => FIVE_ONE_BACK & !LOW_FREQUENCY,
+        "5.0(side)" => FIVE_ONE_SIDE & !LOW_FREQUENCY,
+        "5.1" => FIVE_ONE_BACK,
+        "5.1(side)" => FIVE_ONE_SIDE,
+        "7.1" => SEVEN_ONE,
+        "7.1(wide)" => FIVE_ONE_BACK | FRONT_LEFT_OF_CENTER | FRONT_RIGHT_OF_CENTER,
+        "7.1(wide-side)" => FIVE_ONE_SIDE | FRONT_LEFT_OF_CENTER | FRONT_RIGHT_OF_CENTER,
+        "5.1.2" => FIVE_ONE_BACK | TOP_FRONT,
+        "5.1.4" => FIVE_ONE_BACK | TOP_FRONT | TOP_BACK,
+        "7.1.2" => SEVEN_ONE | TOP_FRONT,
+        "7.1.4" => SEVEN_ONE | TOP_FRONT | TOP_BACK,
+        _ => return None,
+    })
+}
+
+/// 回退方案：无布局元数据时的环绕声道推断
+///
+/// 只对声道顺序没有歧义的 5.0/5.1（环绕声道位于末尾两路）给出结果；
+/// 7 声道及以上的常见顺序互相冲突（侧/后环绕、高度声道位置不一），返回空（全部按 1.0 计）。
+pub fn fallback_surround_indices(channel_count: u16) -> Vec<usize> {
+    match channel_count {
+        5 => vec![3, 4], // L R C Ls Rs
+        6 => vec![4, 5], // L R C LFE Ls Rs
+        _ => Vec::new(),
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -344,6 +461,38 @@ mod tests {
         assert_eq!(detect_lfe_from_layout("mono", 1), Some(vec![]));
     }
 
+    #[test]
+    fn test_surround_from_mask() {
+        // 5.1(back)：FL FR FC LFE BL BR
+        assert_eq!(surround_indices_from_mask(0x3F), vec![4, 5]);
+        // 5.1(side)：FL FR FC LFE SL SR
+        assert_eq!(surround_indices_from_mask(0x60F), vec![4, 5]);
+        // 7.1：FL FR FC LFE BL BR SL SR → 仅侧环绕
+        assert_eq!(surround_indices_from_mask(0x63F), vec![6, 7]);
+        // 7.1.4：高度声道不计入
+        assert_eq!(surround_indices_from_mask(0x2D63F), vec![6, 7]);
+        assert!(surround_indices_from_mask(0x3).is_empty());
+    }
+
+    #[test]
+    fn test_mask_from_ffmpeg_layout() {
+        assert_eq!(mask_from_ffmpeg_layout("5.1"), Some(0x3F));
+        assert_eq!(mask_from_ffmpeg_layout("5.1(side)"), Some(0x60F));
+        assert_eq!(mask_from_ffmpeg_layout("7.1"), Some(0x63F));
+        assert_eq!(mask_from_ffmpeg_layout("7.1.4"), Some(0x2D63F));
+        assert_eq!(mask_from_ffmpeg_layout("FL+FR+FC+LFE+SL+SR"), Some(0x60F));
+        assert_eq!(mask_from_ffmpeg_layout("FL+FR+XYZ"), None);
+        assert_eq!(mask_from_ffmpeg_layout("hexadecagonal"), None);
+    }
+
+    #[test]
+    fn test_fallback_surround() {
+        assert_eq!(fallback_surround_indices(6), vec![4, 5]);
+        assert_eq!(fallback_surround_indices(5), vec![3, 4]);
+        assert!(fallback_surround_indices(8).is_empty());
+        assert!(fallback_surround_indices(12).is_empty());
+    }
+
     #[test]
     fn test_case_insensitive() {
         assert_eq!(detect_lfe_from_layout("5.1", 6), Some(vec![3]));
@@ -0,0 +1,469 @@
+//! CUE 分轨表解析与定位
+//!
+//! 整轨镜像（单个 FLAC/WAV + `.cue`）的分轨信息来源：
+//! - 同目录外部 `.cue` 文件（`<主名>.cue` 或 `<文件名>.cue`）
+//! - 内嵌分轨表：FLAC CUESHEET 元数据块，或 `CUESHEET` 标签（foobar2000 内嵌方式）
+//!
+//! 轨道起点取 INDEX 01（与常见分轨工具一致，INDEX 00 前置间隙归入上一轨；按编号识别，INDEX 02+ 忽略）；
+//! 第 1 轨 INDEX 01 之前的隐藏间隙归入第 1 轨。
+
+use crate::error::{self, AudioError, AudioResult};
+use std::path::{Path, PathBuf};
+
+/// CUE 时间码的帧率（mm:ss:ff 中 ff 为 1/75 秒）
+const CUE_FRAMES_PER_SECOND: u32 = 75;
+
+/// CD-DA 轨号上限（FLAC CUESHEET 的导出轨 170/255 不计入）
+const MAX_TRACK_NUMBER: u32 = 99;
+
+/// 分轨表中的单条轨道
+#[derive(Debug, Clone, PartialEq)]
+pub struct CueTrack {
+    /// 轨号（TRACK nn）
+    pub number: u32,
+    /// 曲名（TITLE）
+    pub title: Option<String>,
+    /// 演奏者（PERFORMER，缺省继承专辑演奏者）
+    pub performer: Option<String>,
+    /// 起点（以 `start_rate` 为单位的时间戳）
+    start: u64,
+    /// 起点时间戳的速率（文本CUE为75，内嵌FLAC CUESHEET为采样率）
+    start_rate: u32,
+    /// 所属 FILE 条目序号（多文件分轨表中各文件时间码独立）
+    file_index: usize,
+}
+
+impl CueTrack {
+    /// 按解码输出采样率换算起点帧号
+    pub fn start_frame(&self, sample_rate: u32) -> u64 {
+        if self.start_rate == sample_rate || self.start_rate == 0 {
+            return self.start;
+        }
+        (self.start as u128 * sample_rate as u128 / self.start_rate as u128) as u64
+    }
+}
+
+/// 单文件分轨表
+#[derive(Debug, Clone, PartialEq, Default)]
+pub struct CueSheet {
+    /// 专辑名（顶层 TITLE）
+    pub title: Option<String>,
+    /// 专辑演奏者（顶层 PERFORMER）
+    pub performer: Option<String>,
+    /// FILE 条目（仅记录文件名）
+    pub files: Vec<String>,
+    /// 按起点升序排列的轨道
+    pub tracks: Vec<CueTrack>,
+}
+
+impl CueSheet {
+    /// 解析 CUE 文本
+    ///
+    /// 仅识别 FILE / TRACK / INDEX 01 / TITLE / PERFORMER，其余命令（REM、FLAGS、ISRC等）忽略。
+    /// 轨道缺少 INDEX 01 或起点非递增时返回错误。
+    pub fn parse(text: &str) -> AudioResult<Self> {
+        let mut sheet = CueSheet::default();
+        let mut current: Option<PendingTrack> = None;
+
+        let invalid = |line_no: usize, what: &str| {
+            AudioError::FormatError(format!(
+                "Invalid CUE sheet at line {line_no}: {what} / CUE分轨表第{line_no}行无效: {what}"
+            ))
+        };
+
+        for (idx, raw_line) in text.trim_start_matches('\u{feff}').lines().enumerate() {
+            let line_no = idx + 1;
+            let line = raw_line.trim();
+            let (command, rest) = line.split_once(char::is_whitespace).unwrap_or((line, ""));
+            let rest = rest.trim();
+
+            match command.to_ascii_uppercase().as_str() {
+                "FILE" => sheet.files.push(file_name_of(rest)),
+                "TRACK" => {
+                    sheet.push_track(current.take(), line_no)?;
+                    let number = rest
+                        .split_whitespace()
+                        .next()
+                        .and_then(|n| n.parse::<u32>().ok())
+                        .ok_or_else(|| invalid(line_no, "TRACK number"))?;
+                    current = Some(PendingTrack {
+                        number,
+                        file_index: sheet.files.len().saturating_sub(1),
+                        ..PendingTrack::default()
+                    });
+                }
+                "INDEX" => {
+                    let mut parts = rest.split_whitespace();
+                    let index = parts.next().and_then(|n| n.parse::<u32>().ok());
+                    let time = parts.next().and_then(parse_cue_time);
+                    match (index, time, current.as_mut()) {
+                        (Some(1), Some(frames), Some(track)) => track.start = Some(frames),
+                        (Some(_), Some(_), _) => {}
+                        _ => return Err(invalid(line_no, "INDEX")),
+                    }
+                }
+                "TITLE" => match current.as_mut() {
+                    Some(track) => track.title = Some(unquote(rest)),
+                    None => sheet.title = Some(unquote(rest)),
+                },
+                "PERFORMER" => match current.as_mut() {
+                    Some(track) => track.performer = Some(unquote(rest)),
+                    None => sheet.performer = Some(unquote(rest)),
+                },
+                _ => {}
+            }
+        }
+        sheet.push_track(current.take(), text.lines().count())?;
+
+        for track in &mut sheet.tracks {
+            if track.performer.is_none() {
+                track.performer = sheet.performer.clone();
+            }
+        }
+        Ok(sheet)
+    }
+
+    /// 查找音频文件对应的分轨表（外部 `.cue` 优先，其次内嵌）
+    ///
+    /// 分轨表引用多个 FILE（每轨一个文件）或 FILE 与音频文件主名不符时视为无关，返回 `None`。
+    pub fn locate_for(audio_path: &Path) -> AudioResult<Option<Self>> {
+        for candidate in external_cue_candidates(audio_path) {
+            if !candidate.is_file() {
+                continue;
+            }
+            let bytes = std::fs::read(&candidate)?;
+            // 非 UTF-8 编码（GBK/Shift-JIS 等）按有损解码处理，仅影响曲名显示
+            let sheet = Self::parse(&String::from_utf8_lossy(&bytes))?;
+            if sheet.describes(audio_path) {
+                return Ok(Some(sheet));
+            }
+        }
+
+        Self::read_embedded(audio_path)
+    }
+
+    /// 分轨表是否描述该音频文件（单 FILE 且主名一致；FILE 缺失时按同名 `.cue` 视为匹配）
+    fn describes(&self, audio_path: &Path) -> bool {
+        match self.files.as_slice() {
+            [] => true,
+            [file] => {
+                let audio_stem = audio_path.file_stem().map(|s| s.to_string_lossy());
+                let cue_stem = Path::new(file).file_stem().map(|s| s.to_string_lossy());
+                audio_stem.is_some() && audio_stem == cue_stem
+            }
+            _ => false,
+        }
+    }
+
+    /// 读取内嵌分轨表：FLAC CUESHEET 块优先，其次 `CUESHEET` 文本标签
+    fn read_embedded(audio_path: &Path) -> AudioResult<Option<Self>> {
+        use symphonia::core::formats::FormatOptions;
+        use symphonia::core::io::MediaSourceStream;
+        use symphonia::core::meta::MetadataOptions;
+        use symphonia::core::probe::Hint;
+
+        let extension = audio_path
+            .extension()
+            .map(|ext| ext.to_string_lossy().to_lowercase())
+            .unwrap_or_default();
+        // 仅 FLAC/WavPack/APE 等整轨镜像常见容器携带内嵌分轨表
+        if !matches!(extension.as_str(), "flac" | "wv" | "ape" | "tak") {
+            return Ok(None);
+        }
+
+        let file = std::fs::File::open(audio_path)?;
+        let mss = MediaSourceStream::new(Box::new(file), Default::default());
+        let mut hint = Hint::new();
+        hint.with_extension(&extension);
+
+        let mut probed = match symphonia::default::get_probe().format(
+            &hint,
+            mss,
+            &FormatOptions::default(),
+            &MetadataOptions::default(),
+        ) {
+            Ok(probed) => probed,
+            // Symphonia 不支持的容器（APE/TAK）：无从读取内嵌分轨表
+            Err(_) => return Ok(None),
+        };
+
+        let sample_rate = probed
+            .format
+            .default_track()
+            .and_then(|t| t.codec_params.sample_rate)
+            .unwrap_or(0);
+
+        // FLAC CUESHEET 块：start_ts 为轨道偏移，points 为索引点（偏移相对轨道起点）
+        let mut tracks: Vec<CueTrack> = probed
+            .format
+            .cues()
+            .iter()
+            .filter(|cue| (1..=MAX_TRACK_NUMBER).contains(&cue.index))
+            .map(|cue| {
+                let points: Vec<(Option<u32>, u64)> = cue
+                    .points
+                    .iter()
+                    .map(|point| (index_point_number(&point.tags), point.start_offset_ts))
+                    .collect();
+                let index_01_offset = index_01_offset(&points);
+                CueTrack {
+                    number: cue.index,
+                    title: None,
+                    performer: None,
+                    start: cue.start_ts + index_01_offset,
+                    start_rate: sample_rate,
+                    file_index: 0,
+                }
+            })
+            .collect();
+        if tracks.len() >= 2 && sample_rate > 0 {
+            tracks.sort_by_key(|t| t.start);
+            return Ok(Some(CueSheet {
+                tracks,
+                ..CueSheet::default()
+            }));
+        }
+
+        // CUESHEET 文本标签（Vorbis comment，容器级或探测阶段元数据）
+        let mut cue_text = None;
+        if let Some(revision) = probed.format.metadata().current() {
+            cue_text = cuesheet_tag(revision.tags());
+        }
+        if cue_text.is_none()
+            && let Some(metadata) = probed.metadata.get()
+            && let Some(revision) = metadata.current()
+        {
+            cue_text = cuesheet_tag(revision.tags());
+        }
+
+        match cue_text {
+            Some(text) => Self::parse(&text)
+                .map(Some)
+                .map_err(|e| error::format_error("Invalid embedded CUESHEET / 内嵌分轨表无效", e)),
+            None => Ok(None),
+        }
+    }
+
+    /// 收尾一条轨道（校验 INDEX 01 存在且起点递增）
+    fn push_track(&mut self, track: Option<PendingTrack>, line_no: usize) -> AudioResult<()> {
+        let Some(PendingTrack {
+            number,
+            title,
+            performer,
+            start,
+            file_index,
+        }) = track
+        else {
+            return Ok(());
+        };
+        let start = start.ok_or_else(|| {
+            AudioError::FormatError(format!(
+                "CUE track {number} has no INDEX 01 (line {line_no}) / CUE第{number}轨缺少INDEX 01（第{line_no}行）"
+            ))
+        })?;
+        if let Some(previous) = self.tracks.last()
+            && previous.file_index == file_index
+            && start <= previous.start
+        {
+            return Err(AudioError::FormatError(format!(
+                "CUE track {number} starts before track {} / CUE第{number}轨起点早于第{}轨",
+                previous.number, previous.number
+            )));
+        }
+        self.tracks.push(CueTrack {
+            number,
+            title,
+            performer,
+            start,
+            start_rate: CUE_FRAMES_PER_SECOND,
+            file_index,
+        });
+        Ok(())
+    }
+}
+
+/// 解析中的轨道（遇到下一个 TRACK 或文本结束时收尾）
+#[derive(Default)]
+struct PendingTrack {
+    number: u32,
+    title: Option<String>,
+    performer: Option<String>,
+    /// INDEX 01（1/75 秒帧数）
+    start: Option<u64>,
+    file_index: usize,
+}
+
+/// 索引点编号（解码器以 `INDEX_POINT` 标签提供）
+fn index_point_number(tags: &[symphonia::core::meta::Tag]) -> Option<u32> {
+    use symphonia::core::meta::Value;
+
+    let tag = tags
+        .iter()
+        .find(|tag| tag.key.eq_ignore_ascii_case("INDEX_POINT"))?;
+    match &tag.value {
+        Value::UnsignedInt(n) => u32::try_from(*n).ok(),
+        Value::SignedInt(n) => u32::try_from(*n).ok(),
+        other => other.to_string().trim().parse().ok(),
+    }
+}
+
+/// 从轨道索引点（编号, 相对偏移）中选取 INDEX 01 的偏移
+///
+/// 按编号查找 INDEX 01；索引点未带编号时取第一个索引点。这样即使没有 INDEX 00，
+/// 也不会把 INDEX 02 误当作起点；代价是存在 INDEX 00 时前置间隙归入本轨。
+fn index_01_offset(points: &[(Option<u32>, u64)]) -> u64 {
+    points
+        .iter()
+        .find(|(number, _)| *number == Some(1))
+        .or_else(|| points.iter().find(|(number, _)| number.is_none()))
+        .or(points.first())
+        .map_or(0, |&(_, offset)| offset)
+}
+
+/// 外部 `.cue` 候选路径：`album.cue`、`album.flac.cue`
+fn external_cue_candidates(audio_path: &Path) -> [PathBuf; 2] {
+    let mut with_file_name = audio_path.as_os_str().to_owned();
+    with_file_name.push(".cue");
+    [
+        audio_path.with_extension("cue"),
+        PathBuf::from(with_file_name),
+    ]
+}
+
+/// 在标签列表中查找 `CUESHEET`（大小写不敏感）
+fn cuesheet_tag(tags: &[symphonia::core::meta::Tag]) -> Option<String> {
+    tags.iter()
+        .find(|tag| tag.key.eq_ignore_ascii_case("CUESHEET"))
+        .map(|tag| tag.value.to_string())
+}
+
+/// 解析 `mm:ss:ff` 为 1/75 秒帧数
+fn parse_cue_time(s: &str) -> Option<u64> {
+    let mut parts = s.split(':').map(|p| p.parse::<u64>().ok());
+    let (minutes, seconds, frames) = (parts.next()??, parts.next()??, parts.next()??);
+    if parts.next().is_some() || seconds >= 60 || frames >= CUE_FRAMES_PER_SECOND as u64 {
+        return None;
+    }
+    Some((minutes * 60 + seconds) * CUE_FRAMES_PER_SECOND as u64 + frames)
+}
+
+/// 去掉 `"..."` 引号
+fn unquote(s: &str) -> String {
+    let s = s.trim();
+    if let Some(inner) = s.strip_prefix('"') {
+        inner.split('"').next().unwrap_or_default().to_string()
+    } else {
+        s.to_string()
+    }
+}
+
+/// FILE 行参数 → 文件名（去掉 WAVE/BINARY 等类型字段与目录部分）
+fn file_name_of(arg: &str) -> String {
+    let name = if arg.starts_with('"') {
+        unquote(arg)
+    } else {
+        arg.rsplit_once(char::is_whitespace)
+            .map(|(name, _)| name.to_string())
+            .unwrap_or_else(|| arg.to_string())
+    };
+    let name = name.replace('\\', "/");
+    name.rsplit('/').next().unwrap_or_default().to_string()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const SAMPLE_CUE: &str = "\u{feff}REM GENRE Jazz\r
+PERFORMER \"Some Artist\"\r
+TITLE \"Some Album\"\r
+FILE \"Some Album.wav\" WAVE\r
+  TRACK 01 AUDIO\r
+    TITLE \"Intro\"\r
+    INDEX 01 00:00:00\r
+  TRACK 02 AUDIO\r
+    TITLE \"Second\"\r
+    PERFORMER \"Guest\"\r
+    INDEX 00 03:58:50\r
+    INDEX 01 04:00:00\r
+  TRACK 03 AUDIO\r
+    TITLE \"Third\"\r
+    INDEX 01 07:12:37\r
+";
+
+    #[test]
+    fn test_parse_cue_sheet() {
+        let sheet = CueSheet::parse(SAMPLE_CUE).unwrap();
+        assert_eq!(sheet.title.as_deref(), Some("Some Album"));
+        assert_eq!(sheet.files, vec!["Some Album.wav".to_string()]);
+        assert_eq!(sheet.tracks.len(), 3);
+
+        // INDEX 01 为起点，INDEX 00 前置间隙归入上一轨
+        assert_eq!(sheet.tracks[1].start_frame(44100), 240 * 44100);
+        // 75fps 帧换算：37/75 秒 @ 48kHz = 23680 帧
+        assert_eq!(
+            sheet.tracks[2].start_frame(48000),
+            (7 * 60 + 12) * 48000 + 23680
+        );
+        // 轨道演奏者缺省继承专辑演奏者
+        assert_eq!(sheet.tracks[0].performer.as_deref(), Some("Some Artist"));
+        assert_eq!(sheet.tracks[1].performer.as_deref(), Some("Guest"));
+    }
+
+    #[test]
+    fn test_parse_rejects_missing_or_unordered_index() {
+        let missing = "FILE \"a.flac\" WAVE\n TRACK 01 AUDIO\n TITLE \"x\"\n";
+        assert!(matches!(
+            CueSheet::parse(missing),
+            Err(AudioError::FormatError(_))
+        ));
+
+        let unordered = "TRACK 01 AUDIO\n INDEX 01 02:00:00\nTRACK 02 AUDIO\n INDEX 01 01:00:00\n";
+        assert!(CueSheet::parse(unordered).is_err());
+    }
+
+    #[test]
+    fn test_describes_matches_file_stem() {
+        let sheet = CueSheet::parse(SAMPLE_CUE).unwrap();
+        // 转码后扩展名不同（.wav → .flac）仍视为同一镜像
+        assert!(sheet.describes(Path::new("/music/Some Album.flac")));
+        assert!(!sheet.describes(Path::new("/music/Other.flac")));
+
+        let multi_file = "FILE \"01.flac\" WAVE\n TRACK 01 AUDIO\n INDEX 01 00:00:00\n\
+                          FILE \"02.flac\" WAVE\n TRACK 02 AUDIO\n INDEX 01 00:00:00\n";
+        // 多文件分轨表：各文件时间码独立，可解析但不描述任何单一镜像
+        let sheet = CueSheet::parse(multi_file).unwrap();
+        assert_eq!(sheet.tracks.len(), 2);
+        assert!(!sheet.describes(Path::new("/music/01.flac")));
+    }
+
+    #[test]
+    fn test_index_01_offset_by_number() {
+        // INDEX 00 + 01：按编号取 INDEX 01
+        assert_eq!(index_01_offset(&[(Some(0), 0), (Some(1), 88200)]), 88200);
+        // 无 INDEX 00，有 INDEX 01 + 02：仍取 INDEX 01 而非第二个索引点
+        assert_eq!(index_01_offset(&[(Some(1), 0), (Some(2), 441_000)]), 0);
+        // 索引点未带编号：取第一个索引点
+        assert_eq!(index_01_offset(&[(None, 0), (None, 441_000)]), 0);
+        assert_eq!(index_01_offset(&[]), 0);
+
+        // 文本分轨表：无 INDEX 00 时 INDEX 02 不影响起点
+        let sheet = CueSheet::parse(
+            "TRACK 01 AUDIO\n INDEX 01 00:00:00\nTRACK 02 AUDIO\n INDEX 01 03:00:00\n INDEX 02 03:30:00\n",
+        )
+        .unwrap();
+        assert_eq!(sheet.tracks[1].start_frame(44100), 180 * 44100);
+    }
+
+    #[test]
+    fn test_parse_cue_time_and_file_name() {
+        assert_eq!(parse_cue_time("01:02:03"), Some((62 * 75) + 3));
+        assert_eq!(parse_cue_time("00:60:00"), None);
+        assert_eq!(parse_cue_time("00:00:75"), None);
+        assert_eq!(
+            file_name_of("\"CD1\\Some Album.flac\" WAVE"),
+            "Some Album.flac"
+        );
+        assert_eq!(file_name_of("Album.wav WAVE"), "Album.wav");
+    }
+}
@@ -394,6 +394,8 @@ impl FFmpegDecoder {
 
                 if let Some(indices) = lfe_idx {
                     format.set_lfe_indices(indices);
+                    // Dolby 顺序中 Ls/Rs 固定在索引 3、4（7.1 的 Rls/Rrs 为后环绕，按 1.0 计）
+                    format.set_surround_indices(vec![3, 4]);
                 }
             } else {
                 // 容器格式或其他编码：使用精确的声道布局检测（基于Apple CoreAudio规范）
@@ -403,6 +405,12 @@ impl FFmpegDecoder {
                 {
                     format.set_lfe_indices(lfe_idxs);
                 }
+                // 环绕声道按 FFmpeg 原生顺序（掩码位序）定位，不套用 CoreAudio 布局表
+                if let Some(mask) = channel_layout::mask_from_ffmpeg_layout(&layout_joined)
+                    && mask.count_ones() == format.channels as u32
+                {
+                    format.set_surround_indices(channel_layout::surround_indices_from_mask(mask));
+                }
             }
         }
 
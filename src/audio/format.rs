@@ -32,6 +32,8 @@ pub struct AudioFormat {
     pub has_channel_layout_metadata: bool,
     /// 由通道掩码/映射推导的 LFE 声道索引（交错顺序中的下标）。若无可用元数据则为空
     pub lfe_indices: Vec<usize>,
+    /// 由通道掩码/布局推导的环绕声道索引（BS.1770 加权 1.41 的声道）。若无可用元数据则为空
+    pub surround_indices: Vec<usize>,
     /// 是否为部分分析（解码过程中跳过了损坏的音频包）
     is_partial: bool,
     /// 跳过的损坏包数量（累积统计）
@@ -52,6 +54,7 @@ impl AudioFormat {
             dsd_multiple_of_44k: None,
             has_channel_layout_metadata: false,
             lfe_indices: Vec::new(),
+            surround_indices: Vec::new(),
             is_partial: false,
             skipped_packets: 0,
         }
@@ -191,6 +194,14 @@ impl AudioFormat {
             self.has_channel_layout_metadata = true;
         }
     }
+
+    /// 设置环绕声道索引（基于掩码/布局推导）。调用该方法也将标记存在布局元数据
+    pub fn set_surround_indices(&mut self, indices: Vec<usize>) {
+        if !indices.is_empty() {
+            self.surround_indices = indices;
+            self.has_channel_layout_metadata = true;
+        }
+    }
 }
 
 /// 格式支持信息
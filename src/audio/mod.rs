@@ -55,8 +55,24 @@ pub mod parallel_decoder;
 // 统一解码器架构 - 唯一推荐的解码器
 pub mod universal_decoder;
 
+// CUE分轨表解析 - 整轨镜像按 INDEX 01 分轨分析
+pub mod cue_sheet;
+
+// 多音轨单次解复用 - MKV/MP4 多音轨逐轨分析
+pub mod multi_track;
+
+// 管道流式解码器 - `-` 标准输入（WAV/W64 或原始PCM）
+pub mod pipe_decoder;
+
+// 稀疏窗口读取器 - 估算模式按定位表只解码抽样窗口
+pub mod sparse_reader;
+
 // 导出核心类型（直接从定义模块导出，避免间接依赖）
+pub use cue_sheet::{CueSheet, CueTrack};
 pub use format::{AudioFormat, FormatSupport};
+pub use multi_track::{AudioTrackInfo, MultiTrackDemuxer, SkippedTrack, TrackStreamingDecoder};
+pub use pipe_decoder::{PipeStreamingDecoder, RawPcmSpec, RawSampleFormat};
+pub use sparse_reader::SparseWindowReader;
 pub use stats::ChunkSizeStats;
 pub use streaming::StreamingDecoder;
 
@@ -0,0 +1,377 @@
+//! 多音轨单次解复用（MKV/MP4 等多音轨容器）
+//!
+//! 蓝光转制文件常含多条音轨（评论音轨、不同混音版本）。逐条分析需要反复读取整个文件；
+//! 这里只解复用一次，按轨道ID把包分发到各自的解码器，每条音轨在独立线程中
+//! 以 [`StreamingDecoder`] 的形式被消费，从而复用完整的流式DR分析引擎。
+//!
+//! 分发队列有界：某条音轨分析较慢时解复用线程阻塞，内存占用与音轨数线性相关而与文件长度无关。
+
+use super::format::AudioFormat;
+use super::stats::ChunkSizeStats;
+use super::streaming::StreamingDecoder;
+use super::universal_decoder::UniversalDecoder;
+use crate::error::{self, AudioError, AudioResult};
+use crate::processing::SampleConverter;
+use crossbeam_channel::{Receiver, Sender};
+use std::collections::HashMap;
+use std::path::Path;
+use symphonia::core::codecs::Decoder;
+use symphonia::core::formats::{FormatReader, Packet};
+
+/// 音轨描述
+#[derive(Debug, Clone)]
+pub struct AudioTrackInfo {
+    /// 音轨序号：在容器全部音频轨道中的位置（含无法解码的音轨，从1开始）
+    pub ordinal: usize,
+    /// 容器内轨道ID
+    pub track_id: u32,
+    /// 语言标记（容器提供时）
+    pub language: Option<String>,
+    /// 音轨格式
+    pub format: AudioFormat,
+}
+
+impl AudioTrackInfo {
+    /// 报告中使用的音轨标签，如 `Track 2 (eng)`
+    pub fn label(&self) -> String {
+        match &self.language {
+            Some(language) => format!("Track {} ({language})", self.ordinal),
+            None => format!("Track {}", self.ordinal),
+        }
+    }
+}
+
+/// 无法解码而被跳过的音轨
+#[derive(Debug, Clone)]
+pub struct SkippedTrack {
+    /// 音轨描述（格式取容器声明值，可能不完整）
+    pub info: AudioTrackInfo,
+    /// 跳过原因
+    pub reason: String,
+}
+
+/// 多音轨解复用器：一次读取，按轨分发
+pub struct MultiTrackDemuxer {
+    format_reader: Box<dyn FormatReader>,
+    tracks: Vec<AudioTrackInfo>,
+    decoders: Vec<Box<dyn Decoder>>,
+    skipped: Vec<SkippedTrack>,
+}
+
+impl MultiTrackDemuxer {
+    /// 打开容器并为每条可解码的音轨创建解码器
+    ///
+    /// 音频轨道按其在容器中的位置编号；无法创建解码器的音轨（如 Symphonia 不支持的
+    /// DTS/TrueHD）记入 [`skipped_tracks`](Self::skipped_tracks) 且保留序号。
+    /// 一条可解码音轨也没有时返回错误。
+    pub fn open<P: AsRef<Path>>(path: P) -> AudioResult<Self> {
+        use symphonia::core::codecs::{CODEC_TYPE_NULL, DecoderOptions};
+        use symphonia::core::formats::FormatOptions;
+        use symphonia::core::io::MediaSourceStream;
+        use symphonia::core::meta::MetadataOptions;
+        use symphonia::core::probe::Hint;
+
+        let path = path.as_ref();
+        let file = std::fs::File::open(path)?;
+        let mss = MediaSourceStream::new(Box::new(file), Default::default());
+        let mut hint = Hint::new();
+        if let Some(extension) = path.extension() {
+            hint.with_extension(&extension.to_string_lossy());
+        }
+
+        let probed = symphonia::default::get_probe()
+            .format(
+                &hint,
+                mss,
+                &FormatOptions::default(),
+                &MetadataOptions::default(),
+            )
+            .map_err(|e| error::format_error("Failed to probe format / 格式探测失败", e))?;
+        let format_reader = probed.format;
+
+        let universal_decoder = UniversalDecoder::new();
+        let mut tracks = Vec::new();
+        let mut decoders = Vec::new();
+        let mut skipped = Vec::new();
+        // 音频轨道：有可识别的编解码器，或容器声明了采样率（编解码器未知的音频轨道）
+        let audio_tracks = format_reader.tracks().iter().filter(|t| {
+            t.codec_params.codec != CODEC_TYPE_NULL || t.codec_params.sample_rate.is_some()
+        });
+        for (index, track) in audio_tracks.enumerate() {
+            let opened = symphonia::default::get_codecs()
+                .make(&track.codec_params, &DecoderOptions::default())
+                .map_err(|e| error::decoding_error("Unsupported audio track / 不支持的音轨", e))
+                .and_then(|decoder| {
+                    let format = universal_decoder.format_from_codec_params(&track.codec_params)?;
+                    format.validate()?;
+                    Ok((decoder, format))
+                });
+
+            let mut info = AudioTrackInfo {
+                ordinal: index + 1,
+                track_id: track.id,
+                language: track.language.clone(),
+                format: AudioFormat::new(0, 0, 0, 0),
+            };
+            match opened {
+                Ok((decoder, format)) => {
+                    info.format = format;
+                    tracks.push(info);
+                    decoders.push(decoder);
+                }
+                Err(e) => {
+                    if let Ok(format) =
+                        universal_decoder.format_from_codec_params(&track.codec_params)
+                    {
+                        info.format = format;
+                    }
+                    skipped.push(SkippedTrack {
+                        info,
+                        reason: e.to_string(),
+                    });
+                }
+            }
+        }
+
+        if tracks.is_empty() {
+            return Err(AudioError::FormatError(format!(
+                "未找到可解码的音频轨道: 文件 {}",
+                path.display()
+            )));
+        }
+
+        Ok(Self {
+            format_reader,
+            tracks,
+            decoders,
+            skipped,
+        })
+    }
+
+    /// 可解码的音轨列表
+    pub fn tracks(&self) -> &[AudioTrackInfo] {
+        &self.tracks
+    }
+
+    /// 无法解码而被跳过的音轨
+    pub fn skipped_tracks(&self) -> &[SkippedTrack] {
+        &self.skipped
+    }
+
+    /// 容器内音频轨道总数（含被跳过的音轨）
+    pub fn audio_track_count(&self) -> usize {
+        self.tracks.len() + self.skipped.len()
+    }
+
+    /// 单次解复用并行分析所有音轨
+    ///
+    /// 每条音轨在独立的作用域线程中通过 `analyze` 消费自己的 [`TrackStreamingDecoder`]，
+    /// 解复用留在调用线程。返回结果与 [`tracks`](Self::tracks) 顺序一致。
+    /// 某条音轨的 `analyze` 提前返回（如解码失败）时，其后续包被直接丢弃，不影响其他音轨。
+    pub fn analyze_all<R, F>(self, analyze: F) -> AudioResult<Vec<R>>
+    where
+        F: Fn(&mut TrackStreamingDecoder) -> R + Sync,
+        R: Send,
+    {
+        use crate::tools::constants::decoder_performance::MULTI_TRACK_PACKET_QUEUE;
+
+        let Self {
+            mut format_reader,
+            tracks,
+            decoders,
+            ..
+        } = self;
+
+        let mut senders: HashMap<u32, Sender<Packet>> = HashMap::with_capacity(tracks.len());
+        let mut track_decoders = Vec::with_capacity(tracks.len());
+        for (info, decoder) in tracks.into_iter().zip(decoders) {
+            let (sender, receiver) = crossbeam_channel::bounded(MULTI_TRACK_PACKET_QUEUE);
+            senders.insert(info.track_id, sender);
+            track_decoders.push(TrackStreamingDecoder::new(info, decoder, receiver));
+        }
+
+        let analyze = &analyze;
+        std::thread::scope(|scope| {
+            let handles: Vec<_> = track_decoders
+                .into_iter()
+                .map(|mut track_decoder| scope.spawn(move || analyze(&mut track_decoder)))
+                .collect();
+
+            let demux_result = demux_packets(&mut *format_reader, &mut senders);
+
+            // 关闭全部队列：各音轨排空剩余包后结束
+            drop(senders);
+            let results = handles
+                .into_iter()
+                .map(|handle| {
+                    handle
+                        .join()
+                        .unwrap_or_else(|p| std::panic::resume_unwind(p))
+                })
+                .collect();
+
+            demux_result.map(|()| results)
+        })
+    }
+}
+
+/// 解复用循环：按轨道ID分发包；接收端已退出的音轨不再分发
+fn demux_packets(
+    format_reader: &mut dyn FormatReader,
+    senders: &mut HashMap<u32, Sender<Packet>>,
+) -> AudioResult<()> {
+    use symphonia::core::errors::Error;
+
+    while !senders.is_empty() {
+        let packet = match format_reader.next_packet() {
+            Ok(packet) => packet,
+            Err(Error::IoError(e)) if e.kind() == std::io::ErrorKind::UnexpectedEof => break,
+            Err(e) => return Err(error::format_error("Failed to read packet / 读取包失败", e)),
+        };
+
+        let track_id = packet.track_id();
+        if let Some(sender) = senders.get(&track_id)
+            && sender.send(packet).is_err()
+        {
+            senders.remove(&track_id);
+        }
+    }
+    Ok(())
+}
+
+/// 单条音轨的流式解码器：从分发队列取包并解码
+pub struct TrackStreamingDecoder {
+    info: AudioTrackInfo,
+    decoder: Box<dyn Decoder>,
+    packets: Receiver<Packet>,
+    sample_converter: SampleConverter,
+    chunk_stats: ChunkSizeStats,
+    /// 已解码帧数（动态更新格式中的样本数）
+    decoded_frames: u64,
+    /// 跳过的损坏包总数
+    skipped_packets: usize,
+    /// 连续解码错误计数（成功时重置）
+    consecutive_errors: usize,
+}
+
+impl TrackStreamingDecoder {
+    fn new(info: AudioTrackInfo, decoder: Box<dyn Decoder>, packets: Receiver<Packet>) -> Self {
+        Self {
+            info,
+            decoder,
+            packets,
+            sample_converter: SampleConverter::new(),
+            chunk_stats: ChunkSizeStats::new(),
+            decoded_frames: 0,
+            skipped_packets: 0,
+            consecutive_errors: 0,
+        }
+    }
+
+    /// 音轨描述
+    pub fn info(&self) -> &AudioTrackInfo {
+        &self.info
+    }
+}
+
+impl StreamingDecoder for TrackStreamingDecoder {
+    fn next_chunk(&mut self) -> AudioResult<Option<Vec<f32>>> {
+        // 与串行流式解码一致的容错上限
+        const MAX_CONSECUTIVE_ERRORS: usize = 100;
+
+        while let Ok(packet) = self.packets.recv() {
+            self.chunk_stats.add_chunk(packet.dur() as usize);
+
+            match self.decoder.decode(&packet) {
+                Ok(decoded) => {
+                    let mut samples = Vec::new();
+                    self.sample_converter
+                        .convert_buffer_to_interleaved(&decoded, &mut samples)?;
+                    self.consecutive_errors = 0;
+                    self.decoded_frames +=
+                        samples.len() as u64 / self.info.format.channels.max(1) as u64;
+                    return Ok(Some(samples));
+                }
+                Err(symphonia::core::errors::Error::DecodeError(_)) => {
+                    self.skipped_packets += 1;
+                    self.consecutive_errors += 1;
+                    if self.consecutive_errors > MAX_CONSECUTIVE_ERRORS {
+                        return Err(error::decoding_error(
+                            "Too many consecutive decode failures, file may be corrupted / 连续解码失败过多，文件可能已损坏",
+                            format!(
+                                "{} ({} skipped packets / 跳过{}个包)",
+                                self.info.label(),
+                                self.skipped_packets,
+                                self.skipped_packets
+                            ),
+                        ));
+                    }
+                }
+                Err(e) => {
+                    return Err(error::decoding_error(
+                        "Audio packet decoding failed / 音频包解码失败",
+                        e,
+                    ));
+                }
+            }
+        }
+
+        // 队列关闭：解复用已结束
+        Ok(None)
+    }
+
+    fn progress(&self) -> f32 {
+        let expected = self.info.format.sample_count;
+        if expected == 0 {
+            0.0
+        } else {
+            (self.decoded_frames as f32 / expected as f32).min(1.0)
+        }
+    }
+
+    fn format(&self) -> AudioFormat {
+        let mut format = self.info.format.clone();
+        format.update_sample_count(self.decoded_frames);
+        if self.skipped_packets > 0 {
+            format.mark_as_partial(self.skipped_packets);
+        }
+        format
+    }
+
+    fn reset(&mut self) -> AudioResult<()> {
+        Err(AudioError::InvalidInput(
+            "Demultiplexed audio tracks cannot be rewound / 解复用音轨不支持重置".to_string(),
+        ))
+    }
+
+    fn get_chunk_stats(&mut self) -> Option<ChunkSizeStats> {
+        self.chunk_stats.finalize();
+        Some(self.chunk_stats.clone())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_track_label() {
+        let mut info = AudioTrackInfo {
+            ordinal: 2,
+            track_id: 3,
+            language: Some("eng".to_string()),
+            format: AudioFormat::new(48000, 6, 24, 0),
+        };
+        assert_eq!(info.label(), "Track 2 (eng)");
+        info.language = None;
+        assert_eq!(info.label(), "Track 2");
+    }
+
+    #[test]
+    fn test_open_missing_file_is_io_error() {
+        assert!(matches!(
+            MultiTrackDemuxer::open("missing_multi_track.mkv"),
+            Err(AudioError::IoError(_))
+        ));
+    }
+}
@@ -15,25 +15,30 @@
 //! ```text
 //! Packet Stream → [Batch Buffer] → [Parallel Decode Pool] → [Sequence Reorder] → Ordered Samples
 //!                      ↓                    ↓                      ↓
-//!                 固定批大小           4-8线程并行              序列号排序重组
+//!            自适应批大小       连续包组/线程并行         包组序列号排序重组
 //! ```
 
+use super::stats::ChunkSizeStats;
 use crate::error::{self, AudioResult};
 use crate::processing::SampleConverter;
 use crate::tools::constants::{
-    decoder_performance::{self, DRAIN_RECV_TIMEOUT_MS, THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY},
+    decoder_performance::{
+        self, ADAPTIVE_BATCH_MAX_FRAMES, ADAPTIVE_BATCH_TARGET_WORKER_MICROS,
+        ADAPTIVE_BATCH_WARMUP_PACKETS, SAMPLE_BUFFER_POOL_CAPACITY,
+        THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY,
+    },
     parallel_limits,
 };
 use crossbeam_channel::{
     self, Receiver, RecvError, RecvTimeoutError, SendError, Sender, TryRecvError,
 };
 use rayon::ThreadPoolBuilder;
-use std::time::Duration;
+use std::time::{Duration, Instant};
 use std::{
-    collections::HashMap,
+    collections::{HashMap, VecDeque},
     sync::{
         Arc, Mutex,
-        atomic::{AtomicUsize, Ordering},
+        atomic::{AtomicU64, AtomicUsize, Ordering},
     },
 };
 use symphonia::core::{
@@ -66,10 +71,13 @@ pub enum DecodingState {
     Completed,
 }
 
-/// 带序列号的数据包装器
-struct SequencedPacket {
+/// 带序列号的连续包组 - 并行解码的最小调度单元
+///
+/// 一组连续的包由同一个工作线程顺序解码，输出拼接为一个连续缓冲区，
+/// 只占用一个序列号、一次通道发送和一次重排序插入。
+struct PacketGroup {
     sequence: usize,
-    packet: Packet,
+    packets: Vec<Packet>,
 }
 
 /// 有序通道 - 确保乱序并行结果按顺序输出
@@ -274,6 +282,68 @@ impl<T> OrderedSender<T> {
     }
 }
 
+/// 样本缓冲池 - 分析端归还、解码工作线程取用的无锁缓冲区池
+///
+/// 基于 crossbeam 有界通道（数组实现，无锁）：
+/// - **取用** `take()`：工作线程发送结果后取一个空缓冲区替换，池空时新分配
+/// - **归还** `give_back()`：消费端处理完样本后清空并放回，池满时直接释放
+///
+/// 缓冲区容量随流的典型包大小自然增长，稳态下解码不再为每个包分配堆内存。
+#[derive(Debug, Clone)]
+pub struct SampleBufferPool {
+    sender: Sender<Vec<f32>>,
+    receiver: Receiver<Vec<f32>>,
+    /// 池空导致新分配的次数（所有克隆共享）
+    misses: Arc<AtomicUsize>,
+}
+
+impl SampleBufferPool {
+    /// 创建最多保留 `capacity` 个缓冲区的池
+    pub fn with_capacity(capacity: usize) -> Self {
+        let (sender, receiver) = crossbeam_channel::bounded(capacity.max(1));
+        Self {
+            sender,
+            receiver,
+            misses: Arc::new(AtomicUsize::new(0)),
+        }
+    }
+
+    /// 取一个空缓冲区；池为空时分配容量为 `min_capacity` 的新缓冲区
+    pub fn take(&self, min_capacity: usize) -> Vec<f32> {
+        match self.receiver.try_recv() {
+            Ok(mut buffer) => {
+                buffer.reserve(min_capacity);
+                buffer
+            }
+            Err(_) => {
+                self.misses.fetch_add(1, Ordering::Relaxed);
+                Vec::with_capacity(min_capacity)
+            }
+        }
+    }
+
+    /// 归还缓冲区（清空但保留容量）；零容量缓冲区或池已满时直接释放
+    pub fn give_back(&self, mut buffer: Vec<f32>) {
+        if buffer.capacity() == 0 {
+            return;
+        }
+        buffer.clear();
+        let _ = self.sender.try_send(buffer);
+    }
+
+    /// 当前池中可用缓冲区数
+    pub fn available(&self) -> usize {
+        self.receiver.len()
+    }
+
+    /// 累计未命中次数（池空时 `take()` 新分配的缓冲区数）
+    ///
+    /// 稳态下应停止增长；持续增长说明缓冲区未被归还。
+    pub fn misses(&self) -> usize {
+        self.misses.load(Ordering::Relaxed)
+    }
+}
+
 /// 有序并行解码器 - 核心性能优化组件
 ///
 /// 职责：将包批量化并行解码，保证输出顺序与输入完全一致
@@ -283,8 +353,8 @@ pub struct OrderedParallelDecoder {
     /// Rayon线程池 - 复用工作线程（Arc包装，支持廉价clone）
     thread_pool: Arc<rayon::ThreadPool>,
     /// 当前批次缓冲区
-    current_batch: Vec<SequencedPacket>,
-    /// 序列号计数器
+    current_batch: Vec<Packet>,
+    /// 序列号计数器（按包组分配）
     sequence_counter: usize,
     /// 有序样本通道（传输DecodedChunk以支持显式EOF）
     samples_channel: SequencedChannel<DecodedChunk>,
@@ -298,6 +368,45 @@ pub struct OrderedParallelDecoder {
     flushed: bool,
     /// EOF遇到标志 - 防止next_samples()消费EOF导致drain无法收到
     eof_encountered: bool,
+    /// 是否根据实测解码成本自适应调整批大小
+    adaptive_batching: bool,
+    /// 工作线程共享的解码耗时计量
+    cost_meter: Arc<DecodeCostMeter>,
+    /// 已提交到线程池的包数（序列号已分派）
+    dispatched_packets: usize,
+    /// 已从有序通道接收的结果所覆盖的包数（含解码失败的包）
+    received_packets: usize,
+    /// 已分派、尚未接收的包组大小（按序列号顺序）
+    in_flight_groups: VecDeque<usize>,
+    /// 工作线程共享的失败包计数（解码失败或解码器创建失败）
+    failed_packets: Arc<AtomicUsize>,
+    /// 分析端归还的样本缓冲池（工作线程共享）
+    buffer_pool: SampleBufferPool,
+}
+
+/// 解码耗时计量 - 工作线程累加单包解码耗时，调度端据此推算批大小
+#[derive(Debug, Default)]
+struct DecodeCostMeter {
+    decode_nanos: AtomicU64,
+    packets: AtomicU64,
+}
+
+impl DecodeCostMeter {
+    /// 记录一个包的解码耗时（Relaxed：仅用于统计，不参与同步）
+    fn record(&self, elapsed: Duration) {
+        self.decode_nanos
+            .fetch_add(elapsed.as_nanos() as u64, Ordering::Relaxed);
+        self.packets.fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// 平均单包解码耗时（纳秒）；预热包数不足时返回 None
+    fn mean_packet_nanos(&self) -> Option<f64> {
+        let packets = self.packets.load(Ordering::Relaxed);
+        if packets < ADAPTIVE_BATCH_WARMUP_PACKETS {
+            return None;
+        }
+        Some(self.decode_nanos.load(Ordering::Relaxed) as f64 / packets as f64)
+    }
 }
 
 /// 并行解码统计信息
@@ -306,8 +415,7 @@ struct ParallelDecodingStats {
     packets_added: usize,
     batches_processed: usize,
     samples_decoded: usize,
-    failed_packets: usize,
-    consumed_batches: usize, // 已通过next_samples()消费的批次数
+    consumed_batches: usize, // 已通过next_samples()消费的包组数
 }
 
 impl ParallelDecodingStats {
@@ -315,11 +423,6 @@ impl ParallelDecodingStats {
     fn add_decoded_samples(&mut self, count: usize) {
         self.samples_decoded += count;
     }
-
-    /// 记录失败的包数
-    fn increment_failed_packets(&mut self) {
-        self.failed_packets += 1;
-    }
 }
 
 /// 解码器工厂 - 为每个并行线程创建独立解码器
@@ -387,6 +490,13 @@ impl OrderedParallelDecoder {
             decoding_state: DecodingState::Decoding,
             flushed: false,
             eof_encountered: false,
+            adaptive_batching: false,
+            cost_meter: Arc::new(DecodeCostMeter::default()),
+            dispatched_packets: 0,
+            received_packets: 0,
+            in_flight_groups: VecDeque::new(),
+            failed_packets: Arc::new(AtomicUsize::new(0)),
+            buffer_pool: SampleBufferPool::with_capacity(SAMPLE_BUFFER_POOL_CAPACITY),
         }
     }
 
@@ -419,15 +529,73 @@ impl OrderedParallelDecoder {
         self
     }
 
-    /// 添加包到当前批次，批次满时触发并行解码
-    pub fn add_packet(&mut self, packet: Packet) -> AudioResult<()> {
-        let sequenced_packet = SequencedPacket {
-            sequence: self.sequence_counter,
-            packet,
+    /// 启用/禁用自适应批大小
+    ///
+    /// 启用后 `with_config` 的批大小仅作为初始值，之后由 [`Self::retune_batch_size`]
+    /// 按实测单包解码耗时和平均包帧数在 `[MIN, MAX]_PARALLEL_BATCH_SIZE` 内调整。
+    pub fn with_adaptive_batching(mut self, enabled: bool) -> Self {
+        self.adaptive_batching = enabled;
+        self
+    }
+
+    /// 当前批大小（包数）
+    pub fn batch_size(&self) -> usize {
+        self.batch_size
+    }
+
+    /// 根据实测解码成本重新计算批大小
+    ///
+    /// 仅在批次边界（当前批次为空）调整，保证已入批的包按原批大小调度。
+    /// `chunk_stats` 提供平均包帧数，用于限制单批输出总量（重排缓冲内存上限）。
+    pub fn retune_batch_size(&mut self, chunk_stats: &ChunkSizeStats) {
+        if !self.adaptive_batching || !self.current_batch.is_empty() {
+            return;
+        }
+        if let Some(mean_packet_nanos) = self.cost_meter.mean_packet_nanos() {
+            self.batch_size = Self::adaptive_batch_size(
+                self.batch_size,
+                self.thread_pool_size,
+                mean_packet_nanos,
+                chunk_stats.running_mean_size(),
+            );
+        }
+    }
+
+    /// 自适应批大小计算（纯函数，便于测试）
+    ///
+    /// - 成本目标：批次总耗时 ≈ 线程数 × 每线程目标耗时
+    /// - 内存上限：批次总帧数 ≤ `ADAPTIVE_BATCH_MAX_FRAMES`
+    /// - 平滑：单次最多放大/缩小 2 倍，避免耗时抖动导致批大小振荡
+    fn adaptive_batch_size(
+        current: usize,
+        threads: usize,
+        mean_packet_nanos: f64,
+        mean_packet_frames: f64,
+    ) -> usize {
+        let target_batch_nanos =
+            threads as f64 * ADAPTIVE_BATCH_TARGET_WORKER_MICROS as f64 * 1_000.0;
+        let by_cost = if mean_packet_nanos > 0.0 {
+            target_batch_nanos / mean_packet_nanos
+        } else {
+            f64::INFINITY
+        };
+        let by_memory = if mean_packet_frames > 0.0 {
+            ADAPTIVE_BATCH_MAX_FRAMES as f64 / mean_packet_frames
+        } else {
+            f64::INFINITY
         };
 
-        self.current_batch.push(sequenced_packet);
-        self.sequence_counter += 1;
+        let target = by_cost.min(by_memory).min(usize::MAX as f64) as usize;
+        let smoothed = target.clamp(current.div_ceil(2), current.saturating_mul(2));
+        smoothed.clamp(
+            parallel_limits::MIN_PARALLEL_BATCH_SIZE,
+            parallel_limits::MAX_PARALLEL_BATCH_SIZE,
+        )
+    }
+
+    /// 添加包到当前批次，批次满时触发并行解码
+    pub fn add_packet(&mut self, packet: Packet) -> AudioResult<()> {
+        self.current_batch.push(packet);
         self.stats.packets_added += 1;
 
         // 批次满了，启动并行解码
@@ -475,13 +643,7 @@ impl OrderedParallelDecoder {
 
         match self.samples_channel.try_recv_ordered() {
             Ok(DecodedChunk::Samples(samples)) => {
-                // 更新统计信息
-                if samples.is_empty() {
-                    self.stats.increment_failed_packets();
-                } else {
-                    self.stats.add_decoded_samples(samples.len());
-                    self.stats.consumed_batches += 1;
-                }
+                self.record_received(&samples);
                 Some(samples)
             }
             Ok(DecodedChunk::EOF) => {
@@ -500,6 +662,59 @@ impl OrderedParallelDecoder {
         }
     }
 
+    /// 阻塞等待下一个有序结果（事件驱动，无轮询）
+    ///
+    /// 在下一个期望序列号的结果就绪或EOF到达时返回：
+    /// - `Some(samples)`：下一个包的解码结果（解码失败的包为空Vec）
+    /// - `None`：遇到EOF或通道断开
+    ///
+    /// **调用约束**：仅在 `in_flight_packets() > 0` 或已 flush 时调用，
+    /// 否则没有任何结果会到达，调用将永久阻塞。
+    pub fn recv_next_samples(&mut self) -> Option<Vec<f32>> {
+        if self.eof_encountered {
+            return None;
+        }
+
+        match self.samples_channel.recv_ordered() {
+            Ok(DecodedChunk::Samples(samples)) => {
+                self.record_received(&samples);
+                Some(samples)
+            }
+            Ok(DecodedChunk::EOF) => {
+                self.eof_encountered = true;
+                None
+            }
+            Err(RecvError) => {
+                #[cfg(debug_assertions)]
+                eprintln!("[WARNING] Sample channel disconnected unexpectedly");
+
+                None
+            }
+        }
+    }
+
+    /// 归还已消费完的样本缓冲区，供工作线程复用
+    pub fn recycle_buffer(&self, buffer: Vec<f32>) {
+        self.buffer_pool.give_back(buffer);
+    }
+
+    /// 已提交但尚未被消费的包数（在途包数）
+    ///
+    /// 消费端据此决定"继续读包提交"还是"阻塞等待下一个结果"
+    pub fn in_flight_packets(&self) -> usize {
+        self.dispatched_packets - self.received_packets
+    }
+
+    /// 记录一个已接收的包组结果
+    fn record_received(&mut self, samples: &[f32]) {
+        // 有序接收：结果与分派顺序一一对应
+        self.received_packets += self.in_flight_groups.pop_front().unwrap_or(1);
+        if !samples.is_empty() {
+            self.stats.add_decoded_samples(samples.len());
+            self.stats.consumed_batches += 1;
+        }
+    }
+
     /// 获取当前解码状态
     pub fn get_state(&self) -> DecodingState {
         self.decoding_state
@@ -512,13 +727,14 @@ impl OrderedParallelDecoder {
 
     /// 获取跳过的损坏包数量（容错处理统计）
     pub fn get_skipped_packets(&self) -> usize {
-        self.stats.failed_packets
+        self.failed_packets.load(Ordering::Relaxed)
     }
 
-    /// 确定性drain所有剩余样本 - 短超时阻塞等待，100%可靠
+    /// 确定性drain所有剩余样本 - 阻塞接收直到EOF，100%可靠
     ///
-    /// 通过eof_encountered标志实现确定性结束，彻底解决MP3并行解码样本丢失问题。
-    /// 使用短超时(5ms)的recv_timeout避免CPU空轮询，直到eof_encountered=true且channel为空。
+    /// EOF标记的序列号位于所有包之后，有序通道保证它最后到达，
+    /// 因此阻塞接收到EOF即表示全部样本已收齐，无需超时轮询。
+    /// 若EOF已在 `next_samples()` 中被消费，则其之前的数据也已全部消费，直接返回。
     ///
     /// # 返回值
     ///
@@ -526,33 +742,21 @@ impl OrderedParallelDecoder {
     pub fn drain_all_samples(&mut self) -> Vec<Vec<f32>> {
         let mut all_samples = Vec::new();
 
-        loop {
-            match self
-                .samples_channel
-                .recv_timeout_ordered(Duration::from_millis(DRAIN_RECV_TIMEOUT_MS))
-            {
-                Ok(DecodedChunk::Samples(samples)) => {
+        while !self.eof_encountered {
+            match self.recv_next_samples() {
+                Some(samples) => {
                     if !samples.is_empty() {
                         all_samples.push(samples);
                     }
                 }
-                Ok(DecodedChunk::EOF) => {
-                    // 收到EOF（如果next_samples()没消费的话）
-                    self.eof_encountered = true;
-                    break;
-                }
-                Err(RecvTimeoutError::Timeout) => {
-                    // Channel空了，检查EOF是否已被遇到
-                    if self.eof_encountered {
-                        // EOF已在next_samples()中被遇到，所有数据已接收完毕
-                        break;
-                    }
-                    // 超时但EOF未到，继续等待（后台线程仍在解码）
-                }
-                Err(RecvTimeoutError::Disconnected) => {
-                    // Channel已断开（异常情况）
+                None => {
+                    // EOF（recv_next_samples已设置标志）或通道断开（异常情况）
                     #[cfg(debug_assertions)]
-                    eprintln!("[WARNING] Sample channel disconnected during drain (异常提前断开)");
+                    if !self.eof_encountered {
+                        eprintln!(
+                            "[WARNING] Sample channel disconnected during drain (异常提前断开)"
+                        );
+                    }
 
                     break;
                 }
@@ -564,15 +768,42 @@ impl OrderedParallelDecoder {
     }
 
     /// 处理当前批次 - 核心并行解码逻辑
+    ///
+    /// ## 包合并
+    ///
+    /// 批次按线程数切分为连续的包组（每个工作线程一组），组内顺序解码并拼接输出：
+    /// - 通道发送与重排序插入从"每包一次"降为"每组一次"（默认批次下约 1/16，
+    ///   自适应放大批次后可达 1/64）
+    /// - 组内包连续，有状态编解码器（如 MP3 比特池）的解码上下文更完整
     fn process_current_batch(&mut self) -> AudioResult<()> {
         if self.current_batch.is_empty() {
             return Ok(());
         }
 
         let batch = std::mem::take(&mut self.current_batch);
+        let group_len = batch.len().div_ceil(self.thread_pool_size.max(1));
+        let mut groups = Vec::with_capacity(batch.len().div_ceil(group_len));
+        let mut packets = batch.into_iter();
+        loop {
+            let group_packets: Vec<Packet> = packets.by_ref().take(group_len).collect();
+            if group_packets.is_empty() {
+                break;
+            }
+            self.dispatched_packets += group_packets.len();
+            self.in_flight_groups.push_back(group_packets.len());
+            groups.push(PacketGroup {
+                sequence: self.sequence_counter,
+                packets: group_packets,
+            });
+            self.sequence_counter += 1;
+        }
+
         let sender = self.samples_channel.sender();
         let decoder_factory = self.decoder_factory.clone();
         let thread_pool = self.thread_pool.clone(); // Clone线程池（Arc包装，廉价操作）
+        let cost_meter = Arc::clone(&self.cost_meter);
+        let failed_packets = Arc::clone(&self.failed_packets);
+        let buffer_pool = self.buffer_pool.clone();
         self.stats.batches_processed += 1;
 
         // 直接在rayon线程池中调度批次处理（避免OS线程创建开销和嵌套）
@@ -587,72 +818,61 @@ impl OrderedParallelDecoder {
 
             // 直接调用 into_par_iter，无需 install 嵌套
             // 在 rayon 池线程上下文中，par_iter 自动使用当前池
-            batch.into_par_iter().for_each_init(
+            groups.into_par_iter().for_each_init(
                 || {
                     // 初始化阶段：每个rayon工作线程只执行一次
                     let decoder = decoder_factory.create_decoder().ok()?;
                     let sample_converter = decoder_factory.get_sample_converter();
                     let thread_sender = sender.clone();
 
-                    // 线程本地样本缓冲区复用
+                    // 线程本地单包解码缓冲区复用
                     //
                     // 预分配容量，避免解码过程中的频繁内存分配：
                     // - 初始容量：THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY (8192样本 = 32KB)
                     // - 复用策略：clear() 保留容量，跨包复用内存
-                    // - 预期收益：内存峰值-20%，分配开销-10-15%
-                    //
-                    // 当前限制：每次发送仍需创建新Vec获取所有权
-                    // - 原因：channel.send() 要求转移Vec所有权
-                    // - 开销：仅分配Vec控制结构（~24字节），堆内存通过resize复用
-                    // - 进一步优化：需引入对象池或修改channel实现（超出当前优化范围）
-                    let samples_buffer = Vec::with_capacity(THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY);
-                    Some((decoder, sample_converter, thread_sender, samples_buffer))
+                    let packet_buffer = Vec::with_capacity(THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY);
+                    Some((decoder, sample_converter, thread_sender, packet_buffer))
                 },
-                |state, sequenced_packet| {
-                    // 处理阶段：复用decoder和buffer解码多个包
-                    if let Some((decoder, sample_converter, thread_sender, samples_buffer)) = state
-                    {
-                        match Self::decode_single_packet_with_simd_into(
+                |state, group| {
+                    let PacketGroup { sequence, packets } = group;
+
+                    let Some((decoder, sample_converter, thread_sender, packet_buffer)) = state
+                    else {
+                        // 解码器创建失败：整组记为失败并发送空样本，避免序列号缺口导致消费端永久阻塞
+                        failed_packets.fetch_add(packets.len(), Ordering::Relaxed);
+                        let _ = sender.send_sequenced(sequence, DecodedChunk::Samples(vec![]));
+                        return;
+                    };
+
+                    // 组输出缓冲区取自缓冲池（分析端归还，稳态零分配），池空时新分配
+                    let mut group_samples = buffer_pool.take(THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY);
+
+                    // 处理阶段：复用decoder和buffer顺序解码组内各包
+                    for packet in packets {
+                        let decode_started = Instant::now();
+                        let decode_result = Self::decode_single_packet_with_simd_into(
                             &mut **decoder, // Box<dyn Decoder> 需要两次解引用
-                            sequenced_packet.packet,
+                            packet,
                             sample_converter,
-                            samples_buffer, // 复用缓冲区
-                        ) {
-                            Ok(()) => {
-                                // 获取所有权用于发送，同时为下次处理准备新缓冲区
-                                //
-                                // 使用 mem::replace 避免 clone 开销：
-                                // - 取走 samples_buffer 的所有权（包含数据和容量）
-                                // - 放入新的空Vec，容量保持为当前容量或初始容量的较大值
-                                // - 容量采样：保持"常见容量"，避免反复从初始容量起步
-                                //
-                                // 容量策略：
-                                // - 使用 prev_cap.max(THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY)
-                                // - 如果上一包容量大于初始容量，新Vec继承该容量
-                                // - 这样能更贴合当前流的典型包大小，减少容量抖动
-                                let prev_cap = samples_buffer.capacity();
-                                let samples_to_send = std::mem::replace(
-                                    samples_buffer,
-                                    Vec::with_capacity(
-                                        prev_cap.max(THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY),
-                                    ),
-                                );
-                                // 直接发送到OrderedSender，无中间通道hop
-                                let _ = thread_sender.send_sequenced(
-                                    sequenced_packet.sequence,
-                                    DecodedChunk::Samples(samples_to_send),
-                                );
+                            packet_buffer, // 复用缓冲区
+                        );
+                        cost_meter.record(decode_started.elapsed());
+
+                        match decode_result {
+                            Ok(()) if !packet_buffer.is_empty() => {
+                                group_samples.extend_from_slice(packet_buffer);
                             }
-                            Err(_) => {
-                                // 解码失败，发送空样本保持序列连续性
-                                samples_buffer.clear(); // 确保缓冲区清空，保留容量
-                                let _ = thread_sender.send_sequenced(
-                                    sequenced_packet.sequence,
-                                    DecodedChunk::Samples(vec![]),
-                                );
+                            _ => {
+                                // 解码失败（或容错跳过）：计入失败包，组内后续包继续解码
+                                packet_buffer.clear(); // 确保缓冲区清空，保留容量
+                                failed_packets.fetch_add(1, Ordering::Relaxed);
                             }
                         }
                     }
+
+                    // 每组一次发送：直接发送到OrderedSender，无中间通道hop
+                    let _ = thread_sender
+                        .send_sequenced(sequence, DecodedChunk::Samples(group_samples));
                 },
             );
             // spawn_fifo 是异步的，批次处理在后台进行
@@ -959,6 +1179,52 @@ mod tests {
         assert_eq!(samples.len(), 0); // 没有真实数据
     }
 
+    #[test]
+    fn test_recv_next_samples_waits_for_next_sequence() {
+        use crate::processing::SampleConverter;
+
+        let mut codec_params = symphonia::core::codecs::CodecParameters::new();
+        codec_params.for_codec(symphonia::core::codecs::CODEC_TYPE_NULL);
+
+        let mut decoder = OrderedParallelDecoder::new(codec_params, SampleConverter::new());
+        // 模拟已提交3个包组（2包、1包、3包）
+        decoder.dispatched_packets = 6;
+        decoder.in_flight_groups.extend([2, 1, 3]);
+        assert_eq!(decoder.in_flight_packets(), 6);
+
+        // 后台线程延迟、乱序完成（包组1全部解码失败）
+        let sender = decoder.samples_channel.sender();
+        let worker = std::thread::spawn(move || {
+            std::thread::sleep(std::time::Duration::from_millis(20));
+            sender
+                .send_sequenced(2, DecodedChunk::Samples(vec![3.0]))
+                .unwrap();
+            sender
+                .send_sequenced(1, DecodedChunk::Samples(vec![]))
+                .unwrap();
+            sender
+                .send_sequenced(0, DecodedChunk::Samples(vec![1.0, 2.0]))
+                .unwrap();
+            sender.send_sequenced(3, DecodedChunk::EOF).unwrap();
+        });
+
+        // 阻塞接收按序返回，不因等待时间过长而提前结束
+        assert_eq!(decoder.recv_next_samples(), Some(vec![1.0, 2.0]));
+        assert_eq!(decoder.in_flight_packets(), 4);
+        assert_eq!(decoder.recv_next_samples(), Some(vec![]));
+        assert_eq!(decoder.in_flight_packets(), 3);
+        assert_eq!(decoder.recv_next_samples(), Some(vec![3.0]));
+        assert_eq!(decoder.in_flight_packets(), 0);
+
+        assert_eq!(decoder.recv_next_samples(), None);
+        assert!(decoder.eof_encountered);
+        // EOF之后不再阻塞
+        assert_eq!(decoder.recv_next_samples(), None);
+        assert!(decoder.drain_all_samples().is_empty());
+
+        worker.join().unwrap();
+    }
+
     // ==================== Phase 3: 配置和统计测试 ====================
 
     #[test]
@@ -1005,7 +1271,7 @@ mod tests {
         assert_eq!(decoder.stats.packets_added, 0);
         assert_eq!(decoder.stats.batches_processed, 0);
         assert_eq!(decoder.stats.samples_decoded, 0);
-        assert_eq!(decoder.stats.failed_packets, 0);
+        assert_eq!(decoder.get_skipped_packets(), 0);
     }
 
     #[test]
@@ -1049,4 +1315,113 @@ mod tests {
         // 初始跳过包数应该是0
         assert_eq!(decoder.get_skipped_packets(), 0);
     }
+
+    #[test]
+    fn test_adaptive_batch_size_tracks_decode_cost() {
+        // 4线程 × 2ms 目标 = 8ms/批
+        // 轻包（20µs）→ 400包，受2倍平滑限制 64 → 128
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(64, 4, 20_000.0, 1152.0),
+            128
+        );
+        // 继续放大时受内存上限约束：2^18 / 1152 ≈ 227 包
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(128, 4, 20_000.0, 1152.0),
+            227
+        );
+        // 重包（500µs）→ 16包，受平滑限制 64 → 32，再 → 16
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(64, 4, 500_000.0, 4096.0),
+            32
+        );
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(32, 4, 500_000.0, 4096.0),
+            16
+        );
+    }
+
+    #[test]
+    fn test_adaptive_batch_size_memory_cap_and_limits() {
+        // 耗时极低但每包帧数很大：内存上限 2^18 / 16384 = 16 包
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(16, 8, 1_000.0, 16_384.0),
+            16
+        );
+        // 极重包不会低于最小批大小
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(1, 1, 1e12, 4096.0),
+            parallel_limits::MIN_PARALLEL_BATCH_SIZE
+        );
+        // 无帧数统计时仅按耗时计算
+        assert_eq!(
+            OrderedParallelDecoder::adaptive_batch_size(256, 4, 1.0, 0.0),
+            parallel_limits::MAX_PARALLEL_BATCH_SIZE
+        );
+    }
+
+    #[test]
+    fn test_retune_requires_warmup_and_opt_in() {
+        use crate::processing::SampleConverter;
+
+        let mut codec_params = symphonia::core::codecs::CodecParameters::new();
+        codec_params.for_codec(symphonia::core::codecs::CODEC_TYPE_NULL);
+
+        let mut stats = ChunkSizeStats::new();
+        stats.add_chunk(1152);
+
+        // 未启用自适应：记录再多耗时也不调整
+        let mut fixed = OrderedParallelDecoder::new(codec_params.clone(), SampleConverter::new())
+            .with_config(64, 4);
+        for _ in 0..ADAPTIVE_BATCH_WARMUP_PACKETS {
+            fixed.cost_meter.record(Duration::from_micros(20));
+        }
+        fixed.retune_batch_size(&stats);
+        assert_eq!(fixed.batch_size(), 64);
+
+        // 启用自适应：预热不足时保持初始值，预热完成后开始调整
+        let mut adaptive = OrderedParallelDecoder::new(codec_params, SampleConverter::new())
+            .with_config(64, 4)
+            .with_adaptive_batching(true);
+        adaptive.cost_meter.record(Duration::from_micros(20));
+        adaptive.retune_batch_size(&stats);
+        assert_eq!(adaptive.batch_size(), 64);
+
+        for _ in 1..ADAPTIVE_BATCH_WARMUP_PACKETS {
+            adaptive.cost_meter.record(Duration::from_micros(20));
+        }
+        adaptive.retune_batch_size(&stats);
+        assert_eq!(adaptive.batch_size(), 128);
+    }
+
+    #[test]
+    fn test_sample_buffer_pool_reuses_capacity() {
+        let pool = SampleBufferPool::with_capacity(2);
+
+        // 空池：新分配
+        let buffer = pool.take(16);
+        assert!(buffer.capacity() >= 16);
+        assert_eq!(pool.available(), 0);
+        assert_eq!(pool.misses(), 1);
+
+        // 归还后再取：复用同一块堆内存且已清空
+        let mut used = buffer;
+        used.extend_from_slice(&[1.0; 100]);
+        let ptr = used.as_ptr();
+        pool.give_back(used);
+        assert_eq!(pool.available(), 1);
+
+        let reused = pool.take(16);
+        assert_eq!(reused.as_ptr(), ptr);
+        assert_eq!(pool.misses(), 1);
+        assert!(reused.is_empty());
+        assert!(reused.capacity() >= 100);
+
+        // 池满时多余缓冲区直接释放；零容量缓冲区不入池
+        pool.give_back(vec![0.0; 4]);
+        pool.give_back(vec![0.0; 4]);
+        pool.give_back(vec![0.0; 4]);
+        assert_eq!(pool.available(), 2);
+        pool.give_back(Vec::new());
+        assert_eq!(pool.available(), 2);
+    }
 }
@@ -0,0 +1,676 @@
+//! 管道/标准输入流式解码器（`-` 输入）
+//!
+//! 转码流水线可以直接把 PCM 写进管道测量 DR，无需落地临时文件。
+//! 输入只能顺序读取：WAV（RIFF/RF64）与 W64 的头部在读取过程中解析，
+//! 未知块直接读过丢弃；无头的原始 PCM 由调用方给出样本格式、采样率与声道数。
+//!
+//! 样本缩放与 Symphonia 解码路径一致（整数按 2^(N-1) 归一化），
+//! 同一段 PCM 经管道或文件分析得到逐位一致的结果。
+
+use super::channel_layout;
+use super::format::AudioFormat;
+use super::stats::ChunkSizeStats;
+use super::streaming::StreamingDecoder;
+use crate::error::{AudioError, AudioResult};
+use std::io::{self, Read};
+
+/// 原始 PCM 样本格式（小端交错）
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum RawSampleFormat {
+    /// 8位无符号整数
+    U8,
+    /// 16位有符号整数
+    S16Le,
+    /// 24位有符号整数（3字节紧凑存储）
+    S24Le,
+    /// 32位有符号整数
+    S32Le,
+    /// 32位浮点
+    F32Le,
+    /// 64位浮点
+    F64Le,
+}
+
+impl RawSampleFormat {
+    /// 命令行可用的格式名（与 FFmpeg `-f` 命名一致）
+    pub const NAMES: [&'static str; 6] = ["u8", "s16le", "s24le", "s32le", "f32le", "f64le"];
+
+    /// 按格式名解析
+    pub fn from_name(name: &str) -> Option<Self> {
+        match name.to_ascii_lowercase().as_str() {
+            "u8" => Some(Self::U8),
+            "s16le" => Some(Self::S16Le),
+            "s24le" => Some(Self::S24Le),
+            "s32le" => Some(Self::S32Le),
+            "f32le" => Some(Self::F32Le),
+            "f64le" => Some(Self::F64Le),
+            _ => None,
+        }
+    }
+
+    /// 按 WAV 格式标签与位深选择样本格式（1 = PCM 整数，3 = IEEE 浮点）
+    fn from_wave_tag(format_tag: u16, bits_per_sample: u16) -> Option<Self> {
+        match (format_tag, bits_per_sample) {
+            (WAVE_FORMAT_PCM, 8) => Some(Self::U8),
+            (WAVE_FORMAT_PCM, 16) => Some(Self::S16Le),
+            (WAVE_FORMAT_PCM, 24) => Some(Self::S24Le),
+            (WAVE_FORMAT_PCM, 32) => Some(Self::S32Le),
+            (WAVE_FORMAT_IEEE_FLOAT, 32) => Some(Self::F32Le),
+            (WAVE_FORMAT_IEEE_FLOAT, 64) => Some(Self::F64Le),
+            _ => None,
+        }
+    }
+
+    /// 每个样本的字节数
+    pub fn bytes_per_sample(self) -> usize {
+        match self {
+            Self::U8 => 1,
+            Self::S16Le => 2,
+            Self::S24Le => 3,
+            Self::S32Le | Self::F32Le => 4,
+            Self::F64Le => 8,
+        }
+    }
+
+    /// 位深度（报告显示用）
+    pub fn bits_per_sample(self) -> u16 {
+        self.bytes_per_sample() as u16 * 8
+    }
+
+    fn codec_type(self) -> symphonia::core::codecs::CodecType {
+        use symphonia::core::codecs::*;
+        match self {
+            Self::U8 => CODEC_TYPE_PCM_U8,
+            Self::S16Le => CODEC_TYPE_PCM_S16LE,
+            Self::S24Le => CODEC_TYPE_PCM_S24LE,
+            Self::S32Le => CODEC_TYPE_PCM_S32LE,
+            Self::F32Le => CODEC_TYPE_PCM_F32LE,
+            Self::F64Le => CODEC_TYPE_PCM_F64LE,
+        }
+    }
+
+    /// 把紧凑字节流转换为 f32 样本（`bytes` 长度须为样本字节数的整数倍）
+    fn convert(self, bytes: &[u8], samples: &mut Vec<f32>) {
+        let width = self.bytes_per_sample();
+        samples.clear();
+        samples.reserve(bytes.len() / width);
+        let chunks = bytes.chunks_exact(width);
+        match self {
+            Self::U8 => samples.extend(chunks.map(|b| (b[0] as f32 - 128.0) / 128.0)),
+            Self::S16Le => {
+                samples.extend(chunks.map(|b| i16::from_le_bytes([b[0], b[1]]) as f32 / 32768.0))
+            }
+            Self::S24Le => samples.extend(chunks.map(|b| {
+                // 放入高24位后算术右移完成符号扩展
+                (i32::from_le_bytes([0, b[0], b[1], b[2]]) >> 8) as f32 / 8388608.0
+            })),
+            Self::S32Le => samples.extend(chunks.map(|b| {
+                (i32::from_le_bytes([b[0], b[1], b[2], b[3]]) as f64 / 2147483648.0) as f32
+            })),
+            Self::F32Le => {
+                samples.extend(chunks.map(|b| f32::from_le_bytes([b[0], b[1], b[2], b[3]])))
+            }
+            Self::F64Le => samples.extend(chunks.map(|b| {
+                f64::from_le_bytes([b[0], b[1], b[2], b[3], b[4], b[5], b[6], b[7]]) as f32
+            })),
+        }
+    }
+}
+
+/// 无头原始 PCM 的流参数（`--format/--rate/--channels`）
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct RawPcmSpec {
+    pub sample_format: RawSampleFormat,
+    pub sample_rate: u32,
+    pub channels: u16,
+}
+
+const WAVE_FORMAT_PCM: u16 = 0x0001;
+const WAVE_FORMAT_IEEE_FLOAT: u16 = 0x0003;
+const WAVE_FORMAT_EXTENSIBLE: u16 = 0xFFFE;
+/// WAVE_FORMAT_EXTENSIBLE 声道掩码中的 SPEAKER_LOW_FREQUENCY 位
+const SPEAKER_LOW_FREQUENCY: u32 = 0x8;
+
+/// W64 块 GUID：前4字节为 FourCC，其余为固定后缀（"riff" 块除外）
+const W64_GUID_SUFFIX: [u8; 12] = [
+    0xF3, 0xAC, 0xD3, 0x11, 0x8C, 0xD1, 0x00, 0xC0, 0x4F, 0x8E, 0xDB, 0x8A,
+];
+const W64_RIFF_GUID: [u8; 16] = [
+    0x72, 0x69, 0x66, 0x66, 0x2E, 0x91, 0xCF, 0x11, 0xA5, 0xD6, 0x28, 0xDB, 0x04, 0xC1, 0x00, 0x00,
+];
+
+/// 解析出的 `fmt ` 块
+struct WaveFormat {
+    sample_format: RawSampleFormat,
+    sample_rate: u32,
+    channels: u16,
+    channel_mask: Option<u32>,
+}
+
+/// 管道流式解码器：顺序读取、不可定位
+pub struct PipeStreamingDecoder<R: Read> {
+    reader: R,
+    sample_format: RawSampleFormat,
+    format: AudioFormat,
+    /// 数据块剩余字节数（None 表示长度未知，读到 EOF 为止）
+    data_remaining: Option<u64>,
+    /// 单次读取的字节缓冲（整帧对齐）
+    byte_buffer: Vec<u8>,
+    decoded_frames: u64,
+    /// 流末尾不足一帧而丢弃的字节数
+    truncated_bytes: usize,
+    chunk_stats: ChunkSizeStats,
+    finished: bool,
+}
+
+impl<R: Read> PipeStreamingDecoder<R> {
+    /// 读取容器头（WAV/RF64/W64）并定位到数据块起点
+    pub fn from_container(mut reader: R) -> AudioResult<Self> {
+        let mut magic = [0u8; 4];
+        reader.read_exact(&mut magic)?;
+        let (wave_format, data_size) = match &magic {
+            b"RIFF" | b"RF64" => read_riff_header(&mut reader, &magic == b"RF64")?,
+            b"riff" => read_w64_header(&mut reader)?,
+            _ => {
+                return Err(AudioError::FormatError(
+                    "Piped input is not WAV/W64; use --format/--rate/--channels for raw PCM / 管道输入不是WAV/W64；原始PCM请指定 --format/--rate/--channels"
+                        .to_string(),
+                ));
+            }
+        };
+
+        let spec = RawPcmSpec {
+            sample_format: wave_format.sample_format,
+            sample_rate: wave_format.sample_rate,
+            channels: wave_format.channels,
+        };
+        let mut decoder = Self::new(reader, spec, data_size)?;
+        if let Some(mask) = wave_format.channel_mask {
+            decoder
+                .format
+                .set_surround_indices(channel_layout::surround_indices_from_mask(mask as u64));
+            if mask & SPEAKER_LOW_FREQUENCY != 0 {
+                let lfe_index = (mask & (SPEAKER_LOW_FREQUENCY - 1)).count_ones() as usize;
+                decoder.format.set_lfe_indices(vec![lfe_index]);
+            } else {
+                decoder.format.mark_has_channel_layout();
+            }
+        }
+        Ok(decoder)
+    }
+
+    /// 无头原始 PCM：按给定参数读到 EOF
+    pub fn from_raw(reader: R, spec: RawPcmSpec) -> AudioResult<Self> {
+        Self::new(reader, spec, None)
+    }
+
+    fn new(reader: R, spec: RawPcmSpec, data_size: Option<u64>) -> AudioResult<Self> {
+        use crate::tools::constants::decoder_performance::PIPE_READ_CHUNK_FRAMES;
+
+        let frame_bytes = spec.sample_format.bytes_per_sample() * spec.channels as usize;
+        let expected_frames = match data_size {
+            Some(size) if frame_bytes > 0 => size / frame_bytes as u64,
+            _ => 0,
+        };
+        let format = AudioFormat::with_codec(
+            spec.sample_rate,
+            spec.channels,
+            spec.sample_format.bits_per_sample(),
+            expected_frames,
+            spec.sample_format.codec_type(),
+        );
+        format.validate()?;
+
+        Ok(Self {
+            reader,
+            sample_format: spec.sample_format,
+            format,
+            data_remaining: data_size,
+            byte_buffer: vec![0; PIPE_READ_CHUNK_FRAMES * frame_bytes],
+            decoded_frames: 0,
+            truncated_bytes: 0,
+            chunk_stats: ChunkSizeStats::new(),
+            finished: false,
+        })
+    }
+
+    fn frame_bytes(&self) -> usize {
+        self.sample_format.bytes_per_sample() * self.format.channels as usize
+    }
+}
+
+impl<R: Read> StreamingDecoder for PipeStreamingDecoder<R> {
+    fn next_chunk(&mut self) -> AudioResult<Option<Vec<f32>>> {
+        if self.finished {
+            return Ok(None);
+        }
+
+        let want = match self.data_remaining {
+            Some(remaining) => (self.byte_buffer.len() as u64).min(remaining) as usize,
+            None => self.byte_buffer.len(),
+        };
+        let filled = read_fully(&mut self.reader, &mut self.byte_buffer[..want])?;
+        if let Some(remaining) = self.data_remaining.as_mut() {
+            *remaining -= filled as u64;
+        }
+        if filled < want || self.data_remaining == Some(0) {
+            self.finished = true;
+        }
+
+        let frame_bytes = self.frame_bytes();
+        let whole = filled - filled % frame_bytes;
+        self.truncated_bytes += filled - whole;
+        if whole == 0 {
+            return Ok(None);
+        }
+
+        let mut samples = Vec::new();
+        self.sample_format
+            .convert(&self.byte_buffer[..whole], &mut samples);
+        let frames = whole / frame_bytes;
+        self.decoded_frames += frames as u64;
+        self.chunk_stats.add_chunk(frames);
+        Ok(Some(samples))
+    }
+
+    fn progress(&self) -> f32 {
+        let expected = self.format.sample_count;
+        if expected == 0 {
+            0.0
+        } else {
+            (self.decoded_frames as f32 / expected as f32).min(1.0)
+        }
+    }
+
+    fn format(&self) -> AudioFormat {
+        let mut format = self.format.clone();
+        // 开始读取前保留头部声明的样本数，之后以实际读取为准
+        if self.decoded_frames > 0 || self.finished {
+            format.update_sample_count(self.decoded_frames);
+        }
+        // 流在声明的数据长度之前结束，或末尾残留不完整帧：视为部分分析
+        let short_read = self.finished && self.data_remaining.is_some_and(|r| r > 0);
+        if short_read || self.truncated_bytes > 0 {
+            format.mark_as_partial(0);
+        }
+        format
+    }
+
+    fn reset(&mut self) -> AudioResult<()> {
+        Err(AudioError::InvalidInput(
+            "Piped input cannot be rewound / 管道输入不支持重置".to_string(),
+        ))
+    }
+
+    fn get_chunk_stats(&mut self) -> Option<ChunkSizeStats> {
+        self.chunk_stats.finalize();
+        Some(self.chunk_stats.clone())
+    }
+}
+
+/// 尽量填满缓冲区；返回实际读取字节数（小于缓冲区长度即到达 EOF）
+fn read_fully<R: Read>(reader: &mut R, buffer: &mut [u8]) -> io::Result<usize> {
+    let mut filled = 0;
+    while filled < buffer.len() {
+        match reader.read(&mut buffer[filled..]) {
+            Ok(0) => break,
+            Ok(n) => filled += n,
+            Err(e) if e.kind() == io::ErrorKind::Interrupted => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(filled)
+}
+
+/// 顺序跳过 `len` 字节（管道不可定位）
+fn skip_bytes<R: Read>(reader: &mut R, len: u64) -> AudioResult<()> {
+    let skipped = io::copy(&mut reader.by_ref().take(len), &mut io::sink())?;
+    if skipped < len {
+        return Err(AudioError::FormatError(
+            "Piped WAV header is truncated / 管道WAV头部不完整".to_string(),
+        ));
+    }
+    Ok(())
+}
+
+fn read_u32_le<R: Read>(reader: &mut R) -> AudioResult<u32> {
+    let mut bytes = [0u8; 4];
+    reader.read_exact(&mut bytes)?;
+    Ok(u32::from_le_bytes(bytes))
+}
+
+fn read_u64_le<R: Read>(reader: &mut R) -> AudioResult<u64> {
+    let mut bytes = [0u8; 8];
+    reader.read_exact(&mut bytes)?;
+    Ok(u64::from_le_bytes(bytes))
+}
+
+/// 解析 RIFF/RF64 头，返回格式与数据块长度（流式写出的占位长度视为未知）
+fn read_riff_header<R: Read>(
+    reader: &mut R,
+    is_rf64: bool,
+) -> AudioResult<(WaveFormat, Option<u64>)> {
+    let _riff_size = read_u32_le(reader)?;
+    let mut wave = [0u8; 4];
+    reader.read_exact(&mut wave)?;
+    if &wave != b"WAVE" {
+        return Err(AudioError::FormatError(
+            "Piped RIFF stream is not WAVE / 管道RIFF流不是WAVE".to_string(),
+        ));
+    }
+
+    let mut wave_format = None;
+    let mut rf64_data_size = None;
+    loop {
+        let mut id = [0u8; 4];
+        reader.read_exact(&mut id)?;
+        let size = read_u32_le(reader)?;
+
+        match &id {
+            b"fmt " => {
+                let body = read_chunk_body(reader, size as u64)?;
+                wave_format = Some(parse_fmt_chunk(&body)?);
+            }
+            b"ds64" if is_rf64 => {
+                let body = read_chunk_body(reader, size as u64)?;
+                if body.len() >= 16 {
+                    rf64_data_size = Some(u64::from_le_bytes(body[8..16].try_into().unwrap()));
+                }
+            }
+            b"data" => {
+                let wave_format = wave_format.ok_or_else(missing_fmt_error)?;
+                let data_size = match size {
+                    // RF64 由 ds64 给出真实长度；0/0xFFFFFFFF 为流式写出时的占位值
+                    u32::MAX if is_rf64 => rf64_data_size,
+                    0 | u32::MAX => None,
+                    size => Some(size as u64),
+                };
+                return Ok((wave_format, data_size));
+            }
+            _ => skip_bytes(reader, size as u64)?,
+        }
+        // 块按偶数字节对齐
+        if size & 1 == 1 {
+            skip_bytes(reader, 1)?;
+        }
+    }
+}
+
+/// 解析 Sony Wave64 头（块ID为GUID、长度为含头的64位值、8字节对齐）
+fn read_w64_header<R: Read>(reader: &mut R) -> AudioResult<(WaveFormat, Option<u64>)> {
+    const HEADER_LEN: u64 = 24;
+
+    let mut riff_rest = [0u8; 12];
+    reader.read_exact(&mut riff_rest)?;
+    if riff_rest != W64_RIFF_GUID[4..] {
+        return Err(AudioError::FormatError(
+            "Unrecognized W64 header / 无法识别的W64头部".to_string(),
+        ));
+    }
+    let _riff_size = read_u64_le(reader)?;
+    let mut wave = [0u8; 16];
+    reader.read_exact(&mut wave)?;
+    if &wave[..4] != b"wave" || wave[4..] != W64_GUID_SUFFIX {
+        return Err(AudioError::FormatError(
+            "Piped W64 stream is not WAVE / 管道W64流不是WAVE".to_string(),
+        ));
+    }
+
+    let mut wave_format = None;
+    loop {
+        let mut guid = [0u8; 16];
+        reader.read_exact(&mut guid)?;
+        let chunk_size = read_u64_le(reader)?;
+        let is_known = guid[4..] == W64_GUID_SUFFIX;
+
+        if &guid[..4] == b"data" && is_known {
+            let wave_format = wave_format.ok_or_else(missing_fmt_error)?;
+            // 0/u64::MAX 为流式写出时的占位值，不足块头长度的值同样不可信：读到EOF
+            let data_size = match chunk_size {
+                u64::MAX => None,
+                size => size.checked_sub(HEADER_LEN),
+            };
+            return Ok((wave_format, data_size));
+        }
+
+        let body_size = chunk_size.checked_sub(HEADER_LEN).ok_or_else(|| {
+            AudioError::FormatError("Invalid W64 chunk size / W64块长度无效".to_string())
+        })?;
+        match &guid[..4] {
+            b"fmt " if is_known => {
+                let body = read_chunk_body(reader, body_size)?;
+                wave_format = Some(parse_fmt_chunk(&body)?);
+            }
+            _ => skip_bytes(reader, body_size)?,
+        }
+        let padding = (8 - chunk_size % 8) % 8;
+        skip_bytes(reader, padding)?;
+    }
+}
+
+fn read_chunk_body<R: Read>(reader: &mut R, size: u64) -> AudioResult<Vec<u8>> {
+    // 头部块很小；限制长度防止畸形长度字段触发巨额分配
+    const MAX_HEADER_CHUNK: u64 = 64 * 1024;
+    if size > MAX_HEADER_CHUNK {
+        return Err(AudioError::FormatError(format!(
+            "Header chunk too large ({size} bytes) / 头部块过大"
+        )));
+    }
+    let mut body = vec![0u8; size as usize];
+    reader.read_exact(&mut body)?;
+    Ok(body)
+}
+
+fn parse_fmt_chunk(body: &[u8]) -> AudioResult<WaveFormat> {
+    if body.len() < 16 {
+        return Err(AudioError::FormatError(
+            "fmt chunk too short / fmt块过短".to_string(),
+        ));
+    }
+    let u16_at = |offset: usize| u16::from_le_bytes([body[offset], body[offset + 1]]);
+    let u32_at = |offset: usize| u32::from_le_bytes(body[offset..offset + 4].try_into().unwrap());
+
+    let mut format_tag = u16_at(0);
+    let channels = u16_at(2);
+    let sample_rate = u32_at(4);
+    let bits_per_sample = u16_at(14);
+    let mut channel_mask = None;
+
+    if format_tag == WAVE_FORMAT_EXTENSIBLE {
+        if body.len() < 40 {
+            return Err(AudioError::FormatError(
+                "WAVE_FORMAT_EXTENSIBLE fmt chunk too short / 扩展fmt块过短".to_string(),
+            ));
+        }
+        channel_mask = Some(u32_at(20)).filter(|&mask| mask != 0);
+        // 子格式GUID的前两个字节即实际格式标签
+        format_tag = u16_at(24);
+    }
+
+    let sample_format =
+        RawSampleFormat::from_wave_tag(format_tag, bits_per_sample).ok_or_else(|| {
+            AudioError::FormatError(format!(
+                "Unsupported piped WAV encoding (tag 0x{format_tag:04X}, {bits_per_sample} bits) / 不支持的管道WAV编码"
+            ))
+        })?;
+
+    Ok(WaveFormat {
+        sample_format,
+        sample_rate,
+        channels,
+        channel_mask,
+    })
+}
+
+fn missing_fmt_error() -> AudioError {
+    AudioError::FormatError("data chunk before fmt chunk / data块出现在fmt块之前".to_string())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn fmt_body(tag: u16, channels: u16, rate: u32, bits: u16) -> Vec<u8> {
+        let block_align = channels * bits / 8;
+        let mut body = Vec::new();
+        body.extend_from_slice(&tag.to_le_bytes());
+        body.extend_from_slice(&channels.to_le_bytes());
+        body.extend_from_slice(&rate.to_le_bytes());
+        body.extend_from_slice(&(rate * block_align as u32).to_le_bytes());
+        body.extend_from_slice(&block_align.to_le_bytes());
+        body.extend_from_slice(&bits.to_le_bytes());
+        body
+    }
+
+    fn s24_bytes(values: &[i32]) -> Vec<u8> {
+        values
+            .iter()
+            .flat_map(|v| v.to_le_bytes()[..3].to_vec())
+            .collect()
+    }
+
+    fn drain<R: Read>(decoder: &mut PipeStreamingDecoder<R>) -> Vec<f32> {
+        let mut all = Vec::new();
+        while let Some(chunk) = decoder.next_chunk().unwrap() {
+            all.extend(chunk);
+        }
+        all
+    }
+
+    #[test]
+    fn test_raw_s24le_conversion() {
+        let data = s24_bytes(&[0, 4_194_304, -8_388_608, 8_388_607]);
+        let spec = RawPcmSpec {
+            sample_format: RawSampleFormat::S24Le,
+            sample_rate: 48000,
+            channels: 2,
+        };
+        let mut decoder = PipeStreamingDecoder::from_raw(&data[..], spec).unwrap();
+        let samples = drain(&mut decoder);
+        assert_eq!(samples, vec![0.0, 0.5, -1.0, 8_388_607.0 / 8_388_608.0]);
+        assert_eq!(decoder.format().sample_count, 2);
+        assert!(!decoder.format().is_partial());
+        assert!(decoder.reset().is_err());
+    }
+
+    #[test]
+    fn test_riff_streaming_placeholder_size_and_skipped_chunks() {
+        let mut stream = Vec::new();
+        stream.extend_from_slice(b"RIFF");
+        stream.extend_from_slice(&u32::MAX.to_le_bytes());
+        stream.extend_from_slice(b"WAVE");
+        stream.extend_from_slice(b"LIST");
+        stream.extend_from_slice(&3u32.to_le_bytes());
+        stream.extend_from_slice(&[1, 2, 3, 0]); // 奇数长度 + 对齐填充
+        let fmt = fmt_body(WAVE_FORMAT_PCM, 1, 44100, 16);
+        stream.extend_from_slice(b"fmt ");
+        stream.extend_from_slice(&(fmt.len() as u32).to_le_bytes());
+        stream.extend_from_slice(&fmt);
+        stream.extend_from_slice(b"data");
+        stream.extend_from_slice(&u32::MAX.to_le_bytes());
+        for v in [16384i16, -32768, 0] {
+            stream.extend_from_slice(&v.to_le_bytes());
+        }
+        stream.push(0x7F); // 末尾不完整样本
+
+        let mut decoder = PipeStreamingDecoder::from_container(&stream[..]).unwrap();
+        assert_eq!(decoder.format().sample_rate, 44100);
+        assert_eq!(drain(&mut decoder), vec![0.5, -1.0, 0.0]);
+        assert_eq!(decoder.format().sample_count, 3);
+        assert!(decoder.format().is_partial());
+    }
+
+    #[test]
+    fn test_riff_declared_size_stops_before_trailing_chunks() {
+        let fmt = fmt_body(WAVE_FORMAT_IEEE_FLOAT, 2, 96000, 32);
+        let mut stream = Vec::new();
+        stream.extend_from_slice(b"RIFF");
+        stream.extend_from_slice(&0u32.to_le_bytes());
+        stream.extend_from_slice(b"WAVE");
+        stream.extend_from_slice(b"fmt ");
+        stream.extend_from_slice(&(fmt.len() as u32).to_le_bytes());
+        stream.extend_from_slice(&fmt);
+        stream.extend_from_slice(b"data");
+        stream.extend_from_slice(&8u32.to_le_bytes());
+        stream.extend_from_slice(&0.25f32.to_le_bytes());
+        stream.extend_from_slice(&(-0.75f32).to_le_bytes());
+        stream.extend_from_slice(b"LIST\x04\x00\x00\x00junk");
+
+        let mut decoder = PipeStreamingDecoder::from_container(&stream[..]).unwrap();
+        assert_eq!(decoder.format().sample_count, 1);
+        assert_eq!(drain(&mut decoder), vec![0.25, -0.75]);
+        assert!(!decoder.format().is_partial());
+        assert_eq!(decoder.progress(), 1.0);
+    }
+
+    #[test]
+    fn test_w64_extensible_with_lfe() {
+        let mut fmt = fmt_body(WAVE_FORMAT_EXTENSIBLE, 6, 48000, 24);
+        fmt.extend_from_slice(&22u16.to_le_bytes()); // cbSize
+        fmt.extend_from_slice(&24u16.to_le_bytes()); // 有效位数
+        fmt.extend_from_slice(&0x3Fu32.to_le_bytes()); // 5.1：FL FR FC LFE BL BR
+        fmt.extend_from_slice(&WAVE_FORMAT_PCM.to_le_bytes());
+        fmt.extend_from_slice(&[0; 14]);
+
+        let data = s24_bytes(&[0; 6]);
+        let chunk = |fourcc: &[u8; 4], body: &[u8]| {
+            let mut bytes = fourcc.to_vec();
+            bytes.extend_from_slice(&W64_GUID_SUFFIX);
+            bytes.extend_from_slice(&(body.len() as u64 + 24).to_le_bytes());
+            bytes.extend_from_slice(body);
+            bytes.resize(bytes.len().div_ceil(8) * 8, 0);
+            bytes
+        };
+        let mut stream = W64_RIFF_GUID.to_vec();
+        stream.extend_from_slice(&0u64.to_le_bytes());
+        stream.extend_from_slice(b"wave");
+        stream.extend_from_slice(&W64_GUID_SUFFIX);
+        stream.extend(chunk(b"fmt ", &fmt));
+        stream.extend(chunk(b"data", &data));
+
+        let mut decoder = PipeStreamingDecoder::from_container(&stream[..]).unwrap();
+        let format = decoder.format();
+        assert_eq!((format.channels, format.bits_per_sample), (6, 24));
+        assert_eq!(format.lfe_indices, vec![3]);
+        assert_eq!(drain(&mut decoder).len(), 6);
+    }
+
+    #[test]
+    fn test_w64_placeholder_data_size_reads_to_eof() {
+        let fmt = fmt_body(WAVE_FORMAT_PCM, 1, 44100, 16);
+        for data_chunk_size in [0u64, 7, u64::MAX] {
+            let mut stream = W64_RIFF_GUID.to_vec();
+            stream.extend_from_slice(&u64::MAX.to_le_bytes());
+            stream.extend_from_slice(b"wave");
+            stream.extend_from_slice(&W64_GUID_SUFFIX);
+            stream.extend_from_slice(b"fmt ");
+            stream.extend_from_slice(&W64_GUID_SUFFIX);
+            stream.extend_from_slice(&(fmt.len() as u64 + 24).to_le_bytes());
+            stream.extend_from_slice(&fmt);
+            stream.extend_from_slice(b"data");
+            stream.extend_from_slice(&W64_GUID_SUFFIX);
+            stream.extend_from_slice(&data_chunk_size.to_le_bytes());
+            for v in [16384i16, -32768, 0] {
+                stream.extend_from_slice(&v.to_le_bytes());
+            }
+
+            let mut decoder = PipeStreamingDecoder::from_container(&stream[..]).unwrap();
+            assert_eq!(drain(&mut decoder), vec![0.5, -1.0, 0.0]);
+            assert_eq!(decoder.format().sample_count, 3);
+            assert!(!decoder.format().is_partial());
+        }
+    }
+
+    #[test]
+    fn test_non_wav_stream_is_rejected() {
+        assert!(matches!(
+            PipeStreamingDecoder::from_container(&b"fLaC\0\0\0\x22"[..]),
+            Err(AudioError::FormatError(_))
+        ));
+        assert_eq!(
+            RawSampleFormat::from_name("S24LE"),
+            Some(RawSampleFormat::S24Le)
+        );
+        assert_eq!(RawSampleFormat::from_name("s24be"), None);
+    }
+}
@@ -0,0 +1,266 @@
+//! 稀疏窗口读取器（`--estimate` 估算模式）
+//!
+//! 借助容器的定位表（FLAC SEEKTABLE、MP4 stts/stco、WAV 线性偏移等）直接跳到指定帧，
+//! 只解码被抽中的窗口及其预滚段，其余音频既不读取也不解码。
+//!
+//! 仅支持 Symphonia 可定位的格式；Opus（songbird）与 FFmpeg 回退格式返回错误，
+//! 由调用方回退到完整流式分析。
+
+use super::format::AudioFormat;
+use super::universal_decoder::UniversalDecoder;
+use crate::error::{self, AudioError, AudioResult};
+use crate::processing::SampleConverter;
+use std::path::Path;
+use symphonia::core::codecs::Decoder;
+use symphonia::core::formats::{FormatReader, SeekMode, SeekTo};
+use symphonia::core::units::TimeBase;
+
+/// 需要专用解码器（songbird/FFmpeg）的扩展名：不走稀疏读取
+const NON_SEEKABLE_EXTENSIONS: [&str; 7] = ["opus", "ac3", "ec3", "eac3", "dts", "dsf", "dff"];
+
+/// 稀疏窗口读取器：定位 → 预滚 → 精确截取 `[start, start + frames)` 帧区间
+pub struct SparseWindowReader {
+    format: AudioFormat,
+    format_reader: Box<dyn FormatReader>,
+    decoder: Box<dyn Decoder>,
+    track_id: u32,
+    /// 轨道时间基（None 或 1/采样率 时时间戳即帧号）
+    time_base: Option<TimeBase>,
+    total_frames: u64,
+    sample_converter: SampleConverter,
+    /// 单包解码暂存（交错样本）
+    packet_samples: Vec<f32>,
+    /// 实际解码的帧数（含预滚与定位落点偏差，用于统计读取比例）
+    frames_decoded: u64,
+}
+
+impl SparseWindowReader {
+    /// 打开文件并准备定位读取
+    ///
+    /// 总帧数未知（无法分层抽样）或格式不经由 Symphonia 解码时返回错误。
+    pub fn open<P: AsRef<Path>>(path: P) -> AudioResult<Self> {
+        use symphonia::core::codecs::{CODEC_TYPE_NULL, DecoderOptions};
+        use symphonia::core::formats::FormatOptions;
+        use symphonia::core::io::MediaSourceStream;
+        use symphonia::core::meta::MetadataOptions;
+        use symphonia::core::probe::Hint;
+
+        let path = path.as_ref();
+        let extension = path
+            .extension()
+            .map(|ext| ext.to_string_lossy().to_lowercase())
+            .unwrap_or_default();
+        if NON_SEEKABLE_EXTENSIONS.contains(&extension.as_str()) {
+            return Err(AudioError::FormatError(format!(
+                "Sparse reading is not supported for '{extension}' / '{extension}'格式不支持稀疏读取"
+            )));
+        }
+
+        let format = UniversalDecoder::new().probe_format(path)?;
+
+        let file = std::fs::File::open(path)?;
+        let mss = MediaSourceStream::new(Box::new(file), Default::default());
+        let mut hint = Hint::new();
+        if !extension.is_empty() {
+            hint.with_extension(&extension);
+        }
+
+        let probed = symphonia::default::get_probe()
+            .format(
+                &hint,
+                mss,
+                &FormatOptions::default(),
+                &MetadataOptions::default(),
+            )
+            .map_err(|e| error::format_error("Failed to create decoder / 创建解码器失败", e))?;
+        let format_reader = probed.format;
+
+        let track = format_reader
+            .tracks()
+            .iter()
+            .find(|t| t.codec_params.codec != CODEC_TYPE_NULL)
+            .ok_or_else(|| {
+                AudioError::FormatError(format!("未找到音频轨道: 文件 {}", path.display()))
+            })?;
+
+        let total_frames = track.codec_params.n_frames.unwrap_or(format.sample_count);
+        if total_frames == 0 {
+            return Err(AudioError::FormatError(
+                "Unknown stream length, cannot plan sparse reads / 流长度未知，无法规划稀疏读取"
+                    .to_string(),
+            ));
+        }
+
+        let track_id = track.id;
+        let time_base = track.codec_params.time_base;
+        let decoder = symphonia::default::get_codecs()
+            .make(&track.codec_params, &DecoderOptions::default())
+            .map_err(|e| error::format_error("Failed to create decoder / 创建解码器失败", e))?;
+
+        Ok(Self {
+            format,
+            format_reader,
+            decoder,
+            track_id,
+            time_base,
+            total_frames,
+            sample_converter: SampleConverter::new(),
+            packet_samples: Vec::new(),
+            frames_decoded: 0,
+        })
+    }
+
+    /// 文件格式信息（样本数为整轨帧数）
+    pub fn format(&self) -> &AudioFormat {
+        &self.format
+    }
+
+    /// 整轨总帧数
+    pub fn total_frames(&self) -> u64 {
+        self.total_frames
+    }
+
+    /// 累计解码帧数（含预滚）
+    pub fn frames_decoded(&self) -> u64 {
+        self.frames_decoded
+    }
+
+    /// 读取 `[start_frame, start_frame + frames)` 区间的交错样本到 `out`
+    ///
+    /// 先定位到 `start_frame - preroll_frames`，预滚段解码后丢弃；
+    /// 按包时间戳精确截取目标区间，不依赖定位落点是否恰好对齐。
+    /// 返回实际写入的帧数（文件末尾处可能不足 `frames`）。
+    pub fn read_window(
+        &mut self,
+        start_frame: u64,
+        frames: u64,
+        preroll_frames: u64,
+        out: &mut Vec<f32>,
+    ) -> AudioResult<u64> {
+        use symphonia::core::errors::Error;
+
+        out.clear();
+        let channels = self.format.channels.max(1) as usize;
+        let end_frame = start_frame + frames;
+
+        let seek_frame = start_frame.saturating_sub(preroll_frames);
+        self.format_reader
+            .seek(
+                SeekMode::Accurate,
+                SeekTo::TimeStamp {
+                    ts: self.frame_to_ts(seek_frame),
+                    track_id: self.track_id,
+                },
+            )
+            .map_err(|e| error::format_error("Seek failed / 定位失败", e))?;
+        self.decoder.reset();
+
+        loop {
+            let packet = match self.format_reader.next_packet() {
+                Ok(packet) => packet,
+                Err(Error::IoError(e)) if e.kind() == std::io::ErrorKind::UnexpectedEof => break,
+                Err(e) => return Err(error::format_error("Failed to read packet / 读取包失败", e)),
+            };
+            if packet.track_id() != self.track_id {
+                continue;
+            }
+
+            let packet_start = self.ts_to_frame(packet.ts());
+            if packet_start >= end_frame {
+                break;
+            }
+
+            match self.decoder.decode(&packet) {
+                Ok(decoded) => {
+                    self.sample_converter
+                        .convert_buffer_to_interleaved(&decoded, &mut self.packet_samples)?;
+                    let packet_frames = (self.packet_samples.len() / channels) as u64;
+                    self.frames_decoded += packet_frames;
+
+                    // 截取与目标区间的交集（预滚段与越界部分丢弃）
+                    let from = start_frame.saturating_sub(packet_start).min(packet_frames);
+                    let to = (end_frame - packet_start).min(packet_frames);
+                    if to > from {
+                        out.extend_from_slice(
+                            &self.packet_samples[from as usize * channels..to as usize * channels],
+                        );
+                    }
+
+                    if packet_start + packet_frames >= end_frame {
+                        break;
+                    }
+                }
+                // 与流式解码一致：跳过损坏包
+                Err(Error::DecodeError(_)) => continue,
+                Err(e) => {
+                    return Err(error::decoding_error(
+                        "Audio packet decoding failed / 音频包解码失败",
+                        e,
+                    ));
+                }
+            }
+        }
+
+        Ok((out.len() / channels) as u64)
+    }
+
+    /// 时间戳 → 帧号
+    fn ts_to_frame(&self, ts: u64) -> u64 {
+        match self.time_base {
+            Some(tb) => rescale(
+                ts,
+                tb.numer as u64 * self.format.sample_rate as u64,
+                tb.denom as u64,
+            ),
+            None => ts,
+        }
+    }
+
+    /// 帧号 → 时间戳
+    fn frame_to_ts(&self, frame: u64) -> u64 {
+        match self.time_base {
+            Some(tb) => rescale(
+                frame,
+                tb.denom as u64,
+                tb.numer as u64 * self.format.sample_rate as u64,
+            ),
+            None => frame,
+        }
+    }
+}
+
+/// `value × numer / denom`（128位中间值，避免长曲目溢出）
+fn rescale(value: u64, numer: u64, denom: u64) -> u64 {
+    if denom == 0 || numer == denom {
+        return value;
+    }
+    (value as u128 * numer as u128 / denom as u128) as u64
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_rescale_between_time_bases() {
+        // 1/44100 时间基：时间戳即帧号
+        assert_eq!(rescale(132_480, 44_100, 44_100), 132_480);
+        // 毫秒时间基（MKV）：1000ms @ 48kHz = 48000帧
+        assert_eq!(rescale(1_000, 48_000, 1_000), 48_000);
+        assert_eq!(rescale(48_000, 1_000, 48_000), 1_000);
+        // 10小时 @ 384kHz 乘积超出u64范围也不溢出
+        let frames = 384_000u64 * 36_000;
+        assert_eq!(rescale(frames, 1_000_000_000, 384_000), 36_000_000_000_000);
+    }
+
+    #[test]
+    fn test_open_rejects_dedicated_decoder_formats() {
+        for ext in ["opus", "dsf", "ac3"] {
+            let path = std::path::PathBuf::from(format!("missing_file.{ext}"));
+            assert!(matches!(
+                SparseWindowReader::open(&path),
+                Err(AudioError::FormatError(_))
+            ));
+        }
+    }
+}
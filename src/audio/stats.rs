@@ -66,6 +66,17 @@ impl ChunkSizeStats {
         }
     }
 
+    /// 当前累计的平均块大小（无需 finalize，可在解码过程中调用）
+    ///
+    /// 尚无统计数据时返回 0.0
+    pub fn running_mean_size(&self) -> f64 {
+        if self.total_chunks == 0 {
+            0.0
+        } else {
+            self.sizes_sum as f64 / self.total_chunks as f64
+        }
+    }
+
     pub fn finalize(&mut self) {
         if self.total_chunks > 0 {
             self.mean_size = self.sizes_sum as f64 / self.total_chunks as f64;
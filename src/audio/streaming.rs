@@ -150,6 +150,15 @@ pub trait StreamingDecoder {
     fn get_chunk_stats(&mut self) -> Option<ChunkSizeStats> {
         None // 默认不支持
     }
+
+    /// 归还已消费完的样本缓冲区（可选，供解码器复用）
+    ///
+    /// 调用方处理完 `next_chunk()` 返回的样本后，可把 `Vec` 交还解码器。
+    /// 支持缓冲池的实现（如并行解码器）会清空并复用其容量，
+    /// 使稳态解码不再为每个包分配堆内存；默认实现直接释放。
+    fn recycle_buffer(&mut self, buffer: Vec<f32>) {
+        drop(buffer); // 默认不复用
+    }
 }
 
 #[cfg(test)]
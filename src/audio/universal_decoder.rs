@@ -3,6 +3,7 @@
 //! 真正的UniversalDecoder - 直接处理所有音频格式的解码
 //! 基于Symphonia提供完整的多格式支持
 
+use super::channel_layout;
 use crate::error::{self, AudioError, AudioResult};
 use crate::processing::SampleConverter;
 use std::path::Path;
@@ -434,6 +435,56 @@ impl UniversalDecoder {
             })?;
 
         let codec_params = &track.codec_params;
+        let mut format = self.format_from_codec_params(codec_params)?;
+
+        // 若仍未获得 LFE 信息，做两种兼容型回退：
+        // 1) WAV: 直接解析 WAVEFORMATEXTENSIBLE 的 dwChannelMask（避免依赖外部工具）
+        // 2) FLAC: 按 FLAC 规范的通道分配，在 5.1/7.1 中 LFE 位于 index=3（0-based）
+        if format.lfe_indices.is_empty() && format.channels as usize >= 3 {
+            // 回退 1：WAV 容器解析
+            if path
+                .extension()
+                .and_then(|s| s.to_str())
+                .map(|s| s.eq_ignore_ascii_case("wav"))
+                .unwrap_or(false)
+                && let Ok(Some(mask)) = parse_wav_channel_mask(path)
+            {
+                // WAVEFORMATEXTENSIBLE 规定交错顺序按掩码从低位到高位排列
+                const SPEAKER_LOW_FREQUENCY: u32 = 0x0008;
+                if (mask & SPEAKER_LOW_FREQUENCY) != 0 {
+                    let bit = SPEAKER_LOW_FREQUENCY as u64;
+                    let raw_bits = mask as u64;
+                    let lower = raw_bits & (bit - 1);
+                    let idx = lower.count_ones() as usize;
+                    format.set_lfe_indices(vec![idx]);
+                }
+                format
+                    .set_surround_indices(channel_layout::surround_indices_from_mask(mask as u64));
+            }
+
+            // 回退 2：FLAC 规范的固定分配（仅当仍无 LFE 索引时）
+            if format.lfe_indices.is_empty()
+                && codec_params.codec == symphonia::core::codecs::CODEC_TYPE_FLAC
+            {
+                let ch = format.channels as usize;
+                if ch == 6 || ch == 8 {
+                    // FLAC 5.1/7.1 的标准分配：L, R, C, LFE, ... => LFE 在 index 3
+                    format.set_lfe_indices(vec![3]);
+                }
+            }
+        }
+        format.validate()?;
+
+        Ok(format)
+    }
+
+    /// 由轨道编解码参数构建格式信息（含声道掩码中的 LFE 位置）
+    ///
+    /// 不含依赖文件路径的回退（WAV 声道掩码解析、FLAC 固定分配），供多音轨解复用逐轨复用。
+    pub(crate) fn format_from_codec_params(
+        &self,
+        codec_params: &symphonia::core::codecs::CodecParameters,
+    ) -> AudioResult<AudioFormat> {
         let sample_rate = codec_params.sample_rate.unwrap_or(44100);
         let channels = self.detect_channel_count(codec_params)?;
         let bits_per_sample = self.detect_bit_depth(codec_params);
@@ -472,6 +523,7 @@ impl UniversalDecoder {
             // 支持第二路 LFE（若存在）
             push_index(&mut lfe_indices, Ch::LFE2, raw as u64, Ch::LFE2);
 
+            format.set_surround_indices(channel_layout::surround_indices_from_mask(raw as u64));
             if !lfe_indices.is_empty() {
                 format.set_lfe_indices(lfe_indices);
             } else {
@@ -480,42 +532,6 @@ impl UniversalDecoder {
             }
         }
 
-        // 若仍未获得 LFE 信息，做两种兼容型回退：
-        // 1) WAV: 直接解析 WAVEFORMATEXTENSIBLE 的 dwChannelMask（避免依赖外部工具）
-        // 2) FLAC: 按 FLAC 规范的通道分配，在 5.1/7.1 中 LFE 位于 index=3（0-based）
-        if format.lfe_indices.is_empty() && format.channels as usize >= 3 {
-            // 回退 1：WAV 容器解析
-            if path
-                .extension()
-                .and_then(|s| s.to_str())
-                .map(|s| s.eq_ignore_ascii_case("wav"))
-                .unwrap_or(false)
-                && let Ok(Some(mask)) = parse_wav_channel_mask(path)
-            {
-                // WAVEFORMATEXTENSIBLE 规定交错顺序按掩码从低位到高位排列
-                const SPEAKER_LOW_FREQUENCY: u32 = 0x0008;
-                if (mask & SPEAKER_LOW_FREQUENCY) != 0 {
-                    let bit = SPEAKER_LOW_FREQUENCY as u64;
-                    let raw_bits = mask as u64;
-                    let lower = raw_bits & (bit - 1);
-                    let idx = lower.count_ones() as usize;
-                    format.set_lfe_indices(vec![idx]);
-                }
-            }
-
-            // 回退 2：FLAC 规范的固定分配（仅当仍无 LFE 索引时）
-            if format.lfe_indices.is_empty()
-                && codec_params.codec == symphonia::core::codecs::CODEC_TYPE_FLAC
-            {
-                let ch = format.channels as usize;
-                if ch == 6 || ch == 8 {
-                    // FLAC 5.1/7.1 的标准分配：L, R, C, LFE, ... => LFE 在 index 3
-                    format.set_lfe_indices(vec![3]);
-                }
-            }
-        }
-        format.validate()?;
-
         Ok(format)
     }
 
@@ -1116,6 +1132,7 @@ impl ParallelUniversalStreamProcessor {
                 self.state.sample_converter.clone(),
             )
             .with_config(self.batch_size, self.thread_count)
+            .with_adaptive_batching(true)
         } else {
             super::parallel_decoder::OrderedParallelDecoder::new(
                 codec_params,
@@ -1210,62 +1227,59 @@ impl StreamingDecoder for ParallelUniversalStreamProcessor {
             // 状态机驱动
             match current_state {
                 DecodingState::Decoding => {
-                    // 尝试获取已解码样本
-                    match self
+                    // 1. 非阻塞：下一个有序结果已就绪则直接返回
+                    if let Some(samples) = self
                         .parallel_decoder
                         .as_mut()
                         .expect("parallel_decoder必须已初始化")
                         .next_samples()
                     {
-                        Some(samples) if !samples.is_empty() => {
+                        if !samples.is_empty() {
                             self.state
                                 .update_position(&samples, self.state.format.channels);
                             self.sync_skipped_packets();
                             return Ok(Some(samples));
                         }
-                        _ => {}
+                        // 解码失败的空结果：继续取下一个
+                        continue;
                     }
 
-                    // 没有样本，读取更多包
-                    let batch_size = self.batch_size;
-                    self.process_packets_batch(batch_size)?;
-
-                    // 等待后台线程解码，最多等待100ms
-                    const MAX_WAIT_ATTEMPTS: usize = 100;
-                    const WAIT_INTERVAL_MS: u64 = 1;
-
-                    for _attempt in 0..MAX_WAIT_ATTEMPTS {
-                        match self
+                    // 2. 在途包不足两批：继续读包提交，保持工作线程饱和（批大小按实测解码成本自适应）
+                    let batch_size = if self.parallel_enabled {
+                        let parallel_decoder = self
                             .parallel_decoder
                             .as_mut()
-                            .expect("parallel_decoder必须已初始化")
-                            .next_samples()
-                        {
-                            Some(samples) if !samples.is_empty() => {
-                                self.state
-                                    .update_position(&samples, self.state.format.channels);
-                                self.sync_skipped_packets();
-                                return Ok(Some(samples));
-                            }
-                            _ => {}
-                        }
-                        std::thread::sleep(std::time::Duration::from_millis(WAIT_INTERVAL_MS));
-                    }
-
-                    // 等待超时，检查状态是否已切换到Flushing（process_packets_batch遇到EOF）
-                    let new_state = self
+                            .expect("parallel_decoder必须已初始化");
+                        parallel_decoder.retune_batch_size(&self.state.chunk_stats);
+                        parallel_decoder.batch_size()
+                    } else {
+                        self.batch_size
+                    };
+                    let in_flight = self
                         .parallel_decoder
                         .as_ref()
                         .expect("parallel_decoder必须已初始化")
-                        .get_state();
+                        .in_flight_packets();
 
-                    if new_state == DecodingState::Flushing {
-                        // 状态已切换，循环继续进入Flushing分支
+                    if in_flight < batch_size.saturating_mul(2) {
+                        // 遇到文件末尾时会flush并切换到Flushing，下一轮循环进入drain
+                        self.process_packets_batch(batch_size)?;
                         continue;
                     }
 
-                    // 仍在Decoding，暂无样本
-                    return Ok(None);
+                    // 3. 在途包充足：阻塞等待下一个序列号就绪（事件驱动，无sleep轮询）
+                    if let Some(samples) = self
+                        .parallel_decoder
+                        .as_mut()
+                        .expect("parallel_decoder必须已初始化")
+                        .recv_next_samples()
+                        && !samples.is_empty()
+                    {
+                        self.state
+                            .update_position(&samples, self.state.format.channels);
+                        self.sync_skipped_packets();
+                        return Ok(Some(samples));
+                    }
                 }
 
                 DecodingState::Flushing => {
@@ -1311,6 +1325,12 @@ impl StreamingDecoder for ParallelUniversalStreamProcessor {
         }
     }
 
+    fn recycle_buffer(&mut self, buffer: Vec<f32>) {
+        if let Some(parallel_decoder) = &self.parallel_decoder {
+            parallel_decoder.recycle_buffer(buffer);
+        }
+    }
+
     fn reset(&mut self) -> AudioResult<()> {
         self.format_reader = None;
         self.parallel_decoder = None;
@@ -122,6 +122,30 @@ enum Commands {
         #[arg(long, short = 'f', default_value = "markdown")]
         format: OutputFormat,
     },
+
+    /// 测量 --true-peak 开销：同一可执行文件分别以默认参数和附加 --true-peak 运行
+    /// Measure --true-peak overhead: run the same executable without and with --true-peak
+    TruePeak {
+        /// 测试数据路径
+        /// Test data path
+        #[arg(long, short = 'p')]
+        path: Option<PathBuf>,
+
+        /// 运行次数
+        /// Number of runs
+        #[arg(long, short = 'n', default_value_t = DEFAULT_RUNS)]
+        runs: usize,
+
+        /// 额外参数（两组运行共用）
+        /// Extra arguments (shared by both runs)
+        #[arg(long, short = 'a')]
+        args: Option<String>,
+
+        /// 输出格式
+        /// Output format
+        #[arg(long, short = 'f', default_value = "markdown")]
+        format: OutputFormat,
+    },
 }
 
 #[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
@@ -900,6 +924,54 @@ fn run_main() -> Result<()> {
                 OutputFormat::Table => output_compare_markdown(&compare_report), // 复用 Markdown
             }
         }
+        Some(Commands::TruePeak {
+            path,
+            runs,
+            args,
+            format,
+        }) => {
+            // 真峰值开销：默认参数为基准，附加 --true-peak 为候选
+            let exe = cli
+                .exe
+                .or_else(auto_discover_executable)
+                .context("No executable found / 未找到可执行文件，请用 -e 指定")?;
+            let target = path
+                .or_else(auto_discover_test_data)
+                .context("No test data found / 未找到测试数据，请用 -p 指定")?;
+            let true_peak_args = Some(match &args {
+                Some(args) => format!("{args} --true-peak"),
+                None => "--true-peak".to_string(),
+            });
+
+            eprintln!(
+                "True peak overhead / 真峰值开销:\n  Executable: {}\n  Target: {}\n",
+                exe.display(),
+                target.display()
+            );
+
+            eprintln!("Running without --true-peak / 运行默认参数...");
+            let baseline_results = run_multiple(&exe, &target, runs, &args, cli.sample_interval)?;
+            let baseline_report = generate_report(&exe, &target, &baseline_results);
+
+            eprintln!("Running with --true-peak / 运行 --true-peak...");
+            let candidate_results =
+                run_multiple(&exe, &target, runs, &true_peak_args, cli.sample_interval)?;
+            let mut candidate_report = generate_report(&exe, &target, &candidate_results);
+            candidate_report.executable = format!("{} --true-peak", candidate_report.executable);
+
+            let compare_report = CompareReport {
+                baseline: baseline_report,
+                candidate: candidate_report,
+                timestamp: Local::now().format("%Y-%m-%d %H:%M:%S").to_string(),
+            };
+
+            match format {
+                OutputFormat::Json => output_compare_json(&compare_report),
+                OutputFormat::Markdown | OutputFormat::Table => {
+                    output_compare_markdown(&compare_report)
+                }
+            }
+        }
         None => {
             // 默认模式
             let exe = cli.exe.or_else(auto_discover_executable).context(
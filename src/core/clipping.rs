@@ -0,0 +1,220 @@
+//! 削波统计
+//!
+//! 启用后（`WindowRmsAnalyzer::with_clip_tracking`）在窗口RMS分析的逐样本内核中顺带统计满幅（削波）样本，无需额外遍历：
+//! - 削波样本总数（`|x| ≥ CLIPPING_THRESHOLD`）
+//! - 连续削波段数（连续削波样本数 ≥ `CLIP_RUN_MIN_SAMPLES`）与最长削波段
+//! - 每个3秒窗口的削波样本数与削波段数（与窗口RMS/Peak一一对应）
+//!
+//! 非削波样本只需一次比较，削波分支仅在满幅样本上执行；未启用时内核按常量参数单态化，不含任何削波代码。
+
+use crate::tools::constants::dr_analysis::{CLIP_RUN_MIN_SAMPLES, CLIPPING_THRESHOLD};
+
+/// 单声道削波统计
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct ClipStats {
+    /// 削波样本总数
+    pub clipped_samples: u64,
+    /// 连续削波段数（长度 ≥ `CLIP_RUN_MIN_SAMPLES`）
+    pub clip_runs: u64,
+    /// 最长连续削波样本数
+    pub longest_run: u64,
+}
+
+impl ClipStats {
+    pub fn has_clipping(&self) -> bool {
+        self.clipped_samples > 0
+    }
+}
+
+/// 单个3秒窗口的削波统计
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct WindowClipping {
+    /// 窗口内削波样本数
+    pub clipped_samples: u32,
+    /// 在窗口内达到最小长度的削波段数（跨窗口的削波段计入达到最小长度时所在的窗口）
+    pub clip_runs: u32,
+}
+
+/// 流式削波跟踪器（由 `WindowRmsAnalyzer` 持有）
+#[derive(Debug, Clone, Default)]
+pub(crate) struct ClipTracker {
+    stats: ClipStats,
+    /// 当前未满窗口的统计
+    window: WindowClipping,
+    /// 当前未结束的削波段长度
+    open_run: u64,
+    /// 从第一个样本开始的削波段长度（用于分段拼接）
+    leading_run: u64,
+    /// 是否出现过非削波样本
+    unclipped_seen: bool,
+}
+
+impl ClipTracker {
+    /// 送入一个样本的绝对值
+    #[inline(always)]
+    pub(crate) fn push(&mut self, abs_sample: f64) {
+        if abs_sample >= CLIPPING_THRESHOLD {
+            self.push_clipped();
+        } else {
+            self.open_run = 0;
+            self.unclipped_seen = true;
+        }
+    }
+
+    #[inline]
+    fn push_clipped(&mut self) {
+        self.stats.clipped_samples += 1;
+        self.window.clipped_samples += 1;
+        self.open_run += 1;
+        if self.open_run == CLIP_RUN_MIN_SAMPLES {
+            self.stats.clip_runs += 1;
+            self.window.clip_runs += 1;
+        }
+        self.stats.longest_run = self.stats.longest_run.max(self.open_run);
+        if !self.unclipped_seen {
+            self.leading_run += 1;
+        }
+    }
+
+    /// 结算当前窗口并开始新窗口（削波段状态跨窗口延续）
+    #[inline]
+    pub(crate) fn take_window(&mut self) -> WindowClipping {
+        std::mem::take(&mut self.window)
+    }
+
+    /// 当前未满窗口的统计
+    pub(crate) fn window_mut(&mut self) -> &mut WindowClipping {
+        &mut self.window
+    }
+
+    pub(crate) fn stats(&self) -> ClipStats {
+        self.stats
+    }
+
+    /// 按时间顺序拼接后续分段，未满窗口状态由后续分段继承
+    ///
+    /// 边界两侧的削波段合并为一段；返回削波段计数的修正值（-1/0/+1），
+    /// 调用者将其计入后续分段的第一个窗口，使窗口级统计与串行处理一致。
+    pub(crate) fn append(&mut self, next: &ClipTracker) -> i32 {
+        let joined = self.open_run + next.leading_run;
+        let correction = if self.open_run > 0 && next.leading_run > 0 {
+            let counted = i32::from(self.open_run >= CLIP_RUN_MIN_SAMPLES)
+                + i32::from(next.leading_run >= CLIP_RUN_MIN_SAMPLES);
+            i32::from(joined >= CLIP_RUN_MIN_SAMPLES) - counted
+        } else {
+            0
+        };
+
+        self.stats.clipped_samples += next.stats.clipped_samples;
+        self.stats.clip_runs = (self.stats.clip_runs + next.stats.clip_runs)
+            .checked_add_signed(i64::from(correction))
+            .unwrap_or(0);
+        self.stats.longest_run = self
+            .stats
+            .longest_run
+            .max(next.stats.longest_run)
+            .max(joined);
+
+        if !self.unclipped_seen {
+            self.leading_run += next.leading_run;
+        }
+        self.open_run = if next.unclipped_seen {
+            next.open_run
+        } else {
+            joined
+        };
+        self.unclipped_seen |= next.unclipped_seen;
+        self.window = next.window;
+
+        correction
+    }
+}
+
+impl WindowClipping {
+    /// 应用分段拼接的削波段计数修正
+    pub(crate) fn apply_run_correction(&mut self, correction: i32) {
+        self.clip_runs = self.clip_runs.saturating_add_signed(correction);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn track(samples: &[f64], window_len: usize) -> (ClipTracker, Vec<WindowClipping>) {
+        let mut tracker = ClipTracker::default();
+        let mut windows = Vec::new();
+        for (i, &x) in samples.iter().enumerate() {
+            tracker.push(x.abs());
+            if (i + 1) % window_len == 0 {
+                windows.push(tracker.take_window());
+            }
+        }
+        (tracker, windows)
+    }
+
+    #[test]
+    fn test_runs_and_totals() {
+        // 单个满幅样本不计为削波段；跨窗口的削波段计入达到最小长度的窗口
+        let samples = [0.5, 1.0, 0.5, 1.0, -1.0, 0.2, 0.3, 1.0, -1.0, 1.0, 1.0, 0.1];
+        let (tracker, windows) = track(&samples, 4);
+        assert_eq!(
+            tracker.stats(),
+            ClipStats {
+                clipped_samples: 7,
+                clip_runs: 1,
+                longest_run: 4,
+            }
+        );
+        assert_eq!(
+            windows,
+            [
+                WindowClipping {
+                    clipped_samples: 2,
+                    clip_runs: 0
+                },
+                WindowClipping {
+                    clipped_samples: 2,
+                    clip_runs: 0
+                },
+                WindowClipping {
+                    clipped_samples: 3,
+                    clip_runs: 1
+                },
+            ]
+        );
+    }
+
+    #[test]
+    fn test_append_matches_serial() {
+        let pattern = [1.0, 1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.5, 1.0, 1.0];
+        let samples: Vec<f64> = pattern.iter().cycle().take(60).copied().collect();
+        let (serial, serial_windows) = track(&samples, 5);
+
+        for split in (0..=samples.len()).step_by(5) {
+            let (mut head, mut windows) = track(&samples[..split], 5);
+            let (tail, mut tail_windows) = track(&samples[split..], 5);
+            let correction = head.append(&tail);
+            match tail_windows.first_mut() {
+                Some(first) => first.apply_run_correction(correction),
+                None => head.window_mut().apply_run_correction(correction),
+            }
+            windows.extend(tail_windows);
+
+            assert_eq!(head.stats(), serial.stats(), "split at {split}");
+            assert_eq!(windows, serial_windows, "split at {split}");
+        }
+    }
+
+    #[test]
+    fn test_fully_clipped_segments_join() {
+        let mut head = ClipTracker::default();
+        let mut tail = ClipTracker::default();
+        head.push(1.0);
+        head.push(1.0);
+        tail.push(1.0);
+        assert_eq!(head.append(&tail), 1);
+        assert_eq!(head.stats().clip_runs, 1);
+        assert_eq!(head.stats().longest_run, 3);
+    }
+}
@@ -13,6 +13,7 @@ use crate::processing::simd_core::SimdProcessor;
 #[cfg(test)]
 use crate::tools::constants::dr_analysis;
 use crate::tools::constants::format_constraints;
+use rayon::prelude::*;
 
 // 配置常量：集中管理默认值，提高可维护性
 /// 标准音频采样率（CD质量）
@@ -351,6 +352,26 @@ impl DrCalculator {
         // 多声道支持：基于foobar2000 DR Meter实测行为
         // 每个声道独立计算DR，最终Official DR为算术平均值
 
+        // 长音频：按窗口对齐的帧区间切分，多核并行后确定性合并
+        if let Some(segment_frames) = self.parallel_segment_frames(samples.len() / channel_count) {
+            #[cfg(debug_assertions)]
+            eprintln!(
+                "[DRCALC] Using parallel window-aligned segments ({segment_frames} frames each) / 使用窗口对齐并行分段（每段{segment_frames}帧）"
+            );
+
+            return Ok(self.calculate_dr_parallel_segments(samples, channel_count, segment_frames));
+        }
+
+        // 短音频多声道：各声道直方图互相独立，按声道扇出到rayon线程
+        if self.parallel_channel_fanout(samples.len() / channel_count, channel_count) {
+            #[cfg(debug_assertions)]
+            eprintln!(
+                "[DRCALC] Using per-channel fan-out for {channel_count} channels / 按声道并行处理{channel_count}声道"
+            );
+
+            return Ok(self.calculate_dr_parallel_channels(samples, channel_count));
+        }
+
         // 混合策略：3+声道使用零拷贝strided，1-2声道保持SIMD优势
         if channel_count >= 3 {
             // 3+声道：零拷贝单次遍历跨步处理
@@ -445,22 +466,165 @@ impl DrCalculator {
         )
     }
 
+    /// 计算并行分段的帧数（返回None表示数据量不足以并行，走串行路径）
+    ///
+    /// 分段长度为窗口长度的整数倍，保证除最后一段外每段都结束于窗口边界；
+    /// 分段数不超过rayon线程数，每段至少 `PARALLEL_SEGMENT_MIN_WINDOWS` 个窗口。
+    fn parallel_segment_frames(&self, total_frames: usize) -> Option<usize> {
+        use crate::tools::constants::dr_analysis::PARALLEL_SEGMENT_MIN_WINDOWS;
+
+        let window_len = self.create_analyzer().window_len();
+        if window_len == 0 {
+            return None;
+        }
+
+        let total_windows = total_frames / window_len;
+        let segment_count =
+            (total_windows / PARALLEL_SEGMENT_MIN_WINDOWS).min(rayon::current_num_threads());
+        if segment_count < 2 {
+            return None;
+        }
+
+        Some(total_windows.div_ceil(segment_count) * window_len)
+    }
+
+    /// 是否按声道扇出（分段并行不适用的短音频，3+声道）
+    ///
+    /// 1-2声道由 `ProcessingCoordinator` 负责声道级并行；至少一个完整窗口才扇出，
+    /// 更短的缓冲区任务调度开销与计算量相当。
+    fn parallel_channel_fanout(&self, total_frames: usize, channel_count: usize) -> bool {
+        channel_count >= 3
+            && rayon::current_num_threads() >= 2
+            && total_frames >= self.create_analyzer().window_len()
+    }
+
+    /// 按声道并行的DR计算：每个声道在rayon线程上以跨步方式读取交错样本
+    ///
+    /// 每个声道看到的样本序列与串行跨步/转置路径相同，结果逐位一致（同样不结算尾窗）。
+    fn calculate_dr_parallel_channels(
+        &self,
+        samples: &[f32],
+        channel_count: usize,
+    ) -> Vec<DrResult> {
+        let analyzers = (0..channel_count)
+            .into_par_iter()
+            .map(|channel_idx| {
+                let mut analyzer = self.create_analyzer();
+                analyzer.process_samples_strided(samples, channel_idx, channel_count);
+                analyzer
+            })
+            .collect();
+        self.build_dr_results(analyzers, samples.len() / channel_count)
+    }
+
+    /// 窗口对齐的并行分段DR计算
+    ///
+    /// 每个分段在rayon线程上以独立analyzer处理全部声道（沿用串行路径的
+    /// 转置/跨步内核），随后按时间顺序用 `append_segment` 合并。
+    /// 每个3秒窗口的累积都从0开始，因此结果与串行计算逐位一致。
+    ///
+    /// 尾窗语义与串行路径保持一致：1-2声道（process_samples）结算尾窗，
+    /// 3+声道（跨步/转置路径）不结算尾窗。
+    fn calculate_dr_parallel_segments(
+        &self,
+        samples: &[f32],
+        channel_count: usize,
+        segment_frames: usize,
+    ) -> Vec<DrResult> {
+        let segments: Vec<Vec<WindowRmsAnalyzer>> = samples
+            .par_chunks(segment_frames * channel_count)
+            .map(|segment| {
+                let mut analyzers = self.create_analyzers(channel_count);
+                self.feed_interleaved(&mut analyzers, segment, channel_count);
+                analyzers
+            })
+            .collect();
+
+        let mut segments = segments.into_iter();
+        let mut analyzers = segments
+            .next()
+            .unwrap_or_else(|| self.create_analyzers(channel_count));
+        for segment in segments {
+            for (merged, next) in analyzers.iter_mut().zip(segment) {
+                merged.append_segment(next);
+            }
+        }
+
+        if channel_count <= 2 {
+            for analyzer in &mut analyzers {
+                analyzer.finalize_tail_window();
+            }
+        }
+
+        self.build_dr_results(analyzers, samples.len() / channel_count)
+    }
+
+    /// 创建单个声道的analyzer（使用计算器配置）
+    fn create_analyzer(&self) -> WindowRmsAnalyzer {
+        WindowRmsAnalyzer::with_silence_filter(
+            self.sample_rate,
+            self.sum_doubling_enabled,
+            self.silence_filter,
+        )
+    }
+
+    /// 为每个声道创建analyzer
+    fn create_analyzers(&self, channel_count: usize) -> Vec<WindowRmsAnalyzer> {
+        (0..channel_count).map(|_| self.create_analyzer()).collect()
+    }
+
+    /// 从analyzers派生全部声道的DR结果
+    fn build_dr_results(
+        &self,
+        analyzers: Vec<WindowRmsAnalyzer>,
+        samples_per_channel: usize,
+    ) -> Vec<DrResult> {
+        analyzers
+            .into_iter()
+            .enumerate()
+            .map(|(channel_idx, analyzer)| {
+                self.build_dr_result_from_analyzer(analyzer, channel_idx, samples_per_channel)
+            })
+            .collect()
+    }
+
     /// 零拷贝跨步多声道DR计算（3+声道专用）
     ///
     /// 单次遍历交错样本，直接为每个声道计算DR，消除中间Vec分配。
+    fn calculate_dr_strided(
+        &self,
+        samples: &[f32],
+        channel_count: usize,
+    ) -> AudioResult<Vec<DrResult>> {
+        let mut analyzers = self.create_analyzers(channel_count);
+        self.feed_interleaved(&mut analyzers, samples, channel_count);
+        Ok(self.build_dr_results(analyzers, samples.len() / channel_count))
+    }
+
+    /// 把交错样本送入各声道analyzer（不结算尾窗）
     ///
     /// 性能优化策略：
+    /// - 单声道：连续切片直接处理
     /// - 4的倍数声道（8/12/16）：使用SIMD 4×4块级转置提升缓存局部性
-    /// - 其他声道（3/5/7等）：使用跨步访问方法
-    fn calculate_dr_strided(
+    /// - 6声道（5.1）：前4通道4×4转置 + 后2通道跨步
+    /// - 其他声道（2/3/5/7等）：使用跨步访问方法
+    ///
+    /// 所有内核对每个声道产生相同的样本序列，仅访存模式不同。
+    fn feed_interleaved(
         &self,
+        analyzers: &mut [WindowRmsAnalyzer],
         samples: &[f32],
         channel_count: usize,
-    ) -> AudioResult<Vec<DrResult>> {
+    ) {
         const MIN_FRAMES_FOR_TRANSPOSE: usize = 64;
 
         let total_frames = samples.len() / channel_count;
 
+        if channel_count == 1 {
+            analyzers[0].process_samples_streaming(samples);
+            return;
+        }
+
         if channel_count >= 8
             && channel_count.is_multiple_of(4)
             && total_frames >= MIN_FRAMES_FOR_TRANSPOSE
@@ -470,7 +634,8 @@ impl DrCalculator {
                 "[DRCALC] Using 4×4 block transpose for {channel_count} channels / 使用4×4块级转置处理{channel_count}声道"
             );
 
-            return self.calculate_dr_transpose_4x4(samples, channel_count);
+            Self::feed_transpose_4x4(analyzers, samples, channel_count);
+            return;
         }
 
         if channel_count >= 8 && channel_count.is_multiple_of(4) {
@@ -487,20 +652,7 @@ impl DrCalculator {
                 "[DRCALC] Using mixed 4×4 transpose (ch0-3) + strided (ch4-5) for 6 channels / 6声道采用混合：前4通道4×4转置 + 后2通道跨步"
             );
 
-            use crate::processing::simd_core::SimdProcessor;
             let simd_processor = SimdProcessor::new();
-
-            // 为6个声道创建analyzer
-            let mut analyzers: Vec<WindowRmsAnalyzer> = (0..channel_count)
-                .map(|_| {
-                    WindowRmsAnalyzer::with_silence_filter(
-                        self.sample_rate,
-                        self.sum_doubling_enabled,
-                        self.silence_filter,
-                    )
-                })
-                .collect();
-
             let num_blocks = total_frames / 4; // 每块4帧
 
             // 使用4×4转置处理通道0..3
@@ -537,18 +689,7 @@ impl DrCalculator {
             // 通道4、5整段使用跨步直投（一次遍历）
             analyzers[4].process_samples_strided(samples, 4, channel_count);
             analyzers[5].process_samples_strided(samples, 5, channel_count);
-
-            // 汇总结果
-            let samples_per_channel = samples.len() / channel_count;
-            let dr_results: Vec<DrResult> = analyzers
-                .into_iter()
-                .enumerate()
-                .map(|(channel_idx, analyzer)| {
-                    self.build_dr_result_from_analyzer(analyzer, channel_idx, samples_per_channel)
-                })
-                .collect();
-
-            return Ok(dr_results);
+            return;
         }
 
         // 其他声道：使用跨步访问方法
@@ -557,36 +698,13 @@ impl DrCalculator {
             "[DRCALC] Using strided access for {channel_count} channels / 使用跨步访问处理{channel_count}声道"
         );
 
-        // 创建每个声道的analyzer
-        let mut analyzers: Vec<WindowRmsAnalyzer> = (0..channel_count)
-            .map(|_| {
-                WindowRmsAnalyzer::with_silence_filter(
-                    self.sample_rate,
-                    self.sum_doubling_enabled,
-                    self.silence_filter,
-                )
-            })
-            .collect();
-
         // 零拷贝跨步处理：每个analyzer直接从交错样本提取目标声道
         for (channel_idx, analyzer) in analyzers.iter_mut().enumerate() {
             analyzer.process_samples_strided(samples, channel_idx, channel_count);
         }
-
-        // 从analyzers派生DR结果
-        let samples_per_channel = samples.len() / channel_count;
-        let dr_results: Vec<DrResult> = analyzers
-            .into_iter()
-            .enumerate()
-            .map(|(channel_idx, analyzer)| {
-                self.build_dr_result_from_analyzer(analyzer, channel_idx, samples_per_channel)
-            })
-            .collect();
-
-        Ok(dr_results)
     }
 
-    /// 4×4块级转置多声道DR计算（4的倍数声道专用）
+    /// 4×4块级转置投喂（4的倍数声道专用）
     ///
     /// 使用SIMD 4×4块级转置提升缓存局部性，适用于8/12/16声道等场景。
     /// 相比跨步访问，块级转置将连续的4帧×4声道转换为4声道×4样本，
@@ -597,11 +715,11 @@ impl DrCalculator {
     /// - **缓存局部性**: 转置后的声道数据在内存中连续，减少cache miss
     /// - **SIMD优化**: 使用SSE2/NEON硬件加速转置操作
     /// - **内存遍历**: 单次遍历完成所有声道转置（vs 跨步的N次遍历）
-    fn calculate_dr_transpose_4x4(
-        &self,
+    fn feed_transpose_4x4(
+        analyzers: &mut [WindowRmsAnalyzer],
         samples: &[f32],
         channel_count: usize,
-    ) -> AudioResult<Vec<DrResult>> {
+    ) {
         debug_assert!(
             channel_count.is_multiple_of(4),
             "channel_count must be multiple of 4"
@@ -610,17 +728,6 @@ impl DrCalculator {
         // 创建SIMD处理器
         let simd_processor = SimdProcessor::new();
 
-        // 创建每个声道的analyzer
-        let mut analyzers: Vec<WindowRmsAnalyzer> = (0..channel_count)
-            .map(|_| {
-                WindowRmsAnalyzer::with_silence_filter(
-                    self.sample_rate,
-                    self.sum_doubling_enabled,
-                    self.silence_filter,
-                )
-            })
-            .collect();
-
         let total_frames = samples.len() / channel_count;
         let num_blocks = total_frames / 4;
 
@@ -652,23 +759,11 @@ impl DrCalculator {
             for f in 0..remaining_frames {
                 let frame = base_frame + f;
                 let base = frame * channel_count;
-                for ch_idx in 0..channel_count {
-                    analyzers[ch_idx].process_single_sample(samples[base + ch_idx]);
+                for (ch_idx, analyzer) in analyzers.iter_mut().enumerate() {
+                    analyzer.process_single_sample(samples[base + ch_idx]);
                 }
             }
         }
-
-        // 汇总结果
-        let samples_per_channel = samples.len() / channel_count;
-        let dr_results: Vec<DrResult> = analyzers
-            .into_iter()
-            .enumerate()
-            .map(|(channel_idx, analyzer)| {
-                self.build_dr_result_from_analyzer(analyzer, channel_idx, samples_per_channel)
-            })
-            .collect();
-
-        Ok(dr_results)
     }
 
     /// 单声道DR计算算法（纯算法逻辑）
@@ -811,6 +906,96 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_parallel_segments_match_serial() {
+        // 窗口对齐并行分段与串行路径逐位一致（含尾窗、6声道混合与8声道转置内核）
+        let sample_rate = 1000; // 窗口 = 3004 帧，保持测试数据量较小
+        let frames = 3004 * 20 + 777;
+
+        for channel_count in [1usize, 2, 3, 6, 8] {
+            let calc = DrCalculator::new_with_config(channel_count, sample_rate).unwrap();
+            let samples: Vec<f32> = (0..frames * channel_count)
+                .map(|i| {
+                    let ch = (i % channel_count) as f32;
+                    let t = (i / channel_count) as f32;
+                    (t * 0.05 * (ch + 1.0)).sin() * (0.2 + 0.7 * (t * 0.0003).sin().abs())
+                })
+                .collect();
+
+            let serial = if channel_count >= 3 {
+                calc.calculate_dr_strided(&samples, channel_count).unwrap()
+            } else {
+                (0..channel_count)
+                    .map(|ch| {
+                        let channel: Vec<f32> = samples
+                            .iter()
+                            .skip(ch)
+                            .step_by(channel_count)
+                            .copied()
+                            .collect();
+                        calc.calculate_single_channel_dr(&channel, ch).unwrap()
+                    })
+                    .collect()
+            };
+
+            for segment_windows in [1usize, 3, 7] {
+                let parallel = calc.calculate_dr_parallel_segments(
+                    &samples,
+                    channel_count,
+                    segment_windows * 3004,
+                );
+                assert_eq!(
+                    parallel, serial,
+                    "channels={channel_count}, segment_windows={segment_windows}"
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn test_parallel_channels_match_serial() {
+        // 按声道扇出与串行跨步/转置/6声道混合内核逐位一致
+        let sample_rate = 1000;
+        let frames = 3004 * 3 + 123;
+
+        for channel_count in [3usize, 6, 8, 12] {
+            let calc = DrCalculator::new_with_config(channel_count, sample_rate).unwrap();
+            let samples: Vec<f32> = (0..frames * channel_count)
+                .map(|i| {
+                    let ch = (i % channel_count) as f32;
+                    let t = (i / channel_count) as f32;
+                    (t * 0.07 * (ch + 1.0)).sin() * (0.1 + 0.8 * (t * 0.0005).cos().abs())
+                })
+                .collect();
+
+            assert_eq!(
+                calc.calculate_dr_parallel_channels(&samples, channel_count),
+                calc.calculate_dr_strided(&samples, channel_count).unwrap(),
+                "channels={channel_count}"
+            );
+        }
+
+        let calc = DrCalculator::new_with_config(6, sample_rate).unwrap();
+        assert!(!calc.parallel_channel_fanout(3003, 6));
+        assert!(!calc.parallel_channel_fanout(3004 * 4, 2));
+        assert_eq!(
+            calc.parallel_channel_fanout(3004 * 4, 6),
+            rayon::current_num_threads() >= 2
+        );
+    }
+
+    #[test]
+    fn test_parallel_segment_frames_threshold() {
+        let calc = DrCalculator::new_with_config(2, 1000).unwrap();
+        // 窗口数不足时走串行路径
+        assert_eq!(calc.parallel_segment_frames(3004 * 3), None);
+
+        if rayon::current_num_threads() >= 2 {
+            let segment_frames = calc.parallel_segment_frames(3004 * 64).unwrap();
+            assert!(segment_frames.is_multiple_of(3004));
+        }
+    }
+
     #[test]
     fn test_silent_input_dr_zero() {
         // 验证静音输入（全0）的DR归零策略
@@ -0,0 +1,399 @@
+//! 推送式增量DR分析会话
+//!
+//! 面向嵌入场景（播放器、转码器等已持有解码后PCM的宿主）：
+//! 调用方按任意块大小推送样本，会话内部直接复用每声道的 `WindowRmsAnalyzer`
+//! 窗口状态，无需中间缓冲或整轨驻留内存，DR 作为既有解码流程的副产物得到。
+//!
+//! 结果计算与流式引擎（`analyze_file` / `process_streaming_decoder`）逐位一致：
+//! 每个声道看到的样本序列相同，3秒窗口边界、尾窗与虚拟零窗逻辑完全相同。
+
+use crate::core::SilenceFilterConfig;
+use crate::core::dr_calculator::DrResult;
+use crate::core::histogram::WindowRmsAnalyzer;
+use crate::core::peak_selection::{PeakSelectionStrategy, PeakSelector};
+use crate::error::{AudioError, AudioResult};
+use crate::tools::constants::format_constraints;
+
+/// 参与DR分析所需的最少帧数（与流式引擎一致）
+const MINIMUM_FRAMES_FOR_ANALYSIS: u64 = 2;
+
+/// 16位整数PCM归一化系数（2^15）
+const I16_SCALE: f32 = 1.0 / 32768.0;
+/// 24位整数PCM归一化系数（2^23）
+const I24_SCALE: f64 = 1.0 / 8388608.0;
+/// 32位整数PCM归一化系数（2^31）
+const I32_SCALE: f64 = 1.0 / 2147483648.0;
+
+/// 推送式增量DR分析会话
+///
+/// # 示例
+///
+/// ```rust
+/// use macinmeter_dr_tool::core::DrSession;
+///
+/// let mut session = DrSession::new(44100, 2).unwrap();
+/// let block: Vec<f32> = (0..88200).map(|i| ((i as f32) * 0.01).sin() * 0.5).collect();
+/// session.push_interleaved(&block).unwrap();
+///
+/// // 中途快照不影响后续推送
+/// let _partial = session.snapshot().unwrap();
+///
+/// session.push_interleaved(&block).unwrap();
+/// let results = session.finish().unwrap();
+/// assert_eq!(results.len(), 2);
+/// ```
+#[derive(Debug, Clone)]
+pub struct DrSession {
+    /// 采样率（Hz）
+    sample_rate: u32,
+    /// 声道数
+    channels: usize,
+    /// 每声道独立的窗口分析器（流式状态核心）
+    analyzers: Vec<WindowRmsAnalyzer>,
+    /// 已推送的帧数（每帧包含所有声道样本）
+    frames_pushed: u64,
+}
+
+impl DrSession {
+    /// 创建分析会话（foobar2000兼容默认配置）
+    ///
+    /// # 参数
+    ///
+    /// * `sample_rate` - 采样率（Hz），决定3秒窗口长度
+    /// * `channels` - 声道数（1..=MAX_CHANNELS）
+    pub fn new(sample_rate: u32, channels: usize) -> AudioResult<Self> {
+        Self::with_silence_filter(sample_rate, channels, SilenceFilterConfig::disabled())
+    }
+
+    /// 创建带静音过滤配置的分析会话（实验性）
+    ///
+    /// 启用静音过滤会打破与foobar2000 DR Meter的兼容性。
+    pub fn with_silence_filter(
+        sample_rate: u32,
+        channels: usize,
+        silence_filter: SilenceFilterConfig,
+    ) -> AudioResult<Self> {
+        if channels == 0 {
+            return Err(AudioError::InvalidInput(
+                "Channel count must be greater than zero / 声道数量必须大于0".to_string(),
+            ));
+        }
+
+        if channels > format_constraints::MAX_CHANNELS as usize {
+            return Err(AudioError::InvalidInput(format!(
+                "Channel count cannot exceed {} / 声道数量不能超过{}",
+                format_constraints::MAX_CHANNELS,
+                format_constraints::MAX_CHANNELS
+            )));
+        }
+
+        if sample_rate == 0 {
+            return Err(AudioError::InvalidInput(
+                "Sample rate must be greater than zero / 采样率必须大于0".to_string(),
+            ));
+        }
+
+        let analyzers = (0..channels)
+            .map(|_| WindowRmsAnalyzer::with_silence_filter(sample_rate, false, silence_filter))
+            .collect();
+
+        Ok(Self {
+            sample_rate,
+            channels,
+            analyzers,
+            frames_pushed: 0,
+        })
+    }
+
+    /// 采样率（Hz）
+    pub fn sample_rate(&self) -> u32 {
+        self.sample_rate
+    }
+
+    /// 声道数
+    pub fn channels(&self) -> usize {
+        self.channels
+    }
+
+    /// 已推送的帧数
+    pub fn frames_pushed(&self) -> u64 {
+        self.frames_pushed
+    }
+
+    /// 推送交错f32样本（L0,R0,L1,R1,...）
+    ///
+    /// 长度必须为声道数整数倍；各声道直接以跨步方式送入分析器，零拷贝。
+    pub fn push_interleaved(&mut self, samples: &[f32]) -> AudioResult<()> {
+        let frames = self.check_interleaved_len(samples.len())?;
+
+        if self.channels == 1 {
+            self.analyzers[0].process_samples_streaming(samples);
+        } else {
+            for (channel_idx, analyzer) in self.analyzers.iter_mut().enumerate() {
+                analyzer.process_samples_strided(samples, channel_idx, self.channels);
+            }
+        }
+
+        self.frames_pushed += frames as u64;
+        Ok(())
+    }
+
+    /// 推送平面f32样本（每声道一个切片）
+    ///
+    /// 切片数量必须等于声道数，且各声道长度一致。
+    pub fn push_planar(&mut self, planes: &[&[f32]]) -> AudioResult<()> {
+        if planes.len() != self.channels {
+            return Err(AudioError::InvalidInput(format!(
+                "Plane count mismatch: expected {expected}, got {actual} / 平面数量不匹配：期望{expected}，实际{actual}",
+                expected = self.channels,
+                actual = planes.len()
+            )));
+        }
+
+        let frames = planes[0].len();
+        if planes.iter().any(|plane| plane.len() != frames) {
+            return Err(AudioError::InvalidInput(
+                "All planes must have the same length / 各声道平面长度必须一致".to_string(),
+            ));
+        }
+
+        for (analyzer, plane) in self.analyzers.iter_mut().zip(planes) {
+            analyzer.process_samples_streaming(plane);
+        }
+
+        self.frames_pushed += frames as u64;
+        Ok(())
+    }
+
+    /// 推送交错16位整数PCM样本（按 1/32768 归一化）
+    pub fn push_i16_interleaved(&mut self, samples: &[i16]) -> AudioResult<()> {
+        self.push_converted_interleaved(samples, |s| s as f32 * I16_SCALE)
+    }
+
+    /// 推送交错24位整数PCM样本（低24位有效，存放于i32，按 1/2^23 归一化）
+    pub fn push_i24_interleaved(&mut self, samples: &[i32]) -> AudioResult<()> {
+        self.push_converted_interleaved(samples, |s| (s as f64 * I24_SCALE) as f32)
+    }
+
+    /// 推送交错32位整数PCM样本（按 1/2^31 归一化）
+    pub fn push_i32_interleaved(&mut self, samples: &[i32]) -> AudioResult<()> {
+        self.push_converted_interleaved(samples, |s| (s as f64 * I32_SCALE) as f32)
+    }
+
+    /// 获取当前结果快照（不影响后续推送）
+    ///
+    /// 快照会克隆分析器状态并结算未满窗口，代价与已完成窗口数成正比。
+    pub fn snapshot(&self) -> AudioResult<Vec<DrResult>> {
+        let mut analyzers = self.analyzers.clone();
+        for analyzer in &mut analyzers {
+            analyzer.finalize_tail_window();
+        }
+        self.build_results(&analyzers)
+    }
+
+    /// 检查是否已推送足够样本以输出结果（`snapshot`/`finish` 失败的唯一原因）
+    ///
+    /// 调用方可在 `finish` 消耗会话前确认其会成功，失败时会话仍可继续推送。
+    pub fn check_ready(&self) -> AudioResult<()> {
+        if self.frames_pushed < MINIMUM_FRAMES_FOR_ANALYSIS {
+            return Err(AudioError::InvalidInput(format!(
+                "Too few samples for reliable DR analysis: required {MINIMUM_FRAMES_FOR_ANALYSIS}, got {} / 样本数过少，无法进行可靠的DR分析",
+                self.frames_pushed
+            )));
+        }
+        Ok(())
+    }
+
+    /// 结束会话并返回最终DR结果（就地结算，不克隆窗口状态）
+    pub fn finish(mut self) -> AudioResult<Vec<DrResult>> {
+        for analyzer in &mut self.analyzers {
+            analyzer.finalize_tail_window();
+        }
+        self.build_results(&self.analyzers)
+    }
+
+    /// 逐帧转换整数样本并直接送入分析器（无中间缓冲）
+    fn push_converted_interleaved<T: Copy>(
+        &mut self,
+        samples: &[T],
+        convert: impl Fn(T) -> f32,
+    ) -> AudioResult<()> {
+        let frames = self.check_interleaved_len(samples.len())?;
+
+        for frame in samples.chunks_exact(self.channels) {
+            for (analyzer, &sample) in self.analyzers.iter_mut().zip(frame) {
+                analyzer.process_single_sample(convert(sample));
+            }
+        }
+
+        self.frames_pushed += frames as u64;
+        Ok(())
+    }
+
+    /// 校验交错样本长度并返回帧数
+    fn check_interleaved_len(&self, len: usize) -> AudioResult<usize> {
+        if !len.is_multiple_of(self.channels) {
+            return Err(AudioError::InvalidInput(
+                "Sample count must be an integer multiple of channel count / 样本数量必须是声道数的整数倍"
+                    .to_string(),
+            ));
+        }
+        Ok(len / self.channels)
+    }
+
+    /// 从已结算的分析器构造DR结果（与流式引擎相同的峰值策略与公式）
+    fn build_results(&self, analyzers: &[WindowRmsAnalyzer]) -> AudioResult<Vec<DrResult>> {
+        self.check_ready()?;
+
+        let peak_strategy = PeakSelectionStrategy::default();
+
+        Ok(analyzers
+            .iter()
+            .enumerate()
+            .map(|(channel_idx, analyzer)| {
+                let rms_20_percent = analyzer.calculate_20_percent_rms();
+                let window_primary_peak = analyzer.get_largest_peak();
+                let window_secondary_peak = analyzer.get_second_largest_peak();
+                let peak_for_dr =
+                    peak_strategy.select_peak(window_primary_peak, window_secondary_peak);
+
+                // DR = -20 * log10(RMS / Peak)
+                let dr_value = if peak_for_dr > 0.0 && rms_20_percent > 0.0 {
+                    -20.0 * (rms_20_percent / peak_for_dr).log10()
+                } else {
+                    0.0
+                };
+
+                DrResult::new_with_peaks(
+                    channel_idx,
+                    dr_value,
+                    rms_20_percent,
+                    peak_for_dr,
+                    window_primary_peak,
+                    window_secondary_peak,
+                    self.frames_pushed as usize,
+                )
+            })
+            .collect())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn test_signal(frames: usize, channels: usize) -> Vec<f32> {
+        (0..frames * channels)
+            .map(|i| {
+                let ch = i % channels;
+                let t = (i / channels) as f32;
+                ((t * 0.003 * (ch + 1) as f32).sin() * 0.6) * (1.0 + (t * 0.00001).sin()) * 0.5
+            })
+            .collect()
+    }
+
+    fn reference_results(samples: &[f32], channels: usize) -> Vec<DrResult> {
+        // 参考实现：每声道一次性 process_samples（流式引擎的等价序列）
+        let frames = samples.len() / channels;
+        let mut session = DrSession::new(44100, channels).unwrap();
+        let mut analyzers = Vec::new();
+        for ch in 0..channels {
+            let channel: Vec<f32> = samples.iter().skip(ch).step_by(channels).copied().collect();
+            let mut analyzer = WindowRmsAnalyzer::new(44100, false);
+            analyzer.process_samples(&channel);
+            analyzers.push(analyzer);
+        }
+        session.frames_pushed = frames as u64;
+        session.build_results(&analyzers).unwrap()
+    }
+
+    fn assert_same(a: &[DrResult], b: &[DrResult]) {
+        assert_eq!(a.len(), b.len());
+        for (x, y) in a.iter().zip(b) {
+            assert_eq!(x.dr_value, y.dr_value);
+            assert_eq!(x.rms, y.rms);
+            assert_eq!(x.peak, y.peak);
+            assert_eq!(x.sample_count, y.sample_count);
+        }
+    }
+
+    #[test]
+    fn test_new_rejects_invalid_params() {
+        assert!(DrSession::new(44100, 0).is_err());
+        assert!(DrSession::new(0, 2).is_err());
+        assert!(DrSession::new(44100, 33).is_err());
+    }
+
+    #[test]
+    fn test_interleaved_chunks_match_reference() {
+        for channels in [1usize, 2, 6] {
+            let samples = test_signal(300_000, channels);
+            let mut session = DrSession::new(44100, channels).unwrap();
+            for chunk in samples.chunks(1001 * channels) {
+                session.push_interleaved(chunk).unwrap();
+            }
+            assert_eq!(session.frames_pushed(), 300_000);
+            assert_same(
+                &session.finish().unwrap(),
+                &reference_results(&samples, channels),
+            );
+        }
+    }
+
+    #[test]
+    fn test_planar_matches_interleaved() {
+        let samples = test_signal(200_000, 2);
+        let left: Vec<f32> = samples.iter().step_by(2).copied().collect();
+        let right: Vec<f32> = samples.iter().skip(1).step_by(2).copied().collect();
+
+        let mut planar = DrSession::new(44100, 2).unwrap();
+        for (l, r) in left.chunks(777).zip(right.chunks(777)) {
+            planar.push_planar(&[l, r]).unwrap();
+        }
+
+        let mut interleaved = DrSession::new(44100, 2).unwrap();
+        interleaved.push_interleaved(&samples).unwrap();
+
+        assert_same(&planar.finish().unwrap(), &interleaved.finish().unwrap());
+    }
+
+    #[test]
+    fn test_snapshot_does_not_disturb_state() {
+        let samples = test_signal(300_000, 2);
+        let (head, tail) = samples.split_at(150_001 * 2);
+
+        let mut session = DrSession::new(44100, 2).unwrap();
+        session.push_interleaved(head).unwrap();
+        let snapshot = session.snapshot().unwrap();
+        assert_eq!(snapshot[0].sample_count, 150_001);
+        session.push_interleaved(tail).unwrap();
+
+        assert_same(&session.finish().unwrap(), &reference_results(&samples, 2));
+    }
+
+    #[test]
+    fn test_i16_push_matches_float() {
+        let ints: Vec<i16> = (0..100_000)
+            .map(|i| (((i as f32) * 0.01).sin() * 20000.0) as i16)
+            .collect();
+        let floats: Vec<f32> = ints.iter().map(|&s| s as f32 / 32768.0).collect();
+
+        let mut a = DrSession::new(48000, 2).unwrap();
+        a.push_i16_interleaved(&ints).unwrap();
+        let mut b = DrSession::new(48000, 2).unwrap();
+        b.push_interleaved(&floats).unwrap();
+
+        assert_same(&a.finish().unwrap(), &b.finish().unwrap());
+    }
+
+    #[test]
+    fn test_invalid_pushes_are_rejected() {
+        let mut session = DrSession::new(44100, 2).unwrap();
+        assert!(session.push_interleaved(&[0.1, 0.2, 0.3]).is_err());
+        assert!(session.push_planar(&[&[0.1][..]]).is_err());
+        assert!(session.push_planar(&[&[0.1, 0.2][..], &[0.1][..]]).is_err());
+        // 未推送足够样本时拒绝输出结果
+        assert!(session.check_ready().is_err());
+        assert!(session.snapshot().is_err());
+    }
+}
@@ -10,7 +10,9 @@
 //! - **精确峰值选择**: 主峰/次峰智能切换机制
 //! - **SIMD优化**: 平方和计算使用SSE2并行加速
 //! - **实验性静音过滤**: 窗口级静音检测与过滤（可选）
+//! - **削波统计（可选）**: 启用时逐样本内核顺带统计削波样本与连续削波段（见 [`clipping`](super::clipping)）
 
+use super::clipping::{ClipStats, ClipTracker, WindowClipping};
 use crate::tools::constants::dr_analysis::PEAK_EQUALITY_EPSILON;
 
 /// 窗口级静音过滤配置（实验性功能）
@@ -93,7 +95,7 @@ impl SilenceFilterConfig {
     /// - `true`: 窗口RMS低于阈值，应该被过滤
     /// - `false`: 窗口RMS高于阈值，应该保留
     #[inline]
-    fn should_filter(&self, window_rms: f64) -> bool {
+    pub(crate) fn should_filter(&self, window_rms: f64) -> bool {
         if !self.enabled {
             return false;
         }
@@ -107,6 +109,52 @@ impl SilenceFilterConfig {
     }
 }
 
+/// 窗口静音判定门限：由 [`SilenceFilterConfig`] 预先换算的线性能量阈值
+///
+/// `should_filter` 的 `20·log10(rms) < threshold_db` 随窗口均方能量（`2·sumSq/n`，
+/// 即 rms²）单调变化。构造时在非负f64的位模式上二分一次求出判定边界，
+/// 窗口结算时只需一次能量比较，不再逐窗口开方、取对数，判定结果与 `should_filter` 逐位一致。
+#[derive(Debug, Clone, Copy)]
+pub(crate) struct SilenceGate {
+    /// 是否可能过滤任何窗口（未启用或阈值低于 -240 dB 下限时为 false）
+    active: bool,
+    /// 均方能量低于此值的窗口被过滤
+    min_energy: f64,
+}
+
+impl SilenceGate {
+    pub(crate) fn new(config: &SilenceFilterConfig) -> Self {
+        let filtered = |energy: f64| config.should_filter(energy.sqrt());
+        if !filtered(0.0) {
+            return Self {
+                active: false,
+                min_energy: 0.0,
+            };
+        }
+
+        // 二分不变量：lo 处被过滤、hi 处不被过滤（非负f64的位模式与数值同序；+∞ 的 dB 值不小于任何阈值）
+        let (mut lo, mut hi) = (0u64, f64::INFINITY.to_bits());
+        while hi - lo > 1 {
+            let mid = lo + (hi - lo) / 2;
+            if filtered(f64::from_bits(mid)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        Self {
+            active: true,
+            min_energy: f64::from_bits(hi),
+        }
+    }
+
+    /// 窗口均方能量是否低于静音阈值（NaN 与 `should_filter` 一致按最小电平处理）
+    #[inline(always)]
+    pub(crate) fn is_silent(&self, mean_energy: f64) -> bool {
+        self.active & (mean_energy.is_nan() | (mean_energy < self.min_energy))
+    }
+}
+
 /// WindowRmsAnalyzer - 基于master分支的正确20%采样算法
 ///
 /// 这是从master分支移植的正确算法实现，使用窗口RMS值的20%采样
@@ -136,9 +184,17 @@ pub struct WindowRmsAnalyzer {
     /// **流式双峰跟踪**: 当前窗口的次大Peak值（用于尾窗Peak调整）
     current_second_peak: f64,
     /// 实验性：静音过滤配置
-    silence_filter: SilenceFilterConfig,
+    silence_gate: SilenceGate,
     /// 实验性：被过滤的窗口数量（仅在启用静音过滤时有效）
     filtered_windows_count: usize,
+    /// 被过滤窗口在全部窗口序列（含被过滤窗口）中的位置，按时间顺序
+    filtered_window_indices: Vec<usize>,
+    /// 是否统计削波（关闭时逐样本内核不含削波分支）
+    clip_tracking: bool,
+    /// 削波统计（样本级 + 当前窗口）
+    clipping: ClipTracker,
+    /// 已结算窗口的削波统计（与 `window_peaks` 一一对应）
+    window_clipping: Vec<WindowClipping>,
 }
 
 #[derive(Debug, Clone)]
@@ -166,7 +222,7 @@ impl WindowRmsAnalyzer {
     /// - 44.1 kHz: 132,480样本（3.00408秒）
     /// - 48 kHz: 144,195样本（3.00406秒）
     /// - 96 kHz: 288,391样本（3.00407秒）
-    fn calculate_standard_window_size(sample_rate: u32) -> usize {
+    pub(crate) fn calculate_standard_window_size(sample_rate: u32) -> usize {
         use crate::tools::constants::dr_analysis::WINDOW_DURATION_COEFFICIENT;
         (sample_rate as f64 * WINDOW_DURATION_COEFFICIENT).floor() as usize
     }
@@ -208,14 +264,34 @@ impl WindowRmsAnalyzer {
             last_sample: 0.0,
             current_peak_count: 0,
             current_second_peak: 0.0,
-            silence_filter,
+            silence_gate: SilenceGate::new(&silence_filter),
             filtered_windows_count: 0,
+            filtered_window_indices: Vec::new(),
+            clip_tracking: false,
+            clipping: ClipTracker::default(),
+            window_clipping: Vec::new(),
         }
     }
 
+    /// 启用/关闭削波统计（默认关闭）
+    ///
+    /// 逐样本内核按该开关单态化：关闭时不含削波比较与状态更新，
+    /// [`clip_stats`](Self::clip_stats) 与 [`window_clipping`](Self::window_clipping) 保持为空。
+    pub fn with_clip_tracking(mut self, enabled: bool) -> Self {
+        self.clip_tracking = enabled;
+        self
+    }
+
+    /// 是否统计削波
+    pub fn clip_tracking(&self) -> bool {
+        self.clip_tracking
+    }
+
     /// 处理单声道样本，按3秒窗口计算RMS并填入直方图
+    ///
+    /// `TRACK_CLIPS` 由公开入口按 `clip_tracking` 一次性分派，每个调用只做一次判断。
     #[inline(always)]
-    fn process_one_sample(&mut self, sample_f64: f64) {
+    fn process_one_sample<const TRACK_CLIPS: bool>(&mut self, sample_f64: f64) {
         let abs_sample = sample_f64.abs();
 
         // **dr14兼容性**: 保存当前样本作为潜在的"最后样本"。当前已不以dr14为兼容目标。
@@ -238,6 +314,10 @@ impl WindowRmsAnalyzer {
             self.current_second_peak = abs_sample;
         }
 
+        if TRACK_CLIPS {
+            self.clipping.push(abs_sample);
+        }
+
         // 更新当前窗口的平方和
         self.current_sum_sq += sample_f64 * sample_f64;
         self.current_count += 1;
@@ -246,18 +326,21 @@ impl WindowRmsAnalyzer {
         if self.current_count >= self.window_len {
             // foobar2000 RMS公式：RMS = sqrt(2 * sumSq / window_len)
             // 2.0乘数是foobar2000的实际行为（虽然逆向文档第2节未明确标注）
-            let window_rms = (2.0 * self.current_sum_sq / self.current_count as f64).sqrt();
+            let mean_energy = 2.0 * self.current_sum_sq / self.current_count as f64;
+            let window_clipping = TRACK_CLIPS.then(|| self.clipping.take_window());
 
-            // 实验性功能：应用静音过滤
-            if self.silence_filter.should_filter(window_rms) {
+            // 实验性功能：应用静音过滤（能量直接与预换算阈值比较）
+            if self.silence_gate.is_silent(mean_energy) {
                 // 窗口RMS低于阈值，过滤此窗口
-                self.filtered_windows_count += 1;
+                self.record_filtered_window();
             } else {
                 // 窗口RMS高于阈值，正常处理
+                let window_rms = mean_energy.sqrt();
                 self.histogram.add_window_rms(window_rms);
 
                 // 记录窗口Peak值用于后续排序
                 self.window_peaks.push(self.current_peak);
+                self.window_clipping.extend(window_clipping);
 
                 // **关键修复**: 直接存储RMS值避免量化损失
                 self.window_rms_values.push(window_rms);
@@ -274,46 +357,90 @@ impl WindowRmsAnalyzer {
 
     #[inline(always)]
     pub fn process_block4(&mut self, block: &[f32; 4]) {
+        if self.clip_tracking {
+            self.process_block4_impl::<true>(block);
+        } else {
+            self.process_block4_impl::<false>(block);
+        }
+    }
+
+    #[inline(always)]
+    fn process_block4_impl<const TRACK_CLIPS: bool>(&mut self, block: &[f32; 4]) {
         for &sample in block {
-            self.process_one_sample(sample as f64);
+            self.process_one_sample::<TRACK_CLIPS>(sample as f64);
         }
     }
 
     #[inline(always)]
     pub fn process_single_sample(&mut self, sample: f32) {
-        self.process_one_sample(sample as f64);
+        if self.clip_tracking {
+            self.process_one_sample::<true>(sample as f64);
+        } else {
+            self.process_one_sample::<false>(sample as f64);
+        }
     }
 
     pub fn process_samples(&mut self, samples: &[f32]) {
+        self.process_samples_streaming(samples);
+
+        // 处理不足一个窗口的剩余样本（尾窗）
+        self.finalize_tail_window();
+    }
+
+    /// 流式处理单声道样本（不结算尾窗）
+    ///
+    /// 与 `process_samples` 的区别在于调用结束后保留未满窗口的累积状态，
+    /// 可跨任意长度的 chunk 连续调用；全部样本送入后须调用一次
+    /// [`finalize_tail_window`](Self::finalize_tail_window) 结算尾窗。
+    /// 多次调用的结果与一次性 `process_samples` 完全一致。
+    pub fn process_samples_streaming(&mut self, samples: &[f32]) {
         // **长曲目优化**: 首次调用时预估窗口数，减少realloc
         if self.total_samples_processed == 0 && !samples.is_empty() {
             let estimated_windows = samples.len() / self.window_len + 1;
             self.window_rms_values.reserve(estimated_windows);
             self.window_peaks.reserve(estimated_windows);
+            if self.clip_tracking {
+                self.window_clipping.reserve(estimated_windows);
+            }
         }
 
+        if self.clip_tracking {
+            self.process_samples_impl::<true>(samples);
+        } else {
+            self.process_samples_impl::<false>(samples);
+        }
+    }
+
+    fn process_samples_impl<const TRACK_CLIPS: bool>(&mut self, samples: &[f32]) {
         for &sample in samples {
-            self.process_one_sample(sample as f64);
+            self.process_one_sample::<TRACK_CLIPS>(sample as f64);
         }
+    }
 
-        // 处理不足一个窗口的剩余样本（尾窗）
+    /// 结算不足一个窗口的剩余样本（尾窗）
+    ///
+    /// foobar2000尾窗处理：使用所有样本（分母取filled），尾窗只有1个样本时完全跳过。
+    /// 无未满窗口时为空操作，可安全重复调用。
+    pub fn finalize_tail_window(&mut self) {
         if self.current_count > 0 {
-            // foobar2000尾窗处理：使用所有样本（分母取filled）
             // RMS公式：RMS = sqrt(2 * sumSq / filled)
             if self.current_count > 1 {
-                let window_rms = (2.0 * self.current_sum_sq / self.current_count as f64).sqrt();
+                let mean_energy = 2.0 * self.current_sum_sq / self.current_count as f64;
+                let window_clipping = self.clip_tracking.then(|| self.clipping.take_window());
 
                 // 实验性功能：应用静音过滤
-                if self.silence_filter.should_filter(window_rms) {
+                if self.silence_gate.is_silent(mean_energy) {
                     // 尾窗RMS低于阈值，过滤此窗口
-                    self.filtered_windows_count += 1;
+                    self.record_filtered_window();
                 } else {
                     // 尾窗RMS高于阈值，正常处理
+                    let window_rms = mean_energy.sqrt();
                     self.histogram.add_window_rms(window_rms);
                     self.window_rms_values.push(window_rms);
 
                     // foobar2000尾窗Peak处理：使用所有样本的Peak值
                     self.window_peaks.push(self.current_peak);
+                    self.window_clipping.extend(window_clipping);
                 }
             } else {
                 // 尾窗只有1个样本时会完全跳过
@@ -381,26 +508,42 @@ impl WindowRmsAnalyzer {
             let estimated_windows = samples_this_channel / self.window_len + 1;
             self.window_rms_values.reserve(estimated_windows);
             self.window_peaks.reserve(estimated_windows);
+            if self.clip_tracking {
+                self.window_clipping.reserve(estimated_windows);
+            }
+        }
+
+        if self.clip_tracking {
+            self.process_strided_impl::<true>(interleaved_samples, channel_idx, channel_count);
+        } else {
+            self.process_strided_impl::<false>(interleaved_samples, channel_idx, channel_count);
         }
 
+        // 处理尾窗（与 process_samples 相同逻辑）
+        // 注意：这里不处理尾窗，因为可能还有更多chunk要处理
+        // 尾窗处理在所有chunk处理完后，由调用者通过后续调用或finalize触发
+    }
+
+    fn process_strided_impl<const TRACK_CLIPS: bool>(
+        &mut self,
+        interleaved_samples: &[f32],
+        channel_idx: usize,
+        channel_count: usize,
+    ) {
         // 单次遍历：使用chunks_exact直接取目标声道样本
         let mut chunks = interleaved_samples.chunks_exact(channel_count);
 
         for frame in &mut chunks {
             let sample = frame[channel_idx];
-            self.process_one_sample(sample as f64);
+            self.process_one_sample::<TRACK_CLIPS>(sample as f64);
         }
 
         // 处理不完整的尾帧
         let remainder = chunks.remainder();
         if channel_idx < remainder.len() {
             let sample = remainder[channel_idx];
-            self.process_one_sample(sample as f64);
+            self.process_one_sample::<TRACK_CLIPS>(sample as f64);
         }
-
-        // 处理尾窗（与 process_samples 相同逻辑）
-        // 注意：这里不处理尾窗，因为可能还有更多chunk要处理
-        // 尾窗处理在所有chunk处理完后，由调用者通过后续调用或finalize触发
     }
 
     /// 计算"最响20%窗口"的加权RMS值
@@ -541,6 +684,81 @@ impl WindowRmsAnalyzer {
         second
     }
 
+    /// 3秒窗口长度（样本数）
+    pub fn window_len(&self) -> usize {
+        self.window_len
+    }
+
+    /// 已结算窗口的精确RMS值（按时间顺序，不含被静音过滤的窗口）
+    pub fn window_rms_values(&self) -> &[f64] {
+        &self.window_rms_values
+    }
+
+    /// 已结算窗口的Peak值（与 [`window_rms_values`](Self::window_rms_values) 一一对应）
+    pub fn window_peaks(&self) -> &[f64] {
+        &self.window_peaks
+    }
+
+    /// 削波统计（含未满窗口中的样本）
+    pub fn clip_stats(&self) -> ClipStats {
+        self.clipping.stats()
+    }
+
+    /// 已结算窗口的削波统计（与 [`window_peaks`](Self::window_peaks) 一一对应）
+    pub fn window_clipping(&self) -> &[WindowClipping] {
+        &self.window_clipping
+    }
+
+    /// 按时间顺序拼接后续分段的分析状态
+    ///
+    /// 用于窗口对齐的并行分段计算：各分段从窗口边界开始独立处理，
+    /// 每个窗口的平方和都从0累积，因此窗口RMS/Peak与串行处理逐位一致；
+    /// 拼接后窗口序列、直方图计数、样本总数（虚拟零窗判定）均与串行结果相同。
+    ///
+    /// 前置条件：`self` 恰好结束在窗口边界（无未满窗口），且两者窗口长度相同。
+    pub fn append_segment(&mut self, mut next: WindowRmsAnalyzer) {
+        debug_assert_eq!(
+            self.current_count, 0,
+            "segment must end on a window boundary / 分段必须结束于窗口边界"
+        );
+        debug_assert_eq!(self.window_len, next.window_len);
+
+        let window_offset = self.window_rms_values.len() + self.filtered_windows_count;
+        self.filtered_window_indices.extend(
+            next.filtered_window_indices
+                .iter()
+                .map(|index| index + window_offset),
+        );
+        self.histogram.merge(&next.histogram);
+        self.window_peaks.extend_from_slice(&next.window_peaks);
+        self.window_rms_values
+            .extend_from_slice(&next.window_rms_values);
+        self.total_samples_processed += next.total_samples_processed;
+        self.filtered_windows_count += next.filtered_windows_count;
+
+        // 跨分段边界的削波段合并，计数修正计入后续分段的第一个窗口
+        let run_correction = self.clipping.append(&next.clipping);
+        match next.window_clipping.first_mut() {
+            Some(first) => first.apply_run_correction(run_correction),
+            None => self
+                .clipping
+                .window_mut()
+                .apply_run_correction(run_correction),
+        }
+        self.window_clipping
+            .extend_from_slice(&next.window_clipping);
+
+        // 未满窗口状态由后续分段继承
+        self.current_sum_sq = next.current_sum_sq;
+        self.current_peak = next.current_peak;
+        self.current_count = next.current_count;
+        self.current_peak_count = next.current_peak_count;
+        self.current_second_peak = next.current_second_peak;
+        if next.total_samples_processed > 0 {
+            self.last_sample = next.last_sample;
+        }
+    }
+
     /// 获取被过滤的窗口数量（仅在启用静音过滤时有意义）
     ///
     /// # 返回值
@@ -550,6 +768,18 @@ impl WindowRmsAnalyzer {
         self.filtered_windows_count
     }
 
+    /// 被过滤窗口在全部窗口序列（含被过滤窗口）中的位置，按时间顺序
+    pub fn filtered_window_indices(&self) -> &[usize] {
+        &self.filtered_window_indices
+    }
+
+    /// 记录一个被静音过滤的窗口（位置 = 此前已结算的全部窗口数）
+    fn record_filtered_window(&mut self) {
+        self.filtered_window_indices
+            .push(self.window_rms_values.len() + self.filtered_windows_count);
+        self.filtered_windows_count += 1;
+    }
+
     /// 获取总窗口数（包括被过滤的窗口）
     ///
     /// # 返回值
@@ -575,7 +805,24 @@ impl WindowRmsAnalyzer {
         self.current_peak_count = 0;
         self.current_second_peak = 0.0;
         self.filtered_windows_count = 0;
+        self.filtered_window_indices.clear();
+        self.clipping = ClipTracker::default();
+        self.window_clipping.clear();
+    }
+}
+
+/// 直方图最大bin索引（10001个bin：0-10000）
+pub(crate) const HISTOGRAM_MAX_BIN: usize = 10000;
+
+/// 窗口RMS的foobar2000直方图量化：bin = clamp(int(10000 * rms), 0, 10000)
+///
+/// int操作等价于floor（对于正数）；负值或非有限值返回 `None`（忽略该窗口）。
+#[inline]
+pub(crate) fn quantize_window_rms(window_rms: f64) -> Option<usize> {
+    if window_rms < 0.0 || !window_rms.is_finite() {
+        return None;
     }
+    Some(((10000.0 * window_rms) as i32).clamp(0, HISTOGRAM_MAX_BIN as i32) as usize)
 }
 
 impl DrHistogram {
@@ -596,18 +843,22 @@ impl DrHistogram {
     /// 反汇编代码确认：`v48 = (int)(v47 * 10000.0);`
     /// 注意：使用int(截断)而非round，确保与foobar2000精确一致。
     fn add_window_rms(&mut self, window_rms: f64) {
-        if window_rms < 0.0 || !window_rms.is_finite() {
+        let Some(bin) = quantize_window_rms(window_rms) else {
             return; // 忽略无效窗口
-        }
-
-        // foobar2000量化公式：bin = clamp(int(10000 * rms), 0, 10000)
-        // int操作等价于floor（对于正数）
-        let bin = ((10000.0 * window_rms) as i32).clamp(0, 10000) as usize;
+        };
 
         self.bins[bin] += 1;
         self.total_windows += 1;
     }
 
+    /// 合并另一直方图的计数（bin计数满足交换律，合并结果与顺序无关）
+    fn merge(&mut self, other: &DrHistogram) {
+        for (bin, &count) in self.bins.iter_mut().zip(&other.bins) {
+            *bin += count;
+        }
+        self.total_windows += other.total_windows;
+    }
+
     /// 清空直方图
     fn clear(&mut self) {
         self.bins.fill(0);
@@ -762,6 +1013,117 @@ mod tests {
         assert_eq!(analyzer.window_peaks.len(), 1);
     }
 
+    #[test]
+    fn test_process_samples_streaming_matches_single_call() {
+        // 任意切分的流式输入 + 尾窗结算 应与一次性处理完全一致
+        let samples: Vec<f32> = (0..300_001)
+            .map(|i| ((i as f32) * 0.001).sin() * 0.7)
+            .collect();
+
+        let mut reference = WindowRmsAnalyzer::new(44100, false);
+        reference.process_samples(&samples);
+
+        let mut streaming = WindowRmsAnalyzer::new(44100, false);
+        for chunk in samples.chunks(4097) {
+            streaming.process_samples_streaming(chunk);
+        }
+        streaming.finalize_tail_window();
+        // 重复结算应为空操作
+        streaming.finalize_tail_window();
+
+        assert_eq!(streaming.window_rms_values, reference.window_rms_values);
+        assert_eq!(streaming.window_peaks, reference.window_peaks);
+        assert_eq!(
+            streaming.calculate_20_percent_rms(),
+            reference.calculate_20_percent_rms()
+        );
+        assert_eq!(streaming.get_largest_peak(), reference.get_largest_peak());
+        assert_eq!(
+            streaming.get_second_largest_peak(),
+            reference.get_second_largest_peak()
+        );
+    }
+
+    #[test]
+    fn test_clipping_stats_survive_segment_append() {
+        // 1kHz采样率：窗口长3004；削波正弦的满幅段跨越分段边界
+        let samples: Vec<f32> = (0..3004 * 4 + 500)
+            .map(|i| ((i as f32 * 0.0105).sin() * 1.6).clamp(-1.0, 1.0))
+            .collect();
+
+        let mut serial = WindowRmsAnalyzer::new(1000, false).with_clip_tracking(true);
+        serial.process_samples(&samples);
+        assert!(serial.clip_stats().clip_runs > 0);
+        assert_eq!(serial.window_clipping().len(), serial.window_peaks().len());
+        assert_eq!(
+            serial
+                .window_clipping()
+                .iter()
+                .map(|w| w.clipped_samples as u64)
+                .sum::<u64>(),
+            serial.clip_stats().clipped_samples
+        );
+
+        let mut merged = WindowRmsAnalyzer::new(1000, false).with_clip_tracking(true);
+        merged.process_samples_streaming(&samples[..3004 * 2]);
+        let mut tail = WindowRmsAnalyzer::new(1000, false).with_clip_tracking(true);
+        tail.process_samples_streaming(&samples[3004 * 2..]);
+        merged.append_segment(tail);
+        merged.finalize_tail_window();
+
+        assert_eq!(merged.clip_stats(), serial.clip_stats());
+        assert_eq!(merged.window_clipping(), serial.window_clipping());
+    }
+
+    #[test]
+    fn test_clip_tracking_disabled_keeps_dr_identical() {
+        let samples: Vec<f32> = (0..3004 * 4 + 500)
+            .map(|i| ((i as f32 * 0.0105).sin() * 1.6).clamp(-1.0, 1.0))
+            .collect();
+        let interleaved: Vec<f32> = samples.iter().flat_map(|&s| [s, -s]).collect();
+
+        let mut tracked = WindowRmsAnalyzer::new(1000, false).with_clip_tracking(true);
+        tracked.process_samples_strided(&interleaved, 0, 2);
+        tracked.finalize_tail_window();
+        let mut plain = WindowRmsAnalyzer::new(1000, false);
+        plain.process_samples_strided(&interleaved, 0, 2);
+        plain.finalize_tail_window();
+
+        // 关闭时不收集削波统计，窗口RMS/Peak逐位一致
+        assert!(tracked.clip_stats().has_clipping());
+        assert!(!plain.clip_stats().has_clipping());
+        assert!(plain.window_clipping().is_empty());
+        assert_eq!(plain.window_peaks(), tracked.window_peaks());
+        assert_eq!(
+            plain.calculate_20_percent_rms().to_bits(),
+            tracked.calculate_20_percent_rms().to_bits()
+        );
+    }
+
+    #[test]
+    fn test_filtered_window_indices_survive_segment_append() {
+        // 1kHz采样率：窗口长3004；第1、4个窗口为静音
+        let samples: Vec<f32> = (0..3004 * 5)
+            .map(|i| if matches!(i / 3004, 1 | 4) { 0.0 } else { 0.5 })
+            .collect();
+        let filter = || SilenceFilterConfig::enabled(-60.0);
+
+        let mut serial = WindowRmsAnalyzer::with_silence_filter(1000, false, filter());
+        serial.process_samples(&samples);
+        assert_eq!(serial.filtered_window_indices(), &[1, 4]);
+
+        let mut merged = WindowRmsAnalyzer::with_silence_filter(1000, false, filter());
+        merged.process_samples_streaming(&samples[..3004 * 3]);
+        let mut tail = WindowRmsAnalyzer::with_silence_filter(1000, false, filter());
+        tail.process_samples_streaming(&samples[3004 * 3..]);
+        merged.append_segment(tail);
+        merged.finalize_tail_window();
+        assert_eq!(
+            merged.filtered_window_indices(),
+            serial.filtered_window_indices()
+        );
+    }
+
     #[test]
     fn test_calculate_20_percent_rms_empty() {
         let analyzer = WindowRmsAnalyzer::new(44100, false);
@@ -1437,4 +1799,38 @@ mod tests {
             );
         }
     }
+
+    #[test]
+    fn test_silence_gate_matches_log_threshold() {
+        let mut state = 0x9e37_79b9_7f4a_7c15u64;
+        let mut energies = vec![0.0, f64::NAN, f64::INFINITY, 1e-300, 2.0];
+        for _ in 0..2000 {
+            state = state
+                .wrapping_mul(6364136223846793005)
+                .wrapping_add(1442695040888963407);
+            // 均匀覆盖约 1e-30 ~ 10 的能量数量级
+            energies.push(10f64.powf(-30.0 + 31.0 * (state >> 11) as f64 / (1u64 << 53) as f64));
+        }
+
+        for threshold_db in [-70.0, -60.5, -100.0, -70.000_01, -239.9, -250.0, 0.0, 6.02] {
+            for config in [
+                SilenceFilterConfig::enabled(threshold_db),
+                SilenceFilterConfig::disabled(),
+            ] {
+                let gate = SilenceGate::new(&config);
+                // 判定边界两侧逐ulp比对
+                let boundary = gate.min_energy.to_bits();
+                let near = (boundary.saturating_sub(2000)..boundary.saturating_add(2000))
+                    .map(f64::from_bits)
+                    .filter(|e| e.is_finite());
+                for energy in energies.iter().copied().chain(near) {
+                    assert_eq!(
+                        gate.is_silent(energy),
+                        config.should_filter(energy.sqrt()),
+                        "threshold {threshold_db} dB, energy {energy:e}"
+                    );
+                }
+            }
+        }
+    }
 }
@@ -2,13 +2,19 @@
 //!
 //! 包含DR计算的核心数据结构和算法实现。
 
+pub mod clipping;
 pub mod dr_calculator;
+pub mod dr_session;
 pub mod histogram;
 pub mod peak_selection;
+pub mod rolling_dr;
 
 // 重新导出公共接口
+pub use clipping::{ClipStats, WindowClipping};
 pub use dr_calculator::{DrCalculator, DrResult};
+pub use dr_session::DrSession;
 pub use histogram::SilenceFilterConfig;
 pub use peak_selection::{PeakSelectionStrategy, PeakSelector};
+pub use rolling_dr::{RollingDrMeter, RollingDrUpdate};
 // SimpleHistogramAnalyzer和SimpleStats已删除，不再导出
 // ChannelData已移动到processing层，不再从此导出
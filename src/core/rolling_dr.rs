@@ -0,0 +1,424 @@
+//! 滚动DR表（直播/广播质检的实时DR）
+//!
+//! `WindowRmsAnalyzer` 只在流结束后给出整轨DR；滚动表只保留最近N个3秒窗口，
+//! 每完成一个窗口就输出最近N个窗口的DR，适合长时间连续输入。
+//!
+//! ## 每窗口更新代价
+//!
+//! - **20% RMS**：窗口RMS按与整轨分析相同的10001-bin量化入树状数组（计数 + bin²累积），
+//!   最响20%窗口的平方和通过一次自顶向下的树上二分得到，O(log B)（B = 10001）
+//! - **主峰/次峰**：窗口Peak存入有序计数表，最大与次大各一次查找，O(log N)
+//! - **淘汰**：环形缓冲记录每个窗口的(bin, Peak)，超出跨度时从两处结构中扣除
+//!
+//! 内存与单次更新耗时只与跨度N有关，与已输入时长无关，可连续运行数小时。
+
+use crate::core::SilenceFilterConfig;
+use crate::core::dr_calculator::DrResult;
+use crate::core::histogram::{
+    HISTOGRAM_MAX_BIN, SilenceGate, WindowRmsAnalyzer, quantize_window_rms,
+};
+use crate::core::peak_selection::{PeakSelectionStrategy, PeakSelector};
+use crate::error::{AudioError, AudioResult};
+use crate::tools::constants::format_constraints;
+use std::collections::{BTreeMap, VecDeque};
+
+/// 一次滚动更新：最近N个窗口的逐声道DR
+#[derive(Debug, Clone)]
+pub struct RollingDrUpdate {
+    /// 已完成的窗口总数（从1开始，即本次更新对应的窗口序号）
+    pub window_index: u64,
+    /// 本窗口结束时刻（秒，自输入开始）
+    pub end_seconds: f64,
+    /// 参与本次计算的窗口数（未填满跨度前小于跨度）
+    pub windows_in_span: usize,
+    /// 逐声道DR结果（`sample_count` 为跨度内的帧数）
+    pub results: Vec<DrResult>,
+}
+
+/// 多声道滚动DR表
+#[derive(Debug, Clone)]
+pub struct RollingDrMeter {
+    sample_rate: u32,
+    window_len: usize,
+    /// 跨度（窗口数）
+    span_windows: usize,
+    channels: Vec<RollingChannel>,
+    /// 当前未满窗口已累积的帧数（所有声道同步）
+    current_frames: usize,
+    windows_completed: u64,
+    silence_gate: SilenceGate,
+}
+
+impl RollingDrMeter {
+    /// 创建滚动DR表
+    ///
+    /// * `span_windows` - 滚动跨度（3秒窗口数，至少1）
+    pub fn new(sample_rate: u32, channels: usize, span_windows: usize) -> AudioResult<Self> {
+        Self::with_silence_filter(
+            sample_rate,
+            channels,
+            span_windows,
+            SilenceFilterConfig::disabled(),
+        )
+    }
+
+    /// 创建带静音过滤的滚动DR表（实验性；被过滤的窗口不进入跨度，也不触发更新）
+    pub fn with_silence_filter(
+        sample_rate: u32,
+        channels: usize,
+        span_windows: usize,
+        silence_filter: SilenceFilterConfig,
+    ) -> AudioResult<Self> {
+        if channels == 0 || channels > format_constraints::MAX_CHANNELS as usize {
+            return Err(AudioError::InvalidInput(format!(
+                "Unsupported channel count {channels} / 不支持的声道数 {channels}"
+            )));
+        }
+        if sample_rate == 0 || span_windows == 0 {
+            return Err(AudioError::InvalidInput(
+                "Sample rate and span must be greater than zero / 采样率与跨度必须大于0"
+                    .to_string(),
+            ));
+        }
+
+        Ok(Self {
+            sample_rate,
+            window_len: WindowRmsAnalyzer::calculate_standard_window_size(sample_rate),
+            span_windows,
+            channels: (0..channels)
+                .map(|_| RollingChannel::new(span_windows))
+                .collect(),
+            current_frames: 0,
+            windows_completed: 0,
+            silence_gate: SilenceGate::new(&silence_filter),
+        })
+    }
+
+    /// 跨度（窗口数）
+    pub fn span_windows(&self) -> usize {
+        self.span_windows
+    }
+
+    /// 推送交错样本；每完成一个3秒窗口回调一次最新的滚动DR
+    ///
+    /// 末尾不足一帧的样本被忽略（与流式引擎的尾帧处理一致，须由调用方保证整帧推送）。
+    pub fn push_interleaved<F>(&mut self, samples: &[f32], mut on_update: F)
+    where
+        F: FnMut(&RollingDrUpdate),
+    {
+        let channel_count = self.channels.len();
+        let total_frames = samples.len() / channel_count;
+        let mut offset = 0;
+
+        while offset < total_frames {
+            // 每段最多填满当前窗口，窗口边界处结算并输出
+            let take = (self.window_len - self.current_frames).min(total_frames - offset);
+            let segment = &samples[offset * channel_count..(offset + take) * channel_count];
+            for (channel_idx, channel) in self.channels.iter_mut().enumerate() {
+                for frame in segment.chunks_exact(channel_count) {
+                    channel.accumulate(frame[channel_idx] as f64);
+                }
+            }
+            self.current_frames += take;
+            offset += take;
+
+            if self.current_frames == self.window_len {
+                self.current_frames = 0;
+                if let Some(update) = self.complete_window() {
+                    on_update(&update);
+                }
+            }
+        }
+    }
+
+    /// 结算一个窗口；所有声道都被静音过滤时不产生更新
+    fn complete_window(&mut self) -> Option<RollingDrUpdate> {
+        self.windows_completed += 1;
+
+        let window_len = self.window_len;
+        let silence_gate = self.silence_gate;
+        let mut any_kept = false;
+        for channel in &mut self.channels {
+            any_kept |= channel.complete_window(window_len, &silence_gate);
+        }
+        if !any_kept {
+            return None;
+        }
+
+        let windows_in_span = self
+            .channels
+            .iter()
+            .map(|channel| channel.ring.len())
+            .max()
+            .unwrap_or(0);
+        let results = self
+            .channels
+            .iter()
+            .enumerate()
+            .map(|(channel_idx, channel)| {
+                channel.dr_result(channel_idx, channel.ring.len() * window_len)
+            })
+            .collect();
+
+        Some(RollingDrUpdate {
+            window_index: self.windows_completed,
+            end_seconds: (self.windows_completed * window_len as u64) as f64
+                / self.sample_rate as f64,
+            windows_in_span,
+            results,
+        })
+    }
+}
+
+/// 单声道滚动状态
+#[derive(Debug, Clone)]
+struct RollingChannel {
+    /// 当前窗口平方和 / 峰值
+    sum_sq: f64,
+    peak: f64,
+    /// 跨度内窗口的(bin, Peak)，按时间顺序
+    ring: VecDeque<(usize, f64)>,
+    span_windows: usize,
+    bins: BinTree,
+    /// 跨度内窗口Peak的有序计数（键为f64位模式：非负有限浮点的位序即数值序）
+    peaks: BTreeMap<u64, u32>,
+}
+
+impl RollingChannel {
+    fn new(span_windows: usize) -> Self {
+        Self {
+            sum_sq: 0.0,
+            peak: 0.0,
+            ring: VecDeque::with_capacity(span_windows),
+            span_windows,
+            bins: BinTree::new(),
+            peaks: BTreeMap::new(),
+        }
+    }
+
+    #[inline(always)]
+    fn accumulate(&mut self, sample: f64) {
+        self.sum_sq += sample * sample;
+        let abs_sample = sample.abs();
+        if abs_sample > self.peak {
+            self.peak = abs_sample;
+        }
+    }
+
+    /// 结算窗口并滚动跨度；返回窗口是否被保留（未被静音过滤）
+    fn complete_window(&mut self, window_len: usize, silence_gate: &SilenceGate) -> bool {
+        // foobar2000 RMS公式：RMS = sqrt(2 * sumSq / window_len)（与整轨分析一致）
+        let mean_energy = 2.0 * self.sum_sq / window_len as f64;
+        let peak = self.peak;
+        self.sum_sq = 0.0;
+        self.peak = 0.0;
+
+        if silence_gate.is_silent(mean_energy) {
+            return false;
+        }
+        let window_rms = mean_energy.sqrt();
+        let Some(bin) = quantize_window_rms(window_rms) else {
+            return false;
+        };
+
+        if self.ring.len() == self.span_windows {
+            let (old_bin, old_peak) = self.ring.pop_front().expect("ring is full");
+            self.bins.add(old_bin, -1);
+            let key = old_peak.to_bits();
+            if let Some(count) = self.peaks.get_mut(&key) {
+                *count -= 1;
+                if *count == 0 {
+                    self.peaks.remove(&key);
+                }
+            }
+        }
+        self.ring.push_back((bin, peak));
+        self.bins.add(bin, 1);
+        *self.peaks.entry(peak.to_bits()).or_insert(0) += 1;
+        true
+    }
+
+    /// 主峰与次峰（重复的最大值视为次峰，与整轨 `find_top_two` 语义一致）
+    fn top_two_peaks(&self) -> (f64, f64) {
+        let mut iter = self.peaks.iter().rev();
+        let Some((&max_bits, &max_count)) = iter.next() else {
+            return (0.0, 0.0);
+        };
+        let max = f64::from_bits(max_bits);
+        if max_count >= 2 {
+            return (max, max);
+        }
+        match iter.next() {
+            Some((&second_bits, _)) => (max, f64::from_bits(second_bits)),
+            // 仅一个窗口：主次峰相同
+            None => (max, max),
+        }
+    }
+
+    fn dr_result(&self, channel_idx: usize, frames_in_span: usize) -> DrResult {
+        let rms_20_percent = self.bins.loudest_20_percent_rms();
+        let (primary_peak, secondary_peak) = self.top_two_peaks();
+        let peak_for_dr =
+            PeakSelectionStrategy::default().select_peak(primary_peak, secondary_peak);
+        let dr_value = if peak_for_dr > 0.0 && rms_20_percent > 0.0 {
+            -20.0 * (rms_20_percent / peak_for_dr).log10()
+        } else {
+            0.0
+        };
+
+        DrResult::new_with_peaks(
+            channel_idx,
+            dr_value,
+            rms_20_percent,
+            peak_for_dr,
+            primary_peak,
+            secondary_peak,
+            frames_in_span,
+        )
+    }
+}
+
+/// 10001-bin直方图的树状数组（Fenwick）
+///
+/// 按"从响到轻"的顺序编号（位置 i 对应 bin = 10000 - i），
+/// 前缀即最响的若干窗口；同时累积计数与 bin² 的整数和，平方和无舍入误差。
+#[derive(Debug, Clone)]
+struct BinTree {
+    counts: Vec<i64>,
+    squares: Vec<i64>,
+    total: i64,
+}
+
+impl BinTree {
+    const LEN: usize = HISTOGRAM_MAX_BIN + 1;
+
+    fn new() -> Self {
+        Self {
+            counts: vec![0; Self::LEN + 1],
+            squares: vec![0; Self::LEN + 1],
+            total: 0,
+        }
+    }
+
+    fn add(&mut self, bin: usize, delta: i64) {
+        let square = (bin * bin) as i64 * delta;
+        let mut pos = HISTOGRAM_MAX_BIN - bin + 1;
+        while pos <= Self::LEN {
+            self.counts[pos] += delta;
+            self.squares[pos] += square;
+            pos += pos & pos.wrapping_neg();
+        }
+        self.total += delta;
+    }
+
+    /// 最响20%窗口的RMS（target 截断规则与整轨直方图一致）
+    fn loudest_20_percent_rms(&self) -> f64 {
+        if self.total <= 0 {
+            return 0.0;
+        }
+        let target = ((0.2 * self.total as f64).trunc() as i64).max(1);
+
+        // 树上二分：找到前缀计数 < target 的最长前缀，累积其平方和
+        let mut pos = 0;
+        let mut remaining = target;
+        let mut sum_sq = 0i64;
+        let mut step = Self::LEN.next_power_of_two();
+        while step > 0 {
+            let next = pos + step;
+            if next <= Self::LEN && self.counts[next] < remaining {
+                pos = next;
+                remaining -= self.counts[next];
+                sum_sq += self.squares[next];
+            }
+            step >>= 1;
+        }
+        // 位置 pos+1 的bin提供剩余的窗口
+        let bin = (HISTOGRAM_MAX_BIN - pos) as i64;
+        sum_sq += remaining * bin * bin;
+
+        // 还原公式：sum_sq × 1e-8
+        (sum_sq as f64 * 1e-8 / target as f64).sqrt()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// 每个3秒窗口一个恒定幅度的测试信号
+    fn stepped_signal(sample_rate: u32, levels: &[f32]) -> Vec<f32> {
+        let window_len = WindowRmsAnalyzer::calculate_standard_window_size(sample_rate);
+        levels
+            .iter()
+            .flat_map(|&level| {
+                (0..window_len).map(move |i| if i % 2 == 0 { level } else { -level })
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_rolling_matches_full_analysis_within_span() {
+        let sample_rate = 8000;
+        let levels = [0.1, 0.5, 0.25, 0.9, 0.05, 0.3, 0.7, 0.2, 0.4, 0.6, 0.15];
+        let samples = stepped_signal(sample_rate, &levels);
+
+        let mut meter = RollingDrMeter::new(sample_rate, 1, 64).unwrap();
+        let mut last = None;
+        meter.push_interleaved(&samples, |update| last = Some(update.clone()));
+        let last = last.expect("one update per window");
+        assert_eq!(last.window_index, levels.len() as u64);
+        assert_eq!(last.windows_in_span, levels.len());
+
+        // 整轨分析（样本恰好为整窗：含虚拟零窗，不影响最大/次大Peak）
+        let mut analyzer = WindowRmsAnalyzer::new(sample_rate, false);
+        analyzer.process_samples(&samples);
+        let rolling = &last.results[0];
+        assert!((rolling.rms - analyzer.calculate_20_percent_rms()).abs() < 1e-12);
+        assert_eq!(rolling.primary_peak, analyzer.get_largest_peak());
+        assert_eq!(rolling.secondary_peak, analyzer.get_second_largest_peak());
+    }
+
+    #[test]
+    fn test_rolling_span_evicts_old_windows() {
+        let sample_rate = 8000;
+        let mut meter = RollingDrMeter::new(sample_rate, 2, 3).unwrap();
+        let mut updates = Vec::new();
+
+        // 立体声：两个声道相同；分块大小与窗口不对齐
+        let mono = stepped_signal(sample_rate, &[0.9, 0.8, 0.1, 0.1, 0.1]);
+        let stereo: Vec<f32> = mono.iter().flat_map(|&s| [s, s]).collect();
+        for chunk in stereo.chunks(2 * 1001) {
+            meter.push_interleaved(chunk, |update| updates.push(update.clone()));
+        }
+
+        assert_eq!(updates.len(), 5);
+        assert_eq!(updates[1].results[0].secondary_peak as f32, 0.8);
+        // 跨度为3：最后一次只剩三个0.1窗口，响亮窗口已被淘汰
+        let last = &updates[4];
+        assert_eq!(last.windows_in_span, 3);
+        assert_eq!(last.results[1].primary_peak as f32, 0.1);
+        // 方波 RMS = √2·Peak（bin 1414）：DR ≈ -3.01 dB
+        assert!((last.results[1].dr_value + 3.0103).abs() < 0.01);
+    }
+
+    #[test]
+    fn test_bin_tree_partial_bin() {
+        let mut tree = BinTree::new();
+        for bin in [7000, 7000, 7000, 100, 100, 100, 100, 100, 100, 100] {
+            tree.add(bin, 1);
+        }
+        // 10个窗口取最响2个：都来自 bin 7000
+        assert!((tree.loudest_20_percent_rms() - 0.7).abs() < 1e-12);
+        tree.add(7000, -1);
+        tree.add(7000, -1);
+        tree.add(9000, 1);
+        // 9个窗口取1个：bin 9000
+        assert!((tree.loudest_20_percent_rms() - 0.9).abs() < 1e-12);
+    }
+
+    #[test]
+    fn test_invalid_parameters() {
+        assert!(RollingDrMeter::new(44100, 0, 10).is_err());
+        assert!(RollingDrMeter::new(44100, 2, 0).is_err());
+    }
+}
@@ -0,0 +1,784 @@
+//! C ABI 导出层（cdylib）
+//!
+//! 为 C/C++ 宿主（媒体服务器、播放器插件等）提供进程内 DR 分析能力，
+//! 避免逐曲目启动 CLI 进程带来的进程创建、重复打开与重复解码开销。
+//!
+//! 对应头文件：`include/macinmeter_dr.h`（修改本文件导出符号时须同步更新）。
+//!
+//! ## 约定
+//! - 句柄不透明：`MmDrSession` 仅通过指针传递，由 `mm_dr_session_destroy` 释放
+//! - 缓冲区由调用方持有：结果写入调用方提供的数组，库内不分配需调用方释放的内存
+//! - 返回值：`MM_DR_OK`(0) 表示成功，负值为错误码；错误详情通过
+//!   `mm_dr_last_error_message` 读取（线程局部）
+//! - 单个句柄非线程安全；不同句柄可在不同线程并发使用
+//! - 每个入口都以 `catch_unwind` 包裹，内部 panic 转为 `MM_DR_ERR_PANIC`，不会跨越
+//!   C ABI 边界展开；这要求以展开模式构建（`cargo build --profile release-ffi --lib`），
+//!   默认 release 配置为 `panic = "abort"`，panic 会直接终止宿主进程
+
+use crate::audio::AudioFormat;
+use crate::core::DrSession;
+use crate::core::dr_calculator::DrResult;
+use crate::error::AudioError;
+use crate::tools::{AppConfig, compute_official_precise_dr, constants};
+use std::cell::RefCell;
+use std::ffi::{CStr, c_char};
+use std::path::PathBuf;
+
+/// ABI 版本号（结构体布局或函数签名不兼容变更时递增）
+pub const MM_DR_ABI_VERSION: u32 = 1;
+
+/// 成功
+pub const MM_DR_OK: i32 = 0;
+/// 必需的指针参数为空
+pub const MM_DR_ERR_NULL_POINTER: i32 = -1;
+/// 参数无效（声道数、采样率、样本长度等）
+pub const MM_DR_ERR_INVALID_INPUT: i32 = -2;
+/// 不支持或无法识别的音频格式
+pub const MM_DR_ERR_FORMAT: i32 = -3;
+/// 解码失败
+pub const MM_DR_ERR_DECODING: i32 = -4;
+/// 计算失败（含内存不足）
+pub const MM_DR_ERR_CALCULATION: i32 = -5;
+/// I/O 错误
+pub const MM_DR_ERR_IO: i32 = -6;
+/// 资源不可用（线程池等）
+pub const MM_DR_ERR_RESOURCE: i32 = -7;
+/// 结果缓冲区容量不足（`out_len` 已写入所需容量）
+pub const MM_DR_ERR_BUFFER_TOO_SMALL: i32 = -8;
+/// 会话已结束（`mm_dr_session_finish` 之后不可再推送）
+pub const MM_DR_ERR_SESSION_FINISHED: i32 = -9;
+/// 库内部 panic（已捕获；推送或结算中 panic 的会话随之结束）
+pub const MM_DR_ERR_PANIC: i32 = -10;
+
+/// 单声道DR结果（C布局）
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MmDrChannelResult {
+    /// 声道索引（0-based）
+    pub channel: u32,
+    /// 精确DR值（dB）
+    pub dr_value: f64,
+    /// 最响20%窗口RMS
+    pub rms: f64,
+    /// 参与DR计算的峰值
+    pub peak: f64,
+    /// 主峰值
+    pub primary_peak: f64,
+    /// 次峰值
+    pub secondary_peak: f64,
+    /// 参与分析的帧数
+    pub sample_count: u64,
+}
+
+/// 整体汇总（C布局）
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct MmDrSummary {
+    /// 官方DR（四舍五入整数）；无有效声道时为 0
+    pub official_dr: i32,
+    /// 精确DR（声道平均）
+    pub precise_dr: f64,
+    /// 采样率（Hz，处理用采样率）
+    pub sample_rate: u32,
+    /// 声道数
+    pub channels: u32,
+    /// 源位深
+    pub bits_per_sample: u32,
+    /// 实际分析帧数
+    pub frame_count: u64,
+    /// 是否为部分分析（跳过了损坏包或检测到截断），0/1
+    pub is_partial: i32,
+}
+
+/// 文件分析选项（C布局）；传 NULL 使用默认值
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct MmDrFileOptions {
+    /// 是否启用并行解码，0/1（默认 1）
+    pub parallel_decoding: i32,
+    /// 并行解码线程数，0 表示默认
+    pub parallel_threads: u32,
+    /// 官方DR聚合是否剔除LFE声道，0/1（默认 0）
+    pub exclude_lfe: i32,
+}
+
+impl Default for MmDrFileOptions {
+    fn default() -> Self {
+        Self {
+            parallel_decoding: 1,
+            parallel_threads: 0,
+            exclude_lfe: 0,
+        }
+    }
+}
+
+/// 不透明会话句柄
+pub struct MmDrSession {
+    /// `finish` 后置为 None
+    session: Option<DrSession>,
+    sample_rate: u32,
+    channels: usize,
+    /// 已推送样本的最大位宽（f32 计 32；未推送时为 0）
+    bits_per_sample: u16,
+}
+
+thread_local! {
+    static LAST_ERROR: RefCell<Option<String>> = const { RefCell::new(None) };
+}
+
+fn set_last_error(message: impl Into<String>) {
+    LAST_ERROR.with(|slot| *slot.borrow_mut() = Some(message.into()));
+}
+
+/// 将 AudioError 映射为错误码并记录错误信息
+fn report_error(error: AudioError) -> i32 {
+    let code = match &error {
+        AudioError::InvalidInput(_) => MM_DR_ERR_INVALID_INPUT,
+        AudioError::IoError(_) => MM_DR_ERR_IO,
+        AudioError::FormatError(_) => MM_DR_ERR_FORMAT,
+        AudioError::DecodingError(_) => MM_DR_ERR_DECODING,
+        AudioError::CalculationError(_) | AudioError::OutOfMemory => MM_DR_ERR_CALCULATION,
+        AudioError::ResourceError(_) => MM_DR_ERR_RESOURCE,
+    };
+    set_last_error(error.to_string());
+    code
+}
+
+/// 执行入口函数体并捕获 panic（panic 不得跨越 C ABI 边界展开）
+fn guard<R>(on_panic: R, body: impl FnOnce() -> R) -> R {
+    match std::panic::catch_unwind(std::panic::AssertUnwindSafe(body)) {
+        Ok(value) => value,
+        Err(payload) => {
+            let detail = payload
+                .downcast_ref::<&str>()
+                .map(|message| message.to_string())
+                .or_else(|| payload.downcast_ref::<String>().cloned())
+                .unwrap_or_default();
+            set_last_error(format!("Internal panic / 库内部错误（panic）: {detail}"));
+            on_panic
+        }
+    }
+}
+
+fn report_null(argument: &str) -> i32 {
+    set_last_error(format!(
+        "Null pointer argument: {argument} / 空指针参数：{argument}"
+    ));
+    MM_DR_ERR_NULL_POINTER
+}
+
+/// 把结果与汇总写入调用方缓冲区
+///
+/// # Safety
+/// `out` 需可写 `capacity` 个元素；`out_len` 非空；`summary` 可为空。
+unsafe fn write_results(
+    results: &[DrResult],
+    format: &AudioFormat,
+    exclude_lfe: bool,
+    out: *mut MmDrChannelResult,
+    capacity: usize,
+    out_len: *mut usize,
+    summary: *mut MmDrSummary,
+) -> i32 {
+    // SAFETY: 调用方保证 out_len 有效（入口处已做空指针检查）
+    unsafe { *out_len = results.len() };
+    if capacity < results.len() {
+        set_last_error(format!(
+            "Result buffer too small: need {}, got {capacity} / 结果缓冲区不足",
+            results.len()
+        ));
+        return MM_DR_ERR_BUFFER_TOO_SMALL;
+    }
+
+    for (idx, result) in results.iter().enumerate() {
+        let converted = MmDrChannelResult {
+            channel: result.channel as u32,
+            dr_value: result.dr_value,
+            rms: result.rms,
+            peak: result.peak,
+            primary_peak: result.primary_peak,
+            secondary_peak: result.secondary_peak,
+            sample_count: result.sample_count as u64,
+        };
+        // SAFETY: idx < results.len() <= capacity，调用方保证 out 可写 capacity 个元素
+        unsafe { out.add(idx).write(converted) };
+    }
+
+    if !summary.is_null() {
+        let (official_dr, precise_dr) = compute_official_precise_dr(results, format, exclude_lfe)
+            .map(|(official, precise, _, _)| (official, precise))
+            .unwrap_or((0, 0.0));
+        let sample_rate = format.processed_sample_rate.unwrap_or(format.sample_rate);
+        // SAFETY: 已检查非空，调用方保证其指向有效的 MmDrSummary
+        unsafe {
+            summary.write(MmDrSummary {
+                official_dr,
+                precise_dr,
+                sample_rate,
+                channels: format.channels as u32,
+                bits_per_sample: format.bits_per_sample as u32,
+                frame_count: results.first().map_or(0, |r| r.sample_count as u64),
+                is_partial: format.is_partial() as i32,
+            })
+        };
+    }
+
+    MM_DR_OK
+}
+
+/// 返回 ABI 版本号（`MM_DR_ABI_VERSION`）
+#[unsafe(no_mangle)]
+pub extern "C" fn mm_dr_abi_version() -> u32 {
+    MM_DR_ABI_VERSION
+}
+
+/// 复制当前线程最近一次错误信息到调用方缓冲区（UTF-8，NUL结尾，超长截断）
+///
+/// 返回完整消息的字节长度（不含NUL）；无错误时返回 0。
+///
+/// # Safety
+/// `buffer` 为空或可写 `capacity` 字节。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_last_error_message(buffer: *mut c_char, capacity: usize) -> usize {
+    LAST_ERROR.with(|slot| {
+        let slot = slot.borrow();
+        let Some(message) = slot.as_deref() else {
+            if !buffer.is_null() && capacity > 0 {
+                // SAFETY: capacity > 0 且调用方保证可写
+                unsafe { *buffer = 0 };
+            }
+            return 0;
+        };
+
+        if !buffer.is_null() && capacity > 0 {
+            let copy_len = message.len().min(capacity - 1);
+            // SAFETY: copy_len + 1 <= capacity，源与目标不重叠
+            unsafe {
+                std::ptr::copy_nonoverlapping(message.as_ptr(), buffer.cast::<u8>(), copy_len);
+                *buffer.add(copy_len) = 0;
+            }
+        }
+        message.len()
+    })
+}
+
+/// 创建推送式分析会话；失败返回 NULL（详情见 `mm_dr_last_error_message`）
+#[unsafe(no_mangle)]
+pub extern "C" fn mm_dr_session_create(sample_rate: u32, channels: u32) -> *mut MmDrSession {
+    guard(std::ptr::null_mut(), || {
+        match DrSession::new(sample_rate, channels as usize) {
+            Ok(session) => Box::into_raw(Box::new(MmDrSession {
+                session: Some(session),
+                sample_rate,
+                channels: channels as usize,
+                bits_per_sample: 0,
+            })),
+            Err(e) => {
+                report_error(e);
+                std::ptr::null_mut()
+            }
+        }
+    })
+}
+
+/// 释放会话句柄（可传 NULL）
+///
+/// # Safety
+/// `handle` 为空或由 `mm_dr_session_create` 返回且未被释放。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_session_destroy(handle: *mut MmDrSession) {
+    if !handle.is_null() {
+        // SAFETY: 句柄由 Box::into_raw 创建，调用方保证仅释放一次
+        guard((), || drop(unsafe { Box::from_raw(handle) }));
+    }
+}
+
+/// 取出仍可推送的会话
+fn active_session(handle: &mut MmDrSession) -> Result<&mut DrSession, i32> {
+    handle.session.as_mut().ok_or_else(|| {
+        set_last_error("Session already finished / 会话已结束");
+        MM_DR_ERR_SESSION_FINISHED
+    })
+}
+
+/// 通用推送入口：空指针与空切片处理，记录推送位宽
+///
+/// 推送中 panic 时分析器状态可能只更新了一部分，会话随之结束。
+///
+/// # Safety
+/// `handle` 有效；`samples` 为空时 `sample_count` 须为 0，否则可读 `sample_count` 个元素。
+unsafe fn push_with<T>(
+    handle: *mut MmDrSession,
+    samples: *const T,
+    sample_count: usize,
+    bits_per_sample: u16,
+    push: impl FnOnce(&mut DrSession, &[T]) -> crate::AudioResult<()>,
+) -> i32 {
+    // SAFETY: 调用方保证 handle 为空或有效
+    let Some(handle) = (unsafe { handle.as_mut() }) else {
+        return report_null("handle");
+    };
+    let session = match active_session(handle) {
+        Ok(session) => session,
+        Err(code) => return code,
+    };
+    if sample_count == 0 {
+        return MM_DR_OK;
+    }
+    if samples.is_null() {
+        return report_null("samples");
+    }
+
+    // SAFETY: 调用方保证 samples 可读 sample_count 个元素
+    let slice = unsafe { std::slice::from_raw_parts(samples, sample_count) };
+    let code = guard(MM_DR_ERR_PANIC, || match push(session, slice) {
+        Ok(()) => MM_DR_OK,
+        Err(e) => report_error(e),
+    });
+    match code {
+        MM_DR_OK => handle.bits_per_sample = handle.bits_per_sample.max(bits_per_sample),
+        MM_DR_ERR_PANIC => handle.session = None,
+        _ => {}
+    }
+    code
+}
+
+/// 推送交错 f32 样本（`sample_count` 为样本总数，须为声道数整数倍）
+///
+/// # Safety
+/// `handle` 有效；`samples` 可读 `sample_count` 个元素。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_session_push_f32(
+    handle: *mut MmDrSession,
+    samples: *const f32,
+    sample_count: usize,
+) -> i32 {
+    // SAFETY: 透传调用方保证
+    unsafe {
+        push_with(
+            handle,
+            samples,
+            sample_count,
+            32,
+            DrSession::push_interleaved,
+        )
+    }
+}
+
+/// 推送交错 16 位整数样本
+///
+/// # Safety
+/// 同 `mm_dr_session_push_f32`。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_session_push_i16(
+    handle: *mut MmDrSession,
+    samples: *const i16,
+    sample_count: usize,
+) -> i32 {
+    // SAFETY: 透传调用方保证
+    unsafe {
+        push_with(
+            handle,
+            samples,
+            sample_count,
+            16,
+            DrSession::push_i16_interleaved,
+        )
+    }
+}
+
+/// 推送交错 32 位容器整数样本；`bits_per_sample` 为 24（低24位有效）或 32
+///
+/// # Safety
+/// 同 `mm_dr_session_push_f32`。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_session_push_i32(
+    handle: *mut MmDrSession,
+    samples: *const i32,
+    sample_count: usize,
+    bits_per_sample: u32,
+) -> i32 {
+    let push: fn(&mut DrSession, &[i32]) -> crate::AudioResult<()> = match bits_per_sample {
+        24 => DrSession::push_i24_interleaved,
+        32 => DrSession::push_i32_interleaved,
+        other => {
+            return report_error(AudioError::InvalidInput(format!(
+                "bits_per_sample must be 24 or 32, got {other} / 位深必须为24或32"
+            )));
+        }
+    };
+    // SAFETY: 透传调用方保证
+    unsafe { push_with(handle, samples, sample_count, bits_per_sample as u16, push) }
+}
+
+/// 校验结果输出参数
+fn check_result_args(out: *mut MmDrChannelResult, capacity: usize, out_len: *mut usize) -> i32 {
+    if out_len.is_null() {
+        return report_null("out_len");
+    }
+    if out.is_null() && capacity > 0 {
+        return report_null("out");
+    }
+    MM_DR_OK
+}
+
+/// 会话当前状态对应的格式描述（用于官方DR聚合与汇总）
+fn session_format(handle: &MmDrSession, frames: u64) -> AudioFormat {
+    AudioFormat::new(
+        handle.sample_rate,
+        handle.channels as u16,
+        handle.bits_per_sample,
+        frames,
+    )
+}
+
+/// 获取当前结果快照，会话可继续推送
+///
+/// # Safety
+/// `handle` 有效；`out` 可写 `capacity` 个元素；`out_len` 非空；`summary` 可为空。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_session_snapshot(
+    handle: *const MmDrSession,
+    out: *mut MmDrChannelResult,
+    capacity: usize,
+    out_len: *mut usize,
+    summary: *mut MmDrSummary,
+) -> i32 {
+    // SAFETY: 调用方保证 handle 为空或有效
+    let Some(handle) = (unsafe { handle.as_ref() }) else {
+        return report_null("handle");
+    };
+    let code = check_result_args(out, capacity, out_len);
+    if code != MM_DR_OK {
+        return code;
+    }
+    let Some(session) = handle.session.as_ref() else {
+        set_last_error("Session already finished / 会话已结束");
+        return MM_DR_ERR_SESSION_FINISHED;
+    };
+
+    guard(MM_DR_ERR_PANIC, || match session.snapshot() {
+        Ok(results) => {
+            let format = session_format(handle, session.frames_pushed());
+            // SAFETY: 参数已校验，透传调用方保证
+            unsafe { write_results(&results, &format, false, out, capacity, out_len, summary) }
+        }
+        Err(e) => report_error(e),
+    })
+}
+
+/// 结束会话并输出最终结果；之后仅可调用 `mm_dr_session_destroy`
+///
+/// 缓冲区不足或样本不足时会话保持未结束状态，可扩容后重试或继续推送样本。
+/// 结算就地进行（消耗会话），不克隆窗口状态。
+///
+/// # Safety
+/// 同 `mm_dr_session_snapshot`。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_session_finish(
+    handle: *mut MmDrSession,
+    out: *mut MmDrChannelResult,
+    capacity: usize,
+    out_len: *mut usize,
+    summary: *mut MmDrSummary,
+) -> i32 {
+    // SAFETY: 调用方保证 handle 为空或有效
+    let Some(handle) = (unsafe { handle.as_mut() }) else {
+        return report_null("handle");
+    };
+    let code = check_result_args(out, capacity, out_len);
+    if code != MM_DR_OK {
+        return code;
+    }
+    let Some(session) = handle.session.as_ref() else {
+        set_last_error("Session already finished / 会话已结束");
+        return MM_DR_ERR_SESSION_FINISHED;
+    };
+    if capacity < handle.channels {
+        // SAFETY: out_len 已校验非空
+        unsafe { *out_len = handle.channels };
+        set_last_error(format!(
+            "Result buffer too small: need {}, got {capacity} / 结果缓冲区不足",
+            handle.channels
+        ));
+        return MM_DR_ERR_BUFFER_TOO_SMALL;
+    }
+    // 样本不足是结算失败的唯一原因：先检查，失败时会话保持未结束，可继续推送
+    if let Err(e) = session.check_ready() {
+        return report_error(e);
+    }
+
+    let Some(session) = handle.session.take() else {
+        return MM_DR_ERR_SESSION_FINISHED;
+    };
+    let frames = session.frames_pushed();
+    let format = session_format(handle, frames);
+    guard(MM_DR_ERR_PANIC, || match session.finish() {
+        // SAFETY: 参数已校验，透传调用方保证
+        Ok(results) => unsafe {
+            write_results(&results, &format, false, out, capacity, out_len, summary)
+        },
+        Err(e) => report_error(e),
+    })
+}
+
+/// 使用内置解码器分析音频文件（与 CLI 流程一致）
+///
+/// 结果缓冲区建议按 `MM_DR_MAX_CHANNELS` 分配；不足时返回
+/// `MM_DR_ERR_BUFFER_TOO_SMALL` 并在 `out_len` 写入所需容量。
+///
+/// # Safety
+/// `path` 为有效的 NUL 结尾 UTF-8 字符串；`options` 为空或有效；
+/// 其余参数同 `mm_dr_session_snapshot`。
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mm_dr_analyze_file(
+    path: *const c_char,
+    options: *const MmDrFileOptions,
+    out: *mut MmDrChannelResult,
+    capacity: usize,
+    out_len: *mut usize,
+    summary: *mut MmDrSummary,
+) -> i32 {
+    if path.is_null() {
+        return report_null("path");
+    }
+    let code = check_result_args(out, capacity, out_len);
+    if code != MM_DR_OK {
+        return code;
+    }
+
+    // SAFETY: 调用方保证 path 为有效的 NUL 结尾字符串
+    let path = match unsafe { CStr::from_ptr(path) }.to_str() {
+        Ok(path) => PathBuf::from(path),
+        Err(_) => {
+            return report_error(AudioError::InvalidInput(
+                "Path is not valid UTF-8 / 路径不是有效的UTF-8".to_string(),
+            ));
+        }
+    };
+    // SAFETY: 调用方保证 options 为空或有效
+    let options = unsafe { options.as_ref() }.copied().unwrap_or_default();
+
+    let config = file_app_config(path, &options);
+    // 解码器位于第三方 crate，损坏文件触发的 panic 在此捕获
+    guard(MM_DR_ERR_PANIC, || {
+        match crate::analyze_file(&config.input_path, &config) {
+            Ok(output) => {
+                // SAFETY: 参数已校验，透传调用方保证
+                unsafe {
+                    write_results(
+                        &output.results,
+                        &output.format,
+                        config.exclude_lfe,
+                        out,
+                        capacity,
+                        out_len,
+                        summary,
+                    )
+                }
+            }
+            Err(e) => report_error(e),
+        }
+    })
+}
+
+/// 由 C 选项构造静默的库模式配置
+fn file_app_config(input_path: PathBuf, options: &MmDrFileOptions) -> AppConfig {
+    let parallel_threads = if options.parallel_threads == 0 {
+        constants::defaults::PARALLEL_THREADS
+    } else {
+        (options.parallel_threads as usize).clamp(
+            constants::parallel_limits::MIN_PARALLEL_DEGREE,
+            constants::parallel_limits::MAX_PARALLEL_DEGREE,
+        )
+    };
+
+    AppConfig {
+        input_path,
+        verbose: false,
+        output_path: None,
+        parallel_decoding: options.parallel_decoding != 0,
+        parallel_batch_size: constants::defaults::PARALLEL_BATCH_SIZE,
+        parallel_threads,
+        parallel_files: None,
+        silence_filter_threshold_db: None,
+        edge_trim_threshold_db: None,
+        edge_trim_min_run_ms: None,
+        exclude_lfe: options.exclude_lfe != 0,
+        show_rms_peak: false,
+        compact_output: false,
+        json_output: false,
+        auto_launched: false,
+        no_save: true,
+        estimate: false,
+        two_phase_margin_db: None,
+        all_tracks: false,
+        raw_pcm: None,
+        live_span_minutes: None,
+        loudness: false,
+        true_peak: false,
+        clipping: false,
+        replay_gain: false,
+        timeline: None,
+        store_path: None,
+        query: None,
+        dsd_pcm_rate: Some(352_800),
+        dsd_gain_db: 6.0,
+        dsd_filter: "teac".to_string(),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn last_error() -> String {
+        let mut buf = vec![0 as c_char; 256];
+        let len = unsafe { mm_dr_last_error_message(buf.as_mut_ptr(), buf.len()) };
+        let message = unsafe { CStr::from_ptr(buf.as_ptr()) };
+        assert_eq!(message.to_bytes().len(), len.min(255));
+        message.to_string_lossy().into_owned()
+    }
+
+    #[test]
+    fn test_session_roundtrip() {
+        let handle = mm_dr_session_create(44100, 2);
+        assert!(!handle.is_null());
+
+        // 低电平正弦 + 周期性尖峰，保证 DR 明显大于 0
+        let samples: Vec<f32> = (0..200_000)
+            .map(|i| {
+                if i % 1000 == 0 {
+                    0.9
+                } else {
+                    ((i as f32) * 0.01).sin() * 0.1
+                }
+            })
+            .collect();
+        let code = unsafe { mm_dr_session_push_f32(handle, samples.as_ptr(), samples.len()) };
+        assert_eq!(code, MM_DR_OK);
+
+        let mut out = [MmDrChannelResult::default(); 2];
+        let mut out_len = 0usize;
+        let mut summary = MmDrSummary::default();
+
+        // 缓冲不足时报告所需容量且不结束会话
+        let code = unsafe {
+            mm_dr_session_finish(handle, out.as_mut_ptr(), 1, &mut out_len, &mut summary)
+        };
+        assert_eq!(code, MM_DR_ERR_BUFFER_TOO_SMALL);
+        assert_eq!(out_len, 2);
+
+        let code = unsafe {
+            mm_dr_session_finish(handle, out.as_mut_ptr(), 2, &mut out_len, &mut summary)
+        };
+        assert_eq!(code, MM_DR_OK);
+        assert_eq!(out_len, 2);
+        assert_eq!(summary.channels, 2);
+        assert_eq!(summary.frame_count, 100_000);
+        assert!(out[0].dr_value > 0.0);
+
+        // 结束后推送被拒绝
+        let code = unsafe { mm_dr_session_push_f32(handle, samples.as_ptr(), 2) };
+        assert_eq!(code, MM_DR_ERR_SESSION_FINISHED);
+        assert!(!last_error().is_empty());
+
+        unsafe { mm_dr_session_destroy(handle) };
+    }
+
+    #[test]
+    fn test_failed_finish_keeps_session() {
+        let handle = mm_dr_session_create(44100, 1);
+        let mut out = [MmDrChannelResult::default(); 1];
+        let mut out_len = 0usize;
+
+        // 样本过少：结算失败，但会话未结束，补推样本后可正常结束
+        let short = [0.1f32; 1];
+        unsafe { mm_dr_session_push_f32(handle, short.as_ptr(), short.len()) };
+        let code = unsafe {
+            mm_dr_session_finish(
+                handle,
+                out.as_mut_ptr(),
+                1,
+                &mut out_len,
+                std::ptr::null_mut(),
+            )
+        };
+        assert_eq!(code, MM_DR_ERR_INVALID_INPUT);
+        assert!(last_error().contains("Too few samples"));
+
+        let samples: Vec<f32> = (0..100_000)
+            .map(|i| ((i as f32) * 0.01).sin() * 0.5)
+            .collect();
+        let code = unsafe { mm_dr_session_push_f32(handle, samples.as_ptr(), samples.len()) };
+        assert_eq!(code, MM_DR_OK);
+        let code = unsafe {
+            mm_dr_session_finish(
+                handle,
+                out.as_mut_ptr(),
+                1,
+                &mut out_len,
+                std::ptr::null_mut(),
+            )
+        };
+        assert_eq!(code, MM_DR_OK);
+
+        unsafe { mm_dr_session_destroy(handle) };
+    }
+
+    #[test]
+    fn test_summary_reports_pushed_width() {
+        let handle = mm_dr_session_create(44100, 2);
+        let mut out = [MmDrChannelResult::default(); 2];
+        let mut out_len = 0usize;
+        let mut summary = MmDrSummary::default();
+
+        let ints: Vec<i16> = (0..20_000).map(|i| ((i % 200) * 100) as i16).collect();
+        assert_eq!(
+            unsafe { mm_dr_session_push_i16(handle, ints.as_ptr(), ints.len()) },
+            MM_DR_OK
+        );
+        let code = unsafe {
+            mm_dr_session_snapshot(handle, out.as_mut_ptr(), 2, &mut out_len, &mut summary)
+        };
+        assert_eq!(code, MM_DR_OK);
+        assert_eq!(summary.bits_per_sample, 16);
+
+        let wide = [1i32 << 20; 4];
+        assert_eq!(
+            unsafe { mm_dr_session_push_i32(handle, wide.as_ptr(), wide.len(), 24) },
+            MM_DR_OK
+        );
+        let code = unsafe {
+            mm_dr_session_finish(handle, out.as_mut_ptr(), 2, &mut out_len, &mut summary)
+        };
+        assert_eq!(code, MM_DR_OK);
+        assert_eq!(summary.bits_per_sample, 24);
+        assert_eq!(summary.frame_count, 10_002);
+        unsafe { mm_dr_session_destroy(handle) };
+    }
+
+    #[test]
+    fn test_panic_becomes_error_code() {
+        let code = guard(MM_DR_ERR_PANIC, || -> i32 { panic!("decoder exploded") });
+        assert_eq!(code, MM_DR_ERR_PANIC);
+        assert!(last_error().contains("decoder exploded"));
+    }
+
+    #[test]
+    fn test_invalid_arguments() {
+        assert!(mm_dr_session_create(44100, 0).is_null());
+        assert!(last_error().contains("Channel count"));
+
+        let code = unsafe { mm_dr_session_push_f32(std::ptr::null_mut(), std::ptr::null(), 0) };
+        assert_eq!(code, MM_DR_ERR_NULL_POINTER);
+
+        let handle = mm_dr_session_create(48000, 2);
+        let samples = [0.1f32; 3];
+        let code = unsafe { mm_dr_session_push_f32(handle, samples.as_ptr(), samples.len()) };
+        assert_eq!(code, MM_DR_ERR_INVALID_INPUT);
+        let code = unsafe { mm_dr_session_push_i32(handle, [0i32; 2].as_ptr(), 2, 20) };
+        assert_eq!(code, MM_DR_ERR_INVALID_INPUT);
+        unsafe { mm_dr_session_destroy(handle) };
+    }
+}
@@ -13,6 +13,7 @@
 pub mod audio;
 pub mod core;
 pub mod error;
+pub mod ffi;
 pub mod processing;
 pub mod tools;
 
@@ -21,6 +22,7 @@ pub const VERSION: &str = env!("CARGO_PKG_VERSION");
 
 // 重新导出核心类型
 pub use audio::AudioFormat; // 音频格式信息（从 audio 模块直接导出）
+pub use core::DrSession;
 pub use core::dr_calculator::DrResult;
 pub use error::{AudioError, AudioResult};
 pub use processing::ProcessingCoordinator;
@@ -3,6 +3,7 @@
 //! 纯流程控制器，负责协调各个工具模块完成DR分析任务。
 
 use macinmeter_dr_tool::{
+    AnalysisOutput,
     audio::UniversalDecoder,
     error::{AudioError, ErrorCategory},
     tools::{self, AppConfig},
@@ -141,8 +142,11 @@ fn process_batch_mode(config: &AppConfig) -> Result<(), AudioError> {
 
 /// 串行批量处理音频文件（原有逻辑）
 fn process_batch_serial(config: &AppConfig, audio_files: &[PathBuf]) -> Result<(), AudioError> {
-    // 根据文件数量选择输出策略
-    let is_single_file = audio_files.len() == 1;
+    // 根据文件数量选择输出策略（CUE整轨镜像/多音轨容器按批量报告输出）
+    // 单文件的分轨探测结果留给处理阶段复用，避免重复探测
+    let mut probed_sub_tracks =
+        (audio_files.len() == 1).then(|| tools::probe_sub_tracks(&audio_files[0], config));
+    let is_single_file = matches!(probed_sub_tracks, Some(None));
     let mut batch_output = if !is_single_file {
         tools::create_batch_output_header(config, audio_files)
     } else {
@@ -158,6 +162,13 @@ fn process_batch_serial(config: &AppConfig, audio_files: &[PathBuf]) -> Result<(
     // 排除标记统计（用于脚注）
     let mut exclusion_stats = tools::BatchExclusionStats::default();
 
+    // ReplayGain 专辑聚合（--replaygain）与削波汇总
+    let mut replay_gain = tools::BatchReplayGain::default();
+    let mut clipping = tools::BatchClipping::default();
+
+    // 结果库追加缓冲（--store）
+    let mut store = tools::BatchStore::default();
+
     // 逐个处理音频文件
     for (index, audio_file) in audio_files.iter().enumerate() {
         // 进度提示：verbose模式显示详细信息，静默模式仅显示基本进度
@@ -170,9 +181,25 @@ fn process_batch_serial(config: &AppConfig, audio_files: &[PathBuf]) -> Result<(
             );
         }
 
-        match tools::process_single_audio_file(audio_file, config) {
-            Ok((results, format, trim_report, silence_report)) => {
+        let sub_tracks = probed_sub_tracks
+            .take()
+            .unwrap_or_else(|| tools::probe_sub_tracks(audio_file, config));
+        match tools::process_batch_audio_file(audio_file, config, sub_tracks) {
+            Ok((output, sub_tracks)) => {
                 stats.inc_processed();
+                store.add(config, audio_file, &output);
+                let AnalysisOutput {
+                    results,
+                    format,
+                    edge_trim_report: trim_report,
+                    silence_filter_report: silence_report,
+                    metrics,
+                    estimated,
+                    ..
+                } = output;
+                if let Some(sub_tracks) = &sub_tracks {
+                    store.add_sub_tracks(config, audio_file, sub_tracks, &format);
+                }
 
                 if is_single_file {
                     // 单文件模式：只生成单独的DR结果文件
@@ -183,19 +210,32 @@ fn process_batch_serial(config: &AppConfig, audio_files: &[PathBuf]) -> Result<(
                         config,
                         trim_report,
                         silence_report,
+                        &metrics,
                     );
                 } else {
                     // 多文件模式：添加到批量输出并收集预警信息
+                    replay_gain.add(audio_file, &metrics);
+                    clipping.add(audio_file, &metrics);
                     if let Some(warning) = tools::add_to_batch_output(
                         &mut batch_output,
                         &results,
                         &format,
                         audio_file,
                         config.exclude_lfe,
+                        estimated,
                         &mut exclusion_stats,
                     ) {
                         batch_warnings.push(warning);
                     }
+                    if let Some(sub_tracks) = &sub_tracks {
+                        tools::add_sub_tracks_to_batch_output(
+                            &mut batch_output,
+                            sub_tracks,
+                            &format,
+                            audio_file,
+                            config.exclude_lfe,
+                        );
+                    }
                 }
 
                 if config.verbose {
@@ -237,6 +277,8 @@ fn process_batch_serial(config: &AppConfig, audio_files: &[PathBuf]) -> Result<(
         }
     }
 
+    store.commit(config);
+
     // 统一处理批量输出收尾工作（使用统计快照）
     let snapshot = stats.snapshot();
     tools::finalize_and_write_batch_output(
@@ -249,24 +291,79 @@ fn process_batch_serial(config: &AppConfig, audio_files: &[PathBuf]) -> Result<(
         is_single_file,
         batch_warnings,
         &exclusion_stats,
+        &replay_gain,
+        &clipping,
     )
 }
 
 /// 单文件处理模式
 fn process_single_mode(config: &AppConfig) -> Result<(), AudioError> {
-    let (results, format, trim_report, silence_report) =
-        tools::process_single_audio_file(&config.input_path, config)?;
-
     // 输出结果
     // - 无参数启动（双击）：自动保存报告文件
     // - 有参数启动：只输出控制台，除非用 -o 指定输出文件
     let auto_save = config.auto_launched && config.output_path.is_none();
+
+    // 估算/两阶段模式：估算结论可靠时输出带置信区间的估算报告，否则回退完整分析
+    if config.estimate || config.two_phase_margin_db.is_some() {
+        if let Some(estimate) = tools::estimate_audio_file(&config.input_path, config)?
+            && tools::estimator::estimate_is_conclusive(&estimate, config)
+        {
+            let mut store = tools::BatchStore::default();
+            store.add(
+                config,
+                &config.input_path,
+                &AnalysisOutput::from_estimate(estimate.clone()),
+            );
+            store.commit(config);
+            return tools::output_estimate_results(&estimate, config, auto_save);
+        }
+        let exact_config = AppConfig {
+            estimate: false,
+            two_phase_margin_db: None,
+            ..config.clone()
+        };
+        return process_single_mode(&exact_config);
+    }
+
+    // 多音轨容器：单次解复用分析全部音轨，逐轨输出报告
+    if config.all_tracks
+        && let Some(tracks) = tools::process_all_audio_tracks(&config.input_path, config)?
+    {
+        // 与批处理一致：首条分析成功的音轨记为主结果行，其余音轨按 `#TrackN` 记录
+        let mut store = tools::BatchStore::default();
+        if let Some(main) = tracks.iter().position(|track| track.output.is_ok()) {
+            if let Ok(output) = &tracks[main].output {
+                store.add(config, &config.input_path, output);
+            }
+            store.add_audio_tracks(config, &config.input_path, &tracks[main + 1..]);
+        }
+        store.commit(config);
+
+        return tools::output_audio_track_results(&tracks, config, auto_save);
+    }
+
+    let output = tools::process_single_audio_file(&config.input_path, config)?;
+
+    let mut store = tools::BatchStore::default();
+    store.add(config, &config.input_path, &output);
+    store.commit(config);
+
+    let AnalysisOutput {
+        results,
+        format,
+        edge_trim_report: trim_report,
+        silence_filter_report: silence_report,
+        metrics,
+        ..
+    } = output;
+
     tools::output_results(
         &results,
         config,
         &format,
         trim_report,
         silence_report,
+        &metrics,
         auto_save,
     )
 }
@@ -276,11 +373,18 @@ fn run() -> Result<(), AudioError> {
     // 1. 解析命令行参数
     let config = tools::parse_args();
 
+    // query 子命令：只读取结果库，不显示分析启动信息
+    if let Some(query) = &config.query {
+        return tools::run_query(query);
+    }
+
     // 2. 显示启动信息
     tools::show_startup_info(&config);
 
     // 3. 根据模式选择处理方式
-    let result = if config.is_batch_mode() {
+    let result = if config.live_span_minutes.is_some() {
+        tools::run_live_meter(&config)
+    } else if config.is_batch_mode() {
         process_batch_mode(&config)
     } else {
         process_single_mode(&config)
@@ -0,0 +1,315 @@
+//! 可插拔分析阶段：多个附加指标共享同一次解码
+//!
+//! DR 主链路（首尾裁切 → 样本缓冲 → 窗口RMS分析）之外的指标（响度、真峰值等）以
+//! [`AnalysisStage`] 的形式按次注册到 [`AnalysisStages`]。每个解码块只分发一次：
+//! - 需要交错视图的阶段直接读取解码块；需要平面视图的阶段共享同一次解交错结果
+//! - 多个阶段时可扇出到共享rayon线程池并行执行，否则在调用线程上依次执行
+//! - 结束时各阶段把结果写入 [`MetricReports`] 对应字段
+//!
+//! 所有阶段消费的是裁切前的原始解码块，与DR窗口分析相互独立。
+
+use super::{ChannelSeparator, LoudnessMeter, MetricReports, ReplayGainMeter, TruePeakMeter};
+use rayon::prelude::*;
+
+/// 阶段期望的样本布局
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ChunkLayout {
+    /// 交错样本（解码器原始输出）
+    Interleaved,
+    /// 按声道分离的平面样本
+    Planar,
+}
+
+/// 分发给阶段的解码块视图
+#[derive(Debug, Clone, Copy)]
+pub enum ChunkView<'a> {
+    /// 交错样本与声道数（样本数为声道数的整数倍）
+    Interleaved { samples: &'a [f32], channels: usize },
+    /// 每声道一段等长样本
+    Planar(&'a [Vec<f32>]),
+}
+
+impl ChunkView<'_> {
+    /// 本块帧数
+    pub fn frames(&self) -> usize {
+        match self {
+            ChunkView::Interleaved { samples, channels } => samples.len() / (*channels).max(1),
+            ChunkView::Planar(planar) => planar.first().map_or(0, Vec::len),
+        }
+    }
+}
+
+/// 可插拔分析阶段
+///
+/// 实现者按 [`layout`](AnalysisStage::layout) 声明的布局接收每个解码块，
+/// 在 [`finalize`](AnalysisStage::finalize) 中把结果写入 [`MetricReports`]。
+pub trait AnalysisStage: Send {
+    /// 阶段名称（诊断输出用）
+    fn name(&self) -> &'static str;
+
+    /// 期望的样本布局（默认交错，避免无谓的解交错）
+    fn layout(&self) -> ChunkLayout {
+        ChunkLayout::Interleaved
+    }
+
+    /// 处理一个解码块
+    fn process(&mut self, chunk: ChunkView<'_>);
+
+    /// 结束分析，写入结果
+    fn finalize(self: Box<Self>, reports: &mut MetricReports);
+}
+
+/// 单次运行注册的分析阶段集合
+pub struct AnalysisStages {
+    stages: Vec<Box<dyn AnalysisStage>>,
+    channels: usize,
+    parallel: bool,
+    separator: ChannelSeparator,
+    /// 平面视图缓冲（仅当存在平面阶段时填充，跨块复用容量）
+    planar: Vec<Vec<f32>>,
+}
+
+impl AnalysisStages {
+    /// 创建空集合；`parallel` 为 true 且注册了多个阶段时，每块扇出到rayon线程池
+    pub fn new(channels: usize, parallel: bool) -> Self {
+        Self {
+            stages: Vec::new(),
+            channels,
+            parallel,
+            separator: ChannelSeparator::new(),
+            planar: Vec::new(),
+        }
+    }
+
+    /// 注册一个阶段（按注册顺序执行与结算）
+    pub fn register(&mut self, stage: impl AnalysisStage + 'static) {
+        self.stages.push(Box::new(stage));
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.stages.is_empty()
+    }
+
+    /// 已注册阶段名称
+    pub fn names(&self) -> Vec<&'static str> {
+        self.stages.iter().map(|stage| stage.name()).collect()
+    }
+
+    /// 分发一个交错解码块给全部阶段
+    pub fn push_interleaved(&mut self, samples: &[f32]) {
+        if self.stages.is_empty() || self.channels == 0 {
+            return;
+        }
+
+        let needs_planar = self
+            .stages
+            .iter()
+            .any(|stage| stage.layout() == ChunkLayout::Planar);
+        if needs_planar {
+            self.planar.resize_with(self.channels, Vec::new);
+            for (channel, output) in self.planar.iter_mut().enumerate() {
+                self.separator
+                    .extract_channel_into(samples, channel, self.channels, output);
+            }
+        }
+
+        let interleaved = ChunkView::Interleaved {
+            samples,
+            channels: self.channels,
+        };
+        let planar = ChunkView::Planar(&self.planar);
+        let view_for = |stage: &dyn AnalysisStage| match stage.layout() {
+            ChunkLayout::Interleaved => interleaved,
+            ChunkLayout::Planar => planar,
+        };
+
+        if self.parallel && self.stages.len() > 1 {
+            self.stages
+                .par_iter_mut()
+                .for_each(|stage| stage.process(view_for(stage.as_ref())));
+        } else {
+            for stage in &mut self.stages {
+                stage.process(view_for(stage.as_ref()));
+            }
+        }
+    }
+
+    /// 结算全部阶段
+    pub fn finalize(self) -> MetricReports {
+        let mut reports = MetricReports::default();
+        for stage in self.stages {
+            stage.finalize(&mut reports);
+        }
+        reports
+    }
+}
+
+impl AnalysisStage for LoudnessMeter {
+    fn name(&self) -> &'static str {
+        "loudness"
+    }
+
+    fn process(&mut self, chunk: ChunkView<'_>) {
+        if let ChunkView::Interleaved { samples, .. } = chunk {
+            self.push_interleaved(samples);
+        }
+    }
+
+    fn finalize(self: Box<Self>, reports: &mut MetricReports) {
+        reports.loudness = Some(LoudnessMeter::finalize(*self));
+    }
+}
+
+impl AnalysisStage for ReplayGainMeter {
+    fn name(&self) -> &'static str {
+        if self.reports_loudness() {
+            "replaygain+loudness"
+        } else {
+            "replaygain"
+        }
+    }
+
+    fn process(&mut self, chunk: ChunkView<'_>) {
+        if let ChunkView::Interleaved { samples, .. } = chunk {
+            self.push_interleaved(samples);
+        }
+    }
+
+    fn finalize(self: Box<Self>, reports: &mut MetricReports) {
+        let report_loudness = self.reports_loudness();
+        let replay_gain = ReplayGainMeter::finalize(*self);
+        if report_loudness {
+            reports.loudness = Some(replay_gain.loudness.clone());
+        }
+        reports.replay_gain = Some(replay_gain);
+    }
+}
+
+impl AnalysisStage for TruePeakMeter {
+    fn name(&self) -> &'static str {
+        "true-peak"
+    }
+
+    fn layout(&self) -> ChunkLayout {
+        ChunkLayout::Planar
+    }
+
+    fn process(&mut self, chunk: ChunkView<'_>) {
+        match chunk {
+            ChunkView::Planar(planar) => self.push_planar(planar),
+            ChunkView::Interleaved { samples, .. } => self.push_interleaved(samples),
+        }
+    }
+
+    fn finalize(self: Box<Self>, reports: &mut MetricReports) {
+        reports.true_peak = Some(TruePeakMeter::finalize(*self));
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::{Arc, Mutex};
+
+    /// 统计帧数与首声道和的测试阶段（结算时写入共享槽位）
+    struct FrameCounter {
+        layout: ChunkLayout,
+        frames: usize,
+        first_channel_sum: f64,
+        sink: Arc<Mutex<Option<(usize, f64)>>>,
+    }
+
+    impl AnalysisStage for FrameCounter {
+        fn name(&self) -> &'static str {
+            "frame-counter"
+        }
+
+        fn layout(&self) -> ChunkLayout {
+            self.layout
+        }
+
+        fn process(&mut self, chunk: ChunkView<'_>) {
+            self.frames += chunk.frames();
+            self.first_channel_sum += match chunk {
+                ChunkView::Interleaved { samples, channels } => samples
+                    .iter()
+                    .step_by(channels)
+                    .map(|&x| x as f64)
+                    .sum::<f64>(),
+                ChunkView::Planar(planar) => planar[0].iter().map(|&x| x as f64).sum(),
+            };
+        }
+
+        fn finalize(self: Box<Self>, _reports: &mut MetricReports) {
+            *self.sink.lock().unwrap() = Some((self.frames, self.first_channel_sum));
+        }
+    }
+
+    fn stereo_ramp(frames: usize) -> Vec<f32> {
+        (0..frames)
+            .flat_map(|i| [i as f32 / frames as f32, -0.5])
+            .collect()
+    }
+
+    #[test]
+    fn test_planar_and_interleaved_views_agree() {
+        let samples = stereo_ramp(5000);
+        let sinks: Vec<_> = (0..2).map(|_| Arc::new(Mutex::new(None))).collect();
+        let mut stages = AnalysisStages::new(2, true);
+        for (layout, sink) in [ChunkLayout::Interleaved, ChunkLayout::Planar]
+            .into_iter()
+            .zip(&sinks)
+        {
+            stages.register(FrameCounter {
+                layout,
+                frames: 0,
+                first_channel_sum: 0.0,
+                sink: Arc::clone(sink),
+            });
+        }
+        for chunk in samples.chunks(1234) {
+            stages.push_interleaved(chunk);
+        }
+        stages.finalize();
+
+        let interleaved = sinks[0].lock().unwrap().unwrap();
+        let planar = sinks[1].lock().unwrap().unwrap();
+        assert_eq!(interleaved, planar);
+        assert_eq!(interleaved.0, 5000);
+    }
+
+    #[test]
+    fn test_registered_stages_fill_reports_in_one_pass() {
+        let samples = stereo_ramp(48000);
+        let format = crate::audio::AudioFormat::new(48000, 2, 24, 48000);
+
+        let run = |parallel: bool| {
+            let mut stages = AnalysisStages::new(2, parallel);
+            stages.register(LoudnessMeter::for_format(&format));
+            stages.register(TruePeakMeter::new(48000, 2, parallel));
+            assert_eq!(stages.names(), ["loudness", "true-peak"]);
+            for chunk in samples.chunks(4096) {
+                stages.push_interleaved(chunk);
+            }
+            stages.finalize()
+        };
+
+        let (inline, pooled) = (run(false), run(true));
+        let true_peak = inline.true_peak.as_ref().unwrap();
+        assert_eq!(Some(true_peak), pooled.true_peak.as_ref());
+        assert!(true_peak.channel_peaks[1] >= 0.5);
+        assert_eq!(
+            inline.loudness.unwrap().integrated_lufs,
+            pooled.loudness.unwrap().integrated_lufs
+        );
+    }
+
+    #[test]
+    fn test_empty_stage_set_is_noop() {
+        let mut stages = AnalysisStages::new(2, true);
+        assert!(stages.is_empty());
+        stages.push_interleaved(&stereo_ramp(100));
+        let reports = stages.finalize();
+        assert!(reports.loudness.is_none() && reports.true_peak.is_none());
+    }
+}
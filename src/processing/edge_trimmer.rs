@@ -18,12 +18,19 @@
 //! 防止古典音乐弱音段被误判为静音，要求连续N帧满足条件才转换状态。
 //! 迟滞是"确认状态转换"的机制，不替代 min_run 的"确认裁切有效性"。
 //!
+//! ### 尾部反向探测（可定位输入）
+//! 尾部判定只取决于文件末尾：最后一个长度 ≥ 迟滞帧数的非静音游程结束后进入 Trailing，
+//! 此后不会再回到 Passing。[`TailScanner`] 从文件末尾反向扫描找到该游程，提前得到裁切点；
+//! 流式阶段通过 [`EdgeTrimmer::set_trailing_cutoff`] 按帧数截断，Passing 态不再分类与缓冲，
+//! 结果与流式判定逐帧一致。
+//!
 //! ## 性能特性
-//! - 时间复杂度: O(N) 单遍扫描
-//! - 空间复杂度: O(min_run_frames) 环形缓冲 + O(min_run_frames) 首部缓冲
+//! - 时间复杂度: O(N) 单遍扫描；SIMD 按组分类帧，状态机按同类帧游程推进
+//! - 稳态（Passing）零拷贝：输出直接借用输入切片
+//! - 空间复杂度: O(min_run_frames) 首部缓冲 + Trailing 期间跨块缓冲
 //! - 流式处理: 支持任意大小音频文件
 
-use std::collections::VecDeque;
+use std::ops::Range;
 
 /// 边缘裁切配置（实验性功能）
 #[derive(Debug, Clone, Copy)]
@@ -144,14 +151,21 @@ impl EdgeTrimReport {
     }
 }
 
+/// 帧分类时一组样本的最大数量（一个 u64 位掩码）
+const MASK_BITS: usize = 64;
+
 /// 首尾边缘静音裁切器（min_run 语义已修复）
+///
+/// 按"同类帧游程"推进状态机：向量化分类器一次判定一组帧（≤64样本）是否静音，
+/// 定位游程边界后整段更新计数，不再逐帧调用状态机。Passing 态下整块非静音只推进区间，
+/// 输出直接借用输入切片（见 [`process_chunk_into`](Self::process_chunk_into)）。
 pub struct EdgeTrimmer {
     config: EdgeTrimConfig,
     state: TrimState,
     channels: usize,
 
-    /// 线性幅度阈值（预计算，避免重复转换）
-    threshold_amplitude: f64,
+    /// 线性幅度阈值（f32，向上取整：`|x| < threshold` 与 f64 比较结果逐位一致）
+    threshold: f32,
 
     /// 迟滞计数器（连续高于/低于阈值的帧数）
     hysteresis_counter: usize,
@@ -161,18 +175,28 @@ pub struct EdgeTrimmer {
     /// 最小持续时长（帧数）
     min_run_frames: usize,
 
+    /// 每组分类的帧数（组内样本数 ≤ `MASK_BITS`；声道数超过64时为0，走标量路径）
+    group_frames: usize,
+    /// 组内各帧首样本对应的掩码位
+    frame_start_bits: u64,
+
     /// ===== Leading 态缓冲 =====
-    /// 累积首部静音帧，直到达到 min_run 或检测到音频
-    leading_buffer: VecDeque<f32>,
+    /// 累积首部静音帧（仅保存跨块部分，本块内的帧以区间形式挂起），直到达到 min_run 或检测到音频
+    leading_buffer: Vec<f32>,
     /// 当前 Leading 态中累积的连续静音帧数
     leading_silent_count: usize,
 
     /// ===== Trailing 态缓冲 =====
-    /// 环形缓冲区（存储 Trailing 中的所有帧）
-    ring_buffer: VecDeque<f32>,
+    /// Trailing 中跨块缓冲的所有帧（本块内的帧以区间形式挂起）
+    ring_buffer: Vec<f32>,
     /// Trailing 中最后的连续静音帧数
     trailing_silent_count: usize,
 
+    /// 预先确定的尾部裁切点（帧号，自流起点计）；设置后 Passing 态直接输出至该点
+    trailing_cutoff: Option<u64>,
+    /// 已处理帧数
+    frames_processed: u64,
+
     /// 统计信息
     stats: TrimStats,
 }
@@ -180,7 +204,7 @@ pub struct EdgeTrimmer {
 impl EdgeTrimmer {
     /// 创建新的边缘裁切器
     pub fn new(config: EdgeTrimConfig, channels: usize, sample_rate: u32) -> Self {
-        let threshold_amplitude = config.threshold_amplitude();
+        let threshold = threshold_f32(config.threshold_amplitude());
 
         // 计算迟滞阈值（帧数）
         let hysteresis_threshold_frames =
@@ -192,212 +216,260 @@ impl EdgeTrimmer {
         // 计算缓冲区容量（样本数）
         let buffer_capacity_samples = min_run_frames * channels;
 
+        let group_frames = MASK_BITS / channels.max(1);
+        let frame_start_bits =
+            (0..group_frames).fold(0u64, |bits, frame| bits | 1 << (frame * channels));
+
         Self {
             config,
             state: TrimState::Leading,
             channels,
-            threshold_amplitude,
+            threshold,
             hysteresis_counter: 0,
             hysteresis_threshold_frames,
             min_run_frames,
-            leading_buffer: VecDeque::with_capacity(buffer_capacity_samples),
+            group_frames,
+            frame_start_bits,
+            leading_buffer: Vec::with_capacity(buffer_capacity_samples),
             leading_silent_count: 0,
-            ring_buffer: VecDeque::with_capacity(buffer_capacity_samples),
+            ring_buffer: Vec::with_capacity(buffer_capacity_samples),
             trailing_silent_count: 0,
+            trailing_cutoff: None,
+            frames_processed: 0,
             stats: TrimStats::default(),
         }
     }
 
-    /// 计算单帧的幅度（声道数量大于1时的聚合策略）
+    /// 设置预先确定的尾部裁切点（反向探测模式）
+    ///
+    /// 帧号 ≥ `cutoff_frame` 的帧计为尾部静音直接丢弃；Passing 态不再跟踪静音候选，
+    /// 也不再缓冲尾部。`u64::MAX` 表示探测结论为不裁尾部。须在处理第一个块之前调用。
+    pub fn set_trailing_cutoff(&mut self, cutoff_frame: u64) {
+        self.trailing_cutoff = Some(cutoff_frame);
+    }
+
+    /// 创建与本裁切器参数一致的尾部反向扫描器
+    pub fn tail_scanner(&self) -> TailScanner {
+        TailScanner {
+            channels: self.channels,
+            threshold: self.threshold,
+            hysteresis_frames: self.hysteresis_threshold_frames.max(1),
+            min_run_frames: self.min_run_frames as u64,
+            frames_scanned: 0,
+            final_silent_frames: 0,
+            final_silence_closed: false,
+            loud_run_end: 0,
+            loud_run_len: 0,
+            trim_frames: None,
+        }
+    }
+
+    /// 检查帧是否为静音（低于阈值）
     ///
     /// **声道数量大于1时的策略：取最大值（max strategy）**
     /// - 逻辑：只要任意一个声道不是静音，整帧就不视为静音
     /// - 应用：立体声中若某一声道有音频信号，则不应被裁切
-    /// - 实现：对所有声道取绝对值的最大值
     ///
     /// **PCM归一化假设**
     /// - 本模块假设输入 PCM 样本已归一化到 ±1.0FS（标准浮点范围）
     /// - dBFS 转幅度：`10^(db/20)`，例 -60 dBFS ≈ 1.00e-3
     /// - 若输入未归一化，应在解码层进行规范化，或在阈值处理前进行转换
     #[inline]
-    fn frame_amplitude(&self, samples: &[f32], frame_idx: usize) -> f64 {
-        let base_idx = frame_idx * self.channels;
-        let mut max_amplitude = 0.0_f64;
-
-        for ch in 0..self.channels {
-            let sample_idx = base_idx + ch;
-            if sample_idx < samples.len() {
-                let amp = samples[sample_idx].abs() as f64;
-                if amp > max_amplitude {
-                    max_amplitude = amp;
-                }
-            }
+    fn is_silence_frame(&self, frame: &[f32]) -> bool {
+        frame.iter().all(|sample| sample.abs() < self.threshold)
+    }
+
+    /// 从 `samples` 开头起分类为 `silent` 的连续帧数（调用者保证首帧属于该分类）
+    ///
+    /// 每组帧先由SIMD比较得到样本级静音掩码，再把各声道的位与到帧首位：
+    /// 帧静音 ⇔ 该帧全部声道静音。找到第一个分类不同的帧即返回。
+    fn run_length(&self, samples: &[f32], silent: bool) -> usize {
+        let channels = self.channels;
+        let frames = samples.len() / channels;
+        if self.group_frames == 0 {
+            return samples
+                .chunks_exact(channels)
+                .position(|frame| self.is_silence_frame(frame) != silent)
+                .unwrap_or(frames);
         }
 
-        max_amplitude
-    }
+        let mut offset = 0;
+        while offset < frames {
+            let group = self.group_frames.min(frames - offset);
+            let group_len = group * channels;
+            let sample_mask = silent_sample_mask(
+                &samples[offset * channels..offset * channels + group_len],
+                self.threshold,
+            );
+            let mut frame_mask = sample_mask;
+            for shift in 1..channels {
+                frame_mask &= sample_mask >> shift;
+            }
 
-    /// 检查帧是否为静音（低于阈值）
-    #[inline]
-    fn is_silence_frame(&self, samples: &[f32], frame_idx: usize) -> bool {
-        self.frame_amplitude(samples, frame_idx) < self.threshold_amplitude
+            let starts = self.frame_start_bits & low_bits(group_len);
+            let boundary = if silent {
+                !frame_mask & starts
+            } else {
+                frame_mask & starts
+            };
+            if boundary != 0 {
+                return offset + boundary.trailing_zeros() as usize / channels;
+            }
+            offset += group;
+        }
+        frames
     }
 
-    /// 处理单个音频块（流式）
+    /// 处理单个音频块（流式），返回保留样本的副本
+    ///
+    /// 热路径请使用 [`process_chunk_into`](Self::process_chunk_into) 以避免复制。
     pub fn process_chunk(&mut self, samples: &[f32]) -> Vec<f32> {
+        let mut scratch = Vec::new();
+        self.process_chunk_into(samples, &mut scratch).to_vec()
+    }
+
+    /// 处理单个音频块（流式），返回本块保留的样本
+    ///
+    /// 保留的样本是输入中的一段连续区间时（Passing 态的常态，以及块尾进入 Trailing 缓冲），
+    /// 直接返回输入的子切片，不复制；只有回灌跨块缓冲或区间不连续时才写入 `scratch`
+    /// （每次调用先清空，容量跨块复用）并返回其内容。
+    pub fn process_chunk_into<'a>(
+        &mut self,
+        samples: &'a [f32],
+        scratch: &'a mut Vec<f32>,
+    ) -> &'a [f32] {
+        scratch.clear();
         if !self.config.enabled || samples.is_empty() {
-            return samples.to_vec();
+            return samples;
         }
 
-        let frame_count = samples.len() / self.channels;
-        let mut output = Vec::with_capacity(samples.len());
+        let channels = self.channels;
+        let frame_count = samples.len() / channels;
+        let mut output = TrimOutput::new(samples, scratch);
 
-        for frame_idx in 0..frame_count {
-            let is_silence = self.is_silence_frame(samples, frame_idx);
-
-            match self.state {
-                TrimState::Leading => {
-                    if is_silence {
-                        // 累积静音帧
-                        self.leading_silent_count += 1;
-                        Self::append_frame_to_buffer(
-                            &mut self.leading_buffer,
-                            samples,
-                            frame_idx,
-                            self.channels,
-                        );
-
-                        // 检查是否达到 min_run 确认点
-                        if self.leading_silent_count >= self.min_run_frames {
-                            // 确认为有效首部静音，开始丢弃
-                            self.stats.leading_samples_trimmed += self.leading_buffer.len();
-                            self.leading_buffer.clear();
-                            self.leading_silent_count = 0;
-                        }
-                    } else {
-                        // 遇到非静音帧
+        // 反向探测模式：裁切点之后的帧不进入状态机
+        let frame_limit = match self.trailing_cutoff {
+            Some(cutoff) => cutoff
+                .saturating_sub(self.frames_processed)
+                .min(frame_count as u64) as usize,
+            None => frame_count,
+        };
 
-                        // 如果累积的静音 < min_run，这不符合"最小持续"要求，需要回灌
-                        if self.leading_silent_count < self.min_run_frames {
-                            output.extend(self.leading_buffer.drain(..));
-                        } else {
-                            // 否则这些静音已被确认为有效首部，不回灌
-                            self.leading_buffer.clear();
-                        }
+        // Leading/Trailing 态下本块中尚未写入缓冲的帧区间为 [pending_start, frame)
+        let mut pending_start = 0;
+        let mut frame = 0;
 
-                        self.leading_silent_count = 0;
+        while frame < frame_limit {
+            if self.state == TrimState::Passing && self.trailing_cutoff.is_some() {
+                output.push_range(frame * channels..frame_limit * channels);
+                break;
+            }
 
-                        // 输出当前非静音帧，并尝试进入 Passing 状态
-                        self.hysteresis_counter += 1;
-                        if self.hysteresis_counter >= self.hysteresis_threshold_frames {
-                            // 迟滞确认：进入 Passing 状态
-                            self.state = TrimState::Passing;
-                            self.hysteresis_counter = 0;
-                        }
+            let rest = &samples[frame * channels..frame_limit * channels];
+            let silent = self.is_silence_frame(&rest[..channels]);
+            let run = self.run_length(rest, silent);
 
-                        Self::append_frame_to_output(
-                            &mut output,
-                            samples,
-                            frame_idx,
-                            self.channels,
-                        );
-                    }
+            // 每个分支消费游程的前若干帧；发生状态转换时剩余帧在下一轮按新状态处理
+            let consumed = match (self.state, silent) {
+                (TrimState::Passing, false) => {
+                    // 正常音频帧，直接输出
+                    output.push_range(frame * channels..(frame + run) * channels);
+                    run
                 }
-
-                TrimState::Passing => {
-                    if is_silence {
-                        // 检测到静音，进入 Trailing 状态
-                        self.state = TrimState::Trailing;
-                        self.hysteresis_counter = 0;
-                        self.trailing_silent_count = 0;
+                (TrimState::Passing, true) => {
+                    // 检测到静音，进入 Trailing 状态（本帧起由 Trailing 分支缓冲）
+                    self.state = TrimState::Trailing;
+                    self.hysteresis_counter = 0;
+                    self.trailing_silent_count = 0;
+                    self.ring_buffer.clear();
+                    pending_start = frame;
+                    0
+                }
+                (TrimState::Trailing, true) => {
+                    // 继续静音，累积计数
+                    self.trailing_silent_count += run;
+                    self.hysteresis_counter = 0;
+                    run
+                }
+                (TrimState::Trailing, false) => {
+                    // 检测到非静音帧，重置静音计数
+                    self.trailing_silent_count = 0;
+                    let needed = self
+                        .hysteresis_threshold_frames
+                        .saturating_sub(self.hysteresis_counter)
+                        .max(1);
+                    if run < needed {
+                        self.hysteresis_counter += run;
+                        run
+                    } else {
+                        // 迟滞确认：回灌缓冲区（这些不是有效的尾部静音），转回 Passing
+                        output.push_buffer(&self.ring_buffer);
                         self.ring_buffer.clear();
-                        Self::append_frame_to_buffer(
-                            &mut self.ring_buffer,
-                            samples,
-                            frame_idx,
-                            self.channels,
-                        );
-                        self.trailing_silent_count += 1;
+                        output.push_range(pending_start * channels..(frame + needed) * channels);
+                        self.state = TrimState::Passing;
+                        self.hysteresis_counter = 0;
+                        needed
+                    }
+                }
+                (TrimState::Leading, true) => {
+                    let needed = self
+                        .min_run_frames
+                        .saturating_sub(self.leading_silent_count)
+                        .max(1);
+                    if run < needed {
+                        // 累积静音帧
+                        self.leading_silent_count += run;
+                        run
                     } else {
-                        // 正常音频帧，直接输出
-                        Self::append_frame_to_output(
-                            &mut output,
-                            samples,
-                            frame_idx,
-                            self.channels,
-                        );
+                        // 达到 min_run 确认点：确认为有效首部静音，丢弃
+                        let end = frame + needed;
+                        self.stats.leading_samples_trimmed +=
+                            self.leading_buffer.len() + (end - pending_start) * channels;
+                        self.leading_buffer.clear();
+                        self.leading_silent_count = 0;
+                        pending_start = end;
+                        needed
                     }
                 }
-
-                TrimState::Trailing => {
-                    // 先将当前帧加入缓冲区
-                    Self::append_frame_to_buffer(
-                        &mut self.ring_buffer,
-                        samples,
-                        frame_idx,
-                        self.channels,
-                    );
-
-                    if is_silence {
-                        // 继续静音，累积计数
-                        self.trailing_silent_count += 1;
+                (TrimState::Leading, false) => {
+                    // 累积的静音 < min_run（达到即已丢弃），不符合"最小持续"要求，回灌
+                    output.push_buffer(&self.leading_buffer);
+                    self.leading_buffer.clear();
+                    output.push_range(pending_start * channels..frame * channels);
+                    self.leading_silent_count = 0;
+
+                    // 输出非静音帧，迟滞确认后进入 Passing 状态
+                    let needed = self
+                        .hysteresis_threshold_frames
+                        .saturating_sub(self.hysteresis_counter)
+                        .max(1);
+                    let taken = run.min(needed);
+                    output.push_range(frame * channels..(frame + taken) * channels);
+                    if run >= needed {
+                        self.state = TrimState::Passing;
                         self.hysteresis_counter = 0;
                     } else {
-                        // 检测到非静音帧，重置静音计数
-                        self.trailing_silent_count = 0;
-                        self.hysteresis_counter += 1;
-
-                        // 迟滞确认：缓冲区内检测到足够的音频，可以转回 Passing
-                        if self.hysteresis_counter >= self.hysteresis_threshold_frames {
-                            // 回灌缓冲区（这些不是有效的尾部静音）
-                            output.extend(self.ring_buffer.drain(..));
-                            self.state = TrimState::Passing;
-                            self.hysteresis_counter = 0;
-                            self.trailing_silent_count = 0;
-                        }
+                        self.hysteresis_counter += run;
                     }
-
-                    // 不在此阶段丢弃缓冲，避免误删除需要回灌的静音。
+                    pending_start = frame + taken;
+                    taken
                 }
-            }
+            };
+            frame += consumed;
         }
 
-        self.stats.total_samples_processed += samples.len();
-        output
-    }
-
-    /// 将单帧追加到输出
-    #[inline]
-    fn append_frame_to_output(
-        output: &mut Vec<f32>,
-        samples: &[f32],
-        frame_idx: usize,
-        channels: usize,
-    ) {
-        let base_idx = frame_idx * channels;
-        for ch in 0..channels {
-            let sample_idx = base_idx + ch;
-            if sample_idx < samples.len() {
-                output.push(samples[sample_idx]);
-            }
+        // 挂起的帧写入跨块缓冲（不在此阶段丢弃 Trailing 缓冲，避免误删除需要回灌的静音）
+        let pending = &samples[pending_start * channels..frame_limit * channels];
+        match self.state {
+            TrimState::Leading => self.leading_buffer.extend_from_slice(pending),
+            TrimState::Trailing => self.ring_buffer.extend_from_slice(pending),
+            TrimState::Passing => {}
         }
-    }
 
-    /// 将单帧追加到通用缓冲区
-    #[inline]
-    fn append_frame_to_buffer(
-        buffer: &mut VecDeque<f32>,
-        samples: &[f32],
-        frame_idx: usize,
-        channels: usize,
-    ) {
-        let base_idx = frame_idx * channels;
-        for ch in 0..channels {
-            let sample_idx = base_idx + ch;
-            if sample_idx < samples.len() {
-                buffer.push_back(samples[sample_idx]);
-            }
-        }
+        self.stats.trailing_samples_trimmed += (frame_count - frame_limit) * channels;
+        self.frames_processed += frame_count as u64;
+        self.stats.total_samples_processed += samples.len();
+        output.finish()
     }
 
     /// 结束处理，处理尾部缓冲区
@@ -405,7 +477,7 @@ impl EdgeTrimmer {
         let final_output = match self.state {
             TrimState::Leading => {
                 // 文件结尾仍在 Leading，回灌所有累积的首部静音（即使达到 min_run，也是EOF，不裁）
-                self.leading_buffer.into_iter().collect()
+                self.leading_buffer
             }
             TrimState::Trailing => {
                 // 文件结尾在 Trailing
@@ -416,7 +488,7 @@ impl EdgeTrimmer {
                     Vec::new()
                 } else {
                     // 末尾的静音不足 min_run，或者缓冲区中有混合帧，回灌所有内容
-                    self.ring_buffer.into_iter().collect()
+                    self.ring_buffer
                 }
             }
             TrimState::Passing => {
@@ -435,6 +507,235 @@ impl EdgeTrimmer {
     }
 }
 
+/// 尾部反向扫描器：按从后往前的顺序送入文件尾部的样本块，定位尾部裁切点
+///
+/// 从文件末尾向前找到第一个长度 ≥ 迟滞帧数的非静音游程：其后的帧即流式状态机最终缓冲的
+/// Trailing 段，末尾连续静音 ≥ min_run 时整段裁切。
+pub struct TailScanner {
+    channels: usize,
+    threshold: f32,
+    hysteresis_frames: usize,
+    min_run_frames: u64,
+    /// 已扫描帧数（距文件末尾）
+    frames_scanned: u64,
+    /// 末尾连续静音帧数（遇到第一个非静音帧后固定）
+    final_silent_frames: u64,
+    final_silence_closed: bool,
+    /// 当前非静音游程的结束位置（距文件末尾的帧数）与已扫描长度
+    loud_run_end: u64,
+    loud_run_len: usize,
+    /// 判定结果：末尾需裁切的帧数
+    trim_frames: Option<u64>,
+}
+
+impl TailScanner {
+    /// 送入紧邻已扫描部分之前的一个交错样本块（块内按时间顺序排列）
+    ///
+    /// 返回末尾需裁切的帧数（0 表示不裁）；范围内尚无法判定时返回 None，可继续送入更早的块。
+    pub fn push_preceding_block(&mut self, samples: &[f32]) -> Option<u64> {
+        if self.trim_frames.is_some() {
+            return self.trim_frames;
+        }
+
+        for frame in samples.chunks_exact(self.channels).rev() {
+            let silent = frame.iter().all(|sample| sample.abs() < self.threshold);
+            if !self.final_silence_closed {
+                if silent {
+                    self.final_silent_frames += 1;
+                } else {
+                    self.final_silence_closed = true;
+                }
+            }
+
+            if silent {
+                self.loud_run_len = 0;
+            } else {
+                if self.loud_run_len == 0 {
+                    self.loud_run_end = self.frames_scanned;
+                }
+                self.loud_run_len += 1;
+                if self.loud_run_len >= self.hysteresis_frames {
+                    // 末尾连续静音达到 min_run 时整段丢弃（min_run 为0时含其中的短音频帧）
+                    let trimmed =
+                        self.loud_run_end > 0 && self.final_silent_frames >= self.min_run_frames;
+                    self.trim_frames = Some(if trimmed { self.loud_run_end } else { 0 });
+                    return self.trim_frames;
+                }
+            }
+            self.frames_scanned += 1;
+        }
+        None
+    }
+
+    /// 已扫描帧数
+    pub fn frames_scanned(&self) -> u64 {
+        self.frames_scanned
+    }
+}
+
+/// 单块裁切输出：连续的输入区间直接借用，出现缓冲回灌或区间不连续时才复制到 scratch
+struct TrimOutput<'a> {
+    samples: &'a [f32],
+    scratch: &'a mut Vec<f32>,
+    /// 尚未复制的借用区间（样本下标）
+    borrowed: Option<Range<usize>>,
+    /// 是否已转为写入 scratch
+    spilled: bool,
+}
+
+impl<'a> TrimOutput<'a> {
+    fn new(samples: &'a [f32], scratch: &'a mut Vec<f32>) -> Self {
+        Self {
+            samples,
+            scratch,
+            borrowed: None,
+            spilled: false,
+        }
+    }
+
+    /// 输出输入块中的一段样本
+    #[inline]
+    fn push_range(&mut self, range: Range<usize>) {
+        if range.is_empty() {
+            return;
+        }
+        if !self.spilled {
+            match &mut self.borrowed {
+                None => {
+                    self.borrowed = Some(range);
+                    return;
+                }
+                Some(current) if current.end == range.start => {
+                    current.end = range.end;
+                    return;
+                }
+                Some(_) => self.spill(),
+            }
+        }
+        self.scratch.extend_from_slice(&self.samples[range]);
+    }
+
+    /// 输出跨块缓冲中的样本（必然不与输入块连续）
+    fn push_buffer(&mut self, buffer: &[f32]) {
+        if buffer.is_empty() {
+            return;
+        }
+        self.spill();
+        self.scratch.extend_from_slice(buffer);
+    }
+
+    fn spill(&mut self) {
+        if !self.spilled {
+            self.spilled = true;
+            if let Some(range) = self.borrowed.take() {
+                self.scratch.extend_from_slice(&self.samples[range]);
+            }
+        }
+    }
+
+    fn finish(self) -> &'a [f32] {
+        if self.spilled {
+            let scratch: &'a Vec<f32> = self.scratch;
+            scratch
+        } else {
+            self.borrowed.map_or(&[], |range| &self.samples[range])
+        }
+    }
+}
+
+/// 把 f64 阈值向上取整到 f32：对任意 f32 样本 x，`|x| < t32` 与 `(|x| as f64) < t` 等价
+fn threshold_f32(threshold: f64) -> f32 {
+    let rounded = threshold as f32;
+    if (rounded as f64) < threshold {
+        f32::from_bits(rounded.to_bits() + 1)
+    } else {
+        rounded
+    }
+}
+
+/// 低 `bits` 位全1的掩码
+#[inline]
+fn low_bits(bits: usize) -> u64 {
+    if bits >= MASK_BITS {
+        u64::MAX
+    } else {
+        (1u64 << bits) - 1
+    }
+}
+
+/// 样本级静音掩码：第 i 位表示 `|samples[i]| < threshold`（最多64个样本；NaN 视为非静音）
+#[inline]
+fn silent_sample_mask(samples: &[f32], threshold: f32) -> u64 {
+    debug_assert!(samples.len() <= MASK_BITS);
+    #[cfg(target_arch = "x86_64")]
+    // SAFETY: SSE2 是 x86_64 基线指令集
+    unsafe {
+        silent_sample_mask_sse(samples, threshold)
+    }
+    #[cfg(target_arch = "aarch64")]
+    // SAFETY: NEON 是 aarch64 基线指令集
+    unsafe {
+        silent_sample_mask_neon(samples, threshold)
+    }
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+    {
+        silent_sample_mask_scalar(samples, threshold)
+    }
+}
+
+#[inline]
+fn silent_sample_mask_scalar(samples: &[f32], threshold: f32) -> u64 {
+    samples.iter().enumerate().fold(0, |mask, (i, &x)| {
+        mask | (u64::from(x.abs() < threshold) << i)
+    })
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn silent_sample_mask_sse(samples: &[f32], threshold: f32) -> u64 {
+    use std::arch::x86_64::*;
+
+    let sign_mask = _mm_set1_ps(-0.0);
+    let threshold_v = _mm_set1_ps(threshold);
+    let mut mask = 0u64;
+    let mut chunks = samples.chunks_exact(4);
+    for (k, chunk) in (&mut chunks).enumerate() {
+        // SAFETY: chunk 长度为4
+        let v = unsafe { _mm_loadu_ps(chunk.as_ptr()) };
+        let below = _mm_cmplt_ps(_mm_andnot_ps(sign_mask, v), threshold_v);
+        mask |= (_mm_movemask_ps(below) as u64) << (k * 4);
+    }
+    let tail = chunks.remainder();
+    if !tail.is_empty() {
+        mask |= silent_sample_mask_scalar(tail, threshold) << (samples.len() - tail.len());
+    }
+    mask
+}
+
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn silent_sample_mask_neon(samples: &[f32], threshold: f32) -> u64 {
+    use std::arch::aarch64::*;
+
+    let lane_bits: [u32; 4] = [1, 2, 4, 8];
+    // SAFETY: lane_bits 为4个u32的栈数组
+    let lane_bits = unsafe { vld1q_u32(lane_bits.as_ptr()) };
+    let threshold_v = vdupq_n_f32(threshold);
+    let mut mask = 0u64;
+    let mut chunks = samples.chunks_exact(4);
+    for (k, chunk) in (&mut chunks).enumerate() {
+        // SAFETY: chunk 长度为4
+        let v = unsafe { vld1q_f32(chunk.as_ptr()) };
+        let below = vcltq_f32(vabsq_f32(v), threshold_v);
+        mask |= (vaddvq_u32(vandq_u32(below, lane_bits)) as u64) << (k * 4);
+    }
+    let tail = chunks.remainder();
+    if !tail.is_empty() {
+        mask |= silent_sample_mask_scalar(tail, threshold) << (samples.len() - tail.len());
+    }
+    mask
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -540,4 +841,280 @@ mod tests {
 
         assert_eq!(output.len(), input.len());
     }
+
+    /// 逐帧参考实现（与游程化之前的状态机逐行对应）
+    struct ReferenceTrimmer {
+        state: TrimState,
+        channels: usize,
+        threshold: f64,
+        hysteresis_counter: usize,
+        hysteresis_threshold_frames: usize,
+        min_run_frames: usize,
+        leading_buffer: Vec<f32>,
+        leading_silent_count: usize,
+        ring_buffer: Vec<f32>,
+        trailing_silent_count: usize,
+        stats: TrimStats,
+    }
+
+    impl ReferenceTrimmer {
+        fn new(trimmer: &EdgeTrimmer) -> Self {
+            Self {
+                state: TrimState::Leading,
+                channels: trimmer.channels,
+                threshold: trimmer.config.threshold_amplitude(),
+                hysteresis_counter: 0,
+                hysteresis_threshold_frames: trimmer.hysteresis_threshold_frames,
+                min_run_frames: trimmer.min_run_frames,
+                leading_buffer: Vec::new(),
+                leading_silent_count: 0,
+                ring_buffer: Vec::new(),
+                trailing_silent_count: 0,
+                stats: TrimStats::default(),
+            }
+        }
+
+        fn process_chunk(&mut self, samples: &[f32]) -> Vec<f32> {
+            let mut output = Vec::new();
+            for frame in samples.chunks_exact(self.channels) {
+                let is_silence = frame.iter().all(|&x| (x.abs() as f64) < self.threshold);
+                match self.state {
+                    TrimState::Leading if is_silence => {
+                        self.leading_silent_count += 1;
+                        self.leading_buffer.extend_from_slice(frame);
+                        if self.leading_silent_count >= self.min_run_frames {
+                            self.stats.leading_samples_trimmed += self.leading_buffer.len();
+                            self.leading_buffer.clear();
+                            self.leading_silent_count = 0;
+                        }
+                    }
+                    TrimState::Leading => {
+                        output.append(&mut self.leading_buffer);
+                        self.leading_silent_count = 0;
+                        self.hysteresis_counter += 1;
+                        if self.hysteresis_counter >= self.hysteresis_threshold_frames {
+                            self.state = TrimState::Passing;
+                            self.hysteresis_counter = 0;
+                        }
+                        output.extend_from_slice(frame);
+                    }
+                    TrimState::Passing if is_silence => {
+                        self.state = TrimState::Trailing;
+                        self.hysteresis_counter = 0;
+                        self.ring_buffer.clear();
+                        self.ring_buffer.extend_from_slice(frame);
+                        self.trailing_silent_count = 1;
+                    }
+                    TrimState::Passing => output.extend_from_slice(frame),
+                    TrimState::Trailing => {
+                        self.ring_buffer.extend_from_slice(frame);
+                        if is_silence {
+                            self.trailing_silent_count += 1;
+                            self.hysteresis_counter = 0;
+                        } else {
+                            self.trailing_silent_count = 0;
+                            self.hysteresis_counter += 1;
+                            if self.hysteresis_counter >= self.hysteresis_threshold_frames {
+                                output.append(&mut self.ring_buffer);
+                                self.state = TrimState::Passing;
+                                self.hysteresis_counter = 0;
+                            }
+                        }
+                    }
+                }
+            }
+            self.stats.total_samples_processed += samples.len();
+            output
+        }
+
+        fn finalize(mut self) -> (Vec<f32>, TrimStats) {
+            let tail = match self.state {
+                TrimState::Leading => self.leading_buffer,
+                TrimState::Trailing if self.trailing_silent_count >= self.min_run_frames => {
+                    self.stats.trailing_samples_trimmed += self.ring_buffer.len();
+                    Vec::new()
+                }
+                TrimState::Trailing => self.ring_buffer,
+                TrimState::Passing => Vec::new(),
+            };
+            (tail, self.stats)
+        }
+    }
+
+    /// 伪随机信号：静音/音频/阈值附近/逐样本混合的随机长度段
+    fn random_signal(seed: u64, frames: usize, channels: usize, threshold: f32) -> Vec<f32> {
+        let mut state = seed;
+        let mut next = move || {
+            state = state
+                .wrapping_mul(6364136223846793005)
+                .wrapping_add(1442695040888963407);
+            (state >> 33) as usize
+        };
+        let near = [
+            threshold,
+            f32::from_bits(threshold.to_bits() - 1),
+            f32::from_bits(threshold.to_bits() + 1),
+        ];
+
+        let mut samples = Vec::with_capacity(frames * channels);
+        while samples.len() < frames * channels {
+            let kind = next() % 4;
+            let len = (1 + next() % 150) * channels;
+            for _ in 0..len {
+                let sign = if next() % 2 == 0 { 1.0 } else { -1.0 };
+                let value = match kind {
+                    0 => threshold * 0.05,
+                    1 => 0.5,
+                    2 => near[next() % near.len()],
+                    _ => [threshold * 0.5, 0.3][next() % 2],
+                };
+                samples.push(sign * value);
+            }
+        }
+        samples.truncate(frames * channels);
+        samples
+    }
+
+    #[test]
+    fn test_run_based_trimmer_matches_per_frame_reference() {
+        // sample_rate = 1000 Hz：毫秒数即帧数
+        let cases = [
+            (0.0, 0.0),
+            (0.0, 3.0),
+            (5.0, 1.0),
+            (40.0, 8.0),
+            (200.0, 20.0),
+        ];
+        for channels in [1usize, 2, 3, 6] {
+            for (seed, &(min_run_ms, hysteresis_ms)) in cases.iter().enumerate() {
+                let mut config = EdgeTrimConfig::enabled(-40.0, min_run_ms);
+                config.hysteresis_ms = hysteresis_ms;
+                let mut trimmer = EdgeTrimmer::new(config, channels, 1000);
+                let mut reference = ReferenceTrimmer::new(&trimmer);
+
+                let signal = random_signal(seed as u64 + 1, 4000, channels, trimmer.threshold);
+                let mut scratch = Vec::new();
+                let (mut actual, mut expected) = (Vec::new(), Vec::new());
+                let mut offset = 0;
+                let mut chunk_frames = 1;
+                while offset < signal.len() {
+                    let end = (offset + chunk_frames * channels).min(signal.len());
+                    actual.extend_from_slice(
+                        trimmer.process_chunk_into(&signal[offset..end], &mut scratch),
+                    );
+                    expected.extend(reference.process_chunk(&signal[offset..end]));
+                    offset = end;
+                    chunk_frames = chunk_frames * 7 % 257 + 1;
+                }
+
+                let (tail, stats) = trimmer.finalize();
+                let (expected_tail, expected_stats) = reference.finalize();
+                actual.extend(tail);
+                expected.extend(expected_tail);
+                let label = format!("channels={channels} case={seed}");
+                assert_eq!(actual, expected, "{label}");
+                assert_eq!(
+                    stats.leading_samples_trimmed, expected_stats.leading_samples_trimmed,
+                    "{label}"
+                );
+                assert_eq!(
+                    stats.trailing_samples_trimmed, expected_stats.trailing_samples_trimmed,
+                    "{label}"
+                );
+                assert_eq!(
+                    stats.total_samples_processed, expected_stats.total_samples_processed,
+                    "{label}"
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn test_tail_probe_cutoff_matches_streaming_trim() {
+        let cases = [(0.0, 0.0), (5.0, 1.0), (40.0, 8.0), (200.0, 20.0)];
+        let mut trimmed_cases = 0;
+        for channels in [1usize, 2, 6] {
+            for (seed, &(min_run_ms, hysteresis_ms)) in cases.iter().enumerate() {
+                let mut config = EdgeTrimConfig::enabled(-40.0, min_run_ms);
+                config.hysteresis_ms = hysteresis_ms;
+                let mut trimmer = EdgeTrimmer::new(config, channels, 1000);
+                let reference = ReferenceTrimmer::new(&trimmer);
+
+                let mut signal = random_signal(seed as u64 + 11, 3000, channels, trimmer.threshold);
+                if seed % 2 == 0 {
+                    signal.extend(generate_test_audio(300, 0.0, channels));
+                }
+                let total_frames = (signal.len() / channels) as u64;
+
+                // 从末尾按不等长块反向扫描
+                let mut scanner = trimmer.tail_scanner();
+                let mut end = signal.len();
+                let mut block_frames = 3;
+                let trim_frames = loop {
+                    let start = end.saturating_sub(block_frames * channels);
+                    if let Some(trim) = scanner.push_preceding_block(&signal[start..end]) {
+                        break trim;
+                    }
+                    assert!(start > 0, "random signal always has a long audio run");
+                    end = start;
+                    block_frames = block_frames * 5 % 97 + 1;
+                };
+                trimmer.set_trailing_cutoff(if trim_frames > 0 {
+                    total_frames - trim_frames
+                } else {
+                    u64::MAX
+                });
+
+                let mut expected_trimmer = reference;
+                let mut expected = expected_trimmer.process_chunk(&signal);
+                let (expected_tail, expected_stats) = expected_trimmer.finalize();
+                expected.extend(expected_tail);
+
+                let mut scratch = Vec::new();
+                let mut actual = Vec::new();
+                for chunk in signal.chunks(37 * channels) {
+                    actual.extend_from_slice(trimmer.process_chunk_into(chunk, &mut scratch));
+                }
+                let (tail, stats) = trimmer.finalize();
+                assert!(tail.is_empty());
+                trimmed_cases += usize::from(trim_frames > 0);
+
+                let label = format!("channels={channels} case={seed}");
+                assert_eq!(actual, expected, "{label}");
+                assert_eq!(
+                    stats.trailing_samples_trimmed, expected_stats.trailing_samples_trimmed,
+                    "{label}"
+                );
+                assert_eq!(
+                    stats.leading_samples_trimmed, expected_stats.leading_samples_trimmed,
+                    "{label}"
+                );
+            }
+        }
+        assert!(trimmed_cases > 0);
+    }
+
+    #[test]
+    fn test_passing_chunk_is_borrowed() {
+        let mut config = EdgeTrimConfig::enabled(-40.0, 10.0);
+        config.hysteresis_ms = 1.0;
+        let mut trimmer = EdgeTrimmer::new(config, 2, 44100);
+        let mut scratch = Vec::new();
+
+        let warmup = generate_test_audio(500, 0.5, 2);
+        trimmer.process_chunk_into(&warmup, &mut scratch);
+
+        // Passing 态的整块音频不复制
+        let audio = generate_test_audio(4096, 0.5, 2);
+        let output = trimmer.process_chunk_into(&audio, &mut scratch);
+        assert_eq!(output.as_ptr(), audio.as_ptr());
+        assert_eq!(output.len(), audio.len());
+
+        // 块尾进入 Trailing：输出仍是输入的前缀借用
+        let mut fading = generate_test_audio(1000, 0.5, 2);
+        fading.extend(generate_test_audio(200, 0.0, 2));
+        let output = trimmer.process_chunk_into(&fading, &mut scratch);
+        assert_eq!(output.as_ptr(), fading.as_ptr());
+        assert_eq!(output.len(), 2000);
+    }
 }
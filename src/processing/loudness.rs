@@ -0,0 +1,620 @@
+//! EBU R128 / ITU-R BS.1770 响度测量（积分响度 + 响度范围LRA）
+//!
+//! 与DR窗口分析共享同一次解码：直接消费交错样本块，无需额外的声道分离。
+//!
+//! ## 处理流程
+//! - **K加权**：高架预滤波 + RLB高通两级双二阶滤波（系数按采样率由模拟原型双线性变换得到，
+//!   48kHz 下与 BS.1770 表格系数一致）
+//! - **100ms 子块**：累加各声道加权均方能量
+//! - **400ms 门限块**（75%重叠，即每个子块出一块）：绝对门限 -70 LUFS + 相对门限 -10 LU → 积分响度
+//! - **3s 短期块**（10Hz 更新）：绝对门限 -70 LUFS + 相对门限 -20 LU → P10~P95 即 LRA（EBU Tech 3342）
+//!
+//! ## SIMD
+//! 交错样本中相邻两个声道恰好构成一个 2×f64 向量：滤波按声道对执行（x86_64 SSE2 / ARM NEON），
+//! 运算顺序与标量实现完全相同，结果逐位一致；奇数声道的最后一路走标量路径。
+
+use crate::audio::{AudioFormat, channel_layout};
+#[cfg(target_arch = "x86_64")]
+use std::arch::x86_64::*;
+
+/// BS.1770 响度偏移（dB）：LUFS = -0.691 + 10·log10(Σ G·z)
+const LOUDNESS_OFFSET_DB: f64 = -0.691;
+/// 绝对门限（LUFS）
+const ABSOLUTE_GATE_LUFS: f64 = -70.0;
+/// 积分响度相对门限（LU）
+const INTEGRATED_RELATIVE_GATE_LU: f64 = -10.0;
+/// LRA 相对门限（LU）
+const LRA_RELATIVE_GATE_LU: f64 = -20.0;
+/// LRA 下/上分位
+const LRA_LOW_PERCENTILE: f64 = 0.10;
+const LRA_HIGH_PERCENTILE: f64 = 0.95;
+/// 门限块 / 短期块包含的 100ms 子块数
+const GATING_BLOCK_SUB_BLOCKS: usize = 4;
+const SHORT_TERM_SUB_BLOCKS: usize = 30;
+/// 环绕声道加权（+1.5 dB）
+const SURROUND_CHANNEL_WEIGHT: f64 = 1.41;
+/// 滤波器状态冲零阈值：低于此值的状态对能量的贡献远低于绝对门限，
+/// 冲零可避免静音段长期停留在非规格化浮点数上拖慢运算
+const DENORMAL_FLUSH_THRESHOLD: f64 = 1e-20;
+
+/// 双二阶滤波系数（a0 已归一化）
+#[derive(Debug, Clone, Copy)]
+struct Biquad {
+    b0: f64,
+    b1: f64,
+    b2: f64,
+    a1: f64,
+    a2: f64,
+}
+
+/// K加权滤波器（预滤波 + RLB高通）
+#[derive(Debug, Clone, Copy)]
+struct KWeighting {
+    shelf: Biquad,
+    highpass: Biquad,
+}
+
+impl KWeighting {
+    /// 按采样率生成系数（与 libebur128 相同的模拟原型参数）
+    fn new(sample_rate: u32) -> Self {
+        let rate = sample_rate as f64;
+
+        let f0 = 1_681.974_450_955_533;
+        let gain_db = 3.999_843_853_973_347;
+        let q = 0.707_175_236_955_419_6;
+        let k = (std::f64::consts::PI * f0 / rate).tan();
+        let vh = 10_f64.powf(gain_db / 20.0);
+        let vb = vh.powf(0.499_666_774_154_541_6);
+        let a0 = 1.0 + k / q + k * k;
+        let shelf = Biquad {
+            b0: (vh + vb * k / q + k * k) / a0,
+            b1: 2.0 * (k * k - vh) / a0,
+            b2: (vh - vb * k / q + k * k) / a0,
+            a1: 2.0 * (k * k - 1.0) / a0,
+            a2: (1.0 - k / q + k * k) / a0,
+        };
+
+        let f0 = 38.135_470_876_024_44;
+        let q = 0.500_327_037_323_877_3;
+        let k = (std::f64::consts::PI * f0 / rate).tan();
+        let a0 = 1.0 + k / q + k * k;
+        let highpass = Biquad {
+            b0: 1.0,
+            b1: -2.0,
+            b2: 1.0,
+            a1: 2.0 * (k * k - 1.0) / a0,
+            a2: (1.0 - k / q + k * k) / a0,
+        };
+
+        Self { shelf, highpass }
+    }
+
+    /// 单样本滤波（转置直接II型，两级级联）
+    ///
+    /// 状态布局：`[预滤波 s1, 预滤波 s2, 高通 s1, 高通 s2]`
+    #[inline(always)]
+    fn process(&self, state: &mut [f64; 4], x: f64) -> f64 {
+        let s = &self.shelf;
+        let y1 = s.b0 * x + state[0];
+        state[0] = s.b1 * x - s.a1 * y1 + state[1];
+        state[1] = s.b2 * x - s.a2 * y1;
+
+        let h = &self.highpass;
+        let y2 = h.b0 * y1 + state[2];
+        state[2] = h.b1 * y1 - h.a1 * y2 + state[3];
+        state[3] = h.b2 * y1 - h.a2 * y2;
+        y2
+    }
+}
+
+/// 响度测量结果
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct LoudnessReport {
+    /// 积分响度（LUFS）；全部门限块低于绝对门限时为 None
+    pub integrated_lufs: Option<f64>,
+    /// 响度范围（LU）；不足一个3秒短期块或全部被门限剔除时为 None
+    pub loudness_range_lu: Option<f64>,
+    /// 400ms 门限块的加权均方能量（供专辑级聚合重新门限）
+    pub gating_block_energies: Vec<f64>,
+}
+
+impl LoudnessReport {
+    /// 由多段节目的门限块合并计算整体积分响度（如专辑）
+    pub fn combined_integrated_lufs<'a>(
+        reports: impl IntoIterator<Item = &'a LoudnessReport>,
+    ) -> Option<f64> {
+        let blocks: Vec<f64> = reports
+            .into_iter()
+            .flat_map(|report| report.gating_block_energies.iter().copied())
+            .collect();
+        gated_mean_energy(&blocks, INTEGRATED_RELATIVE_GATE_LU).map(energy_to_lufs)
+    }
+}
+
+/// 流式 BS.1770 响度表
+pub struct LoudnessMeter {
+    channels: usize,
+    weights: Vec<f64>,
+    filter: KWeighting,
+    /// 每声道滤波状态
+    states: Vec<[f64; 4]>,
+    /// 当前子块内每声道 K 加权平方和
+    channel_sums: Vec<f64>,
+    sub_block_frames: usize,
+    frames_in_sub_block: usize,
+    /// 最近30个子块的加权均方能量（环形）
+    recent_sub_blocks: Vec<f64>,
+    sub_blocks_seen: usize,
+    gating_blocks: Vec<f64>,
+    short_term_blocks: Vec<f64>,
+}
+
+impl LoudnessMeter {
+    /// 创建响度表；`weights` 为各声道 BS.1770 加权（LFE 为 0）
+    pub fn new(sample_rate: u32, weights: Vec<f64>) -> Self {
+        let channels = weights.len();
+        Self {
+            channels,
+            weights,
+            filter: KWeighting::new(sample_rate),
+            states: vec![[0.0; 4]; channels],
+            channel_sums: vec![0.0; channels],
+            sub_block_frames: ((sample_rate as f64 / 10.0).round() as usize).max(1),
+            frames_in_sub_block: 0,
+            recent_sub_blocks: vec![0.0; SHORT_TERM_SUB_BLOCKS],
+            sub_blocks_seen: 0,
+            gating_blocks: Vec::new(),
+            short_term_blocks: Vec::new(),
+        }
+    }
+
+    /// 按音频格式创建：LFE/环绕声道取自声道布局元数据，缺失时按常见 5.0/5.1 布局推断
+    pub fn for_format(format: &AudioFormat) -> Self {
+        let lfe_indices = if !format.lfe_indices.is_empty() {
+            format.lfe_indices.clone()
+        } else if format.channels >= 6 {
+            channel_layout::fallback_lfe_indices(format.channels)
+        } else {
+            Vec::new()
+        };
+        // 有布局元数据却没有环绕位（如 3.0、7.1(wide)）时全部按 1.0 计，不再按声道数猜测
+        let surround_indices = if !format.surround_indices.is_empty() {
+            format.surround_indices.clone()
+        } else if !format.has_channel_layout_metadata {
+            channel_layout::fallback_surround_indices(format.channels)
+        } else {
+            Vec::new()
+        };
+        Self::new(
+            format.sample_rate,
+            Self::channel_weights(format.channels as usize, &lfe_indices, &surround_indices),
+        )
+    }
+
+    /// BS.1770 声道加权：LFE 不计入；环绕声道 1.41；其余（前置、高度等）1.0
+    pub fn channel_weights(
+        channels: usize,
+        lfe_indices: &[usize],
+        surround_indices: &[usize],
+    ) -> Vec<f64> {
+        (0..channels)
+            .map(|idx| {
+                if lfe_indices.contains(&idx) {
+                    0.0
+                } else if surround_indices.contains(&idx) {
+                    SURROUND_CHANNEL_WEIGHT
+                } else {
+                    1.0
+                }
+            })
+            .collect()
+    }
+
+    /// 送入一段交错样本（可在任意帧边界切分）
+    pub fn push_interleaved(&mut self, samples: &[f32]) {
+        let channels = self.channels;
+        if channels == 0 {
+            return;
+        }
+
+        let mut rest = &samples[..samples.len() - samples.len() % channels];
+        while !rest.is_empty() {
+            let frames =
+                (rest.len() / channels).min(self.sub_block_frames - self.frames_in_sub_block);
+            let (run, tail) = rest.split_at(frames * channels);
+            self.filter_run(run);
+            self.frames_in_sub_block += frames;
+            if self.frames_in_sub_block == self.sub_block_frames {
+                self.close_sub_block();
+            }
+            rest = tail;
+        }
+    }
+
+    /// 结束测量并计算积分响度与LRA（不足100ms的尾部样本不构成完整块，按规范丢弃）
+    pub fn finalize(self) -> LoudnessReport {
+        let integrated_lufs =
+            gated_mean_energy(&self.gating_blocks, INTEGRATED_RELATIVE_GATE_LU).map(energy_to_lufs);
+        let loudness_range_lu = loudness_range(&self.short_term_blocks);
+        LoudnessReport {
+            integrated_lufs,
+            loudness_range_lu,
+            gating_block_energies: self.gating_blocks,
+        }
+    }
+
+    /// 滤波一段完整帧并累加每声道平方和（累加顺序与分块方式无关）
+    fn filter_run(&mut self, run: &[f32]) {
+        let channels = self.channels;
+        let mut channel = 0;
+        while channel + 1 < channels {
+            #[cfg(target_arch = "x86_64")]
+            // SAFETY: SSE2 是 x86_64 基线指令集；channel+1 < channels 保证声道对在帧内。
+            unsafe {
+                self.filter_pair_sse2(run, channel);
+            }
+            #[cfg(target_arch = "aarch64")]
+            // SAFETY: NEON 是 aarch64 基线指令集；channel+1 < channels 保证声道对在帧内。
+            unsafe {
+                self.filter_pair_neon(run, channel);
+            }
+            #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+            {
+                self.filter_channel_scalar(run, channel);
+                self.filter_channel_scalar(run, channel + 1);
+            }
+            channel += 2;
+        }
+        if channel < channels {
+            self.filter_channel_scalar(run, channel);
+        }
+    }
+
+    /// 标量路径：单声道滤波
+    fn filter_channel_scalar(&mut self, run: &[f32], channel: usize) {
+        let filter = self.filter;
+        let mut state = self.states[channel];
+        let mut sum = self.channel_sums[channel];
+        for frame in run.chunks_exact(self.channels) {
+            let y = filter.process(&mut state, frame[channel] as f64);
+            sum += y * y;
+        }
+        self.states[channel] = state;
+        self.channel_sums[channel] = sum;
+    }
+
+    /// SSE2 路径：相邻两个声道作为一个 2×f64 向量同时滤波
+    #[cfg(target_arch = "x86_64")]
+    #[target_feature(enable = "sse2")]
+    unsafe fn filter_pair_sse2(&mut self, run: &[f32], channel: usize) {
+        let (s, h) = (self.filter.shelf, self.filter.highpass);
+        let (left, right) = (self.states[channel], self.states[channel + 1]);
+        let mut st = [
+            _mm_set_pd(right[0], left[0]),
+            _mm_set_pd(right[1], left[1]),
+            _mm_set_pd(right[2], left[2]),
+            _mm_set_pd(right[3], left[3]),
+        ];
+        let (sb0, sb1, sb2) = (_mm_set1_pd(s.b0), _mm_set1_pd(s.b1), _mm_set1_pd(s.b2));
+        let (sa1, sa2) = (_mm_set1_pd(s.a1), _mm_set1_pd(s.a2));
+        let (hb0, hb1, hb2) = (_mm_set1_pd(h.b0), _mm_set1_pd(h.b1), _mm_set1_pd(h.b2));
+        let (ha1, ha2) = (_mm_set1_pd(h.a1), _mm_set1_pd(h.a2));
+        let mut sum = _mm_set_pd(self.channel_sums[channel + 1], self.channel_sums[channel]);
+
+        for frame in run.chunks_exact(self.channels) {
+            let x = _mm_set_pd(frame[channel + 1] as f64, frame[channel] as f64);
+
+            let y1 = _mm_add_pd(_mm_mul_pd(sb0, x), st[0]);
+            st[0] = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(sb1, x), _mm_mul_pd(sa1, y1)), st[1]);
+            st[1] = _mm_sub_pd(_mm_mul_pd(sb2, x), _mm_mul_pd(sa2, y1));
+
+            let y2 = _mm_add_pd(_mm_mul_pd(hb0, y1), st[2]);
+            st[2] = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(hb1, y1), _mm_mul_pd(ha1, y2)), st[3]);
+            st[3] = _mm_sub_pd(_mm_mul_pd(hb2, y1), _mm_mul_pd(ha2, y2));
+
+            sum = _mm_add_pd(sum, _mm_mul_pd(y2, y2));
+        }
+
+        let mut lanes = [[0.0f64; 2]; 5];
+        for (lane, vector) in lanes.iter_mut().zip(st.iter().chain(std::iter::once(&sum))) {
+            // SAFETY: lane 为2个f64的栈数组，_mm_storeu_pd 写入恰好16字节
+            unsafe { _mm_storeu_pd(lane.as_mut_ptr(), *vector) };
+        }
+        for (i, lane) in lanes[..4].iter().enumerate() {
+            self.states[channel][i] = lane[0];
+            self.states[channel + 1][i] = lane[1];
+        }
+        self.channel_sums[channel] = lanes[4][0];
+        self.channel_sums[channel + 1] = lanes[4][1];
+    }
+
+    /// NEON 路径：相邻两个声道作为一个 2×f64 向量同时滤波
+    #[cfg(target_arch = "aarch64")]
+    #[target_feature(enable = "neon")]
+    unsafe fn filter_pair_neon(&mut self, run: &[f32], channel: usize) {
+        use std::arch::aarch64::*;
+
+        let (s, h) = (self.filter.shelf, self.filter.highpass);
+        let (left, right) = (self.states[channel], self.states[channel + 1]);
+        let pair = |a: f64, b: f64| {
+            // SAFETY: 从2个f64的栈数组加载16字节
+            unsafe { vld1q_f64([a, b].as_ptr()) }
+        };
+        let mut st = [
+            pair(left[0], right[0]),
+            pair(left[1], right[1]),
+            pair(left[2], right[2]),
+            pair(left[3], right[3]),
+        ];
+        let (sb0, sb1, sb2) = (vdupq_n_f64(s.b0), vdupq_n_f64(s.b1), vdupq_n_f64(s.b2));
+        let (sa1, sa2) = (vdupq_n_f64(s.a1), vdupq_n_f64(s.a2));
+        let (hb0, hb1, hb2) = (vdupq_n_f64(h.b0), vdupq_n_f64(h.b1), vdupq_n_f64(h.b2));
+        let (ha1, ha2) = (vdupq_n_f64(h.a1), vdupq_n_f64(h.a2));
+        let mut sum = pair(self.channel_sums[channel], self.channel_sums[channel + 1]);
+
+        // 显式使用 mul + add/sub（不使用 FMA），保持与标量路径逐位一致
+        for frame in run.chunks_exact(self.channels) {
+            let x = pair(frame[channel] as f64, frame[channel + 1] as f64);
+
+            let y1 = vaddq_f64(vmulq_f64(sb0, x), st[0]);
+            st[0] = vaddq_f64(vsubq_f64(vmulq_f64(sb1, x), vmulq_f64(sa1, y1)), st[1]);
+            st[1] = vsubq_f64(vmulq_f64(sb2, x), vmulq_f64(sa2, y1));
+
+            let y2 = vaddq_f64(vmulq_f64(hb0, y1), st[2]);
+            st[2] = vaddq_f64(vsubq_f64(vmulq_f64(hb1, y1), vmulq_f64(ha1, y2)), st[3]);
+            st[3] = vsubq_f64(vmulq_f64(hb2, y1), vmulq_f64(ha2, y2));
+
+            sum = vaddq_f64(sum, vmulq_f64(y2, y2));
+        }
+
+        for (i, vector) in st.iter().enumerate() {
+            self.states[channel][i] = vgetq_lane_f64(*vector, 0);
+            self.states[channel + 1][i] = vgetq_lane_f64(*vector, 1);
+        }
+        self.channel_sums[channel] = vgetq_lane_f64(sum, 0);
+        self.channel_sums[channel + 1] = vgetq_lane_f64(sum, 1);
+    }
+
+    /// 子块结束：合成加权能量，产出门限块/短期块
+    fn close_sub_block(&mut self) {
+        let frames = self.sub_block_frames as f64;
+        let energy: f64 = self
+            .channel_sums
+            .iter()
+            .zip(&self.weights)
+            .map(|(sum, weight)| weight * sum / frames)
+            .sum();
+        self.channel_sums.iter_mut().for_each(|sum| *sum = 0.0);
+        self.frames_in_sub_block = 0;
+
+        for state in self.states.iter_mut().flatten() {
+            if state.abs() < DENORMAL_FLUSH_THRESHOLD {
+                *state = 0.0;
+            }
+        }
+
+        self.recent_sub_blocks[self.sub_blocks_seen % SHORT_TERM_SUB_BLOCKS] = energy;
+        self.sub_blocks_seen += 1;
+
+        if self.sub_blocks_seen >= GATING_BLOCK_SUB_BLOCKS {
+            self.gating_blocks
+                .push(self.recent_mean_energy(GATING_BLOCK_SUB_BLOCKS));
+        }
+        if self.sub_blocks_seen >= SHORT_TERM_SUB_BLOCKS {
+            self.short_term_blocks
+                .push(self.recent_mean_energy(SHORT_TERM_SUB_BLOCKS));
+        }
+    }
+
+    /// 最近 `count` 个子块的平均能量
+    fn recent_mean_energy(&self, count: usize) -> f64 {
+        let sum: f64 = (1..=count)
+            .map(|back| {
+                self.recent_sub_blocks[(self.sub_blocks_seen - back) % SHORT_TERM_SUB_BLOCKS]
+            })
+            .sum();
+        sum / count as f64
+    }
+}
+
+#[inline]
+fn energy_to_lufs(energy: f64) -> f64 {
+    LOUDNESS_OFFSET_DB + 10.0 * energy.log10()
+}
+
+#[inline]
+fn lufs_to_energy(lufs: f64) -> f64 {
+    10_f64.powf((lufs - LOUDNESS_OFFSET_DB) / 10.0)
+}
+
+/// 高于门限的块的平均能量
+fn mean_energy_above(blocks: &[f64], gate: f64) -> Option<f64> {
+    let (sum, count) = blocks
+        .iter()
+        .filter(|&&energy| energy > gate)
+        .fold((0.0, 0usize), |(sum, count), &energy| {
+            (sum + energy, count + 1)
+        });
+    (count > 0).then(|| sum / count as f64)
+}
+
+/// 绝对门限之上再按相对门限（LU）截取的门限值
+fn relative_gate(blocks: &[f64], relative_gate_lu: f64) -> Option<f64> {
+    let absolute_gate = lufs_to_energy(ABSOLUTE_GATE_LUFS);
+    let absolute_mean = mean_energy_above(blocks, absolute_gate)?;
+    Some(absolute_gate.max(absolute_mean * 10_f64.powf(relative_gate_lu / 10.0)))
+}
+
+/// 两级门限后的平均能量（绝对门限 → 相对门限）
+fn gated_mean_energy(blocks: &[f64], relative_gate_lu: f64) -> Option<f64> {
+    mean_energy_above(blocks, relative_gate(blocks, relative_gate_lu)?)
+}
+
+/// EBU Tech 3342 响度范围：门限后短期响度分布的 P10~P95 跨度
+fn loudness_range(short_term_blocks: &[f64]) -> Option<f64> {
+    let gate = relative_gate(short_term_blocks, LRA_RELATIVE_GATE_LU)?;
+
+    let mut loudness: Vec<f64> = short_term_blocks
+        .iter()
+        .filter(|&&energy| energy > gate)
+        .map(|&energy| energy_to_lufs(energy))
+        .collect();
+    if loudness.is_empty() {
+        return None;
+    }
+    loudness.sort_by(f64::total_cmp);
+
+    let percentile = |p: f64| loudness[((loudness.len() - 1) as f64 * p).round() as usize];
+    Some(percentile(LRA_HIGH_PERCENTILE) - percentile(LRA_LOW_PERCENTILE))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sine(frequency: f64, amplitude: f64, sample_rate: u32, seconds: f64) -> Vec<f32> {
+        let frames = (sample_rate as f64 * seconds) as usize;
+        (0..frames)
+            .map(|i| {
+                (amplitude
+                    * (2.0 * std::f64::consts::PI * frequency * i as f64 / sample_rate as f64)
+                        .sin()) as f32
+            })
+            .collect()
+    }
+
+    fn interleave(channels: &[Vec<f32>]) -> Vec<f32> {
+        let frames = channels[0].len();
+        (0..frames)
+            .flat_map(|i| channels.iter().map(move |channel| channel[i]))
+            .collect()
+    }
+
+    #[test]
+    fn test_k_weighting_matches_bs1770_table_at_48k() {
+        let k = KWeighting::new(48000);
+        assert!((k.shelf.b0 - 1.535_124_859_586_97).abs() < 1e-6);
+        assert!((k.shelf.a1 + 1.690_659_293_182_41).abs() < 1e-6);
+        assert!((k.highpass.a1 + 1.990_047_454_833_98).abs() < 1e-6);
+        assert!((k.highpass.a2 - 0.990_072_250_366_21).abs() < 1e-6);
+    }
+
+    #[test]
+    fn test_stereo_1k_sine_at_minus_20_dbfs_is_minus_20_lufs() {
+        // EBU Tech 3341 基准：双声道 1kHz -20dBFS 正弦 → -20 LUFS（允许 ±0.1）
+        let tone = sine(1000.0, 0.1, 48000, 20.0);
+        let mut meter = LoudnessMeter::new(48000, vec![1.0, 1.0]);
+        meter.push_interleaved(&interleave(&[tone.clone(), tone]));
+        let report = meter.finalize();
+
+        let integrated = report.integrated_lufs.unwrap();
+        assert!((integrated + 20.0).abs() < 0.1, "integrated = {integrated}");
+        assert!(report.loudness_range_lu.unwrap() < 0.1);
+    }
+
+    #[test]
+    fn test_loudness_range_of_alternating_levels() {
+        // EBU Tech 3342 基准思路：-20/-30 dBFS 交替段 → LRA 约 10 LU
+        let mut tone = Vec::new();
+        for _ in 0..3 {
+            tone.extend(sine(1000.0, 0.1, 48000, 20.0));
+            tone.extend(sine(1000.0, 0.031_622_8, 48000, 20.0));
+        }
+        let mut meter = LoudnessMeter::new(48000, vec![1.0, 1.0]);
+        meter.push_interleaved(&interleave(&[tone.clone(), tone]));
+        let lra = meter.finalize().loudness_range_lu.unwrap();
+        assert!((lra - 10.0).abs() < 0.5, "lra = {lra}");
+    }
+
+    #[test]
+    fn test_chunking_and_simd_pairs_match_scalar() {
+        let left = sine(440.0, 0.5, 44100, 2.0);
+        let right = sine(3000.0, 0.25, 44100, 2.0);
+        let center = sine(100.0, 0.3, 44100, 2.0);
+        let samples = interleave(&[left, right, center]);
+
+        let mut whole = LoudnessMeter::new(44100, vec![1.0; 3]);
+        whole.push_interleaved(&samples);
+
+        let mut chunked = LoudnessMeter::new(44100, vec![1.0; 3]);
+        for chunk in samples.chunks(3 * 1237) {
+            chunked.push_interleaved(chunk);
+        }
+
+        let mut scalar = LoudnessMeter::new(44100, vec![1.0; 3]);
+        for frame_run in samples.chunks(3 * 4410) {
+            for channel in 0..3 {
+                scalar.filter_channel_scalar(frame_run, channel);
+            }
+            scalar.frames_in_sub_block += frame_run.len() / 3;
+            if scalar.frames_in_sub_block == scalar.sub_block_frames {
+                scalar.close_sub_block();
+            }
+        }
+
+        let whole = whole.finalize();
+        assert_eq!(whole, chunked.finalize());
+        assert_eq!(whole, scalar.finalize());
+    }
+
+    #[test]
+    fn test_silence_and_short_input() {
+        let mut meter = LoudnessMeter::new(48000, vec![1.0]);
+        meter.push_interleaved(&vec![0.0; 48000 * 5]);
+        let report = meter.finalize();
+        assert_eq!(report.integrated_lufs, None);
+        assert_eq!(report.loudness_range_lu, None);
+
+        let mut meter = LoudnessMeter::new(48000, vec![1.0]);
+        meter.push_interleaved(&sine(1000.0, 0.5, 48000, 1.0));
+        let report = meter.finalize();
+        assert!(report.integrated_lufs.is_some());
+        assert_eq!(report.loudness_range_lu, None);
+    }
+
+    #[test]
+    fn test_channel_weights() {
+        assert_eq!(LoudnessMeter::channel_weights(2, &[], &[]), vec![1.0, 1.0]);
+        assert_eq!(
+            LoudnessMeter::channel_weights(6, &[3], &[4, 5]),
+            vec![1.0, 1.0, 1.0, 0.0, 1.41, 1.41]
+        );
+    }
+
+    #[test]
+    fn test_channel_weights_follow_layout() {
+        // 7.1.4（FL FR FC LFE BL BR SL SR TFL TFR TBL TBR）：仅侧环绕 1.41，后环绕与高度声道 1.0
+        let mut format = AudioFormat::new(48_000, 12, 24, 0);
+        format.set_lfe_indices(vec![3]);
+        format.set_surround_indices(channel_layout::surround_indices_from_mask(0x2D63F));
+        let meter = LoudnessMeter::for_format(&format);
+        assert_eq!(
+            meter.weights,
+            vec![1.0, 1.0, 1.0, 0.0, 1.0, 1.0, 1.41, 1.41, 1.0, 1.0, 1.0, 1.0]
+        );
+
+        // 无布局元数据：5.1 按常见顺序推断，12 声道不作猜测
+        let meter = LoudnessMeter::for_format(&AudioFormat::new(48_000, 6, 24, 0));
+        assert_eq!(meter.weights, vec![1.0, 1.0, 1.0, 0.0, 1.41, 1.41]);
+        let meter = LoudnessMeter::for_format(&AudioFormat::new(48_000, 12, 24, 0));
+        assert_eq!(meter.weights[4..], [1.0; 8]);
+    }
+
+    #[test]
+    fn test_combined_integrated_matches_concatenation() {
+        let loud = sine(1000.0, 0.1, 48000, 10.0);
+        let quiet = sine(1000.0, 0.05, 48000, 10.0);
+
+        let measure = |samples: &[f32]| {
+            let mut meter = LoudnessMeter::new(48000, vec![1.0]);
+            meter.push_interleaved(samples);
+            meter.finalize()
+        };
+        let (a, b) = (measure(&loud), measure(&quiet));
+        let combined = LoudnessReport::combined_integrated_lufs([&a, &b]).unwrap();
+
+        let single = a.integrated_lufs.unwrap().max(b.integrated_lufs.unwrap());
+        assert!(combined < single);
+        assert!(combined > b.integrated_lufs.unwrap());
+    }
+}
@@ -7,13 +7,19 @@
 //! - **当前实现**: ARM NEON / x86 SSE2，针对f32平方和计算优化
 //! - **平台相关**: 向量宽度和内存架构会影响实际加速比
 
+pub mod analysis_stage;
 pub mod channel_separator;
 pub mod dr_channel_state;
 pub mod edge_trimmer;
+pub mod loudness;
 pub mod performance_metrics;
 pub mod processing_coordinator;
+pub mod replay_gain;
 pub mod sample_conversion;
 pub mod simd_core;
+pub mod spsc_ring;
+pub mod timeline;
+pub mod true_peak;
 
 // 重新导出公共接口
 pub use processing_coordinator::ProcessingCoordinator; // 外部API
@@ -35,8 +41,96 @@ pub use performance_metrics::{
     PerformanceEvaluator, PerformanceResult, PerformanceStats, SimdUsageStats,
 };
 
+// 解码→分析流水线通道
+pub use spsc_ring::{RingConsumer, RingProducer, spsc_ring};
+
 // 边缘裁切类型（实验性功能）
-pub use edge_trimmer::{EdgeTrimConfig, EdgeTrimReport, EdgeTrimmer, TrimStats};
+pub use edge_trimmer::{EdgeTrimConfig, EdgeTrimReport, EdgeTrimmer, TailScanner, TrimStats};
+
+// 响度测量（EBU R128 / BS.1770）
+pub use loudness::{LoudnessMeter, LoudnessReport};
+
+// 真峰值测量（BS.1770 过采样插值峰值）
+pub use true_peak::{TruePeakMeter, TruePeakReport};
+
+// ReplayGain 2.0（复用响度表的 K 加权）
+pub use replay_gain::{AlbumGain, AlbumGainAccumulator, ReplayGainMeter, ReplayGainReport};
+
+// 逐窗口时间线导出
+pub use timeline::{TimelineFormat, WindowTimeline};
+
+// 可插拔分析阶段（附加指标共享同一次解码）
+pub use analysis_stage::{AnalysisStage, AnalysisStages, ChunkLayout, ChunkView};
+
+use crate::core::{ClipStats, histogram::WindowRmsAnalyzer};
+
+/// 附加指标报告：与DR共享同一次解码的可选分析阶段的结果（供输出模块使用）
+#[derive(Debug, Clone, Default)]
+pub struct MetricReports {
+    /// EBU R128 积分响度与响度范围（`--loudness`）
+    pub loudness: Option<LoudnessReport>,
+    /// 过采样真峰值（`--true-peak`）
+    pub true_peak: Option<TruePeakReport>,
+    /// ReplayGain 2.0 音轨增益与峰值（`--replaygain`）
+    pub replay_gain: Option<ReplayGainReport>,
+    /// 削波统计（随DR窗口分析收集，始终可用；估算模式为 None）
+    pub clipping: Option<ClippingReport>,
+    /// 逐窗口 RMS/Peak 时间线（`--timeline`）
+    pub timeline: Option<WindowTimeline>,
+}
+
+/// 单声道削波报告（供输出模块使用）
+#[derive(Debug, Clone)]
+pub struct ClippingChannelReport {
+    pub channel_index: usize,
+    pub stats: ClipStats,
+    /// 含削波样本的窗口数
+    pub clipped_windows: usize,
+    /// 参与统计的窗口数（不含被静音过滤的窗口）
+    pub total_windows: usize,
+}
+
+#[derive(Debug, Clone, Default)]
+pub struct ClippingReport {
+    pub channels: Vec<ClippingChannelReport>,
+}
+
+impl ClippingReport {
+    /// 从各声道窗口分析器汇总
+    pub fn from_analyzers(analyzers: &[WindowRmsAnalyzer]) -> Self {
+        let channels = analyzers
+            .iter()
+            .enumerate()
+            .map(|(channel_index, analyzer)| ClippingChannelReport {
+                channel_index,
+                stats: analyzer.clip_stats(),
+                clipped_windows: analyzer
+                    .window_clipping()
+                    .iter()
+                    .filter(|window| window.clipped_samples > 0)
+                    .count(),
+                total_windows: analyzer.window_clipping().len(),
+            })
+            .collect();
+        Self { channels }
+    }
+
+    #[inline]
+    pub fn has_clipping(&self) -> bool {
+        self.channels.iter().any(|c| c.stats.has_clipping())
+    }
+
+    /// 全声道合计（最长削波段取各声道最大值）
+    pub fn total(&self) -> ClipStats {
+        self.channels
+            .iter()
+            .fold(ClipStats::default(), |total, c| ClipStats {
+                clipped_samples: total.clipped_samples + c.stats.clipped_samples,
+                clip_runs: total.clip_runs + c.stats.clip_runs,
+                longest_run: total.longest_run.max(c.stats.longest_run),
+            })
+    }
+}
 
 /// 静音窗口过滤报告（供输出模块使用）
 #[derive(Debug, Clone)]
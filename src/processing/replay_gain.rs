@@ -0,0 +1,187 @@
+//! ReplayGain 2.0 增益与峰值
+//!
+//! ReplayGain 2.0 以 EBU R128 / BS.1770 积分响度为基础，参考电平 -18 LUFS：
+//! 增益 = -18 - 积分响度。K 加权与门限由 [`LoudnessMeter`] 完成（`--loudness` 同时启用时共用同一份滤波）。
+//! 专辑增益按全部音轨的 400ms 门限块合并后重新门限计算，峰值取各轨最大值。
+//!
+//! 峰值为样本峰值（线性幅度，与常见标签写入工具一致）。
+
+use super::LoudnessMeter;
+use super::loudness::LoudnessReport;
+use super::true_peak::abs_max;
+
+/// ReplayGain 2.0 参考响度（LUFS）
+pub const REFERENCE_LUFS: f64 = -18.0;
+
+/// 单轨 ReplayGain 结果
+#[derive(Debug, Clone, PartialEq)]
+pub struct ReplayGainReport {
+    /// 音轨增益（dB）；静音（全部块低于绝对门限）时为 None
+    pub track_gain_db: Option<f64>,
+    /// 音轨样本峰值（线性幅度）
+    pub track_peak: f64,
+    /// 响度测量结果（保留门限块供专辑聚合）
+    pub loudness: LoudnessReport,
+}
+
+impl ReplayGainReport {
+    pub fn new(loudness: LoudnessReport, track_peak: f64) -> Self {
+        Self {
+            track_gain_db: loudness.integrated_lufs.map(gain_for_lufs),
+            track_peak,
+            loudness,
+        }
+    }
+}
+
+/// 专辑 ReplayGain 结果
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct AlbumGain {
+    /// 专辑增益（dB）；全部音轨静音时为 None
+    pub gain_db: Option<f64>,
+    /// 专辑峰值（各轨样本峰值最大值）
+    pub peak: f64,
+}
+
+impl AlbumGain {
+    /// 由同一专辑各轨结果聚合
+    pub fn from_tracks<'a>(tracks: impl IntoIterator<Item = &'a ReplayGainReport>) -> Self {
+        let mut accumulator = AlbumGainAccumulator::default();
+        for track in tracks {
+            accumulator.add(track);
+        }
+        accumulator.finish()
+    }
+}
+
+/// 专辑增益增量聚合：仅保留门限块能量与最大峰值（批量模式逐文件累加，无需保留各轨报告）
+#[derive(Debug, Clone, Default)]
+pub struct AlbumGainAccumulator {
+    blocks: LoudnessReport,
+    peak: f64,
+    tracks: usize,
+}
+
+impl AlbumGainAccumulator {
+    /// 累加一轨
+    pub fn add(&mut self, track: &ReplayGainReport) {
+        self.blocks
+            .gating_block_energies
+            .extend_from_slice(&track.loudness.gating_block_energies);
+        self.peak = self.peak.max(track.track_peak);
+        self.tracks += 1;
+    }
+
+    /// 已累加音轨数
+    pub fn track_count(&self) -> usize {
+        self.tracks
+    }
+
+    /// 计算专辑增益与峰值
+    pub fn finish(&self) -> AlbumGain {
+        AlbumGain {
+            gain_db: LoudnessReport::combined_integrated_lufs([&self.blocks]).map(gain_for_lufs),
+            peak: self.peak,
+        }
+    }
+}
+
+/// 积分响度换算为 ReplayGain 2.0 增益（dB）
+pub fn gain_for_lufs(lufs: f64) -> f64 {
+    REFERENCE_LUFS - lufs
+}
+
+/// 流式 ReplayGain 测量：K 加权响度 + 样本峰值
+pub struct ReplayGainMeter {
+    loudness: LoudnessMeter,
+    peak: f32,
+    /// 同时输出响度报告（`--loudness`），避免重复滤波
+    report_loudness: bool,
+}
+
+impl ReplayGainMeter {
+    pub fn new(loudness: LoudnessMeter, report_loudness: bool) -> Self {
+        Self {
+            loudness,
+            peak: 0.0,
+            report_loudness,
+        }
+    }
+
+    /// 是否同时输出响度报告
+    pub fn reports_loudness(&self) -> bool {
+        self.report_loudness
+    }
+
+    /// 送入一段交错样本
+    pub fn push_interleaved(&mut self, samples: &[f32]) {
+        self.loudness.push_interleaved(samples);
+        self.peak = self.peak.max(abs_max(samples));
+    }
+
+    pub fn finalize(self) -> ReplayGainReport {
+        ReplayGainReport::new(self.loudness.finalize(), self.peak as f64)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn stereo_sine(amplitude: f64, seconds: f64) -> Vec<f32> {
+        let frames = (48000.0 * seconds) as usize;
+        (0..frames)
+            .flat_map(|i| {
+                let s = (amplitude
+                    * (2.0 * std::f64::consts::PI * 1000.0 * i as f64 / 48000.0).sin())
+                    as f32;
+                [s, s]
+            })
+            .collect()
+    }
+
+    fn measure(samples: &[f32]) -> ReplayGainReport {
+        let mut meter = ReplayGainMeter::new(LoudnessMeter::new(48000, vec![1.0, 1.0]), false);
+        for chunk in samples.chunks(9600) {
+            meter.push_interleaved(chunk);
+        }
+        meter.finalize()
+    }
+
+    #[test]
+    fn test_track_gain_against_reference() {
+        // 1kHz 正弦、双声道、-18 dBFS 峰值 → 约 -18 LUFS（K 加权在 1kHz 约 +0.7 dB）
+        let amplitude = 10f64.powf(-18.0 / 20.0);
+        let report = measure(&stereo_sine(amplitude, 10.0));
+        let gain = report.track_gain_db.unwrap();
+        let lufs = report.loudness.integrated_lufs.unwrap();
+        assert!((gain - (REFERENCE_LUFS - lufs)).abs() < 1e-12);
+        assert!(gain.abs() < 1.5, "gain = {gain}");
+        assert!((report.track_peak - amplitude).abs() < 1e-4);
+    }
+
+    #[test]
+    fn test_album_gain_regates_combined_blocks() {
+        let loud = measure(&stereo_sine(0.5, 10.0));
+        let softer = measure(&stereo_sine(0.25, 10.0));
+        let album = AlbumGain::from_tracks([&softer, &loud]);
+
+        // 等时长两轨按能量平均：相差 6 dB 时专辑响度比响的一轨低约 2.04 dB
+        let expected = loud.track_gain_db.unwrap() + 10.0 * (2.0 / 1.25f64).log10();
+        assert!((album.gain_db.unwrap() - expected).abs() < 0.05);
+        assert_eq!(album.peak, loud.track_peak);
+
+        // 低 20 dB 的音轨被 -10 LU 相对门限整体剔除，不拉低专辑增益
+        let quiet = measure(&stereo_sine(0.05, 10.0));
+        let gated = AlbumGain::from_tracks([&quiet, &loud]);
+        assert!((gated.gain_db.unwrap() - loud.track_gain_db.unwrap()).abs() < 1e-9);
+    }
+
+    #[test]
+    fn test_silence_has_no_gain() {
+        let report = measure(&vec![0.0; 96000]);
+        assert_eq!(report.track_gain_db, None);
+        assert_eq!(report.track_peak, 0.0);
+        assert_eq!(AlbumGain::from_tracks([&report]).gain_db, None);
+    }
+}
@@ -0,0 +1,326 @@
+//! 有界单生产者/单消费者无锁环形队列（解码→分析流水线）
+//!
+//! 为"解码线程 → 分析线程"两级流水线提供定长、无锁的数据通道：
+//! - **快路径无锁**：入队/出队仅涉及一次 Acquire 读和一次 Release 写
+//! - **有界背压**：队列满时生产者等待，内存占用 = 容量 × 单批大小
+//! - **慢路径停驻**：短暂自旋后 `park_timeout`，对端入队/出队时 `unpark`，避免空转占核
+//! - **关闭语义**：任一端 drop 即关闭；消费者先排空剩余元素再返回 `None`
+//!
+//! 索引为单调递增的 `usize`，槽位 = 索引 % 容量；两端各自缓存本地索引，
+//! 仅在判断空/满时读取对端的原子索引。
+
+use std::cell::UnsafeCell;
+use std::mem::MaybeUninit;
+use std::sync::Arc;
+use std::sync::Mutex;
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering, fence};
+use std::thread::{self, Thread};
+use std::time::Duration;
+
+/// 进入停驻前的自旋次数（覆盖对端"马上就到"的短等待）
+const SPIN_LIMIT: u32 = 64;
+
+/// 单次停驻上限（兜底防止唤醒丢失，正常情况下由对端 unpark 提前唤醒）
+const PARK_TIMEOUT: Duration = Duration::from_millis(1);
+
+/// 缓存行对齐包装（避免 head/tail 伪共享）
+#[repr(align(64))]
+struct CachePadded<T>(T);
+
+/// 等待方登记（仅慢路径使用互斥锁，快路径只读一个原子标志）
+struct Waiter {
+    parked: AtomicBool,
+    thread: Mutex<Option<Thread>>,
+}
+
+impl Waiter {
+    fn new() -> Self {
+        Self {
+            parked: AtomicBool::new(false),
+            thread: Mutex::new(None),
+        }
+    }
+
+    /// 等待直到 `ready()` 为真（或一次停驻超时后交由调用方重试）
+    fn wait(&self, ready: impl Fn() -> bool) {
+        for _ in 0..SPIN_LIMIT {
+            if ready() {
+                return;
+            }
+            std::hint::spin_loop();
+        }
+
+        if let Ok(mut slot) = self.thread.lock() {
+            *slot = Some(thread::current());
+        }
+        self.parked.store(true, Ordering::SeqCst);
+        // 与 wake() 中的 fence 配对：登记停驻后重新检查条件，避免唤醒丢失
+        fence(Ordering::SeqCst);
+        if !ready() {
+            thread::park_timeout(PARK_TIMEOUT);
+        }
+        self.parked.store(false, Ordering::SeqCst);
+    }
+
+    /// 对端状态变化后调用：若等待方已停驻则唤醒
+    fn wake(&self) {
+        fence(Ordering::SeqCst);
+        if self.parked.load(Ordering::SeqCst)
+            && let Ok(slot) = self.thread.lock()
+            && let Some(thread) = slot.as_ref()
+        {
+            thread.unpark();
+        }
+    }
+}
+
+struct SpscRing<T> {
+    slots: Box<[UnsafeCell<MaybeUninit<T>>]>,
+    /// 消费者索引（下一个待读取位置）
+    head: CachePadded<AtomicUsize>,
+    /// 生产者索引（下一个待写入位置）
+    tail: CachePadded<AtomicUsize>,
+    closed: AtomicBool,
+    producer_waiter: Waiter,
+    consumer_waiter: Waiter,
+}
+
+// SAFETY: 每个槽位在任一时刻只被一端访问（由 head/tail 的 Acquire/Release 同步保证），
+// 元素所有权随槽位在线程间转移，因此只要求 T: Send。
+unsafe impl<T: Send> Send for SpscRing<T> {}
+unsafe impl<T: Send> Sync for SpscRing<T> {}
+
+impl<T> SpscRing<T> {
+    #[inline]
+    fn capacity(&self) -> usize {
+        self.slots.len()
+    }
+
+    #[inline]
+    fn is_closed(&self) -> bool {
+        self.closed.load(Ordering::Acquire)
+    }
+
+    fn close(&self) {
+        self.closed.store(true, Ordering::Release);
+        self.producer_waiter.wake();
+        self.consumer_waiter.wake();
+    }
+}
+
+impl<T> Drop for SpscRing<T> {
+    fn drop(&mut self) {
+        // 释放未被消费的元素
+        let head = *self.head.0.get_mut();
+        let tail = *self.tail.0.get_mut();
+        let capacity = self.capacity();
+        for index in head..tail {
+            // SAFETY: [head, tail) 区间内的槽位均已写入且未被读取
+            unsafe { self.slots[index % capacity].get_mut().assume_init_drop() };
+        }
+    }
+}
+
+/// 环形队列生产端（解码线程持有）
+pub struct RingProducer<T> {
+    ring: Arc<SpscRing<T>>,
+    tail: usize,
+}
+
+/// 环形队列消费端（分析线程持有）
+pub struct RingConsumer<T> {
+    ring: Arc<SpscRing<T>>,
+    head: usize,
+}
+
+/// 创建容量为 `capacity` 的 SPSC 环形队列
+///
+/// # Panics
+///
+/// `capacity == 0` 时 panic（零容量队列无法传递任何元素）
+pub fn spsc_ring<T>(capacity: usize) -> (RingProducer<T>, RingConsumer<T>) {
+    assert!(capacity > 0, "SPSC ring capacity must be positive");
+
+    let slots = (0..capacity)
+        .map(|_| UnsafeCell::new(MaybeUninit::uninit()))
+        .collect();
+    let ring = Arc::new(SpscRing {
+        slots,
+        head: CachePadded(AtomicUsize::new(0)),
+        tail: CachePadded(AtomicUsize::new(0)),
+        closed: AtomicBool::new(false),
+        producer_waiter: Waiter::new(),
+        consumer_waiter: Waiter::new(),
+    });
+
+    (
+        RingProducer {
+            ring: Arc::clone(&ring),
+            tail: 0,
+        },
+        RingConsumer { ring, head: 0 },
+    )
+}
+
+impl<T> RingProducer<T> {
+    /// 非阻塞入队：队列已满或已关闭时原样返回元素
+    pub fn try_push(&mut self, value: T) -> Result<(), T> {
+        let ring = &*self.ring;
+        if ring.is_closed() {
+            return Err(value);
+        }
+
+        let head = ring.head.0.load(Ordering::Acquire);
+        if self.tail - head == ring.capacity() {
+            return Err(value);
+        }
+
+        // SAFETY: tail 槽位不在 [head, tail) 内，消费者不会访问
+        unsafe { (*ring.slots[self.tail % ring.capacity()].get()).write(value) };
+        self.tail += 1;
+        ring.tail.0.store(self.tail, Ordering::Release);
+        ring.consumer_waiter.wake();
+        Ok(())
+    }
+
+    /// 阻塞入队：队列满时等待消费者腾出槽位；消费端已关闭时返回元素
+    pub fn push(&mut self, mut value: T) -> Result<(), T> {
+        loop {
+            match self.try_push(value) {
+                Ok(()) => return Ok(()),
+                Err(rejected) => {
+                    if self.ring.is_closed() {
+                        return Err(rejected);
+                    }
+                    value = rejected;
+                }
+            }
+
+            let ring = &*self.ring;
+            let tail = self.tail;
+            ring.producer_waiter.wait(|| {
+                ring.is_closed() || tail - ring.head.0.load(Ordering::Acquire) < ring.capacity()
+            });
+        }
+    }
+}
+
+impl<T> Drop for RingProducer<T> {
+    fn drop(&mut self) {
+        self.ring.close();
+    }
+}
+
+impl<T> RingConsumer<T> {
+    /// 非阻塞出队：队列为空时返回 `None`
+    pub fn try_pop(&mut self) -> Option<T> {
+        let ring = &*self.ring;
+        let tail = ring.tail.0.load(Ordering::Acquire);
+        if self.head == tail {
+            return None;
+        }
+
+        // SAFETY: head < tail，槽位已由生产者写入（Acquire 同步），且生产者不会再访问
+        let value = unsafe { (*ring.slots[self.head % ring.capacity()].get()).assume_init_read() };
+        self.head += 1;
+        ring.head.0.store(self.head, Ordering::Release);
+        ring.producer_waiter.wake();
+        Some(value)
+    }
+
+    /// 阻塞出队：队列为空时等待生产者；生产端关闭且已排空时返回 `None`
+    pub fn pop(&mut self) -> Option<T> {
+        loop {
+            if let Some(value) = self.try_pop() {
+                return Some(value);
+            }
+            if self.ring.is_closed() {
+                // 关闭标志之前写入的元素对此处可见（close 为 Release），最后排空一次
+                return self.try_pop();
+            }
+
+            let ring = &*self.ring;
+            let head = self.head;
+            ring.consumer_waiter
+                .wait(|| ring.is_closed() || ring.tail.0.load(Ordering::Acquire) != head);
+        }
+    }
+}
+
+impl<T> Drop for RingConsumer<T> {
+    fn drop(&mut self) {
+        self.ring.close();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_try_push_respects_capacity() {
+        let (mut tx, mut rx) = spsc_ring::<u32>(2);
+        assert!(tx.try_push(1).is_ok());
+        assert!(tx.try_push(2).is_ok());
+        assert_eq!(tx.try_push(3), Err(3));
+
+        assert_eq!(rx.try_pop(), Some(1));
+        assert!(tx.try_push(3).is_ok());
+        assert_eq!(rx.try_pop(), Some(2));
+        assert_eq!(rx.try_pop(), Some(3));
+        assert_eq!(rx.try_pop(), None);
+    }
+
+    #[test]
+    fn test_cross_thread_order_preserved() {
+        const COUNT: usize = 100_000;
+        let (mut tx, mut rx) = spsc_ring::<usize>(8);
+
+        let producer = thread::spawn(move || {
+            for i in 0..COUNT {
+                tx.push(i).expect("consumer alive");
+            }
+        });
+
+        let mut expected = 0;
+        while let Some(value) = rx.pop() {
+            assert_eq!(value, expected);
+            expected += 1;
+        }
+        producer.join().unwrap();
+        assert_eq!(expected, COUNT);
+    }
+
+    #[test]
+    fn test_consumer_drains_after_producer_drop() {
+        let (mut tx, mut rx) = spsc_ring::<Vec<f32>>(4);
+        tx.push(vec![1.0]).unwrap();
+        tx.push(vec![2.0, 3.0]).unwrap();
+        drop(tx);
+
+        assert_eq!(rx.pop(), Some(vec![1.0]));
+        assert_eq!(rx.pop(), Some(vec![2.0, 3.0]));
+        assert_eq!(rx.pop(), None);
+    }
+
+    #[test]
+    fn test_push_fails_after_consumer_drop() {
+        let (mut tx, rx) = spsc_ring::<u8>(1);
+        tx.push(1).unwrap();
+        drop(rx);
+        // 队列已满且消费端关闭：阻塞入队必须立即返回而不是死等
+        assert_eq!(tx.push(2), Err(2));
+    }
+
+    #[test]
+    fn test_unconsumed_items_are_dropped() {
+        let marker = Arc::new(());
+        {
+            let (mut tx, _rx) = spsc_ring::<Arc<()>>(4);
+            tx.push(Arc::clone(&marker)).unwrap();
+            tx.push(Arc::clone(&marker)).unwrap();
+            assert_eq!(Arc::strong_count(&marker), 3);
+        }
+        assert_eq!(Arc::strong_count(&marker), 1);
+    }
+}
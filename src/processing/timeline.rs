@@ -0,0 +1,348 @@
+//! 逐窗口时间线导出（`--timeline`）
+//!
+//! DR分析本身已为每个声道保存全部3秒窗口的 RMS 与 Peak；时间线把这两列持久化，
+//! 下游工具（UI响度曲线、质检看板）无需再次解码即可绘制时间线或重算DR变体。
+//!
+//! ## 二进制格式（`.drtl`，全部小端）
+//!
+//! | 偏移 | 类型 | 内容 |
+//! |------|------|------|
+//! | 0 | `[u8; 8]` | 魔数 `MDRTLINE` |
+//! | 8 | `u32` | 版本（1） |
+//! | 12 | `u32` | 声道数 C |
+//! | 16 | `u32` | 采样率（Hz） |
+//! | 20 | `u32` | 窗口长度（帧） |
+//! | 24 | `u64` | 窗口0起点在原始音频中的帧偏移（首部边缘裁切量） |
+//! | 32 | `u64` | 参与分析的总帧数（末窗可能不足一个窗口长度） |
+//! | 40 | `C × (u64, u64)` | 每声道：窗口数 Nc（含被过滤窗口）、被静音过滤的窗口数 |
+//! | 40+16C | 列数据 | 按声道依次：`f64 rms[Nc]`，`f64 peak[Nc]` |
+//!
+//! 所有字段与列均8字节对齐，内存映射后可直接按 `f64` 切片读取。
+//! 第 i 个值始终对应起点为 `start_offset + i × 窗口长度` 的窗口：启用 `--filter-silence` 时
+//! 被过滤的窗口以 NaN 占位（JSON 中为 `null`），时间轴保持连续。
+//!
+//! 短曲目可选 JSON（同样的字段，列为数组），便于直接在脚本中读取。
+
+use crate::core::histogram::WindowRmsAnalyzer;
+use crate::error::{AudioError, AudioResult};
+use serde::Serialize;
+
+/// 二进制时间线魔数
+pub const TIMELINE_MAGIC: [u8; 8] = *b"MDRTLINE";
+/// 二进制时间线格式版本
+pub const TIMELINE_VERSION: u32 = 1;
+/// 文件头长度（不含声道表）
+const HEADER_LEN: usize = 40;
+
+/// 时间线文件格式
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum TimelineFormat {
+    /// 小端列式二进制（`.drtl`）
+    Binary,
+    /// JSON（适合短曲目）
+    Json,
+}
+
+impl TimelineFormat {
+    /// 文件扩展名
+    pub fn extension(self) -> &'static str {
+        match self {
+            Self::Binary => "drtl",
+            Self::Json => "json",
+        }
+    }
+}
+
+/// 单声道窗口时间线
+#[derive(Debug, Clone, PartialEq, Serialize)]
+pub struct ChannelTimeline {
+    /// 各窗口RMS（线性，与DR计算使用的值一致；被静音过滤的窗口为 NaN）
+    pub rms: Vec<f64>,
+    /// 各窗口Peak（线性；被静音过滤的窗口为 NaN）
+    pub peak: Vec<f64>,
+    /// 被静音过滤、以 NaN 占位的窗口数
+    pub filtered_windows: u64,
+}
+
+impl ChannelTimeline {
+    /// 按窗口时间顺序展开：被过滤窗口的位置填入 NaN
+    fn from_analyzer(analyzer: &WindowRmsAnalyzer) -> Self {
+        let filtered = analyzer.filtered_window_indices();
+        let total = analyzer.window_rms_values().len() + filtered.len();
+        let mut rms = Vec::with_capacity(total);
+        let mut peak = Vec::with_capacity(total);
+        let mut kept = analyzer
+            .window_rms_values()
+            .iter()
+            .zip(analyzer.window_peaks());
+        let mut filtered = filtered.iter().peekable();
+        for index in 0..total {
+            let (window_rms, window_peak) = match filtered.next_if_eq(&&index) {
+                Some(_) => (f64::NAN, f64::NAN),
+                None => kept.next().map_or((f64::NAN, f64::NAN), |(&r, &p)| (r, p)),
+            };
+            rms.push(window_rms);
+            peak.push(window_peak);
+        }
+        Self {
+            rms,
+            peak,
+            filtered_windows: analyzer.filtered_windows_count() as u64,
+        }
+    }
+}
+
+/// 全部声道的窗口时间线
+#[derive(Debug, Clone, PartialEq, Serialize)]
+pub struct WindowTimeline {
+    pub version: u32,
+    pub sample_rate: u32,
+    /// 窗口长度（帧）
+    pub window_len: u32,
+    /// 窗口0起点在原始音频中的帧偏移（首部边缘裁切量）
+    pub start_offset_frames: u64,
+    /// 参与分析的总帧数
+    pub analyzed_frames: u64,
+    pub channels: Vec<ChannelTimeline>,
+}
+
+impl WindowTimeline {
+    /// 从各声道窗口分析器收集（尾窗已结算）
+    pub fn from_analyzers(
+        analyzers: &[WindowRmsAnalyzer],
+        sample_rate: u32,
+        start_offset_frames: u64,
+        analyzed_frames: u64,
+    ) -> Self {
+        let window_len = analyzers
+            .first()
+            .map_or(0, |analyzer| analyzer.window_len() as u32);
+        let channels = analyzers
+            .iter()
+            .map(ChannelTimeline::from_analyzer)
+            .collect();
+        Self {
+            version: TIMELINE_VERSION,
+            sample_rate,
+            window_len,
+            start_offset_frames,
+            analyzed_frames,
+            channels,
+        }
+    }
+
+    /// 编码为小端列式二进制
+    pub fn to_binary(&self) -> Vec<u8> {
+        let columns: usize = self.channels.iter().map(|c| c.rms.len() * 2).sum();
+        let mut out = Vec::with_capacity(HEADER_LEN + self.channels.len() * 16 + columns * 8);
+
+        out.extend_from_slice(&TIMELINE_MAGIC);
+        out.extend_from_slice(&self.version.to_le_bytes());
+        out.extend_from_slice(&(self.channels.len() as u32).to_le_bytes());
+        out.extend_from_slice(&self.sample_rate.to_le_bytes());
+        out.extend_from_slice(&self.window_len.to_le_bytes());
+        out.extend_from_slice(&self.start_offset_frames.to_le_bytes());
+        out.extend_from_slice(&self.analyzed_frames.to_le_bytes());
+        for channel in &self.channels {
+            out.extend_from_slice(&(channel.rms.len() as u64).to_le_bytes());
+            out.extend_from_slice(&channel.filtered_windows.to_le_bytes());
+        }
+        for channel in &self.channels {
+            for value in channel.rms.iter().chain(&channel.peak) {
+                out.extend_from_slice(&value.to_le_bytes());
+            }
+        }
+        out
+    }
+
+    /// 解码二进制时间线（供下游工具与测试使用）
+    pub fn from_binary(bytes: &[u8]) -> AudioResult<Self> {
+        let invalid = |reason: &str| {
+            AudioError::FormatError(format!(
+                "Invalid timeline file / 无效的时间线文件: {reason}"
+            ))
+        };
+        let mut reader = LeReader { bytes, pos: 0 };
+
+        if reader.take(8).ok_or_else(|| invalid("truncated header"))? != TIMELINE_MAGIC {
+            return Err(invalid("bad magic"));
+        }
+        let header = (|| {
+            Some((
+                reader.u32()?,
+                reader.u32()?,
+                reader.u32()?,
+                reader.u32()?,
+                reader.u64()?,
+                reader.u64()?,
+            ))
+        })();
+        let (version, channel_count, sample_rate, window_len, start_offset_frames, analyzed_frames) =
+            header.ok_or_else(|| invalid("truncated header"))?;
+        if version != TIMELINE_VERSION {
+            return Err(invalid(&format!("unsupported version {version}")));
+        }
+
+        let mut table = Vec::with_capacity(channel_count.min(1024) as usize);
+        for _ in 0..channel_count {
+            let entry = reader
+                .u64()
+                .zip(reader.u64())
+                .ok_or_else(|| invalid("truncated channel table"))?;
+            table.push(entry);
+        }
+
+        let mut channels = Vec::with_capacity(table.len());
+        for (windows, filtered_windows) in table {
+            let mut column = || -> Option<Vec<f64>> {
+                let len = usize::try_from(windows).ok()?.checked_mul(8)?;
+                let raw = reader.take(len)?;
+                Some(
+                    raw.chunks_exact(8)
+                        .map(|b| f64::from_le_bytes(b.try_into().expect("8-byte chunk")))
+                        .collect(),
+                )
+            };
+            let rms = column().ok_or_else(|| invalid("truncated columns"))?;
+            let peak = column().ok_or_else(|| invalid("truncated columns"))?;
+            channels.push(ChannelTimeline {
+                rms,
+                peak,
+                filtered_windows,
+            });
+        }
+
+        Ok(Self {
+            version,
+            sample_rate,
+            window_len,
+            start_offset_frames,
+            analyzed_frames,
+            channels,
+        })
+    }
+
+    /// 编码为 JSON
+    pub fn to_json(&self) -> String {
+        serde_json::to_string(self).unwrap_or_else(|_| "{}".to_string())
+    }
+
+    /// 按格式编码
+    pub fn encode(&self, format: TimelineFormat) -> Vec<u8> {
+        match format {
+            TimelineFormat::Binary => self.to_binary(),
+            TimelineFormat::Json => self.to_json().into_bytes(),
+        }
+    }
+}
+
+/// 小端字段顺序读取
+struct LeReader<'a> {
+    bytes: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> LeReader<'a> {
+    fn take(&mut self, len: usize) -> Option<&'a [u8]> {
+        let end = self.pos.checked_add(len)?;
+        let slice = self.bytes.get(self.pos..end)?;
+        self.pos = end;
+        Some(slice)
+    }
+
+    fn u32(&mut self) -> Option<u32> {
+        self.take(4)
+            .map(|b| u32::from_le_bytes(b.try_into().expect("4 bytes")))
+    }
+
+    fn u64(&mut self) -> Option<u64> {
+        self.take(8)
+            .map(|b| u64::from_le_bytes(b.try_into().expect("8 bytes")))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::core::SilenceFilterConfig;
+
+    fn analyzed_timeline() -> WindowTimeline {
+        // 44.1kHz 下 2.5 个窗口：两个满窗 + 尾窗
+        let mut left = WindowRmsAnalyzer::new(44100, false);
+        let mut right = WindowRmsAnalyzer::new(44100, false);
+        let window_len = left.window_len();
+        let samples: Vec<f32> = (0..window_len * 5 / 2)
+            .map(|i| 0.1 + 0.3 * (i / window_len) as f32)
+            .collect();
+        left.process_samples(&samples);
+        right.process_samples(&samples[..window_len]);
+        WindowTimeline::from_analyzers(&[left, right], 44100, 1234, samples.len() as u64)
+    }
+
+    #[test]
+    fn test_binary_layout_and_round_trip() {
+        let timeline = analyzed_timeline();
+        assert_eq!(timeline.channels[0].rms.len(), 3);
+        assert_eq!(timeline.channels[1].rms.len(), 1);
+
+        let bytes = timeline.to_binary();
+        assert_eq!(&bytes[..8], b"MDRTLINE");
+        assert_eq!(bytes.len(), HEADER_LEN + 2 * 16 + (3 + 1) * 2 * 8);
+        assert_eq!(bytes.len() % 8, 0);
+        // 第一列（声道0 RMS）紧随声道表
+        let first = f64::from_le_bytes(bytes[72..80].try_into().unwrap());
+        assert_eq!(first, timeline.channels[0].rms[0]);
+
+        assert_eq!(WindowTimeline::from_binary(&bytes).unwrap(), timeline);
+        assert!(WindowTimeline::from_binary(&bytes[..bytes.len() - 1]).is_err());
+        assert!(WindowTimeline::from_binary(b"NOTATIMELINE").is_err());
+    }
+
+    #[test]
+    fn test_filtered_windows_keep_time_axis() {
+        // 响-静-响-静(尾窗)：静音窗口以 NaN 占位，列下标即窗口序号
+        let mut analyzer = WindowRmsAnalyzer::with_silence_filter(
+            44100,
+            false,
+            SilenceFilterConfig::enabled(-60.0),
+        );
+        let window_len = analyzer.window_len();
+        let samples: Vec<f32> = (0..window_len * 7 / 2)
+            .map(|i| {
+                if (i / window_len).is_multiple_of(2) {
+                    0.5
+                } else {
+                    0.0
+                }
+            })
+            .collect();
+        analyzer.process_samples(&samples);
+        let timeline = WindowTimeline::from_analyzers(&[analyzer], 44100, 0, samples.len() as u64);
+
+        let channel = &timeline.channels[0];
+        assert_eq!(channel.filtered_windows, 2);
+        assert_eq!(channel.rms.len(), 4);
+        assert!(channel.rms[1].is_nan() && channel.peak[3].is_nan());
+        assert_eq!(channel.peak[2], 0.5);
+
+        let decoded = WindowTimeline::from_binary(&timeline.to_binary()).unwrap();
+        let bits = |values: &[f64]| values.iter().map(|v| v.to_bits()).collect::<Vec<_>>();
+        assert_eq!(bits(&decoded.channels[0].rms), bits(&channel.rms));
+        assert_eq!(decoded.channels[0].filtered_windows, 2);
+
+        let json: serde_json::Value = serde_json::from_str(&timeline.to_json()).unwrap();
+        assert!(json["channels"][0]["rms"][1].is_null());
+    }
+
+    #[test]
+    fn test_json_has_same_columns() {
+        let timeline = analyzed_timeline();
+        let json: serde_json::Value = serde_json::from_str(&timeline.to_json()).unwrap();
+        assert_eq!(json["start_offset_frames"], 1234);
+        assert_eq!(json["channels"][0]["peak"].as_array().unwrap().len(), 3);
+        assert_eq!(
+            json["channels"][0]["rms"][2].as_f64().unwrap(),
+            timeline.channels[0].rms[2]
+        );
+    }
+}
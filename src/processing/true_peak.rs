@@ -0,0 +1,618 @@
+//! 真峰值测量（ITU-R BS.1770 附录2：过采样插值峰值）
+//!
+//! 与DR窗口分析共享同一次解码，统计各声道插值后的最大绝对值（dBTP）。
+//!
+//! ## 插值器
+//! - 多相 FIR：自行设计的 Kaiser 窗（β=5）sinc 低通，每相 12 抽头；
+//!   仅每相抽头数与 BS.1770 附录2示例滤波器一致，系数并非其参考系数
+//! - 结束时以零样本冲洗滤波器，末尾样本之间的插值点同样参与统计
+//! - 过采样倍率按"插值后不低于 352.8kHz"选取：44.1/48kHz → 8×，88.2/96kHz → 4×，
+//!   176.4/192kHz → 2×，更高采样率退化为样本峰值
+//!
+//! ## SIMD
+//! 按时间向量化：一次计算4个相邻输入位置的全部相位插值点（x86_64 SSE2 / ARM NEON），
+//! 系数预先广播为对齐的4通道向量，倍率为编译期常量，累加器全部驻留寄存器。
+//! 以段为单位做幅度上界预检（Σ|h| × max|x|），不可能刷新峰值的段直接跳过，结果与逐点计算一致。
+//! 声道间相互独立，可按声道扇出到共享rayon线程池并行处理。
+
+#[cfg(target_arch = "x86_64")]
+use std::arch::x86_64::*;
+
+use rayon::prelude::*;
+
+/// 插值后的目标采样率下限（Hz）
+const TARGET_OVERSAMPLED_RATE: u32 = 352_800;
+/// 最大过采样倍率
+const MAX_OVERSAMPLING: usize = 8;
+/// 每相抽头数
+const TAPS_PER_PHASE: usize = 12;
+/// Kaiser 窗 β（阻带约 -50 dB，12 抽头/相下通带平坦度与过渡带的折中）
+const KAISER_BETA: f64 = 5.0;
+/// 单个SIMD向量覆盖的输入位置数
+const LANES: usize = 4;
+/// 幅度上界预检的段长（窗口数）
+const SKIP_SPAN_WINDOWS: usize = 256;
+/// 声道并行的最小块帧数：小块调度开销高于计算量
+const PARALLEL_MIN_FRAMES: usize = 4096;
+
+/// 按采样率选择过采样倍率（2的幂，1~8）
+pub fn oversampling_factor(sample_rate: u32) -> usize {
+    let mut factor = 1;
+    while factor < MAX_OVERSAMPLING
+        && sample_rate as usize * factor < TARGET_OVERSAMPLED_RATE as usize
+    {
+        factor *= 2;
+    }
+    factor
+}
+
+/// 预广播系数：同一系数复制到4个通道，16字节对齐以便直接作为乘法内存操作数
+#[derive(Debug, Clone, Copy)]
+#[repr(C, align(16))]
+struct Splat([f32; LANES]);
+
+/// 多相插值系数：`[抽头][相位]` 布局，抽头按时间正序（与历史窗口从旧到新对齐）
+#[derive(Debug, Clone)]
+struct PolyphaseKernel {
+    factor: usize,
+    coefficients: Vec<Splat>,
+    /// 各相位 Σ|h| 的最大值（略放大以覆盖舍入）：窗口内 max|x| × 该值即插值点幅度上界
+    gain_bound: f32,
+}
+
+impl PolyphaseKernel {
+    fn new(factor: usize) -> Self {
+        let mut coefficients = vec![Splat([0.0; LANES]); TAPS_PER_PHASE * factor];
+        if factor == 1 {
+            return Self {
+                factor,
+                coefficients,
+                gain_bound: 0.0,
+            };
+        }
+
+        let length = factor * TAPS_PER_PHASE;
+        let center = (length - 1) as f64 / 2.0;
+        let i0_beta = bessel_i0(KAISER_BETA);
+        let prototype: Vec<f64> = (0..length)
+            .map(|n| {
+                let t = (n as f64 - center) / factor as f64;
+                let sinc = if t == 0.0 {
+                    1.0
+                } else {
+                    (std::f64::consts::PI * t).sin() / (std::f64::consts::PI * t)
+                };
+                let ratio = (n as f64 - center) / center;
+                let window =
+                    bessel_i0(KAISER_BETA * (1.0 - ratio * ratio).max(0.0).sqrt()) / i0_beta;
+                sinc * window
+            })
+            .collect();
+
+        let mut gain_bound = 0.0f32;
+        for phase in 0..factor {
+            // 相位 p 的第 k 个抽头为原型的第 k·L+p 个系数；各相位单独归一化为直流增益1
+            let taps: Vec<f64> = (0..TAPS_PER_PHASE)
+                .map(|k| prototype[k * factor + phase])
+                .collect();
+            let gain: f64 = taps.iter().sum();
+            let mut abs_sum = 0.0f32;
+            for (k, tap) in taps.iter().enumerate() {
+                let coefficient = (tap / gain) as f32;
+                let oldest_first = TAPS_PER_PHASE - 1 - k;
+                coefficients[oldest_first * factor + phase] = Splat([coefficient; LANES]);
+                abs_sum += coefficient.abs();
+            }
+            gain_bound = gain_bound.max(abs_sum);
+        }
+
+        Self {
+            factor,
+            coefficients,
+            gain_bound: gain_bound * (1.0 + 1e-4),
+        }
+    }
+
+    /// 标量路径：历史窗口（旧→新，长度 TAPS_PER_PHASE）的插值点最大绝对值
+    #[inline(always)]
+    fn window_peak_scalar(&self, window: &[f32]) -> f32 {
+        let mut peak = 0.0f32;
+        for phase in 0..self.factor {
+            let mut acc = 0.0f32;
+            for (tap, &sample) in window.iter().enumerate() {
+                acc += self.coefficients[tap * self.factor + phase].0[0] * sample;
+            }
+            peak = peak.max(acc.abs());
+        }
+        peak
+    }
+}
+
+/// 修正的第一类零阶贝塞尔函数（Kaiser 窗用，级数展开）
+fn bessel_i0(x: f64) -> f64 {
+    let mut sum = 1.0;
+    let mut term = 1.0;
+    let half = x / 2.0;
+    for k in 1..50 {
+        term *= (half / k as f64) * (half / k as f64);
+        sum += term;
+        if term < sum * 1e-17 {
+            break;
+        }
+    }
+    sum
+}
+
+/// 单声道插值状态
+#[derive(Debug, Clone)]
+struct ChannelTruePeak {
+    /// 最近 TAPS_PER_PHASE-1 个样本 + 本块样本（解交错后的连续缓冲）
+    buffer: Vec<f32>,
+    /// 插值峰值（绝对值）
+    true_peak: f32,
+    /// 样本峰值（绝对值；真峰值按定义不低于样本峰值）
+    sample_peak: f32,
+}
+
+impl ChannelTruePeak {
+    fn new() -> Self {
+        Self {
+            buffer: vec![0.0; TAPS_PER_PHASE - 1],
+            true_peak: 0.0,
+            sample_peak: 0.0,
+        }
+    }
+
+    /// 从交错块中取出本声道样本并扫描
+    fn process_interleaved(
+        &mut self,
+        kernel: &PolyphaseKernel,
+        samples: &[f32],
+        channel: usize,
+        channels: usize,
+    ) {
+        self.buffer.truncate(TAPS_PER_PHASE - 1);
+        self.buffer
+            .extend(samples.chunks_exact(channels).map(|frame| frame[channel]));
+        self.scan(kernel);
+    }
+
+    /// 追加本声道的平面样本并扫描
+    fn process_planar(&mut self, kernel: &PolyphaseKernel, samples: &[f32]) {
+        self.buffer.truncate(TAPS_PER_PHASE - 1);
+        self.buffer.extend_from_slice(samples);
+        self.scan(kernel);
+    }
+
+    /// 以 TAPS_PER_PHASE-1 个零样本冲洗：最后几个样本之间的插值点只出现在跨越流末尾的窗口中
+    fn flush(&mut self, kernel: &PolyphaseKernel) {
+        self.process_planar(kernel, &[0.0; TAPS_PER_PHASE - 1]);
+    }
+
+    /// 扫描缓冲区（历史 + 新样本）并更新峰值
+    fn scan(&mut self, kernel: &PolyphaseKernel) {
+        let history = TAPS_PER_PHASE - 1;
+        self.sample_peak = self.sample_peak.max(abs_max(&self.buffer[history..]));
+
+        if kernel.factor > 1 {
+            // 以 SKIP_SPAN_WINDOWS 个窗口为一段：段内幅度上界（Σ|h| × max|x|）不超过当前峰值时整段跳过。
+            // 最终取 max(真峰值, 样本峰值)，跳过的窗口不可能刷新该值，结果与逐点计算完全一致。
+            let mut floor = self.true_peak.max(self.sample_peak);
+            let window_count = (self.buffer.len() + 1).saturating_sub(TAPS_PER_PHASE);
+            let mut start = 0;
+            while start < window_count {
+                let end = (start + SKIP_SPAN_WINDOWS).min(window_count);
+                let span = &self.buffer[start..end + TAPS_PER_PHASE - 1];
+                start = end;
+                if abs_max(span) * kernel.gain_bound <= floor {
+                    continue;
+                }
+                let peak = interpolate_peak(kernel, span);
+                self.true_peak = self.true_peak.max(peak);
+                floor = floor.max(peak);
+            }
+        }
+
+        // 保留最后 history 个样本供下一块使用
+        let len = self.buffer.len();
+        self.buffer.copy_within(len - history.., 0);
+    }
+
+    fn peak(&self) -> f64 {
+        self.true_peak.max(self.sample_peak) as f64
+    }
+}
+
+/// 最大绝对值（SIMD 多累加器，避免逐样本 max 依赖链）
+pub(crate) fn abs_max(samples: &[f32]) -> f32 {
+    #[cfg(target_arch = "x86_64")]
+    // SAFETY: SSE2 是 x86_64 基线指令集
+    unsafe {
+        abs_max_sse(samples)
+    }
+    #[cfg(target_arch = "aarch64")]
+    // SAFETY: NEON 是 aarch64 基线指令集
+    unsafe {
+        abs_max_neon(samples)
+    }
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+    {
+        samples.iter().fold(0.0f32, |peak, &x| peak.max(x.abs()))
+    }
+}
+
+/// 一段连续样本（含 TAPS_PER_PHASE-1 个前导历史）内全部窗口的插值峰值
+///
+/// 窗口数不足4的整数倍时，尾部窗口走标量路径；两条路径按相同抽头顺序乘加，结果逐位一致。
+fn interpolate_peak(kernel: &PolyphaseKernel, span: &[f32]) -> f32 {
+    let window_count = (span.len() + 1).saturating_sub(TAPS_PER_PHASE);
+    let vector_windows = window_count / LANES * LANES;
+
+    #[cfg(any(target_arch = "x86_64", target_arch = "aarch64"))]
+    let vector_peak = {
+        let vector_span = &span[..(vector_windows + TAPS_PER_PHASE - 1).min(span.len())];
+        #[cfg(target_arch = "x86_64")]
+        // SAFETY: SSE2 是 x86_64 基线指令集；读取边界见函数内说明
+        let peak = unsafe {
+            match kernel.factor {
+                2 => interpolate_peak_sse::<2>(kernel, vector_span),
+                4 => interpolate_peak_sse::<4>(kernel, vector_span),
+                _ => interpolate_peak_sse::<8>(kernel, vector_span),
+            }
+        };
+        #[cfg(target_arch = "aarch64")]
+        // SAFETY: NEON 是 aarch64 基线指令集；读取边界见函数内说明
+        let peak = unsafe {
+            match kernel.factor {
+                2 => interpolate_peak_neon::<2>(kernel, vector_span),
+                4 => interpolate_peak_neon::<4>(kernel, vector_span),
+                _ => interpolate_peak_neon::<8>(kernel, vector_span),
+            }
+        };
+        peak
+    };
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+    let vector_peak = 0.0f32;
+    #[cfg(not(any(target_arch = "x86_64", target_arch = "aarch64")))]
+    let vector_windows = 0;
+
+    span[vector_windows..]
+        .windows(TAPS_PER_PHASE)
+        .fold(vector_peak, |peak, window| {
+            peak.max(kernel.window_peak_scalar(window))
+        })
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn abs_max_sse(samples: &[f32]) -> f32 {
+    let sign_mask = _mm_set1_ps(-0.0);
+    let mut acc = [_mm_setzero_ps(); 4];
+    let mut chunks = samples.chunks_exact(16);
+    for chunk in &mut chunks {
+        for (k, lane) in acc.iter_mut().enumerate() {
+            // SAFETY: chunk 长度为16，k*4+4 <= 16
+            let v = unsafe { _mm_loadu_ps(chunk.as_ptr().add(k * 4)) };
+            *lane = _mm_max_ps(*lane, _mm_andnot_ps(sign_mask, v));
+        }
+    }
+    let merged = _mm_max_ps(_mm_max_ps(acc[0], acc[1]), _mm_max_ps(acc[2], acc[3]));
+    let mut lanes = [0.0f32; 4];
+    // SAFETY: lanes 为4个f32的栈数组，_mm_storeu_ps 写入恰好16字节
+    unsafe { _mm_storeu_ps(lanes.as_mut_ptr(), merged) };
+    chunks
+        .remainder()
+        .iter()
+        .fold(lanes.into_iter().fold(0.0, f32::max), |peak, &x| {
+            peak.max(x.abs())
+        })
+}
+
+/// SSE 路径：4个相邻窗口 × FACTOR 个相位
+///
+/// 每个抽头只加载一次输入向量，与 FACTOR 个预广播系数相乘，累加到 FACTOR 条互不依赖的累加链；
+/// 每个插值点按抽头顺序累加，结果与分组、分块方式无关。
+/// 调用方保证窗口数为4的整数倍。
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn interpolate_peak_sse<const FACTOR: usize>(kernel: &PolyphaseKernel, span: &[f32]) -> f32 {
+    let sign_mask = _mm_set1_ps(-0.0);
+    let mut peak = _mm_setzero_ps();
+    let coefficients = &kernel.coefficients[..TAPS_PER_PHASE * FACTOR];
+    let window_count = (span.len() + 1).saturating_sub(TAPS_PER_PHASE);
+
+    for start in (0..window_count).step_by(LANES) {
+        let mut acc = [_mm_setzero_ps(); FACTOR];
+        for tap in 0..TAPS_PER_PHASE {
+            // SAFETY: start+tap+4 <= window_count+TAPS_PER_PHASE-1 = span.len()
+            let x = unsafe { _mm_loadu_ps(span.as_ptr().add(start + tap)) };
+            for (phase, lane) in acc.iter_mut().enumerate() {
+                // SAFETY: Splat 16字节对齐，索引在系数切片内
+                let c = unsafe { _mm_load_ps(coefficients[tap * FACTOR + phase].0.as_ptr()) };
+                *lane = _mm_add_ps(*lane, _mm_mul_ps(c, x));
+            }
+        }
+        for lane in acc {
+            peak = _mm_max_ps(peak, _mm_andnot_ps(sign_mask, lane));
+        }
+    }
+
+    let mut lanes = [0.0f32; LANES];
+    // SAFETY: lanes 为4个f32的栈数组，_mm_storeu_ps 写入恰好16字节
+    unsafe { _mm_storeu_ps(lanes.as_mut_ptr(), peak) };
+    lanes.into_iter().fold(0.0, f32::max)
+}
+
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn abs_max_neon(samples: &[f32]) -> f32 {
+    use std::arch::aarch64::*;
+
+    let mut acc = [vdupq_n_f32(0.0); 4];
+    let mut chunks = samples.chunks_exact(16);
+    for chunk in &mut chunks {
+        for (k, lane) in acc.iter_mut().enumerate() {
+            // SAFETY: chunk 长度为16，k*4+4 <= 16
+            let v = unsafe { vld1q_f32(chunk.as_ptr().add(k * 4)) };
+            *lane = vmaxq_f32(*lane, vabsq_f32(v));
+        }
+    }
+    let merged = vmaxq_f32(vmaxq_f32(acc[0], acc[1]), vmaxq_f32(acc[2], acc[3]));
+    chunks
+        .remainder()
+        .iter()
+        .fold(vmaxvq_f32(merged), |peak, &x| peak.max(x.abs()))
+}
+
+/// NEON 路径：与 SSE 路径相同的布局（乘加分开执行、不用 vfmaq，与 SSE/标量路径舍入一致）
+#[cfg(target_arch = "aarch64")]
+#[target_feature(enable = "neon")]
+unsafe fn interpolate_peak_neon<const FACTOR: usize>(
+    kernel: &PolyphaseKernel,
+    span: &[f32],
+) -> f32 {
+    use std::arch::aarch64::*;
+
+    let mut peak = vdupq_n_f32(0.0);
+    let coefficients = &kernel.coefficients[..TAPS_PER_PHASE * FACTOR];
+    let window_count = (span.len() + 1).saturating_sub(TAPS_PER_PHASE);
+
+    for start in (0..window_count).step_by(LANES) {
+        let mut acc = [vdupq_n_f32(0.0); FACTOR];
+        for tap in 0..TAPS_PER_PHASE {
+            // SAFETY: start+tap+4 <= window_count+TAPS_PER_PHASE-1 = span.len()
+            let x = unsafe { vld1q_f32(span.as_ptr().add(start + tap)) };
+            for (phase, lane) in acc.iter_mut().enumerate() {
+                // SAFETY: 索引在系数切片内
+                let c = unsafe { vld1q_f32(coefficients[tap * FACTOR + phase].0.as_ptr()) };
+                *lane = vaddq_f32(*lane, vmulq_f32(c, x));
+            }
+        }
+        for lane in acc {
+            peak = vmaxq_f32(peak, vabsq_f32(lane));
+        }
+    }
+
+    vmaxvq_f32(peak)
+}
+
+/// 真峰值报告（线性幅度，按声道）
+#[derive(Debug, Clone, PartialEq)]
+pub struct TruePeakReport {
+    /// 实际使用的过采样倍率（1 表示退化为样本峰值）
+    pub oversampling: usize,
+    /// 各声道真峰值（线性幅度，不低于样本峰值）
+    pub channel_peaks: Vec<f64>,
+}
+
+impl TruePeakReport {
+    /// 线性幅度换算为 dBTP（静音为 -inf）
+    pub fn to_dbtp(peak: f64) -> f64 {
+        20.0 * peak.log10()
+    }
+
+    /// 所有声道中的最大真峰值（dBTP）
+    pub fn max_dbtp(&self) -> Option<f64> {
+        self.channel_peaks
+            .iter()
+            .copied()
+            .reduce(f64::max)
+            .map(Self::to_dbtp)
+    }
+
+    /// 真峰值超过 0 dBTP 的声道数（样本间过冲，回放/转码时会削波）
+    pub fn over_full_scale_channels(&self) -> usize {
+        self.channel_peaks
+            .iter()
+            .filter(|&&peak| peak > 1.0)
+            .count()
+    }
+}
+
+/// 流式真峰值表
+pub struct TruePeakMeter {
+    kernel: PolyphaseKernel,
+    channels: Vec<ChannelTruePeak>,
+    parallel_channels: bool,
+}
+
+impl TruePeakMeter {
+    /// 创建真峰值表；`parallel_channels` 为 true 时大块按声道扇出到rayon线程池
+    pub fn new(sample_rate: u32, channels: usize, parallel_channels: bool) -> Self {
+        Self {
+            kernel: PolyphaseKernel::new(oversampling_factor(sample_rate)),
+            channels: vec![ChannelTruePeak::new(); channels],
+            parallel_channels: parallel_channels && channels >= 2,
+        }
+    }
+
+    /// 过采样倍率
+    pub fn oversampling(&self) -> usize {
+        self.kernel.factor
+    }
+
+    /// 送入一段交错样本（须为完整帧）
+    pub fn push_interleaved(&mut self, samples: &[f32]) {
+        let channel_count = self.channels.len();
+        if channel_count == 0 {
+            return;
+        }
+        let kernel = &self.kernel;
+
+        if self.parallel_channels && samples.len() / channel_count >= PARALLEL_MIN_FRAMES {
+            self.channels
+                .par_iter_mut()
+                .enumerate()
+                .for_each(|(channel, state)| {
+                    state.process_interleaved(kernel, samples, channel, channel_count)
+                });
+        } else {
+            for (channel, state) in self.channels.iter_mut().enumerate() {
+                state.process_interleaved(kernel, samples, channel, channel_count);
+            }
+        }
+    }
+
+    /// 送入一段平面（按声道分离）样本；各声道长度须一致
+    pub fn push_planar(&mut self, planar: &[Vec<f32>]) {
+        let kernel = &self.kernel;
+        let frames = planar.first().map_or(0, Vec::len);
+
+        if self.parallel_channels && frames >= PARALLEL_MIN_FRAMES {
+            self.channels
+                .par_iter_mut()
+                .zip(planar.par_iter())
+                .for_each(|(state, samples)| state.process_planar(kernel, samples));
+        } else {
+            for (state, samples) in self.channels.iter_mut().zip(planar) {
+                state.process_planar(kernel, samples);
+            }
+        }
+    }
+
+    /// 结束测量（以零样本冲洗滤波器），输出各声道真峰值
+    pub fn finalize(mut self) -> TruePeakReport {
+        for state in &mut self.channels {
+            state.flush(&self.kernel);
+        }
+        TruePeakReport {
+            oversampling: self.kernel.factor,
+            channel_peaks: self.channels.iter().map(ChannelTruePeak::peak).collect(),
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sine(
+        frequency: f64,
+        phase: f64,
+        amplitude: f64,
+        sample_rate: u32,
+        frames: usize,
+    ) -> Vec<f32> {
+        (0..frames)
+            .map(|i| {
+                (amplitude
+                    * (2.0 * std::f64::consts::PI * frequency * i as f64 / sample_rate as f64
+                        + phase)
+                        .sin()) as f32
+            })
+            .collect()
+    }
+
+    fn measure(samples: &[f32], sample_rate: u32) -> f64 {
+        let mut meter = TruePeakMeter::new(sample_rate, 1, false);
+        meter.push_interleaved(samples);
+        meter.finalize().channel_peaks[0]
+    }
+
+    #[test]
+    fn test_oversampling_factor() {
+        assert_eq!(oversampling_factor(44100), 8);
+        assert_eq!(oversampling_factor(48000), 8);
+        assert_eq!(oversampling_factor(96000), 4);
+        assert_eq!(oversampling_factor(192000), 2);
+        assert_eq!(oversampling_factor(384000), 1);
+    }
+
+    #[test]
+    fn test_quarter_rate_sine_recovers_inter_sample_peak() {
+        // fs/4 正弦、45°相位：所有样本为 ±0.707，真峰值为 1.0（样本峰值低估约 3 dB）
+        let samples = sine(12000.0, std::f64::consts::FRAC_PI_4, 1.0, 48000, 4800);
+        let sample_peak = samples.iter().fold(0.0f32, |p, x| p.max(x.abs()));
+        assert!((sample_peak - std::f32::consts::FRAC_1_SQRT_2).abs() < 1e-3);
+
+        let true_peak_db = 20.0 * measure(&samples, 48000).log10();
+        assert!(true_peak_db.abs() < 0.3, "true peak = {true_peak_db} dBTP");
+    }
+
+    #[test]
+    fn test_low_frequency_true_peak_matches_amplitude() {
+        let samples = sine(997.0, 0.3, 0.5, 44100, 44100);
+        let true_peak_db = 20.0 * (measure(&samples, 44100) / 0.5).log10();
+        assert!(true_peak_db.abs() < 0.05, "deviation = {true_peak_db} dB");
+    }
+
+    #[test]
+    fn test_simd_matches_scalar_and_chunking() {
+        let samples = sine(5000.0, 1.0, 0.8, 48000, 10_000);
+        let kernel = PolyphaseKernel::new(8);
+        let mut padded = vec![0.0; TAPS_PER_PHASE - 1];
+        padded.extend_from_slice(&samples);
+        padded.extend_from_slice(&[0.0; TAPS_PER_PHASE - 1]);
+        let scalar = padded.windows(TAPS_PER_PHASE).fold(0.0f32, |peak, window| {
+            peak.max(kernel.window_peak_scalar(window))
+        });
+
+        let whole = measure(&samples, 48000);
+        let mut chunked = TruePeakMeter::new(48000, 1, false);
+        for chunk in samples.chunks(777) {
+            chunked.push_interleaved(chunk);
+        }
+        assert_eq!(whole, chunked.finalize().channel_peaks[0]);
+        assert!((whole - scalar.max(0.8) as f64).abs() < 1e-6);
+    }
+
+    #[test]
+    fn test_parallel_channels_match_serial() {
+        let left = sine(3000.0, 0.0, 0.9, 44100, 20_000);
+        let right = sine(11000.0, 0.7, 0.6, 44100, 20_000);
+        let interleaved: Vec<f32> = left
+            .iter()
+            .zip(&right)
+            .flat_map(|(&l, &r)| [l, r])
+            .collect();
+
+        let mut serial = TruePeakMeter::new(44100, 2, false);
+        let mut parallel = TruePeakMeter::new(44100, 2, true);
+        serial.push_interleaved(&interleaved);
+        parallel.push_interleaved(&interleaved);
+        let (serial, parallel) = (serial.finalize(), parallel.finalize());
+        assert_eq!(serial, parallel);
+        assert_eq!(serial.oversampling, 8);
+        assert!(serial.channel_peaks[0] >= 0.9 - 1e-3 && serial.channel_peaks[1] >= 0.6 - 1e-3);
+        assert!(
+            (serial.max_dbtp().unwrap() - 20.0 * serial.channel_peaks[0].log10()).abs() < 1e-12
+        );
+    }
+
+    #[test]
+    fn test_finalize_flushes_trailing_inter_sample_peak() {
+        // 末尾两个同号样本之间的插值峰值约为 0.9（fs/4 正弦的波峰），只有冲洗后的窗口能覆盖
+        let mut samples = vec![0.0f32; 1000];
+        samples.extend_from_slice(&[std::f32::consts::FRAC_1_SQRT_2; 2]);
+        let peak = measure(&samples, 48000);
+        assert!(peak > 0.8, "trailing true peak = {peak}");
+    }
+
+    #[test]
+    fn test_high_rate_falls_back_to_sample_peak() {
+        let samples = sine(1000.0, 0.0, 0.25, 384000, 2000);
+        let meter_peak = measure(&samples, 384000);
+        let sample_peak = samples.iter().fold(0.0f32, |p, x| p.max(x.abs())) as f64;
+        assert_eq!(meter_peak, sample_peak);
+    }
+}
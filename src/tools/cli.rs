@@ -3,7 +3,10 @@
 //! 负责命令行参数解析、配置管理和程序信息展示。
 
 use super::constants;
-use super::utils::{effective_parallel_degree, get_parent_dir};
+use super::result_store::{ExportFormat, GroupBy, StoreQuery, flags as store_flags};
+use super::utils::{self, effective_parallel_degree, get_parent_dir};
+use crate::audio::{RawPcmSpec, RawSampleFormat};
+use crate::processing::TimelineFormat;
 use clap::{Arg, Command};
 use std::path::PathBuf;
 
@@ -20,6 +23,8 @@ const DEFAULT_PARALLEL_FILES: &str = "4";
 const DEFAULT_SILENCE_THRESHOLD_DB_STR: &str = "-70";
 const DEFAULT_TRIM_THRESHOLD_DB_STR: &str = "-60";
 const DEFAULT_TRIM_MIN_RUN_MS_STR: &str = "60";
+const DEFAULT_TWO_PHASE_MARGIN_DB_STR: &str = "0.3";
+const DEFAULT_LIVE_SPAN_MINUTES_STR: &str = "5";
 
 /// 自定义范围校验函数
 fn parse_parallel_degree(s: &str) -> Result<usize, String> {
@@ -82,6 +87,62 @@ fn parse_trim_min_run(s: &str) -> Result<f64, String> {
     Ok(value)
 }
 
+/// 两阶段边界余量校验（0 ~ 2 dB）
+fn parse_two_phase_margin(s: &str) -> Result<f64, String> {
+    let value: f64 = s.parse().map_err(|_| {
+        format!("'{s}' is not a valid float (example: 0.3) / 不是有效的浮点数字（示例：0.3）")
+    })?;
+    if !(0.0..=2.0).contains(&value) {
+        return Err(
+            "boundary margin must be between 0 and 2 dB / 边界余量必须在 0 到 2 dB 之间"
+                .to_string(),
+        );
+    }
+    Ok(value)
+}
+
+/// 滚动DR跨度校验（0.1 ~ 1440 分钟）
+fn parse_live_span(s: &str) -> Result<f64, String> {
+    let value: f64 = s.parse().map_err(|_| {
+        format!("'{s}' is not a valid float (example: 5) / 不是有效的浮点数字（示例：5）")
+    })?;
+    let max = constants::live_meter::MAX_SPAN_MINUTES;
+    if !(0.1..=max).contains(&value) {
+        return Err(format!(
+            "span must be between 0.1 and {max} minutes / 跨度必须在 0.1 到 {max} 分钟之间"
+        ));
+    }
+    Ok(value)
+}
+
+/// 原始PCM采样率校验（1 ~ 768000 Hz）
+fn parse_raw_rate(s: &str) -> Result<u32, String> {
+    let value: u32 = s
+        .parse()
+        .map_err(|_| format!("'{s}' is not a valid number / 不是有效的数字"))?;
+    if !(1..=768_000).contains(&value) {
+        return Err(
+            "sample rate must be between 1 and 768000 Hz / 采样率必须在 1 到 768000 Hz 之间"
+                .to_string(),
+        );
+    }
+    Ok(value)
+}
+
+/// 原始PCM声道数校验（1 ~ MAX_CHANNELS）
+fn parse_raw_channels(s: &str) -> Result<u16, String> {
+    let value: u16 = s
+        .parse()
+        .map_err(|_| format!("'{s}' is not a valid number / 不是有效的数字"))?;
+    let max = constants::format_constraints::MAX_CHANNELS;
+    if !(1..=max).contains(&value) {
+        return Err(format!(
+            "channel count must be between 1 and {max} / 声道数必须在 1 到 {max} 之间"
+        ));
+    }
+    Ok(value)
+}
+
 /// 应用程序配置（简化版 - 遵循零配置优雅性原则）
 #[derive(Debug, Clone)]
 pub struct AppConfig {
@@ -98,7 +159,7 @@ pub struct AppConfig {
     /// 是否启用并行解码（默认：true）
     pub parallel_decoding: bool,
 
-    /// 并行解码批大小（默认：64包）
+    /// 并行解码初始批大小（默认：64包，之后自适应调整）
     pub parallel_batch_size: usize,
 
     /// 并行解码线程数（默认：4线程）
@@ -138,6 +199,45 @@ pub struct AppConfig {
     /// 禁用自动保存结果文件（用于脚本/benchmark场景）
     pub no_save: bool,
 
+    /// 稀疏估算模式：仅解码分层随机抽样的3秒窗口，输出带置信区间的DR估计
+    /// （用于大型曲库初筛；不支持定位或曲目过短时自动回退到完整分析）
+    pub estimate: bool,
+
+    /// 两阶段分析的边界余量（dB；存在即启用）
+    /// 先稀疏估算，仅当估算区间在该余量内触及DR舍入边界时再做完整精确分析
+    pub two_phase_margin_db: Option<f64>,
+
+    /// 多音轨容器（MKV/MP4）分析全部音轨：单次解复用，每条音轨独立解码与分析
+    pub all_tracks: bool,
+
+    /// 标准输入（`-`）为无头原始PCM时的流参数；None 表示按 WAV/W64 头部解析
+    pub raw_pcm: Option<RawPcmSpec>,
+
+    /// 实时滚动DR表的跨度（分钟；存在即启用）
+    /// 每完成一个3秒窗口输出最近跨度内的DR，用于直播/管道输入的持续监测
+    pub live_span_minutes: Option<f64>,
+
+    /// 同一次解码中附加测量 EBU R128 积分响度与响度范围（LRA）
+    pub loudness: bool,
+
+    /// 同一次解码中附加测量过采样真峰值（dBTP）
+    pub true_peak: bool,
+
+    /// 同一次解码中附加统计削波（满幅样本、连续削波段）
+    pub clipping: bool,
+
+    /// 同一次解码中附加计算 ReplayGain 2.0 音轨增益/峰值（批量模式按目录聚合专辑值）
+    pub replay_gain: bool,
+
+    /// 逐窗口 RMS/Peak 时间线导出格式（存在即启用；保存在报告所在目录）
+    pub timeline: Option<TimelineFormat>,
+
+    /// 列式结果库目录（存在即启用；每次分析结束后追加结果）
+    pub store_path: Option<PathBuf>,
+
+    /// `query` 子命令参数（存在时只查询结果库，不做分析）
+    pub query: Option<StoreQuery>,
+
     /// DSD → PCM 的目标采样率（Hz）。
     /// 可选：88200 / 176400 / 352800 / 384000。
     /// None 表示使用默认值（352800）。
@@ -164,13 +264,13 @@ impl AppConfig {
 
 /// 解析命令行参数并创建配置
 pub fn parse_args() -> AppConfig {
-    let matches = Command::new(env!("CARGO_PKG_NAME"))
+    let mut command = Command::new(env!("CARGO_PKG_NAME"))
         .version(VERSION)
         .about(DESCRIPTION)
         .author(AUTHORS)
         .arg(
             Arg::new("INPUT")
-                .help("Audio file or directory path (supports WAV, FLAC, MP3, AAC, OGG). If not specified, scans current directory / 音频文件或目录路径 (支持WAV, FLAC, MP3, AAC, OGG)。如果不指定，将扫描可执行文件所在目录")
+                .help("Audio file or directory path (supports WAV, FLAC, MP3, AAC, OGG), or '-' to read WAV/W64/raw PCM from stdin. If not specified, scans current directory / 音频文件或目录路径 (支持WAV, FLAC, MP3, AAC, OGG)，'-' 表示从标准输入读取 WAV/W64/原始PCM。如果不指定，将扫描可执行文件所在目录")
                 .required(false)
                 .index(1)
                 .value_parser(clap::value_parser!(PathBuf))
@@ -209,7 +309,7 @@ pub fn parse_args() -> AppConfig {
         .arg(
             Arg::new("parallel-batch")
                 .long("parallel-batch")
-                .help("Parallel decoding batch size (range: 1-256) / 并行解码批大小 (范围: 1-256)")
+                .help("Initial parallel decoding batch size, adapted automatically to measured decode cost (range: 1-256) / 并行解码初始批大小，之后按实测解码耗时自动调整 (范围: 1-256)")
                 .value_name("SIZE")
                 .value_parser(parse_batch_size)
                 .default_value(DEFAULT_PARALLEL_BATCH),
@@ -328,6 +428,111 @@ pub fn parse_args() -> AppConfig {
                 }))
                 .default_value("6.0"),
         )
+        .arg(
+            Arg::new("estimate")
+                .long("estimate")
+                .help("Fast DR estimate from a stratified sample of 3-second windows, with a confidence interval (falls back to full analysis for short or unseekable files) / 基于分层抽样3秒窗口快速估算DR并给出置信区间（短文件或不可定位时回退完整分析）")
+                .action(clap::ArgAction::SetTrue),
+        )
+        .arg(
+            Arg::new("two-phase")
+                .long("two-phase")
+                .help("Two-phase analysis: sparse estimate first, exact analysis only when the estimate lies within the margin of a DR rounding boundary; optional margin (dB, range 0~2, default 0.3) / 两阶段分析：先稀疏估算，仅当估算值距DR舍入边界在余量内时再完整分析；可选余量（dB，范围 0~2，默认 0.3）")
+                .value_name("DB")
+                .num_args(0..=1)
+                .require_equals(true)
+                .default_missing_value(DEFAULT_TWO_PHASE_MARGIN_DB_STR)
+                .value_parser(parse_two_phase_margin),
+        )
+        .arg(
+            Arg::new("all-tracks")
+                .long("all-tracks")
+                .help("Analyze every audio track of multi-track containers (MKV/MP4) in one demux pass instead of only the first / 多音轨容器（MKV/MP4）单次解复用分析全部音轨，而非仅第一条")
+                .action(clap::ArgAction::SetTrue),
+        )
+        .arg(
+            Arg::new("loudness")
+                .long("loudness")
+                .help("Also measure EBU R128 integrated loudness (LUFS) and loudness range (LRA) in the same decode pass / 在同一次解码中附加测量 EBU R128 积分响度（LUFS）与响度范围（LRA）")
+                .action(clap::ArgAction::SetTrue)
+                .conflicts_with_all(["estimate", "two-phase", "live"]),
+        )
+        .arg(
+            Arg::new("true-peak")
+                .long("true-peak")
+                .help("Also measure oversampled true peak (dBTP, ITU-R BS.1770) per channel in the same decode pass / 在同一次解码中附加测量各声道过采样真峰值（dBTP，ITU-R BS.1770）")
+                .action(clap::ArgAction::SetTrue)
+                .conflicts_with_all(["estimate", "two-phase", "live"]),
+        )
+        .arg(
+            Arg::new("clipping")
+                .long("clipping")
+                .help("Also count clipped (full-scale) samples and runs of consecutive clipped samples per channel in the same decode pass / 在同一次解码中附加统计各声道削波样本数与连续削波段")
+                .action(clap::ArgAction::SetTrue)
+                .conflicts_with_all(["estimate", "two-phase", "live"]),
+        )
+        .arg(
+            Arg::new("replaygain")
+                .long("replaygain")
+                .help("Also compute ReplayGain 2.0 track gain/peak in the same decode pass; batch mode adds album gain/peak per directory / 在同一次解码中附加计算 ReplayGain 2.0 音轨增益/峰值；批量模式按目录附加专辑增益/峰值")
+                .action(clap::ArgAction::SetTrue)
+                .conflicts_with_all(["estimate", "two-phase", "live"]),
+        )
+        .arg(
+            Arg::new("timeline")
+                .long("timeline")
+                .help("Save per-channel 3-second window RMS/peak timelines next to the report: bin (little-endian columnar .drtl, default) or json / 在报告所在目录保存各声道3秒窗口 RMS/Peak 时间线：bin（小端列式 .drtl，默认）或 json")
+                .value_name("FORMAT")
+                .num_args(0..=1)
+                .require_equals(true)
+                .default_missing_value("bin")
+                .value_parser(clap::builder::PossibleValuesParser::new(["bin", "json"]))
+                .conflicts_with_all(["estimate", "two-phase", "live"]),
+        )
+        .arg(
+            Arg::new("store")
+                .long("store")
+                .help("Append every analyzed file to a columnar result store directory (created if missing); query it later with the 'query' subcommand / 将每个已分析文件追加到列式结果库目录（不存在则创建），之后用 query 子命令查询")
+                .value_name("DIR")
+                .value_parser(clap::value_parser!(PathBuf))
+                .value_hint(clap::ValueHint::DirPath)
+                .conflicts_with_all(["estimate", "two-phase", "live"]),
+        )
+        .arg(
+            Arg::new("live")
+                .long("live")
+                .help("Live rolling DR meter: print the DR of the last N minutes after every 3-second window (single file or stdin '-'); optional span (minutes, range 0.1~1440, default 5) / 实时滚动DR表：每完成一个3秒窗口输出最近N分钟的DR（单文件或标准输入 '-'）；可选跨度（分钟，范围 0.1~1440，默认 5）")
+                .value_name("MINUTES")
+                .num_args(0..=1)
+                .require_equals(true)
+                .default_missing_value(DEFAULT_LIVE_SPAN_MINUTES_STR)
+                .value_parser(parse_live_span)
+                .conflicts_with_all(["estimate", "two-phase", "all-tracks", "trim-edges", "compact"]),
+        )
+        .arg(
+            Arg::new("format")
+                .long("format")
+                .help("Raw PCM sample format for stdin input '-' (requires --rate and --channels; omit for WAV/W64 streams) / 标准输入 '-' 的原始PCM样本格式（需同时指定 --rate 与 --channels；WAV/W64 流无需指定）")
+                .value_name("FMT")
+                .value_parser(clap::builder::PossibleValuesParser::new(RawSampleFormat::NAMES))
+                .requires_all(["rate", "channels"]),
+        )
+        .arg(
+            Arg::new("rate")
+                .long("rate")
+                .help("Raw PCM sample rate in Hz / 原始PCM采样率（Hz）")
+                .value_name("HZ")
+                .value_parser(parse_raw_rate)
+                .requires("format"),
+        )
+        .arg(
+            Arg::new("channels")
+                .long("channels")
+                .help("Raw PCM channel count / 原始PCM声道数")
+                .value_name("N")
+                .value_parser(parse_raw_channels)
+                .requires("format"),
+        )
         .arg(
             Arg::new("trim-edges")
                 .long("trim-edges")
@@ -347,7 +552,11 @@ pub fn parse_args() -> AppConfig {
                 .value_parser(parse_trim_min_run)
                 .default_value(DEFAULT_TRIM_MIN_RUN_MS_STR),
         )
-        .get_matches();
+        .args_conflicts_with_subcommands(true)
+        .subcommand(query_command());
+    let matches = command.get_matches_mut();
+
+    let query = matches.subcommand_matches("query").map(parse_store_query);
 
     // 确定输入路径（智能路径处理）
     let (input_path, auto_launched) = match matches.get_one::<PathBuf>("INPUT") {
@@ -359,6 +568,25 @@ pub fn parse_args() -> AppConfig {
         }
     };
 
+    // 原始PCM参数仅描述标准输入流
+    let raw_pcm = matches.get_one::<String>("format").map(|name| RawPcmSpec {
+        sample_format: RawSampleFormat::from_name(name).expect("validated by clap"),
+        sample_rate: *matches
+            .get_one::<u32>("rate")
+            .expect("required by --format"),
+        channels: *matches
+            .get_one::<u16>("channels")
+            .expect("required by --format"),
+    });
+    if raw_pcm.is_some() && !utils::is_stdin_path(&input_path) {
+        command
+            .error(
+                clap::error::ErrorKind::ArgumentConflict,
+                "--format/--rate/--channels only apply to stdin input '-' / 仅适用于标准输入 '-'",
+            )
+            .exit();
+    }
+
     // 并行解码配置逻辑（性能优先策略）
     // 已验证：SequencedChannel保证样本顺序，DR精度无损
     // 性能提升：3.71倍 (57.47 → 213.19 MB/s, 10次平均测试)
@@ -418,6 +646,23 @@ pub fn parse_args() -> AppConfig {
         json_output: matches.get_flag("json"),
         auto_launched,
         no_save: matches.get_flag("no-save"),
+        estimate: matches.get_flag("estimate"),
+        two_phase_margin_db: matches.get_one::<f64>("two-phase").copied(),
+        all_tracks: matches.get_flag("all-tracks"),
+        raw_pcm,
+        live_span_minutes: matches.get_one::<f64>("live").copied(),
+        loudness: matches.get_flag("loudness"),
+        true_peak: matches.get_flag("true-peak"),
+        clipping: matches.get_flag("clipping"),
+        replay_gain: matches.get_flag("replaygain"),
+        timeline: matches
+            .get_one::<String>("timeline")
+            .map(|format| match format.as_str() {
+                "json" => TimelineFormat::Json,
+                _ => TimelineFormat::Binary,
+            }),
+        store_path: matches.get_one::<PathBuf>("store").cloned(),
+        query,
         // 默认 352.8 kHz；用户可通过 --dsd-pcm-rate 覆盖
         dsd_pcm_rate: matches
             .get_one::<u32>("dsd-pcm-rate")
@@ -436,6 +681,133 @@ pub fn parse_args() -> AppConfig {
     }
 }
 
+/// `query` 子命令：过滤/聚合/导出结果库
+fn query_command() -> Command {
+    Command::new("query")
+        .about("Filter, aggregate or export a result store written by --store / 过滤、聚合或导出 --store 写入的结果库")
+        .arg(
+            Arg::new("STORE")
+                .help("Result store directory / 结果库目录")
+                .required(true)
+                .value_parser(clap::value_parser!(PathBuf))
+                .value_hint(clap::ValueHint::DirPath),
+        )
+        .arg(
+            Arg::new("min-dr")
+                .long("min-dr")
+                .help("Minimum official DR (inclusive) / 官方DR下限（含）")
+                .value_name("DR")
+                .value_parser(clap::value_parser!(i32).range(0..=99)),
+        )
+        .arg(
+            Arg::new("max-dr")
+                .long("max-dr")
+                .help("Maximum official DR (inclusive) / 官方DR上限（含）")
+                .value_name("DR")
+                .value_parser(clap::value_parser!(i32).range(0..=99)),
+        )
+        .arg(
+            Arg::new("codec")
+                .long("codec")
+                .help("Codec name as shown in reports, case-insensitive (e.g. FLAC, MP3, AAC) / 编解码器名称（同报告显示，不区分大小写）")
+                .value_name("NAME"),
+        )
+        .arg(
+            Arg::new("sample-rate")
+                .long("sample-rate")
+                .help("Sample rate in Hz / 采样率（Hz）")
+                .value_name("HZ")
+                .value_parser(clap::value_parser!(u32)),
+        )
+        .arg(
+            Arg::new("channels")
+                .long("channels")
+                .help("Channel count / 声道数")
+                .value_name("N")
+                .value_parser(clap::value_parser!(u16)),
+        )
+        .arg(
+            Arg::new("path")
+                .long("path")
+                .help("Only tracks whose path contains this text (case-sensitive) / 仅路径包含该文本的曲目（区分大小写）")
+                .value_name("TEXT"),
+        )
+        .arg(
+            Arg::new("flag")
+                .long("flag")
+                .help("Only tracks carrying this flag; repeat to require several / 仅带有该标记的曲目；可重复指定以同时要求多个")
+                .value_name("FLAG")
+                .action(clap::ArgAction::Append)
+                .value_parser(clap::builder::PossibleValuesParser::new(
+                    store_flags::NAMES.map(|(_, name)| name),
+                )),
+        )
+        .arg(
+            Arg::new("all-history")
+                .long("all-history")
+                .help("Include earlier analyses of re-analyzed paths (default: latest row per path) / 包含同一路径的历史分析（默认只取每个路径的最新一行）")
+                .action(clap::ArgAction::SetTrue),
+        )
+        .arg(
+            Arg::new("group-by")
+                .long("group-by")
+                .help("Aggregate track count and precise DR per group / 按分组统计曲目数与精确DR")
+                .value_name("KEY")
+                .value_parser(clap::builder::PossibleValuesParser::new(GroupBy::NAMES))
+                .conflicts_with("export"),
+        )
+        .arg(
+            Arg::new("export")
+                .long("export")
+                .help("Export matching tracks instead of a summary: csv or jsonl / 导出匹配的曲目而非汇总：csv 或 jsonl")
+                .value_name("FORMAT")
+                .value_parser(clap::builder::PossibleValuesParser::new(["csv", "jsonl"])),
+        )
+        .arg(
+            Arg::new("output")
+                .long("output")
+                .short('o')
+                .help("Export file (default: stdout) / 导出文件（默认标准输出）")
+                .value_name("FILE")
+                .requires("export")
+                .value_parser(clap::value_parser!(PathBuf))
+                .value_hint(clap::ValueHint::FilePath),
+        )
+}
+
+/// 解析 `query` 子命令参数
+fn parse_store_query(matches: &clap::ArgMatches) -> StoreQuery {
+    StoreQuery {
+        store_dir: matches
+            .get_one::<PathBuf>("STORE")
+            .cloned()
+            .expect("STORE is required"),
+        min_dr: matches.get_one::<i32>("min-dr").copied(),
+        max_dr: matches.get_one::<i32>("max-dr").copied(),
+        codec: matches.get_one::<String>("codec").cloned(),
+        sample_rate: matches.get_one::<u32>("sample-rate").copied(),
+        channels: matches.get_one::<u16>("channels").copied(),
+        path_contains: matches.get_one::<String>("path").cloned(),
+        required_flags: matches
+            .get_many::<String>("flag")
+            .into_iter()
+            .flatten()
+            .filter_map(|name| store_flags::from_name(name))
+            .fold(0, |bits, bit| bits | bit),
+        all_history: matches.get_flag("all-history"),
+        group_by: matches
+            .get_one::<String>("group-by")
+            .and_then(|name| GroupBy::from_name(name)),
+        export: matches
+            .get_one::<String>("export")
+            .map(|format| match format.as_str() {
+                "jsonl" => ExportFormat::Jsonl,
+                _ => ExportFormat::Csv,
+            }),
+        output_path: matches.get_one::<PathBuf>("output").cloned(),
+    }
+}
+
 /// 显示程序启动信息
 pub fn show_startup_info(config: &AppConfig) {
     println!("{} v{VERSION}", constants::app_info::APP_NAME);
@@ -447,7 +819,7 @@ pub fn show_startup_info(config: &AppConfig) {
         );
         if config.parallel_decoding {
             println!(
-                "并行解码 / Parallel decoding: 启用 / enabled ({}threads, {}batch) - 预期 / expected 3-5x speedup",
+                "并行解码 / Parallel decoding: 启用 / enabled ({}threads, {}batch 初始值 / initial, 自适应 / adaptive) - 预期 / expected 3-5x speedup",
                 config.parallel_threads, config.parallel_batch_size
             );
         } else {
@@ -502,6 +874,18 @@ mod tests {
             "DEFAULT_PARALLEL_FILES 必须与 constants::defaults::PARALLEL_FILES_DEGREE 同步"
         );
 
+        assert_eq!(
+            DEFAULT_LIVE_SPAN_MINUTES_STR.parse::<f64>().unwrap(),
+            constants::live_meter::SPAN_MINUTES,
+            "DEFAULT_LIVE_SPAN_MINUTES_STR 必须与 constants::live_meter::SPAN_MINUTES 同步"
+        );
+
+        assert_eq!(
+            DEFAULT_TWO_PHASE_MARGIN_DB_STR.parse::<f64>().unwrap(),
+            constants::sparse_estimate::TWO_PHASE_MARGIN_DB,
+            "DEFAULT_TWO_PHASE_MARGIN_DB_STR 必须与 constants::sparse_estimate::TWO_PHASE_MARGIN_DB 同步"
+        );
+
         let default_threshold = DEFAULT_SILENCE_THRESHOLD_DB_STR
             .parse::<f64>()
             .expect("DEFAULT_SILENCE_THRESHOLD_DB_STR 应该是有效浮点数");
@@ -533,6 +917,28 @@ mod tests {
         assert_eq!(parse_batch_size("256").unwrap(), 256);
     }
 
+    #[test]
+    fn test_parse_two_phase_margin() {
+        assert_eq!(parse_two_phase_margin("0.3").unwrap(), 0.3);
+        assert_eq!(parse_two_phase_margin("0").unwrap(), 0.0);
+        assert!(parse_two_phase_margin("-0.1").is_err());
+        assert!(parse_two_phase_margin("2.5").is_err());
+        assert!(parse_two_phase_margin("abc").is_err());
+    }
+
+    #[test]
+    fn test_parse_raw_pcm_params() {
+        assert_eq!(parse_raw_rate("48000").unwrap(), 48000);
+        assert!(parse_raw_rate("0").is_err());
+        assert!(parse_raw_rate("1000000").is_err());
+        assert_eq!(parse_raw_channels("2").unwrap(), 2);
+        assert!(parse_raw_channels("0").is_err());
+        assert!(parse_raw_channels("33").is_err());
+        for name in RawSampleFormat::NAMES {
+            assert!(RawSampleFormat::from_name(name).is_some());
+        }
+    }
+
     #[test]
     fn test_parse_batch_size_invalid() {
         assert!(parse_batch_size("0").is_err());
@@ -75,6 +75,26 @@ pub mod dr_analysis {
     /// - 完全静音（全0样本）的RMS为 0.0
     /// - 为测试预留容差时，通常使用 DR_ZERO_EPS * 100.0 ≈ 1e-10
     pub const DR_ZERO_EPS: f64 = 1e-12;
+
+    /// 内存并行分段计算：每个分段至少包含的3秒窗口数
+    ///
+    /// `DrCalculator` 对整轨内存缓冲按窗口对齐的帧区间切分，分段在rayon线程池上
+    /// 并行处理后按时间顺序合并（结果与串行逐位一致）。
+    ///
+    /// **设计考量**：
+    /// - 分段过短时任务调度与合并（10001-bin直方图相加）开销占比上升
+    /// - 8个窗口约24秒音频，单段处理时间远大于调度开销
+    /// - 总窗口数不足 2×该值 时不分段：3+声道按声道扇出，1-2声道走声道级并行的串行路径
+    pub const PARALLEL_SEGMENT_MIN_WINDOWS: usize = 8;
+
+    /// 削波段统计的最小连续样本数
+    ///
+    /// 连续达到 `CLIPPING_THRESHOLD` 的样本数不少于该值时计为一个削波段（clip run）。
+    ///
+    /// **设计考量**：
+    /// - 单个满幅样本可能是合法的峰值，连续3个满幅样本几乎只可能来自削波
+    /// - 与常见CD削波检测工具的判定口径一致
+    pub const CLIP_RUN_MIN_SAMPLES: u64 = 3;
 }
 
 /// 音频格式约束常量
@@ -86,6 +106,103 @@ pub mod format_constraints {
     pub const MAX_CHANNELS: u16 = 32;
 }
 
+/// 稀疏估算模式（`--estimate`）常量
+pub mod sparse_estimate {
+    /// 抽样窗口占完整窗口总数的目标比例
+    ///
+    /// 10% 抽样在长曲目上把解码量降到约 1/10（含预滚后约 1/8），
+    /// 实际抽样数再由 [`MIN_SAMPLED_WINDOWS`]/[`MAX_SAMPLED_WINDOWS`] 钳制。
+    pub const SAMPLE_FRACTION: f64 = 0.10;
+
+    /// 最少抽样窗口数
+    ///
+    /// 20% 分位统计至少需要若干个"最响窗口"才有意义：12个窗口时取前2个。
+    pub const MIN_SAMPLED_WINDOWS: usize = 12;
+
+    /// 最多抽样窗口数
+    ///
+    /// 48个窗口（约2.4分钟音频）后置信区间收窄有限，继续增加只会抬高读取比例；
+    /// 对1小时音频（约1200窗口）读取比例约4%。
+    pub const MAX_SAMPLED_WINDOWS: usize = 48;
+
+    /// 抽样后读取比例上限：超过该比例时估算不再划算，直接回退完整分析
+    pub const MAX_READ_FRACTION: f64 = 0.5;
+
+    /// 每个抽样窗口前的预滚时长（秒）
+    ///
+    /// 定位落点后先解码并丢弃这段音频，让有状态解码器（MP3位储备、AAC/Vorbis重叠相加）
+    /// 收敛；无损格式的额外开销仅为0.5秒/窗口。
+    pub const PREROLL_SECONDS: f64 = 0.5;
+
+    /// Bootstrap 重抽样轮数（置信区间）
+    pub const BOOTSTRAP_ROUNDS: usize = 1000;
+
+    /// 置信水平（双侧百分位区间）
+    pub const CONFIDENCE_LEVEL: f64 = 0.95;
+
+    /// 两阶段分析默认边界余量（dB）
+    ///
+    /// 估算区间外扩该余量（及 Peak 偏差上界）后仍不含任何舍入边界（k + 0.5）时直接采用估算结果。
+    /// 余量吸收 bootstrap 区间之外的剩余抽样误差；抽样 Peak 偏低的系统偏差由
+    /// [`PEAK_NEAR_FULL_SCALE_DB`]/[`PEAK_STABILITY_DB`] 判据单独处理。
+    /// 0.3 dB 为保守取值，可用 `--two-phase=<DB>` 按曲库实测偏差调整。
+    pub const TWO_PHASE_MARGIN_DB: f64 = 0.3;
+
+    /// 抽样 Peak 距满幅在该值（dB）以内时视为已到顶
+    ///
+    /// 抽样 Peak 是整轨 Peak 的下界，DR 估计因此偏低；Peak 不会超过满幅，
+    /// 故其与满幅的距离即是 DR 偏差的上界（两阶段判定时计入区间上沿）。
+    pub const PEAK_NEAR_FULL_SCALE_DB: f64 = 0.3;
+
+    /// 抽样最大/次大窗口 Peak 相差在该值（dB）以内时视为 Peak 已收敛
+    ///
+    /// 两个不同抽样窗口触及同一峰值上限（限幅/归一化母带的典型特征）时，未抽中的窗口
+    /// 超出该上限的可能性很小，偏差上界取两者之差；既未到顶也未收敛时两阶段强制完整分析。
+    pub const PEAK_STABILITY_DB: f64 = 0.1;
+
+    /// 抽样随机种子（与文件帧数混合：同一文件多次估算结果可复现）
+    pub const SAMPLING_SEED: u64 = 0x4d61_6369_6e44_5221;
+}
+
+/// 首尾边缘裁切（`--trim-edges`）常量
+pub mod edge_trim {
+    /// 尾部反向探测每次读取的时长（秒）
+    pub const TAIL_PROBE_BLOCK_SECONDS: f64 = 5.0;
+
+    /// 尾部反向探测的总时长上限（秒）
+    ///
+    /// 超过该范围仍未找到足够长的非静音段（如数分钟的隐藏音轨间隔）时，
+    /// 回退到流式缓冲判定，避免探测本身变成第二次完整解码。
+    pub const TAIL_PROBE_MAX_SECONDS: f64 = 60.0;
+
+    /// 启用尾部反向探测的扩展名
+    ///
+    /// 仅限定位与解码帧号逐帧精确的无损格式：有损格式的编码延迟/填充使定位帧号
+    /// 与流式解码帧号可能错位，裁切点无法保证一致。
+    pub const TAIL_PROBE_EXTENSIONS: [&str; 4] = ["wav", "flac", "aiff", "aif"];
+}
+
+/// 实时滚动DR表（`--live`）常量
+pub mod live_meter {
+    /// 默认滚动跨度（分钟）
+    ///
+    /// 5分钟约100个3秒窗口：最响20%取20个窗口，统计足够稳定，
+    /// 同时能在一个节目段内反映动态变化。
+    pub const SPAN_MINUTES: f64 = 5.0;
+
+    /// 滚动跨度上限（分钟）：24小时约2.9万窗口，每声道状态仍只有数百KB
+    pub const MAX_SPAN_MINUTES: f64 = 1440.0;
+}
+
+/// 结果库（`--store`）常量
+pub mod result_store {
+    /// 批处理每累计多少行追加一次
+    ///
+    /// 已分析的文件按块落盘，进程中途崩溃或被终止时只丢失最后不足一块的结果；
+    /// 每次追加只打开、写入十几个列文件，64行一块的开销相对解码可以忽略。
+    pub const APPEND_CHUNK_ROWS: usize = 64;
+}
+
 /// 解码器性能优化常量
 pub mod decoder_performance {
     /// BatchPacketReader批量预读包数
@@ -102,6 +219,19 @@ pub mod decoder_performance {
     /// 20个包的阈值确保缓冲区始终有足够数据，避免解码器空等
     pub const PREFETCH_THRESHOLD: usize = 20;
 
+    /// 多音轨解复用：每条音轨的待解码包队列容量
+    ///
+    /// 单次解复用按轨分发包，队列满时解复用线程阻塞（背压），
+    /// 防止解码较慢的音轨（如高码率无损）让其余音轨的包在内存中无限堆积。
+    /// 容量与 BATCH_PACKET_SIZE 同量级：足以平滑交织间隔，单轨峰值仅数百KB。
+    pub const MULTI_TRACK_PACKET_QUEUE: usize = 128;
+
+    /// 管道输入（`-`）单次读取的帧数
+    ///
+    /// 管道无包结构，按固定帧数整帧读取后转换；4096帧在48kHz下约85ms，
+    /// 与常见编解码器包长同量级，读取系统调用次数与内存占用均可忽略。
+    pub const PIPE_READ_CHUNK_FRAMES: usize = 4096;
+
     /// 并行解码器批量处理大小
     ///
     /// 用于OrderedParallelDecoder的批量解码配置，
@@ -131,20 +261,6 @@ pub mod decoder_performance {
     /// - 容量=8（threads×2）：栈溢出崩溃（背压过度）
     pub const SEQUENCED_CHANNEL_CAPACITY_MULTIPLIER: usize = 4;
 
-    /// drain_all_samples() 接收超时时间（毫秒）
-    ///
-    /// 用于 drain_all_samples() 中的 recv_timeout，5ms 是经过性能测试的最优值：
-    /// - 避免CPU空轮询开销（相比 try_recv + sleep(1ms)）
-    /// - 保持良好的响应性（尾部样本延迟 < 5ms）
-    /// - 实测性能提升：+10% 吞吐量（213.27 MB/s → 234.65 MB/s）
-    ///
-    /// **性能验证**：
-    /// - 优化前（try_recv + sleep(1ms)）：213.27 MB/s
-    /// - 优化后（recv_timeout(5ms)）：234.65 MB/s（中位数 236.535 MB/s）
-    /// - 性能提升：+10.0% ~ +10.9%
-    /// - 稳定性：标准差 5.76 MB/s（变异系数 2.45%）
-    pub const DRAIN_RECV_TIMEOUT_MS: u64 = 5;
-
     /// 线程本地样本缓冲区初始容量
     ///
     /// 用于并行解码器中每个工作线程的样本缓冲区预分配，
@@ -159,6 +275,66 @@ pub mod decoder_performance {
     /// - 通过clear()保留容量，实现跨包复用
     /// - 预期收益：内存峰值-20%，分配开销-10-15%
     pub const THREAD_LOCAL_SAMPLE_BUFFER_CAPACITY: usize = 8192;
+
+    /// 并行解码样本缓冲池容量（缓冲区个数）
+    ///
+    /// 分析端归还的 `Vec<f32>` 进入无锁缓冲池，解码工作线程发送结果后从池中取回
+    /// 替换缓冲区，稳态下每包零堆分配。池中保留的缓冲区数不会超过实际在途峰值
+    /// （归还的都是此前在途的缓冲区），256 覆盖最大批大小下两批在途的常见情形；
+    /// 池满时多余缓冲区直接释放。
+    pub const SAMPLE_BUFFER_POOL_CAPACITY: usize = 256;
+
+    /// 自适应批大小：每个工作线程每批的目标解码耗时（微秒）
+    ///
+    /// 并行解码器按"线程数 × 目标耗时 ÷ 实测单包耗时"推算下一批包数：
+    /// - 高采样率 FLAC 等重包：批次自动缩小，降低重排缓冲内存与文件尾延迟
+    /// - MP3/AAC 等轻包：批次自动放大，摊薄 spawn_fifo 调度与解码器初始化开销
+    /// - 2ms 在 4 线程下约等于默认 64 包 × 30µs 的典型批次，保持默认行为附近起步
+    pub const ADAPTIVE_BATCH_TARGET_WORKER_MICROS: u64 = 2_000;
+
+    /// 自适应批大小：单批最大帧数（每声道样本数）
+    ///
+    /// 限制单批解码输出的总量，防止轻包编解码器批次放大后重排缓冲内存膨胀。
+    /// 262,144 帧 ≈ 44.1kHz 下 6 秒 / 192kHz 下 1.4 秒。
+    pub const ADAPTIVE_BATCH_MAX_FRAMES: usize = 1 << 18;
+
+    /// 自适应批大小：开始调整前需要的已解码包数（预热样本量）
+    ///
+    /// 样本不足时保持 `--parallel-batch` 配置的初始批大小，避免首包冷启动耗时误导调整。
+    pub const ADAPTIVE_BATCH_WARMUP_PACKETS: u64 = 32;
+
+    /// 解码→分析流水线环形队列槽位数
+    ///
+    /// 解码线程与分析线程之间的 SPSC 填充队列容量（回收队列取 2 倍，容纳全部在途缓冲区）。
+    /// 8 个槽位足以吸收解码/分析的瞬时速率抖动，同时把在途内存限制在
+    /// 8 × [`PIPELINE_BATCH_SAMPLES`] × 4 字节 ≈ 2 MB。
+    pub const PIPELINE_RING_SLOTS: usize = 8;
+
+    /// 解码→分析流水线单批样本数（交错样本）
+    ///
+    /// 解码线程把若干小 chunk 合并成约 64K 样本（256KB）的批次后再入队，
+    /// 摊薄每次跨线程交接的同步开销；单个 chunk 已达到该大小时直接转移所有权（零拷贝）。
+    pub const PIPELINE_BATCH_SAMPLES: usize = 65_536;
+
+    /// 解码→分析流水线开关（内部策略，面向开发者）
+    ///
+    /// **默认行为（Release）**：固定返回 true
+    ///
+    /// **调试模式（Debug/Test）**：`DR_DISABLE_PIPELINE=1` 或 `=true` 时回退为
+    /// 单线程"解码一块→分析一块"的串行循环，便于 A/B 对比和回归测试。
+    #[inline]
+    pub fn decode_pipeline_enabled() -> bool {
+        #[cfg(any(test, debug_assertions))]
+        {
+            std::env::var("DR_DISABLE_PIPELINE")
+                .map(|v| v != "1" && v != "true")
+                .unwrap_or(true)
+        }
+        #[cfg(not(any(test, debug_assertions)))]
+        {
+            true
+        }
+    }
 }
 
 /// 默认配置值
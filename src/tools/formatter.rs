@@ -4,10 +4,14 @@
 
 use super::cli::AppConfig;
 use super::constants;
+use super::estimator::DrEstimate;
 use super::utils;
 use crate::{
     AudioError, AudioFormat, AudioResult, DrResult,
-    processing::{EdgeTrimReport, SilenceFilterReport},
+    processing::{
+        ClippingReport, EdgeTrimReport, LoudnessReport, MetricReports, ReplayGainReport,
+        SilenceFilterReport, TruePeakReport,
+    },
 };
 use comfy_table::{CellAlignment, Table, presets::ASCII_MARKDOWN};
 use serde::Serialize;
@@ -31,7 +35,7 @@ const VERSION: &str = env!("CARGO_PKG_VERSION");
 /// 将 CodecType 映射为人类可读的编解码器名称
 ///
 /// 优先使用真实的解码器类型信息，比文件扩展名更准确
-fn codec_type_to_string(codec_type: CodecType) -> &'static str {
+pub(crate) fn codec_type_to_string(codec_type: CodecType) -> &'static str {
     match codec_type {
         // 有损压缩格式
         CODEC_TYPE_AAC => "AAC",
@@ -152,6 +156,7 @@ pub fn create_output_header(
     format: &AudioFormat,
     edge_trim_report: Option<EdgeTrimReport>,
     silence_filter_report: Option<SilenceFilterReport>,
+    metrics: &MetricReports,
 ) -> String {
     let mut output = String::new();
 
@@ -237,6 +242,8 @@ pub fn create_output_header(
         }
     }
 
+    output.push_str(&format_metric_lines(metrics));
+
     let sep_dash2 = utils::table::separator_for_lines_with_char(&[&header_line], '-');
     output.push_str(&sep_dash2);
     output.push('\n');
@@ -1047,6 +1054,95 @@ pub fn format_experimental_notes(
     output
 }
 
+/// 格式化附加指标行（各指标一行；未启用或无内容的指标不输出）
+pub fn format_metric_lines(metrics: &MetricReports) -> String {
+    let mut output = String::new();
+    if let Some(report) = &metrics.loudness {
+        output.push_str(&format_loudness_line(report));
+    }
+    if let Some(report) = &metrics.true_peak {
+        output.push_str(&format_true_peak_line(report));
+    }
+    if let Some(report) = &metrics.replay_gain {
+        output.push_str(&format_replay_gain_line(report));
+    }
+    if let Some(report) = &metrics.clipping {
+        output.push_str(&format_clipping_line(report, metrics.true_peak.as_ref()));
+    }
+    output
+}
+
+/// 格式化削波统计（一行：合计 + 各声道削波样本数；无削波且无样本间过冲时为空）
+///
+/// 样本间过冲需要 `--true-peak`：真峰值超过 0 dBTP 的声道即使没有满幅样本也会在回放时削波。
+pub fn format_clipping_line(report: &ClippingReport, true_peak: Option<&TruePeakReport>) -> String {
+    let over_channels = true_peak.map_or(0, TruePeakReport::over_full_scale_channels);
+    if !report.has_clipping() && over_channels == 0 {
+        return String::new();
+    }
+
+    let total = report.total();
+    let channels: Vec<String> = report
+        .channels
+        .iter()
+        .map(|channel| channel.stats.clipped_samples.to_string())
+        .collect();
+    let mut line = format!(
+        "削波 / Clipping: {} samples, {} runs >= {} (longest {}) | {}",
+        total.clipped_samples,
+        total.clip_runs,
+        constants::dr_analysis::CLIP_RUN_MIN_SAMPLES,
+        total.longest_run,
+        channels.join(" ")
+    );
+    if over_channels > 0 {
+        line.push_str(&format!(
+            "; 样本间过冲 / inter-sample overs: {over_channels} ch"
+        ));
+    }
+    line.push('\n');
+    line
+}
+
+/// 格式化响度测量结果（一行；无法测量的项显示为 `-`）
+pub fn format_loudness_line(report: &LoudnessReport) -> String {
+    let integrated = report
+        .integrated_lufs
+        .map_or_else(|| "-".to_string(), |lufs| format!("{lufs:.1} LUFS"));
+    let range = report
+        .loudness_range_lu
+        .map_or_else(|| "-".to_string(), |lu| format!("{lu:.1} LU"));
+    format!("响度 / Loudness (EBU R128): {integrated}, LRA {range}\n")
+}
+
+/// 格式化真峰值测量结果（一行：最大值 + 各声道；静音声道显示为 `-inf`）
+pub fn format_true_peak_line(report: &TruePeakReport) -> String {
+    let channels: Vec<String> = report
+        .channel_peaks
+        .iter()
+        .map(|&peak| format!("{:.2}", TruePeakReport::to_dbtp(peak)))
+        .collect();
+    let max = report
+        .max_dbtp()
+        .map_or_else(|| "-".to_string(), |dbtp| format!("{dbtp:.2} dBTP"));
+    format!(
+        "真峰值 / True Peak ({}x): {max} | {}\n",
+        report.oversampling,
+        channels.join(" ")
+    )
+}
+
+/// 格式化 ReplayGain 2.0 音轨增益与峰值（一行；静音时增益显示为 `-`）
+pub fn format_replay_gain_line(report: &ReplayGainReport) -> String {
+    let gain = report
+        .track_gain_db
+        .map_or_else(|| "-".to_string(), |gain| format!("{gain:+.2} dB"));
+    format!(
+        "ReplayGain 2.0: track gain {gain}, track peak {:.6}\n",
+        report.track_peak
+    )
+}
+
 /// 格式化边界风险预警（紧凑版）
 pub fn format_boundary_warning_compact(official_dr: i32, precise_dr: f64) -> String {
     if let Some((risk_level, direction, distance)) =
@@ -1079,6 +1175,7 @@ pub fn generate_compact_report(
     show_rms_peak: bool,
     edge_trim_report: Option<EdgeTrimReport>,
     silence_filter_report: Option<SilenceFilterReport>,
+    metrics: &MetricReports,
     exclude_lfe: bool,
 ) -> String {
     let mut output = String::new();
@@ -1108,6 +1205,13 @@ pub fn generate_compact_report(
         output.push_str(&create_diagnostics_table(results, format));
     }
 
+    // 附加指标（响度 / 真峰值 / ReplayGain / 削波），整组前置一个空行
+    let metric_lines = format_metric_lines(metrics);
+    if !metric_lines.is_empty() {
+        output.push('\n');
+        output.push_str(&metric_lines);
+    }
+
     // 边界风险预警
     let boundary_warning = format_boundary_warning_compact(official_dr, precise_dr);
     if !boundary_warning.is_empty() {
@@ -1214,6 +1318,82 @@ pub struct JsonReport {
     pub boundary_warning: Option<JsonBoundaryWarning>,
     pub exclude_lfe: bool,
     pub channels: Vec<JsonChannelResult>,
+    /// 稀疏估算信息（仅 `--estimate` 时输出）
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub estimate: Option<JsonEstimate>,
+    /// EBU R128 响度（仅 `--loudness` 时输出）
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub loudness: Option<JsonLoudness>,
+    /// 过采样真峰值（仅 `--true-peak` 时输出）
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub true_peak: Option<JsonTruePeak>,
+    /// ReplayGain 2.0（仅 `--replaygain` 时输出）
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub replay_gain: Option<JsonReplayGain>,
+    /// 削波统计（估算模式不输出）
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub clipping: Option<JsonClipping>,
+}
+
+/// JSON 输出中的响度信息（无法测量时为 null）
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct JsonLoudness {
+    pub integrated_lufs: Option<f64>,
+    pub loudness_range_lu: Option<f64>,
+}
+
+/// JSON 输出中的真峰值信息（dBTP；静音声道为 null）
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct JsonTruePeak {
+    pub oversampling: usize,
+    pub max_dbtp: Option<f64>,
+    pub channels_dbtp: Vec<Option<f64>>,
+}
+
+/// JSON 输出中的 ReplayGain 2.0 信息（静音时增益为 null）
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct JsonReplayGain {
+    pub track_gain_db: Option<f64>,
+    pub track_peak: f64,
+}
+
+/// JSON 输出中的削波统计（样本间过冲仅在 `--true-peak` 时输出）
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct JsonClipping {
+    pub clipped_samples: u64,
+    pub clip_runs: u64,
+    pub longest_run: u64,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub inter_sample_over_channels: Option<usize>,
+    pub channels: Vec<JsonClippingChannel>,
+}
+
+/// JSON 输出中的单声道削波统计
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct JsonClippingChannel {
+    pub channel: usize,
+    pub clipped_samples: u64,
+    pub clip_runs: u64,
+    pub longest_run: u64,
+    pub clipped_windows: usize,
+    pub total_windows: usize,
+}
+
+/// JSON 输出中的稀疏估算信息
+#[derive(Serialize)]
+#[serde(rename_all = "camelCase")]
+pub struct JsonEstimate {
+    pub confidence_level: f64,
+    pub interval_low: f64,
+    pub interval_high: f64,
+    pub windows_sampled: usize,
+    pub windows_total: usize,
+    pub fraction_read: f64,
 }
 
 /// 计算 Official DR 和 Precise DR 值（用于 JSON 输出）
@@ -1233,7 +1413,82 @@ pub fn generate_json_report(
     format: &AudioFormat,
     results: &[DrResult],
     exclude_lfe: bool,
+    metrics: &MetricReports,
 ) -> String {
+    let mut report = build_json_report(config, format, results, exclude_lfe);
+    report.loudness = metrics.loudness.as_ref().map(|loudness| JsonLoudness {
+        integrated_lufs: loudness.integrated_lufs,
+        loudness_range_lu: loudness.loudness_range_lu,
+    });
+    report.true_peak = metrics.true_peak.as_ref().map(|true_peak| JsonTruePeak {
+        oversampling: true_peak.oversampling,
+        max_dbtp: true_peak.max_dbtp().filter(|dbtp| dbtp.is_finite()),
+        channels_dbtp: true_peak
+            .channel_peaks
+            .iter()
+            .map(|&peak| Some(TruePeakReport::to_dbtp(peak)).filter(|dbtp| dbtp.is_finite()))
+            .collect(),
+    });
+    report.replay_gain = metrics
+        .replay_gain
+        .as_ref()
+        .map(|replay_gain| JsonReplayGain {
+            track_gain_db: replay_gain.track_gain_db,
+            track_peak: replay_gain.track_peak,
+        });
+    report.clipping = metrics.clipping.as_ref().map(|clipping| {
+        let total = clipping.total();
+        JsonClipping {
+            clipped_samples: total.clipped_samples,
+            clip_runs: total.clip_runs,
+            longest_run: total.longest_run,
+            inter_sample_over_channels: metrics
+                .true_peak
+                .as_ref()
+                .map(TruePeakReport::over_full_scale_channels),
+            channels: clipping
+                .channels
+                .iter()
+                .map(|channel| JsonClippingChannel {
+                    channel: channel.channel_index + 1,
+                    clipped_samples: channel.stats.clipped_samples,
+                    clip_runs: channel.stats.clip_runs,
+                    longest_run: channel.stats.longest_run,
+                    clipped_windows: channel.clipped_windows,
+                    total_windows: channel.total_windows,
+                })
+                .collect(),
+        }
+    });
+    serde_json::to_string_pretty(&report).unwrap_or_else(|_| "{}".to_string())
+}
+
+/// 生成稀疏估算的 JSON 报告（在标准结构上附加 `estimate` 字段）
+pub fn generate_estimate_json_report(config: &AppConfig, estimate: &DrEstimate) -> String {
+    let mut report = build_json_report(
+        config,
+        &estimate.format,
+        &estimate.results,
+        config.exclude_lfe,
+    );
+    report.estimate = Some(JsonEstimate {
+        confidence_level: estimate.confidence_level,
+        interval_low: estimate.interval_low,
+        interval_high: estimate.interval_high,
+        windows_sampled: estimate.windows_sampled,
+        windows_total: estimate.windows_total,
+        fraction_read: estimate.fraction_read,
+    });
+    serde_json::to_string_pretty(&report).unwrap_or_else(|_| "{}".to_string())
+}
+
+/// 组装 JSON 报告结构
+fn build_json_report(
+    config: &AppConfig,
+    format: &AudioFormat,
+    results: &[DrResult],
+    exclude_lfe: bool,
+) -> JsonReport {
     let lfe_set: std::collections::HashSet<usize> = format.lfe_indices.iter().copied().collect();
 
     // 计算 Official DR
@@ -1288,7 +1543,7 @@ pub fn generate_json_report(
         })
         .collect();
 
-    let report = JsonReport {
+    JsonReport {
         tool: "MacinMeter DR Tool".to_string(),
         version: VERSION.to_string(),
         timestamp: chrono::Local::now().format("%Y-%m-%d %H:%M:%S").to_string(),
@@ -1309,9 +1564,28 @@ pub fn generate_json_report(
         boundary_warning,
         exclude_lfe,
         channels,
-    };
+        estimate: None,
+        loudness: None,
+        true_peak: None,
+        replay_gain: None,
+        clipping: None,
+    }
+}
 
-    serde_json::to_string_pretty(&report).unwrap_or_else(|_| "{}".to_string())
+/// 格式化稀疏估算摘要（文本报告末尾）
+pub fn format_estimate_summary(estimate: &DrEstimate) -> String {
+    format!(
+        "Estimate / 估算 (--estimate): DR{} ({:.2}), {:.0}% CI / 置信区间 [{:.2}, {:.2}]\n\
+         Sampled / 抽样: {}/{} windows / 窗口, read / 读取 {:.1}% of audio / 音频\n",
+        estimate.official_dr,
+        estimate.precise_dr,
+        estimate.confidence_level * 100.0,
+        estimate.interval_low,
+        estimate.interval_high,
+        estimate.windows_sampled,
+        estimate.windows_total,
+        estimate.fraction_read * 100.0,
+    )
 }
 
 /// 处理输出写入（文件或控制台）
@@ -1438,4 +1712,44 @@ mod tests {
         assert!(warning.is_some(), "10.53应该接近下边界10.5，距离仅0.03");
         assert!(warning.unwrap().contains("DR10"));
     }
+
+    #[test]
+    fn test_clipping_line() {
+        use crate::core::ClipStats;
+        use crate::processing::ClippingChannelReport;
+
+        let channel =
+            |channel_index, clipped_samples, clip_runs, longest_run| ClippingChannelReport {
+                channel_index,
+                stats: ClipStats {
+                    clipped_samples,
+                    clip_runs,
+                    longest_run,
+                },
+                clipped_windows: usize::from(clipped_samples > 0),
+                total_windows: 10,
+            };
+        let clean = ClippingReport {
+            channels: vec![channel(0, 0, 0, 0), channel(1, 0, 0, 0)],
+        };
+        assert!(format_clipping_line(&clean, None).is_empty());
+
+        // 无满幅样本但真峰值超过 0 dBTP：仍报告样本间过冲
+        let true_peak = TruePeakReport {
+            oversampling: 4,
+            channel_peaks: vec![0.9, 1.2],
+        };
+        let line = format_clipping_line(&clean, Some(&true_peak));
+        assert!(line.contains("inter-sample overs: 1 ch"), "{line}");
+
+        let clipped = ClippingReport {
+            channels: vec![channel(0, 12, 2, 5), channel(1, 3, 1, 3)],
+        };
+        let line = format_clipping_line(&clipped, None);
+        assert!(
+            line.contains("15 samples, 3 runs >= 3 (longest 5) | 12 3"),
+            "{line}"
+        );
+        assert!(!line.contains("inter-sample"));
+    }
 }
@@ -0,0 +1,146 @@
+//! 实时滚动DR表（`--live`）
+//!
+//! 从单个文件或标准输入（`-`）顺序解码，每完成一个3秒窗口输出一行最近跨度内的DR。
+//! 文本模式输出可读的一行摘要，JSON 模式逐行输出 JSON 对象（JSON Lines），便于下游监控采集。
+//! 内存与每次更新耗时恒定，可对数小时的直播流持续运行。
+
+use super::cli::AppConfig;
+use super::constants::dr_analysis::WINDOW_DURATION_COEFFICIENT;
+use super::constants::live_meter::SPAN_MINUTES;
+use super::{formatter, processor};
+use crate::{
+    AudioError, AudioFormat, AudioResult,
+    core::{RollingDrMeter, RollingDrUpdate, SilenceFilterConfig},
+};
+use std::io::{self, Write};
+
+/// 跨度（分钟）换算为3秒窗口数（至少1个）
+pub fn span_windows_for_minutes(span_minutes: f64) -> usize {
+    ((span_minutes * 60.0 / WINDOW_DURATION_COEFFICIENT).round() as usize).max(1)
+}
+
+/// 运行实时滚动DR表直到输入结束
+///
+/// 输出端关闭（如管道下游的 `head` 退出）视为正常结束。
+pub fn run_live_meter(config: &AppConfig) -> AudioResult<()> {
+    if config.is_batch_mode() {
+        return Err(AudioError::InvalidInput(
+            "--live analyzes a single stream; pass a file or '-' / --live 仅分析单个音频流，请指定文件或 '-'"
+                .to_string(),
+        ));
+    }
+
+    let span_minutes = config.live_span_minutes.unwrap_or(SPAN_MINUTES);
+    let span_windows = span_windows_for_minutes(span_minutes);
+
+    let mut streaming_decoder = processor::open_streaming_decoder(&config.input_path, config)?;
+    let format = streaming_decoder.format();
+    let silence_filter = config
+        .silence_filter_threshold_db
+        .map(SilenceFilterConfig::enabled)
+        .unwrap_or_else(SilenceFilterConfig::disabled);
+    let mut meter = RollingDrMeter::with_silence_filter(
+        format.sample_rate,
+        format.channels as usize,
+        span_windows,
+        silence_filter,
+    )?;
+
+    if !config.json_output {
+        println!(
+            "[LIVE] 滚动DR / Rolling DR: 最近 / last {span_minutes} min ({span_windows} windows), {}Hz, {}ch",
+            format.sample_rate, format.channels
+        );
+    }
+
+    let mut out = io::stdout().lock();
+    while let Some(samples) = streaming_decoder.next_chunk()? {
+        let mut write_result = Ok(());
+        meter.push_interleaved(&samples, |update| {
+            if write_result.is_ok() {
+                write_result =
+                    write_update(&mut out, update, &format, config).and_then(|()| out.flush());
+            }
+        });
+
+        match write_result {
+            Ok(()) => {}
+            Err(e) if e.kind() == io::ErrorKind::BrokenPipe => return Ok(()),
+            Err(e) => return Err(e.into()),
+        }
+    }
+
+    Ok(())
+}
+
+/// 输出一次滚动更新（文本一行或 JSON 一行）
+fn write_update(
+    out: &mut impl Write,
+    update: &RollingDrUpdate,
+    format: &AudioFormat,
+    config: &AppConfig,
+) -> io::Result<()> {
+    let Some((official_dr, precise_dr, _, _)) =
+        formatter::compute_official_precise_dr(&update.results, format, config.exclude_lfe)
+    else {
+        return Ok(());
+    };
+
+    if config.json_output {
+        let line = serde_json::json!({
+            "time_seconds": update.end_seconds,
+            "window": update.window_index,
+            "windows_in_span": update.windows_in_span,
+            "official_dr": official_dr,
+            "precise_dr": precise_dr,
+            "channels": update
+                .results
+                .iter()
+                .map(|result| result.dr_value)
+                .collect::<Vec<_>>(),
+        });
+        writeln!(out, "{line}")
+    } else {
+        let channels: Vec<String> = update
+            .results
+            .iter()
+            .map(|result| format!("{:.2}", result.dr_value))
+            .collect();
+        writeln!(
+            out,
+            "[{}] DR{official_dr} ({precise_dr:.2} dB) | {} | {} windows",
+            format_timestamp(update.end_seconds),
+            channels.join(" "),
+            update.windows_in_span
+        )
+    }
+}
+
+/// 秒数格式化为 `HH:MM:SS`
+fn format_timestamp(seconds: f64) -> String {
+    let total = seconds.floor() as u64;
+    format!(
+        "{:02}:{:02}:{:02}",
+        total / 3600,
+        (total / 60) % 60,
+        total % 60
+    )
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_span_windows_for_minutes() {
+        assert_eq!(span_windows_for_minutes(5.0), 100);
+        assert_eq!(span_windows_for_minutes(1.0), 20);
+        assert_eq!(span_windows_for_minutes(0.01), 1);
+    }
+
+    #[test]
+    fn test_format_timestamp() {
+        assert_eq!(format_timestamp(3.004), "00:00:03");
+        assert_eq!(format_timestamp(3725.9), "01:02:05");
+    }
+}
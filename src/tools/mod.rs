@@ -9,7 +9,11 @@
 //! - 配置和流程控制：`AppConfig`, `parse_args`, `show_*`
 //! - 核心处理函数：`process_single_audio_file`, `output_results`, `process_streaming_decoder`
 //! - DR 计算：`calculate_official_dr`, `compute_official_precise_dr` (测试/插件使用)
-//! - 批处理入口：`process_batch_parallel`
+//! - 稀疏估算/两阶段：`estimate_audio_file`, `output_estimate_results`, `DrEstimate`
+//! - 批处理入口：`process_batch_parallel`, `process_batch_audio_file`（CUE整轨镜像/多音轨逐轨分析）
+//! - 多音轨：`process_all_audio_tracks`, `output_audio_track_results`
+//! - 实时滚动DR：`run_live_meter`
+//! - 结果库：`ResultStore`, `StoreQuery`, `run_query`（`--store` 追加、`query` 子命令）
 //! - 文件扫描：`scan_audio_files`, `show_scan_results`
 //! - 统计类型：`BatchStatsSnapshot`, `SerialBatchStats`, `ParallelBatchStats`
 //! - 工具函数模块：`audio` (dB转换), `path` (路径处理) - 测试使用
@@ -24,9 +28,12 @@
 pub mod batch_state;
 pub mod cli;
 pub mod constants;
+pub mod estimator;
 pub mod formatter;
+pub mod live_meter;
 pub mod parallel_processor;
 pub mod processor;
+pub mod result_store;
 pub mod scanner;
 pub mod utils;
 
@@ -37,10 +44,23 @@ pub use cli::{AppConfig, parse_args, show_completion_info, show_startup_info};
 
 // --- 核心处理函数 ---
 pub use processor::{
-    BatchExclusionStats, add_failed_to_batch_output, add_to_batch_output, output_results,
-    process_single_audio_file, process_streaming_decoder, save_individual_result,
+    AudioTrackAnalysis, BatchClipping, BatchExclusionStats, BatchReplayGain, BatchStore,
+    CueTrackAnalysis, SubTrackResults, SubTrackSource, add_cue_tracks_to_batch_output,
+    add_failed_to_batch_output, add_sub_tracks_to_batch_output, add_to_batch_output,
+    output_audio_track_results, output_estimate_results, output_results, probe_sub_tracks,
+    process_all_audio_tracks, process_batch_audio_file, process_single_audio_file,
+    process_streaming_decoder, save_individual_result,
 };
 
+// --- 稀疏估算 ---
+pub use estimator::{DrEstimate, estimate_audio_file};
+
+// --- 结果库（--store / query 子命令）---
+pub use result_store::{ResultStore, StoreQuery, run_query};
+
+// --- 实时滚动DR ---
+pub use live_meter::run_live_meter;
+
 // --- DR 计算（测试和插件使用）---
 pub use formatter::{calculate_official_dr, compute_official_precise_dr};
 
@@ -4,15 +4,19 @@
 
 use super::cli::AppConfig;
 use super::{
-    BatchExclusionStats, ParallelBatchStats, add_failed_to_batch_output, add_to_batch_output,
-    create_batch_output_header, finalize_and_write_batch_output, process_single_audio_file,
-    processor::AnalysisOutput, save_individual_result, utils,
+    BatchClipping, BatchExclusionStats, BatchReplayGain, BatchStore, ParallelBatchStats,
+    add_failed_to_batch_output, add_sub_tracks_to_batch_output, add_to_batch_output,
+    create_batch_output_header, finalize_and_write_batch_output, probe_sub_tracks,
+    process_batch_audio_file,
+    processor::{AnalysisOutput, BatchAnalysisOutput},
+    save_individual_result, utils,
 };
 use crate::AudioError;
 use crate::error::ErrorCategory;
 use rayon::prelude::*;
 use std::panic;
 use std::path::PathBuf;
+use std::sync::Mutex;
 use std::sync::atomic::{AtomicUsize, Ordering};
 
 /// 有序结果容器（保证输出顺序）
@@ -24,7 +28,7 @@ struct OrderedResult {
     file_path: PathBuf,
 
     /// 处理结果
-    result: Result<AnalysisOutput, AudioError>,
+    result: Result<BatchAnalysisOutput, AudioError>,
 }
 
 /// 多文件并行处理（优雅实现）
@@ -49,6 +53,9 @@ pub fn process_batch_parallel(
     // 进度输出节流计数器（每 50 个文件打印一次）
     let progress_counter = AtomicUsize::new(0);
 
+    // 结果库在处理过程中按块追加（中途中断时已完成的文件不丢失）
+    let store = Mutex::new(BatchStore::default());
+
     // 创建自定义rayon线程池（精确控制并发度）
     let pool = rayon::ThreadPoolBuilder::new()
         .num_threads(parallel_degree)
@@ -84,7 +91,8 @@ pub fn process_batch_parallel(
 
                 // 任务级 panic 隔离：将 panic 转换为错误，防止单文件崩全局
                 let result = panic::catch_unwind(panic::AssertUnwindSafe(|| {
-                    process_single_audio_file(audio_file, &silent_config)
+                    let sub_tracks = probe_sub_tracks(audio_file, &silent_config);
+                    process_batch_audio_file(audio_file, &silent_config, sub_tracks)
                 }))
                 .unwrap_or_else(|_| {
                     Err(AudioError::ResourceError(
@@ -94,7 +102,19 @@ pub fn process_batch_parallel(
 
                 // 更新统计（使用统一的 ParallelBatchStats）
                 match &result {
-                    Ok(_) => {
+                    Ok((output, sub_tracks)) => {
+                        if config.store_path.is_some() {
+                            let mut store = store.lock().unwrap_or_else(|e| e.into_inner());
+                            store.add(config, audio_file, output);
+                            if let Some(sub_tracks) = sub_tracks {
+                                store.add_sub_tracks(
+                                    config,
+                                    audio_file,
+                                    sub_tracks,
+                                    &output.format,
+                                );
+                            }
+                        }
                         let count = stats.inc_processed();
                         if config.verbose {
                             println!(
@@ -144,7 +164,12 @@ pub fn process_batch_parallel(
     sorted_results.sort_by_key(|r| r.index);
 
     // 按序输出到批量文件（与串行模式输出格式完全一致）
-    let is_single_file = audio_files.len() == 1;
+    // 单文件且无附加分轨行（CUE整轨镜像/多音轨容器按批量报告输出）：沿用处理阶段的探测结果
+    let is_single_file = audio_files.len() == 1
+        && !matches!(
+            sorted_results.first().map(|r| &r.result),
+            Some(Ok((_, Some(_))))
+        );
     let mut batch_output = if !is_single_file {
         // 预估容量：header(~500字节) + 每个文件(~250字节)
         let estimated_capacity = 500 + audio_files.len() * 250;
@@ -158,10 +183,22 @@ pub fn process_batch_parallel(
     // 收集边界风险预警和排除统计
     let mut batch_warnings = Vec::new();
     let mut exclusion_stats = BatchExclusionStats::default();
-
+    let mut replay_gain = BatchReplayGain::default();
+    let mut clipping = BatchClipping::default();
     for ordered_result in sorted_results {
         match ordered_result.result {
-            Ok((results, format, trim_report, silence_report)) => {
+            Ok((
+                AnalysisOutput {
+                    results,
+                    format,
+                    edge_trim_report: trim_report,
+                    silence_filter_report: silence_report,
+                    metrics,
+                    estimated,
+                    ..
+                },
+                sub_tracks,
+            )) => {
                 if is_single_file {
                     save_individual_result(
                         &results,
@@ -170,8 +207,11 @@ pub fn process_batch_parallel(
                         config,
                         trim_report,
                         silence_report,
+                        &metrics,
                     )?;
                 } else {
+                    replay_gain.add(&ordered_result.file_path, &metrics);
+                    clipping.add(&ordered_result.file_path, &metrics);
                     // 收集预警信息
                     if let Some(warning) = add_to_batch_output(
                         &mut batch_output,
@@ -179,10 +219,20 @@ pub fn process_batch_parallel(
                         &format,
                         &ordered_result.file_path,
                         config.exclude_lfe,
+                        estimated,
                         &mut exclusion_stats,
                     ) {
                         batch_warnings.push(warning);
                     }
+                    if let Some(sub_tracks) = &sub_tracks {
+                        add_sub_tracks_to_batch_output(
+                            &mut batch_output,
+                            sub_tracks,
+                            &format,
+                            &ordered_result.file_path,
+                            config.exclude_lfe,
+                        );
+                    }
                 }
             }
             Err(_) => {
@@ -193,6 +243,11 @@ pub fn process_batch_parallel(
         }
     }
 
+    store
+        .into_inner()
+        .unwrap_or_else(|e| e.into_inner())
+        .commit(config);
+
     // 统一处理批量输出收尾工作（使用统计快照）
     let snapshot = stats.snapshot();
     finalize_and_write_batch_output(
@@ -205,5 +260,7 @@ pub fn process_batch_parallel(
         is_single_file,
         batch_warnings,
         &exclusion_stats,
+        &replay_gain,
+        &clipping,
     )
 }
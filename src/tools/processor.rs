@@ -3,33 +3,123 @@
 //! 负责音频文件的解码、DR计算和结果处理。
 
 use super::cli::AppConfig;
+use super::estimator::DrEstimate;
+use super::result_store::{self, StoreChannel, StoreRow, flags as store_flags};
 use super::{formatter, utils};
 use crate::{
     AudioError, AudioFormat, AudioResult, DrResult,
-    audio::UniversalDecoder,
+    audio::{
+        AudioTrackInfo, CueSheet, MultiTrackDemuxer, PipeStreamingDecoder, SparseWindowReader,
+        UniversalDecoder,
+    },
     core::{
-        PeakSelectionStrategy, SilenceFilterConfig, histogram::WindowRmsAnalyzer,
+        ClipStats, PeakSelectionStrategy, SilenceFilterConfig, histogram::WindowRmsAnalyzer,
         peak_selection::PeakSelector,
     },
     processing::{
-        ChannelSeparator, EdgeTrimConfig, EdgeTrimReport, EdgeTrimmer, SilenceFilterChannelReport,
-        SilenceFilterReport,
+        AlbumGainAccumulator, AnalysisStages, ChannelSeparator, ClippingReport, EdgeTrimConfig,
+        EdgeTrimReport, EdgeTrimmer, LoudnessMeter, MetricReports, ReplayGainMeter, RingConsumer,
+        RingProducer, SilenceFilterChannelReport, SilenceFilterReport, TruePeakMeter,
+        TruePeakReport, WindowTimeline, spsc_ring,
     },
 };
+use rayon::prelude::*;
+
+/// DR 分析输出（结果 + 最终格式 + 辅助诊断 + 附加指标）
+///
+/// 命名字段且 `#[non_exhaustive]`：新增诊断或指标只加字段，外部调用方按字段名
+/// 解构（`AnalysisOutput { results, format, .. }`）不受影响。
+#[derive(Debug)]
+#[non_exhaustive]
+pub struct AnalysisOutput {
+    /// 各声道DR结果
+    pub results: Vec<DrResult>,
+    /// 最终格式（样本数为实际解码帧数）
+    pub format: AudioFormat,
+    /// 首尾裁切报告（启用 `--trim-edges` 时）
+    pub edge_trim_report: Option<EdgeTrimReport>,
+    /// 静音过滤报告（启用 `--filter-silence` 时）
+    pub silence_filter_report: Option<SilenceFilterReport>,
+    /// 附加指标（响度/真峰值/ReplayGain/时间线，未启用的为 None）
+    pub metrics: MetricReports,
+    /// 结果来自稀疏抽样估算（`--estimate`/`--two-phase` 采纳估算值），而非完整分析
+    pub estimated: bool,
+}
+
+impl AnalysisOutput {
+    /// 仅含DR结果与格式的输出（无诊断、无附加指标）
+    pub fn new(results: Vec<DrResult>, format: AudioFormat) -> Self {
+        Self {
+            results,
+            format,
+            edge_trim_report: None,
+            silence_filter_report: None,
+            metrics: MetricReports::default(),
+            estimated: false,
+        }
+    }
+
+    /// 采纳的稀疏估算结果（标记为估算）
+    pub fn from_estimate(estimate: DrEstimate) -> Self {
+        Self {
+            estimated: true,
+            ..Self::new(estimate.results, estimate.format)
+        }
+    }
+}
+
+/// CUE分轨中单轨的DR结果
+#[derive(Debug, Clone)]
+pub struct CueTrackAnalysis {
+    /// 轨号（TRACK nn）
+    pub number: u32,
+    /// 曲名（分轨表 TITLE）
+    pub title: Option<String>,
+    /// 该轨帧数（超出文件长度的轨道为 0）
+    pub frames: u64,
+    /// 各声道DR结果
+    pub results: Vec<DrResult>,
+}
 
-/// DR 分析输出（结果 + 最终格式 + 辅助诊断）
-pub type AnalysisOutput = (
-    Vec<DrResult>,
-    AudioFormat,
-    Option<EdgeTrimReport>,
-    Option<SilenceFilterReport>,
-);
+/// 多音轨容器中单条音轨的分析结果
+#[derive(Debug)]
+pub struct AudioTrackAnalysis {
+    /// 音轨描述（序号、轨道ID、语言、格式）
+    pub info: AudioTrackInfo,
+    /// 该音轨的分析输出（单条音轨失败不影响其他音轨）
+    pub output: AudioResult<AnalysisOutput>,
+}
+
+/// 附加分轨结果：整轨镜像的CUE分轨，或多音轨容器中主结果以外的音轨
+#[derive(Debug)]
+pub enum SubTrackResults {
+    Cue(Vec<CueTrackAnalysis>),
+    AudioTracks(Vec<AudioTrackAnalysis>),
+}
+
+/// 批处理单文件输出：常规分析结果 + 附加分轨结果
+pub type BatchAnalysisOutput = (AnalysisOutput, Option<SubTrackResults>);
 
 /// 处理单个音频文件
 pub fn process_audio_file(
     path: &std::path::Path,
     config: &AppConfig,
 ) -> AudioResult<AnalysisOutput> {
+    // 估算/两阶段模式：仅解码抽样窗口；不适用或靠近DR边界时回退到完整分析
+    if config.estimate || config.two_phase_margin_db.is_some() {
+        if let Some(estimate) = super::estimator::estimate_audio_file(path, config)? {
+            if super::estimator::estimate_is_conclusive(&estimate, config) {
+                return Ok(AnalysisOutput::from_estimate(estimate));
+            }
+            if config.verbose {
+                println!(
+                    "[INFO] Estimate DR {:.2} [{:.2}, {:.2}] is near a DR boundary, running exact analysis / 估算值靠近DR边界，执行完整精确分析",
+                    estimate.precise_dr, estimate.interval_low, estimate.interval_high
+                );
+            }
+        }
+    }
+
     // 直接使用流式处理实现：零内存累积，恒定内存使用
     // 注：旧的全量加载方法已移除，避免8GB内存占用问题
     process_audio_file_streaming(path, config)
@@ -48,10 +138,11 @@ pub fn process_single_audio_file(
     }
 
     // 处理音频文件
-    let (dr_results, format, trim_report, silence_report) = process_audio_file(file_path, config)?;
+    let output = process_audio_file(file_path, config)?;
 
     if config.verbose {
         use crate::tools::utils;
+        let format = &output.format;
         // 统一对齐：按“显示宽度”对齐左列标签，避免中英混排产生的偏移
         println!("音频格式信息 / Audio format information:");
 
@@ -88,7 +179,238 @@ pub fn process_single_audio_file(
         print!("   {line5}");
     }
 
-    Ok((dr_results, format, trim_report, silence_report))
+    Ok(output)
+}
+
+/// 批处理分轨来源：整轨镜像的CUE分轨表，或 `--all-tracks` 下已打开的多音轨容器
+pub enum SubTrackSource {
+    Cue(CueSheet),
+    AudioTracks(MultiTrackDemuxer),
+}
+
+/// 探测文件是否会产生附加分轨行（CUE整轨镜像，或 `--all-tracks` 下的多音轨容器）
+///
+/// 每个文件只探测一次：探测结果直接交给 [`process_batch_audio_file`]，
+/// 分轨表与已打开的解复用器不会被重复读取。
+pub fn probe_sub_tracks(path: &std::path::Path, config: &AppConfig) -> Option<SubTrackSource> {
+    if config.all_tracks
+        && let Ok(demuxer) = MultiTrackDemuxer::open(path)
+        && demuxer.audio_track_count() >= 2
+    {
+        return Some(SubTrackSource::AudioTracks(demuxer));
+    }
+    locate_cue_sheet(path).map(SubTrackSource::Cue)
+}
+
+/// 批处理单个音频文件，附带分轨结果
+///
+/// `sub_tracks` 为 [`probe_sub_tracks`] 的探测结果：
+/// - 多音轨容器：单次解复用分析全部音轨，第一条分析成功的音轨作为常规结果，
+///   其余音轨（含失败音轨）作为附加行
+/// - 整轨镜像附带CUE分轨表：在同一次解码中逐轨分析，整轨结果照常返回
+///
+/// 以上两种情况都需要完整解码，因此不走估算/两阶段路径。
+pub fn process_batch_audio_file(
+    path: &std::path::Path,
+    config: &AppConfig,
+    sub_tracks: Option<SubTrackSource>,
+) -> AudioResult<BatchAnalysisOutput> {
+    let cue_sheet = match sub_tracks {
+        None => return process_single_audio_file(path, config).map(|output| (output, None)),
+        Some(SubTrackSource::AudioTracks(demuxer)) => {
+            let tracks = analyze_audio_tracks(path, demuxer, config)?;
+            return split_main_audio_track(path, tracks);
+        }
+        Some(SubTrackSource::Cue(cue_sheet)) => cue_sheet,
+    };
+
+    if config.verbose {
+        println!(
+            "检测到CUE分轨表 / CUE sheet detected: {} tracks, 单次解码逐轨分析 / analyzing per track in one decode pass",
+            cue_sheet.tracks.len()
+        );
+    }
+
+    let mut streaming_decoder = open_streaming_decoder(path, config)?;
+    let (output, cue_tracks) = analyze_streaming_decoder_with_cue(
+        &mut *streaming_decoder,
+        config,
+        Some(&cue_sheet),
+        Some(path),
+    )?;
+    save_timeline(path, config, &output.metrics, None);
+    Ok((output, cue_tracks.map(SubTrackResults::Cue)))
+}
+
+/// 取第一条分析成功的音轨作为常规结果，其余音轨保留为附加行；全部失败时返回第一条音轨的错误
+fn split_main_audio_track(
+    path: &std::path::Path,
+    mut tracks: Vec<AudioTrackAnalysis>,
+) -> AudioResult<BatchAnalysisOutput> {
+    let Some(main_index) = tracks.iter().position(|track| track.output.is_ok()) else {
+        return Err(tracks
+            .into_iter()
+            .find_map(|track| track.output.err())
+            .unwrap_or_else(|| {
+                AudioError::FormatError(format!("未找到可解码的音频轨道: 文件 {}", path.display()))
+            }));
+    };
+
+    let main = tracks.remove(main_index);
+    if main_index > 0 {
+        eprintln!(
+            "[WARNING] {}: {} 之前的音轨分析失败，以其作为主结果 / earlier tracks failed, using it as the main result",
+            utils::extract_filename_lossy(path),
+            main.info.label()
+        );
+    }
+    Ok((main.output?, Some(SubTrackResults::AudioTracks(tracks))))
+}
+
+/// 单次解复用分析多音轨容器的全部音轨
+///
+/// 容器无法由 Symphonia 解复用或仅含一条音频轨道时返回 `None`，由调用方按普通文件分析。
+pub fn process_all_audio_tracks(
+    path: &std::path::Path,
+    config: &AppConfig,
+) -> AudioResult<Option<Vec<AudioTrackAnalysis>>> {
+    let Ok(demuxer) = MultiTrackDemuxer::open(path) else {
+        return Ok(None);
+    };
+    if demuxer.audio_track_count() < 2 {
+        return Ok(None);
+    }
+    analyze_audio_tracks(path, demuxer, config).map(Some)
+}
+
+/// 分析已打开容器的全部音频轨道，按音轨序号返回
+///
+/// 各可解码音轨在独立线程中解码与分析，逐轨诊断输出关闭以免交错；
+/// 无法解码的音轨以失败结果保留在原位置。`--timeline` 时逐轨保存时间线（文件名带音轨序号）。
+fn analyze_audio_tracks(
+    path: &std::path::Path,
+    demuxer: MultiTrackDemuxer,
+    config: &AppConfig,
+) -> AudioResult<Vec<AudioTrackAnalysis>> {
+    if config.verbose {
+        println!(
+            "检测到多音轨容器 / Multi-track container: {} audio tracks, 单次解复用并行分析 / analyzing all in one demux pass",
+            demuxer.audio_track_count()
+        );
+        for info in demuxer.tracks() {
+            println!(
+                "   • {}: {}声道 / channels, {}Hz",
+                info.label(),
+                info.format.channels,
+                info.format.sample_rate
+            );
+        }
+        for skipped in demuxer.skipped_tracks() {
+            println!(
+                "   • {}: 跳过 / skipped ({})",
+                skipped.info.label(),
+                skipped.reason
+            );
+        }
+    }
+
+    let skipped: Vec<AudioTrackAnalysis> = demuxer
+        .skipped_tracks()
+        .iter()
+        .map(|skipped| AudioTrackAnalysis {
+            info: skipped.info.clone(),
+            output: Err(AudioError::DecodingError(skipped.reason.clone())),
+        })
+        .collect();
+
+    let track_config = AppConfig {
+        verbose: false,
+        ..config.clone()
+    };
+    let mut tracks = demuxer.analyze_all(|track_decoder| AudioTrackAnalysis {
+        info: track_decoder.info().clone(),
+        output: analyze_streaming_decoder(track_decoder, &track_config),
+    })?;
+    for track in &tracks {
+        if let Ok(output) = &track.output {
+            save_timeline(path, config, &output.metrics, Some(track.info.ordinal));
+        }
+    }
+    tracks.extend(skipped);
+    tracks.sort_by_key(|track| track.info.ordinal);
+    Ok(tracks)
+}
+
+/// 查找可用于分轨分析的分轨表（单轨分轨表无意义，视为无）
+fn locate_cue_sheet(path: &std::path::Path) -> Option<CueSheet> {
+    match CueSheet::locate_for(path) {
+        Ok(sheet) => sheet.filter(|sheet| sheet.tracks.len() >= 2),
+        Err(e) => {
+            eprintln!(
+                "[WARNING] Ignoring CUE sheet for / 忽略分轨表 {}: {e}",
+                utils::extract_filename_lossy(path)
+            );
+            None
+        }
+    }
+}
+
+/// 尾部反向探测：从文件末尾按块反向解码，提前确定边缘裁切的尾部裁切点
+///
+/// 返回 [`EdgeTrimmer::set_trailing_cutoff`] 所需的帧号（`u64::MAX` 表示不裁尾部）。
+/// 非无损格式、无法定位、格式与流式解码器不一致或探测范围内无法判定时返回 None，
+/// 由裁切器回退到流式缓冲判定。
+fn probe_trailing_cutoff(
+    path: &std::path::Path,
+    format: &AudioFormat,
+    trimmer: &EdgeTrimmer,
+) -> Option<u64> {
+    use super::constants::edge_trim::{
+        TAIL_PROBE_BLOCK_SECONDS, TAIL_PROBE_EXTENSIONS, TAIL_PROBE_MAX_SECONDS,
+    };
+
+    let extension = path
+        .extension()
+        .map(|ext| ext.to_string_lossy().to_lowercase())?;
+    if !TAIL_PROBE_EXTENSIONS.contains(&extension.as_str()) {
+        return None;
+    }
+
+    let mut reader = SparseWindowReader::open(path).ok()?;
+    let probed = reader.format();
+    let total_frames = reader.total_frames();
+    if probed.channels != format.channels
+        || probed.sample_rate != format.sample_rate
+        || (format.sample_count != 0 && format.sample_count != total_frames)
+    {
+        return None;
+    }
+
+    let block_frames = (TAIL_PROBE_BLOCK_SECONDS * format.sample_rate as f64).ceil() as u64;
+    let max_frames = (TAIL_PROBE_MAX_SECONDS * format.sample_rate as f64).ceil() as u64;
+    let mut scanner = trimmer.tail_scanner();
+    let mut samples = Vec::new();
+    let mut end = total_frames;
+
+    while end > 0 && total_frames - end < max_frames {
+        let start = end.saturating_sub(block_frames);
+        // 无损格式无需预滚
+        let read = reader
+            .read_window(start, end - start, 0, &mut samples)
+            .ok()?;
+        if read != end - start {
+            return None;
+        }
+        if let Some(trim_frames) = scanner.push_preceding_block(&samples) {
+            return Some(if trim_frames > 0 {
+                total_frames - trim_frames
+            } else {
+                u64::MAX
+            });
+        }
+        end = start;
+    }
+    None
 }
 
 /// 新的流式处理实现：真正的零内存累积处理
@@ -98,10 +420,82 @@ pub fn process_audio_file_streaming(
     path: &std::path::Path,
     config: &AppConfig,
 ) -> AudioResult<AnalysisOutput> {
+    let mut streaming_decoder = open_streaming_decoder(path, config)?;
+
+    // 委托给核心分析引擎（消除150行重复代码）
+    let (output, _) =
+        analyze_streaming_decoder_with_cue(&mut *streaming_decoder, config, None, Some(path))?;
+    save_timeline(path, config, &output.metrics, None);
+    Ok(output)
+}
+
+/// 保存逐窗口时间线（`--timeline`）：与报告同目录，文件名 `<音频文件名>_DR_Timeline.<drtl|json>`
+///
+/// 多音轨容器的音轨传入音轨序号，文件名为 `<音频文件名>_Track<N>_DR_Timeline.<drtl|json>`。
+/// 写入失败只给出警告，不影响DR结果。
+fn save_timeline(
+    audio_file: &std::path::Path,
+    config: &AppConfig,
+    metrics: &MetricReports,
+    track_ordinal: Option<usize>,
+) {
+    let (Some(timeline_format), Some(timeline)) = (config.timeline, &metrics.timeline) else {
+        return;
+    };
+
+    let dir = match &config.output_path {
+        Some(report_path) => utils::get_parent_dir(report_path),
+        None => utils::get_parent_dir(audio_file),
+    };
+    let file_stem = if utils::is_stdin_path(audio_file) {
+        "stdin"
+    } else {
+        utils::extract_file_stem(audio_file)
+    };
+    let track_suffix = track_ordinal.map_or(String::new(), |ordinal| format!("_Track{ordinal}"));
+    let timeline_path = dir.join(format!(
+        "{file_stem}{track_suffix}_DR_Timeline.{}",
+        timeline_format.extension()
+    ));
+
+    match std::fs::write(&timeline_path, timeline.encode(timeline_format)) {
+        Ok(()) if config.verbose => {
+            println!("时间线已保存 / Timeline saved: {}", timeline_path.display());
+        }
+        Ok(()) => {}
+        Err(e) => eprintln!(
+            "[WARNING] 保存时间线失败 / Failed to save timeline {}: {e}",
+            timeline_path.display()
+        ),
+    }
+}
+
+/// 按配置创建串行或并行流式解码器
+pub(super) fn open_streaming_decoder(
+    path: &std::path::Path,
+    config: &AppConfig,
+) -> AudioResult<Box<dyn crate::audio::StreamingDecoder>> {
     if config.verbose {
         println!("使用流式处理模式进行DR分析 / Using streaming processing mode for DR analysis...");
     }
 
+    // 标准输入：顺序读取的管道解码器（不可定位，忽略并行解码配置）
+    if utils::is_stdin_path(path) {
+        let stdin = std::io::stdin().lock();
+        let streaming_decoder: Box<dyn crate::audio::StreamingDecoder> = match config.raw_pcm {
+            Some(spec) => Box::new(PipeStreamingDecoder::from_raw(stdin, spec)?),
+            None => Box::new(PipeStreamingDecoder::from_container(stdin)?),
+        };
+        if config.verbose {
+            let format = streaming_decoder.format();
+            println!(
+                "读取标准输入 / Reading stdin: {}声道 / channels, {}Hz, {}位 / bits",
+                format.channels, format.sample_rate, format.bits_per_sample
+            );
+        }
+        return Ok(streaming_decoder);
+    }
+
     let decoder = UniversalDecoder;
 
     // 创建高性能流式解码器（支持并行解码）
@@ -146,8 +540,7 @@ pub fn process_audio_file_streaming(
         println!("开始流式解码和分析 / Starting streaming decoding and analysis...");
     }
 
-    // 委托给核心分析引擎（消除150行重复代码）
-    analyze_streaming_decoder(&mut *streaming_decoder, config)
+    Ok(streaming_decoder)
 }
 
 /// SIMD优化窗口声道分离处理（辅助函数，内存优化版本）
@@ -158,6 +551,13 @@ pub fn process_audio_file_streaming(
 ///
 /// 通过复用预分配的left_buffer和right_buffer，避免每个窗口都分配新Vec，
 /// 显著降低内存峰值和分配开销（每个并发文件约降低1-1.2MB峰值）。
+///
+/// # 声道级并行
+///
+/// `parallel_channels` 为 true 时把各声道的窗口分析扇出到共享rayon线程池：
+/// 立体声左右声道通过 `rayon::join` 并行分离与处理，3+声道按声道组划分任务。
+/// 每个analyzer只处理自己声道的样本序列，结果与串行处理逐位一致；
+/// 调度粒度为一个3秒窗口，单次调度开销相对窗口计算量可忽略。
 fn process_window_with_simd_separation(
     window_samples: &[f32],
     channel_count: u32,
@@ -165,6 +565,7 @@ fn process_window_with_simd_separation(
     analyzers: &mut [WindowRmsAnalyzer],
     left_buffer: &mut Vec<f32>,
     right_buffer: &mut Vec<f32>,
+    parallel_channels: bool,
 ) {
     // 安全检查：确保analyzers数量与声道数一致
     debug_assert_eq!(
@@ -180,29 +581,57 @@ fn process_window_with_simd_separation(
         analyzers[0].process_samples(window_samples);
     } else if channel_count == 2 {
         // 立体声：使用SIMD优化分离左右声道（复用缓冲区）
-        channel_separator.extract_channel_into(
-            window_samples,
-            0, // 左声道索引
-            2, // 总声道数
-            left_buffer,
-        );
-
-        channel_separator.extract_channel_into(
-            window_samples,
-            1, // 右声道索引
-            2, // 总声道数
-            right_buffer,
-        );
+        let (left_analyzer, right_analyzer) = analyzers.split_at_mut(1);
+        let mut process_left = || {
+            channel_separator.extract_channel_into(
+                window_samples,
+                0, // 左声道索引
+                2, // 总声道数
+                left_buffer,
+            );
+            left_analyzer[0].process_samples(left_buffer);
+        };
+        let mut process_right = || {
+            channel_separator.extract_channel_into(
+                window_samples,
+                1, // 右声道索引
+                2, // 总声道数
+                right_buffer,
+            );
+            right_analyzer[0].process_samples(right_buffer);
+        };
 
-        analyzers[0].process_samples(left_buffer);
-        analyzers[1].process_samples(right_buffer);
+        if parallel_channels {
+            rayon::join(process_left, process_right);
+        } else {
+            process_left();
+            process_right();
+        }
     } else {
         // 多声道（3+）：零拷贝单次遍历跨步处理
         // 使用 process_samples_strided 直接从交错样本提取并处理每个声道
         // 性能收益：单次遍历 vs N次遍历，零Vec分配 vs N个Vec
         // 对Atmos场景（7.1.4=12ch, 9.1.6=16ch）尤为关键
-        for (channel_idx, analyzer) in analyzers.iter_mut().enumerate() {
-            analyzer.process_samples_strided(window_samples, channel_idx, channel_count as usize);
+        let channel_count = channel_count as usize;
+        if parallel_channels {
+            // 按线程数划分声道组，每组一个任务（避免每声道一次调度）
+            let group_size = channel_count.div_ceil(rayon::current_num_threads()).max(1);
+            analyzers
+                .par_chunks_mut(group_size)
+                .enumerate()
+                .for_each(|(group_idx, group)| {
+                    for (offset, analyzer) in group.iter_mut().enumerate() {
+                        analyzer.process_samples_strided(
+                            window_samples,
+                            group_idx * group_size + offset,
+                            channel_count,
+                        );
+                    }
+                });
+        } else {
+            for (channel_idx, analyzer) in analyzers.iter_mut().enumerate() {
+                analyzer.process_samples_strided(window_samples, channel_idx, channel_count);
+            }
         }
     }
 }
@@ -228,6 +657,167 @@ fn compact_buffer(
     *buffer_offset = 0;
 }
 
+/// CUE分轨路由器：按 INDEX 01 边界把交错样本分派到每轨独立的窗口分析器组
+///
+/// 每轨从自身起点重新对齐3秒窗口，轨末不足一窗的尾块照常参与计算，
+/// 结果与先切分为单轨文件再逐个分析一致。
+struct CueTrackRouter {
+    tracks: Vec<CueTrackState>,
+    /// 各轨起始帧（首轨从0开始，INDEX 01 之前的隐藏间隙归入首轨）
+    starts: Vec<u64>,
+    current: usize,
+    frame_position: u64,
+    channels: usize,
+    window_size_samples: usize,
+    /// 当前轨未满一窗的样本
+    buffer: Vec<f32>,
+    left_buffer: Vec<f32>,
+    right_buffer: Vec<f32>,
+}
+
+/// 单轨分析状态
+struct CueTrackState {
+    number: u32,
+    title: Option<String>,
+    analyzers: Vec<WindowRmsAnalyzer>,
+    frames: u64,
+}
+
+impl CueTrackRouter {
+    fn new(
+        cue_sheet: &CueSheet,
+        format: &AudioFormat,
+        window_size_samples: usize,
+        sum_doubling: bool,
+        silence_filter_config: SilenceFilterConfig,
+    ) -> Self {
+        let tracks = cue_sheet
+            .tracks
+            .iter()
+            .map(|track| CueTrackState {
+                number: track.number,
+                title: track.title.clone(),
+                analyzers: (0..format.channels)
+                    .map(|_| {
+                        WindowRmsAnalyzer::with_silence_filter(
+                            format.sample_rate,
+                            sum_doubling,
+                            silence_filter_config,
+                        )
+                    })
+                    .collect(),
+                frames: 0,
+            })
+            .collect();
+
+        let mut starts: Vec<u64> = cue_sheet
+            .tracks
+            .iter()
+            .map(|track| track.start_frame(format.sample_rate))
+            .collect();
+        if let Some(first) = starts.first_mut() {
+            *first = 0;
+        }
+
+        Self {
+            tracks,
+            starts,
+            current: 0,
+            frame_position: 0,
+            channels: format.channels.max(1) as usize,
+            window_size_samples,
+            buffer: Vec::with_capacity(window_size_samples),
+            left_buffer: Vec::new(),
+            right_buffer: Vec::new(),
+        }
+    }
+
+    /// 送入一段交错样本（跨越轨道边界时自动切换到下一轨）
+    fn push(&mut self, samples: &[f32], channel_separator: &ChannelSeparator) {
+        let mut rest = samples;
+        while !rest.is_empty() {
+            let take = match self.starts.get(self.current + 1) {
+                Some(&next_start) if next_start <= self.frame_position => {
+                    self.finish_current(channel_separator);
+                    continue;
+                }
+                Some(&next_start) => {
+                    (((next_start - self.frame_position) as usize) * self.channels).min(rest.len())
+                }
+                None => rest.len(),
+            };
+
+            let (head, tail) = rest.split_at(take);
+            let frames = (head.len() / self.channels) as u64;
+            self.frame_position += frames;
+            self.tracks[self.current].frames += frames;
+            self.buffer.extend_from_slice(head);
+
+            let mut offset = 0;
+            while self.buffer.len() - offset >= self.window_size_samples {
+                process_window_with_simd_separation(
+                    &self.buffer[offset..offset + self.window_size_samples],
+                    self.channels as u32,
+                    channel_separator,
+                    &mut self.tracks[self.current].analyzers,
+                    &mut self.left_buffer,
+                    &mut self.right_buffer,
+                    false,
+                );
+                offset += self.window_size_samples;
+            }
+            self.buffer.drain(..offset);
+
+            rest = tail;
+        }
+    }
+
+    /// 当前轨收尾：不足一窗的尾块参与计算，随后切换到下一轨
+    fn finish_current(&mut self, channel_separator: &ChannelSeparator) {
+        if !self.buffer.is_empty() {
+            process_window_with_simd_separation(
+                &self.buffer,
+                self.channels as u32,
+                channel_separator,
+                &mut self.tracks[self.current].analyzers,
+                &mut self.left_buffer,
+                &mut self.right_buffer,
+                false,
+            );
+            self.buffer.clear();
+        }
+        self.current += 1;
+    }
+
+    /// 结算各轨DR（超出文件长度的轨道没有样本，结果为空）
+    fn finish(mut self, channel_separator: &ChannelSeparator) -> Vec<CueTrackAnalysis> {
+        while self.current < self.tracks.len() {
+            self.finish_current(channel_separator);
+        }
+
+        self.tracks
+            .into_iter()
+            .map(|track| CueTrackAnalysis {
+                number: track.number,
+                title: track.title,
+                frames: track.frames,
+                results: if track.frames == 0 {
+                    Vec::new()
+                } else {
+                    track
+                        .analyzers
+                        .iter()
+                        .enumerate()
+                        .map(|(channel_idx, analyzer)| {
+                            dr_result_from_analyzer(channel_idx, analyzer, track.frames as usize)
+                        })
+                        .collect()
+                },
+            })
+            .collect()
+    }
+}
+
 /// 核心DR分析引擎（私有函数）：处理任何StreamingDecoder实现
 ///
 /// 包含完整的流式DR分析流程：声道检查→窗口分析→DR计算
@@ -236,6 +826,19 @@ fn analyze_streaming_decoder(
     streaming_decoder: &mut dyn crate::audio::StreamingDecoder,
     config: &AppConfig,
 ) -> AudioResult<AnalysisOutput> {
+    analyze_streaming_decoder_with_cue(streaming_decoder, config, None, None)
+        .map(|(output, _)| output)
+}
+
+/// 核心DR分析引擎（可选CUE分轨）：整轨分析与逐轨分析共享同一次解码
+///
+/// `source_path` 为解码器对应的源文件时，边缘裁切先对文件尾部做反向探测（见 [`probe_trailing_cutoff`]）。
+fn analyze_streaming_decoder_with_cue(
+    streaming_decoder: &mut dyn crate::audio::StreamingDecoder,
+    config: &AppConfig,
+    cue_sheet: Option<&CueSheet>,
+    source_path: Option<&std::path::Path>,
+) -> AudioResult<(AnalysisOutput, Option<Vec<CueTrackAnalysis>>)> {
     #[cfg(feature = "flame-prof")]
     let _guard_processing = {
         let enabled = std::env::var("DR_FLAME").map(|v| v == "1").unwrap_or(false);
@@ -275,6 +878,7 @@ fn analyze_streaming_decoder(
                 config.sum_doubling_enabled(),
                 silence_filter_config,
             )
+            .with_clip_tracking(config.clipping)
         })
         .collect();
 
@@ -297,14 +901,28 @@ fn analyze_streaming_decoder(
             );
         }
 
-        Some(EdgeTrimmer::new(
-            trim_config,
-            format.channels as usize,
-            format.sample_rate,
-        ))
+        let mut trimmer =
+            EdgeTrimmer::new(trim_config, format.channels as usize, format.sample_rate);
+        if let Some(cutoff) =
+            source_path.and_then(|path| probe_trailing_cutoff(path, &format, &trimmer))
+        {
+            if config.verbose {
+                println!(
+                    "尾部反向探测完成 / Tail probe resolved trailing cutoff: {}",
+                    if cutoff == u64::MAX {
+                        "no trailing trim / 不裁尾部".to_string()
+                    } else {
+                        format!("frame / 帧 {cutoff}")
+                    }
+                );
+            }
+            trimmer.set_trailing_cutoff(cutoff);
+        }
+        Some(trimmer)
     } else {
         None
     };
+    let mut trim_scratch: Vec<f32> = Vec::new();
 
     let mut trim_report: Option<EdgeTrimReport> = None;
     let mut silence_filter_report: Option<SilenceFilterReport> = None;
@@ -313,6 +931,9 @@ fn analyze_streaming_decoder(
     use super::constants::buffers::{
         BUFFER_CAPACITY_MULTIPLIER, MAX_BUFFER_RATIO, window_alignment_enabled,
     };
+    use super::constants::decoder_performance::{
+        PIPELINE_BATCH_SAMPLES, PIPELINE_RING_SLOTS, decode_pipeline_enabled,
+    };
     use super::constants::dr_analysis::{WINDOW_DURATION_COEFFICIENT, WINDOW_DURATION_SECONDS};
 
     // 窗口长度计算 - foobar2000精确公式
@@ -347,7 +968,49 @@ fn analyze_streaming_decoder(
         Vec::new()
     };
 
-    let mut total_chunks = 0;
+    // 声道级并行：并行解码开启后分析成为瓶颈，多声道窗口分析扇出到共享线程池
+    let parallel_channels =
+        config.parallel_decoding && format.channels >= 2 && rayon::current_num_threads() > 1;
+
+    // 解码→分析流水线：解码留在调用线程，窗口分析移到独立线程并行推进。
+    // 已处于rayon工作线程（多文件并行批处理）时不再额外起线程，避免超订阅。
+    let use_pipeline = decode_pipeline_enabled()
+        && rayon::current_thread_index().is_none()
+        && std::thread::available_parallelism()
+            .map(|n| n.get() > 1)
+            .unwrap_or(false);
+
+    // CUE分轨路由：逐轨分析不受首尾裁切影响（裁切仅作用于整轨结果）
+    let mut cue_router = cue_sheet.map(|sheet| {
+        CueTrackRouter::new(
+            sheet,
+            &format,
+            window_size_samples,
+            config.sum_doubling_enabled(),
+            silence_filter_config,
+        )
+    });
+
+    // 附加指标阶段：消费与DR相同的原始解码块（不受首尾裁切影响），N个指标共享一次解码
+    let mut metric_stages = AnalysisStages::new(format.channels as usize, parallel_channels);
+    if config.replay_gain {
+        // ReplayGain 复用响度表的 K 加权；同时启用 --loudness 时一并输出响度报告
+        metric_stages.register(ReplayGainMeter::new(
+            LoudnessMeter::for_format(&format),
+            config.loudness,
+        ));
+    } else if config.loudness {
+        metric_stages.register(LoudnessMeter::for_format(&format));
+    }
+    if config.true_peak {
+        metric_stages.register(TruePeakMeter::new(
+            format.sample_rate,
+            format.channels as usize,
+            parallel_channels,
+        ));
+    }
+
+    let mut total_chunks = 0usize;
     let mut total_samples_processed = 0u64;
     let mut windows_processed = 0;
 
@@ -363,6 +1026,24 @@ fn analyze_streaming_decoder(
             "缓冲管理 / Buffer management: offset+compact (阈值 / threshold: {:.0}%)",
             COMPACT_THRESHOLD_RATIO * 100.0
         );
+        if use_pipeline {
+            println!(
+                "解码流水线 / Decode pipeline: 解码与分析双线程重叠 / decode and analysis overlapped on two threads ({} slots × {} samples)",
+                PIPELINE_RING_SLOTS, PIPELINE_BATCH_SAMPLES
+            );
+        }
+        if parallel_channels {
+            println!(
+                "声道并行 / Channel parallelism: 窗口分析扇出到 / window analysis fanned out to {} threads",
+                rayon::current_num_threads()
+            );
+        }
+        if !metric_stages.is_empty() {
+            println!(
+                "附加指标阶段 / Metric stages (共享解码 / shared decode): {}",
+                metric_stages.names().join(", ")
+            );
+        }
         if window_align_enabled {
             println!(
                 "样本缓冲 / Sample buffer: 预分配 {:.1}×窗口 / pre-allocated to {:.1}x window size, 硬上限 / hard limit: {:.1}x",
@@ -374,71 +1055,99 @@ fn analyze_streaming_decoder(
     }
 
     // 智能缓冲流式处理：积累chunk到标准窗口大小，保持算法精度
-    while let Some(chunk_samples) = streaming_decoder.next_chunk()? {
-        total_chunks += 1;
+    // 流水线模式下该闭包运行在分析线程，否则与解码在调用线程上交替执行
+    {
+        let mut analyze_chunk = |chunk_samples: &[f32],
+                                 chunk_count: usize,
+                                 decode_progress: f32| {
+            let previous_chunks = total_chunks;
+            total_chunks += chunk_count;
+
+            if let Some(ref mut router) = cue_router {
+                router.push(chunk_samples, &channel_separator);
+            }
 
-        // 首尾边缘裁切（如果启用）
-        let processed_samples = if let Some(ref mut trimmer) = edge_trimmer {
-            trimmer.process_chunk(&chunk_samples)
-        } else {
-            chunk_samples
-        };
+            metric_stages.push_interleaved(chunk_samples);
 
-        // 修复：累加实际处理后的样本数（启用裁切时会减少）
-        total_samples_processed += processed_samples.len() as u64;
+            // 首尾边缘裁切（如果启用）
+            // 稳态下直接借用输入切片，仅回灌缓冲时写入复用的 trim_scratch
+            let processed_samples = if let Some(ref mut trimmer) = edge_trimmer {
+                trimmer.process_chunk_into(chunk_samples, &mut trim_scratch)
+            } else {
+                chunk_samples
+            };
 
-        // 积累chunk到缓冲区
-        sample_buffer.extend_from_slice(&processed_samples);
+            // 修复：累加实际处理后的样本数（启用裁切时会减少）
+            total_samples_processed += processed_samples.len() as u64;
 
-        if config.verbose && total_chunks % 500 == 0 {
-            let progress = streaming_decoder.progress() * 100.0;
-            println!(
-                "[PROGRESS] Smart buffer progress / 智能缓冲进度: {progress:.1}% (processed / 已处理 {total_chunks} chunks, buffer / 缓冲: {:.1}KB, offset / 偏移: {buffer_offset})",
-                sample_buffer.len() * 4 / 1024
-            );
-        }
+            // 积累chunk到缓冲区
+            sample_buffer.extend_from_slice(processed_samples);
 
-        // 当积累到完整窗口时，处理并移动offset（消除drain的内存搬移）
-        while sample_buffer.len() - buffer_offset >= window_size_samples {
-            windows_processed += 1;
-
-            if config.verbose && windows_processed % 20 == 0 {
+            if config.verbose && total_chunks / 500 > previous_chunks / 500 {
+                let progress = decode_progress * 100.0;
                 println!(
-                    "处理第 / Processing window #{windows_processed} {WINDOW_DURATION_SECONDS:.1}秒 / second standard window..."
+                    "[PROGRESS] Smart buffer progress / 智能缓冲进度: {progress:.1}% (processed / 已处理 {total_chunks} chunks, buffer / 缓冲: {:.1}KB, offset / 偏移: {buffer_offset})",
+                    sample_buffer.len() * 4 / 1024
                 );
             }
 
-            // 提取一个完整的标准窗口（从offset开始）
-            let window_samples = &sample_buffer[buffer_offset..buffer_offset + window_size_samples];
+            // 当积累到完整窗口时，处理并移动offset（消除drain的内存搬移）
+            while sample_buffer.len() - buffer_offset >= window_size_samples {
+                windows_processed += 1;
 
-            // 使用SIMD优化的声道分离处理（保持窗口完整性，复用缓冲区）
-            process_window_with_simd_separation(
-                window_samples,
-                format.channels as u32,
-                &channel_separator,
-                &mut analyzers,
-                &mut left_buffer,
-                &mut right_buffer,
-            );
+                if config.verbose && windows_processed % 20 == 0 {
+                    println!(
+                        "处理第 / Processing window #{windows_processed} {WINDOW_DURATION_SECONDS:.1}秒 / second standard window..."
+                    );
+                }
 
-            // Offset+compact优化：仅移动offset，延迟实际内存搬移
-            buffer_offset += window_size_samples;
+                // 提取一个完整的标准窗口（从offset开始）
+                let window_samples =
+                    &sample_buffer[buffer_offset..buffer_offset + window_size_samples];
+
+                // 使用SIMD优化的声道分离处理（保持窗口完整性，复用缓冲区）
+                process_window_with_simd_separation(
+                    window_samples,
+                    format.channels as u32,
+                    &channel_separator,
+                    &mut analyzers,
+                    &mut left_buffer,
+                    &mut right_buffer,
+                    parallel_channels,
+                );
 
-            // 硬上限优化：防止缓冲区无限增长
-            // 仅在窗口对齐优化启用时执行硬上限检查
-            if window_align_enabled {
-                let max_buffer_size = (window_size_samples as f64 * MAX_BUFFER_RATIO) as usize;
-                if sample_buffer.len() > max_buffer_size && buffer_offset > window_size_samples {
-                    compact_buffer(
-                        &mut sample_buffer,
-                        &mut buffer_offset,
-                        config.verbose,
-                        &format!(
-                            "Trigger hard limit compact / 触发硬上限Compact: buffer exceeded / 缓冲区超过 {MAX_BUFFER_RATIO:.1}×window / 窗口"
-                        ),
-                    );
+                // Offset+compact优化：仅移动offset，延迟实际内存搬移
+                buffer_offset += window_size_samples;
+
+                // 硬上限优化：防止缓冲区无限增长
+                // 仅在窗口对齐优化启用时执行硬上限检查
+                if window_align_enabled {
+                    let max_buffer_size = (window_size_samples as f64 * MAX_BUFFER_RATIO) as usize;
+                    if sample_buffer.len() > max_buffer_size && buffer_offset > window_size_samples
+                    {
+                        compact_buffer(
+                            &mut sample_buffer,
+                            &mut buffer_offset,
+                            config.verbose,
+                            &format!(
+                                "Trigger hard limit compact / 触发硬上限Compact: buffer exceeded / 缓冲区超过 {MAX_BUFFER_RATIO:.1}×window / 窗口"
+                            ),
+                        );
+                    }
+                    // Compact触发：当已处理样本占比超过阈值时，执行一次性内存整理
+                    else if buffer_offset > 0
+                        && buffer_offset as f64 / sample_buffer.len() as f64
+                            > COMPACT_THRESHOLD_RATIO
+                    {
+                        compact_buffer(
+                            &mut sample_buffer,
+                            &mut buffer_offset,
+                            config.verbose,
+                            "Executing compact / 执行Compact",
+                        );
+                    }
                 }
-                // Compact触发：当已处理样本占比超过阈值时，执行一次性内存整理
+                // 窗口对齐优化禁用时，仅使用compact阈值机制
                 else if buffer_offset > 0
                     && buffer_offset as f64 / sample_buffer.len() as f64 > COMPACT_THRESHOLD_RATIO
                 {
@@ -450,20 +1159,21 @@ fn analyze_streaming_decoder(
                     );
                 }
             }
-            // 窗口对齐优化禁用时，仅使用compact阈值机制
-            else if buffer_offset > 0
-                && buffer_offset as f64 / sample_buffer.len() as f64 > COMPACT_THRESHOLD_RATIO
-            {
-                compact_buffer(
-                    &mut sample_buffer,
-                    &mut buffer_offset,
-                    config.verbose,
-                    "Executing compact / 执行Compact",
-                );
+        };
+
+        if use_pipeline {
+            run_decode_pipeline(streaming_decoder, &mut analyze_chunk)?;
+        } else {
+            while let Some(chunk_samples) = streaming_decoder.next_chunk()? {
+                analyze_chunk(&chunk_samples, 1, streaming_decoder.progress());
+                streaming_decoder.recycle_buffer(chunk_samples);
             }
         }
     }
 
+    let cue_tracks = cue_router.map(|router| router.finish(&channel_separator));
+    let mut metrics = metric_stages.finalize();
+
     // 处理边缘裁切的尾部缓冲区并输出诊断
     if let Some(trimmer) = edge_trimmer {
         let (final_chunk, trim_stats) = trimmer.finalize();
@@ -560,6 +1270,7 @@ fn analyze_streaming_decoder(
             &mut analyzers,
             &mut left_buffer,
             &mut right_buffer,
+            parallel_channels,
         );
     }
 
@@ -592,37 +1303,34 @@ fn analyze_streaming_decoder(
     // 从每个WindowRmsAnalyzer获取最终DR结果
     let mut dr_results = Vec::new();
 
+    // 样本计数说明：
+    // - sample_count 表示"参与分析的总帧数"（每帧包含所有声道样本）
+    // - total_samples_processed 是交错样本总数，除以声道数得到帧数
+    // - 此计数与最终 format.sample_count 一致性由解码器保证
+    let analyzed_frames = total_samples_processed as usize / format.channels as usize;
     for (channel_idx, analyzer) in analyzers.iter().enumerate() {
-        // 使用WindowRmsAnalyzer的20%采样算法
-        let rms_20_percent = analyzer.calculate_20_percent_rms();
-
-        // 获取峰值信息
-        let window_primary_peak = analyzer.get_largest_peak();
-        let window_secondary_peak = analyzer.get_second_largest_peak();
-
-        // 使用官方峰值选择策略系统（与foobar2000一致）
-        let peak_strategy = PeakSelectionStrategy::default(); // PreferSecondary
-        let peak_for_dr = peak_strategy.select_peak(window_primary_peak, window_secondary_peak);
+        dr_results.push(dr_result_from_analyzer(
+            channel_idx,
+            analyzer,
+            analyzed_frames,
+        ));
+    }
 
-        // 计算DR值：DR = -20 * log10(RMS / Peak)
-        let dr_value = if peak_for_dr > 0.0 && rms_20_percent > 0.0 {
-            -20.0 * (rms_20_percent / peak_for_dr).log10()
-        } else {
-            0.0
-        };
+    // 削波统计由窗口分析内核顺带收集，无需额外遍历
+    if config.clipping {
+        metrics.clipping = Some(ClippingReport::from_analyzers(&analyzers));
+    }
 
-        // 样本计数说明：
-        // - sample_count 表示"参与分析的总帧数"（每帧包含所有声道样本）
-        // - total_samples_processed 是交错样本总数，除以声道数得到帧数
-        // - 此计数与最终 format.sample_count 一致性由解码器保证
-        dr_results.push(DrResult::new_with_peaks(
-            channel_idx,
-            dr_value,
-            rms_20_percent,
-            peak_for_dr,
-            window_primary_peak,
-            window_secondary_peak,
-            total_samples_processed as usize / format.channels as usize,
+    if config.timeline.is_some() {
+        // 窗口0起点 = 首部裁切的帧数（时间线对齐原始音频）
+        let start_offset_frames = trim_report.as_ref().map_or(0, |report| {
+            (report.stats.leading_samples_trimmed / format.channels as usize) as u64
+        });
+        metrics.timeline = Some(WindowTimeline::from_analyzers(
+            &analyzers,
+            format.sample_rate,
+            start_offset_frames,
+            analyzed_frames as u64,
         ));
     }
 
@@ -731,7 +1439,202 @@ fn analyze_streaming_decoder(
         }
     }
 
-    Ok((dr_results, final_format, trim_report, silence_filter_report))
+    Ok((
+        AnalysisOutput {
+            results: dr_results,
+            format: final_format,
+            edge_trim_report: trim_report,
+            silence_filter_report,
+            metrics,
+        },
+        cue_tracks,
+    ))
+}
+
+/// 从单声道WindowRmsAnalyzer结算DR结果
+///
+/// 20%分位RMS + 官方峰值选择策略（PreferSecondary，与foobar2000一致），
+/// DR = -20 * log10(RMS / Peak)。
+pub(super) fn dr_result_from_analyzer(
+    channel_idx: usize,
+    analyzer: &WindowRmsAnalyzer,
+    analyzed_frames: usize,
+) -> DrResult {
+    // 使用WindowRmsAnalyzer的20%采样算法
+    let rms_20_percent = analyzer.calculate_20_percent_rms();
+
+    // 获取峰值信息
+    let window_primary_peak = analyzer.get_largest_peak();
+    let window_secondary_peak = analyzer.get_second_largest_peak();
+
+    // 使用官方峰值选择策略系统（与foobar2000一致）
+    let peak_strategy = PeakSelectionStrategy::default(); // PreferSecondary
+    let peak_for_dr = peak_strategy.select_peak(window_primary_peak, window_secondary_peak);
+
+    // 计算DR值：DR = -20 * log10(RMS / Peak)
+    let dr_value = if peak_for_dr > 0.0 && rms_20_percent > 0.0 {
+        -20.0 * (rms_20_percent / peak_for_dr).log10()
+    } else {
+        0.0
+    };
+
+    DrResult::new_with_peaks(
+        channel_idx,
+        dr_value,
+        rms_20_percent,
+        peak_for_dr,
+        window_primary_peak,
+        window_secondary_peak,
+        analyzed_frames,
+    )
+}
+
+/// 解码→分析流水线中的一个批次（若干解码chunk合并后的交错样本）
+struct DecodedBatch {
+    samples: Vec<f32>,
+    /// 合并进本批次的解码chunk数（用于进度统计）
+    chunk_count: usize,
+    /// 批次入队时的解码进度（0.0-1.0）
+    progress: f32,
+    /// 缓冲区来自解码器（大块直接转移）：分析完须经 `recycle_buffer` 还给解码器缓冲池
+    from_decoder: bool,
+}
+
+impl DecodedBatch {
+    fn new(samples: Vec<f32>) -> Self {
+        Self {
+            samples,
+            chunk_count: 0,
+            progress: 0.0,
+            from_decoder: false,
+        }
+    }
+}
+
+/// 解码→分析两级流水线
+///
+/// 解码留在调用线程（解码器无需 `Send`），`analyze_chunk` 运行在作用域线程中；
+/// 两者通过有界 SPSC 环形队列交接批次，分析完的缓冲区经回收队列返还解码端：
+/// 直接转移的解码器缓冲区交还 `recycle_buffer`（解码器缓冲池），合并批次缓冲区留在流水线内复用。
+/// 批次保持解码顺序，分析结果与串行循环逐位一致。
+fn run_decode_pipeline<F>(
+    streaming_decoder: &mut dyn crate::audio::StreamingDecoder,
+    analyze_chunk: &mut F,
+) -> AudioResult<()>
+where
+    F: FnMut(&[f32], usize, f32) + Send,
+{
+    use super::constants::decoder_performance::PIPELINE_RING_SLOTS;
+
+    let (mut filled_tx, mut filled_rx) = spsc_ring::<DecodedBatch>(PIPELINE_RING_SLOTS);
+    // 回收队列容纳全部在途批次（填充队列 + 分析中 + 合并中），归还永不因队列满而丢弃
+    let (mut recycle_tx, mut recycle_rx) = spsc_ring::<DecodedBatch>(PIPELINE_RING_SLOTS * 2);
+
+    std::thread::scope(|scope| {
+        let analysis = scope.spawn(move || {
+            while let Some(mut batch) = filled_rx.pop() {
+                analyze_chunk(&batch.samples, batch.chunk_count, batch.progress);
+
+                // 回收缓冲区（保留容量），由解码端按来源分流
+                batch.samples.clear();
+                let _ = recycle_tx.try_push(batch);
+            }
+        });
+
+        let mut spare_buffers = Vec::new();
+        let decode_result = decode_into_ring(
+            streaming_decoder,
+            &mut filled_tx,
+            &mut recycle_rx,
+            &mut spare_buffers,
+        );
+
+        // 关闭填充队列：分析线程排空剩余批次后退出
+        drop(filled_tx);
+        if let Err(panic) = analysis.join() {
+            std::panic::resume_unwind(panic);
+        }
+        // 分析线程最后归还的解码器缓冲区同样回到缓冲池
+        drain_recycled(streaming_decoder, &mut recycle_rx, &mut spare_buffers);
+
+        decode_result
+    })
+}
+
+/// 流水线解码端：取回已分析的缓冲区并按来源分流
+///
+/// 解码器缓冲区交还 `recycle_buffer`；合并批次缓冲区放入 `spare_buffers` 供下一批次使用。
+fn drain_recycled(
+    streaming_decoder: &mut dyn crate::audio::StreamingDecoder,
+    recycle_rx: &mut RingConsumer<DecodedBatch>,
+    spare_buffers: &mut Vec<Vec<f32>>,
+) {
+    while let Some(batch) = recycle_rx.try_pop() {
+        if batch.from_decoder {
+            streaming_decoder.recycle_buffer(batch.samples);
+        } else {
+            spare_buffers.push(batch.samples);
+        }
+    }
+}
+
+/// 流水线解码端：把解码chunk合并为批次写入填充队列
+fn decode_into_ring(
+    streaming_decoder: &mut dyn crate::audio::StreamingDecoder,
+    filled_tx: &mut RingProducer<DecodedBatch>,
+    recycle_rx: &mut RingConsumer<DecodedBatch>,
+    spare_buffers: &mut Vec<Vec<f32>>,
+) -> AudioResult<()> {
+    use super::constants::decoder_performance::PIPELINE_BATCH_SAMPLES;
+
+    let mut batch = DecodedBatch::new(Vec::with_capacity(PIPELINE_BATCH_SAMPLES));
+
+    loop {
+        // 每轮先取回已分析的缓冲区，解码器缓冲池在解码下一块前即可复用
+        drain_recycled(streaming_decoder, recycle_rx, spare_buffers);
+
+        let Some(chunk_samples) = streaming_decoder.next_chunk()? else {
+            break;
+        };
+
+        // 大块且当前批次为空：直接转移所有权（零拷贝），分析完归还解码器
+        if batch.samples.is_empty() && chunk_samples.len() >= PIPELINE_BATCH_SAMPLES {
+            let direct = DecodedBatch {
+                samples: chunk_samples,
+                chunk_count: 1,
+                progress: streaming_decoder.progress(),
+                from_decoder: true,
+            };
+            if filled_tx.push(direct).is_err() {
+                // 分析线程已退出（仅panic时发生），由join负责传播
+                return Ok(());
+            }
+            continue;
+        }
+
+        batch.samples.extend_from_slice(&chunk_samples);
+        batch.chunk_count += 1;
+        // 已拷入批次，原缓冲区立即交还解码器复用
+        streaming_decoder.recycle_buffer(chunk_samples);
+
+        if batch.samples.len() >= PIPELINE_BATCH_SAMPLES {
+            batch.progress = streaming_decoder.progress();
+            let next_buffer = spare_buffers
+                .pop()
+                .unwrap_or_else(|| Vec::with_capacity(PIPELINE_BATCH_SAMPLES));
+            let full = std::mem::replace(&mut batch, DecodedBatch::new(next_buffer));
+            if filled_tx.push(full).is_err() {
+                return Ok(());
+            }
+        }
+    }
+
+    if !batch.samples.is_empty() {
+        batch.progress = streaming_decoder.progress();
+        let _ = filled_tx.push(batch);
+    }
+
+    Ok(())
 }
 
 /// 处理StreamingDecoder进行DR分析（插件专用API）
@@ -749,6 +1652,59 @@ pub fn process_streaming_decoder(
     analyze_streaming_decoder(streaming_decoder, config)
 }
 
+/// 输出多音轨容器的逐轨DR结果
+///
+/// 每条音轨一份完整报告（以音轨标签分节）；JSON 模式输出为报告数组。
+pub fn output_audio_track_results(
+    tracks: &[AudioTrackAnalysis],
+    config: &AppConfig,
+    auto_save: bool,
+) -> AudioResult<()> {
+    let sections: Vec<String> = tracks
+        .iter()
+        .map(|track| match &track.output {
+            Ok(AnalysisOutput {
+                results,
+                format,
+                edge_trim_report: trim_report,
+                silence_filter_report: silence_report,
+                metrics,
+                ..
+            }) => {
+                let report = render_report(
+                    results,
+                    config,
+                    format,
+                    *trim_report,
+                    silence_report.clone(),
+                    metrics,
+                );
+                if config.json_output {
+                    report
+                } else {
+                    format!("=== {} ===\n{report}", track.info.label())
+                }
+            }
+            Err(e) if config.json_output => serde_json::json!({
+                "track": track.info.label(),
+                "error": e.to_string(),
+            })
+            .to_string(),
+            Err(e) => format!(
+                "=== {} ===\n[FAIL] 分析失败 / Analysis failed: {e}\n",
+                track.info.label()
+            ),
+        })
+        .collect();
+
+    let output = if config.json_output {
+        format!("[\n{}\n]\n", sections.join(",\n"))
+    } else {
+        sections.join("\n")
+    };
+    formatter::write_output(&output, config, auto_save)
+}
+
 /// 输出DR计算结果（foobar2000兼容格式）
 pub fn output_results(
     results: &[DrResult],
@@ -756,11 +1712,58 @@ pub fn output_results(
     format: &AudioFormat,
     edge_trim_report: Option<EdgeTrimReport>,
     silence_filter_report: Option<SilenceFilterReport>,
+    metrics: &MetricReports,
+    auto_save: bool,
+) -> AudioResult<()> {
+    let output = render_report(
+        results,
+        config,
+        format,
+        edge_trim_report,
+        silence_filter_report,
+        metrics,
+    );
+
+    // 写入输出（文件或控制台）
+    formatter::write_output(&output, config, auto_save)
+}
+
+/// 输出稀疏估算结果：标准报告 + 置信区间与读取比例
+pub fn output_estimate_results(
+    estimate: &DrEstimate,
+    config: &AppConfig,
     auto_save: bool,
 ) -> AudioResult<()> {
     let output = if config.json_output {
+        formatter::generate_estimate_json_report(config, estimate)
+    } else {
+        let mut output = render_report(
+            &estimate.results,
+            config,
+            &estimate.format,
+            None,
+            None,
+            &MetricReports::default(),
+        );
+        output.push_str(&formatter::format_estimate_summary(estimate));
+        output
+    };
+
+    formatter::write_output(&output, config, auto_save)
+}
+
+/// 按输出模式（JSON/紧凑/详细）渲染单文件报告
+fn render_report(
+    results: &[DrResult],
+    config: &AppConfig,
+    format: &AudioFormat,
+    edge_trim_report: Option<EdgeTrimReport>,
+    silence_filter_report: Option<SilenceFilterReport>,
+    metrics: &MetricReports,
+) -> String {
+    if config.json_output {
         // JSON 模式
-        formatter::generate_json_report(config, format, results, config.exclude_lfe)
+        formatter::generate_json_report(config, format, results, config.exclude_lfe, metrics)
     } else if config.compact_output {
         // 紧凑模式：~12 行输出
         formatter::generate_compact_report(
@@ -770,6 +1773,7 @@ pub fn output_results(
             config.show_rms_peak,
             edge_trim_report,
             silence_filter_report,
+            metrics,
             config.exclude_lfe,
         )
     } else {
@@ -782,6 +1786,7 @@ pub fn output_results(
             format,
             edge_trim_report,
             silence_filter_report,
+            metrics,
         ));
 
         // 2. 根据声道数格式化DR结果
@@ -810,10 +1815,7 @@ pub fn output_results(
         output.push_str(&formatter::format_audio_info(config, format));
 
         output
-    };
-
-    // 写入输出（文件或控制台）
-    formatter::write_output(&output, config, auto_save)
+    }
 }
 
 /// 批量处理的单个文件结果添加到批量输出
@@ -833,6 +1835,287 @@ pub struct BatchWarningInfo {
 pub struct BatchExclusionStats {
     pub has_lfe_excluded: bool,
     pub has_silent_excluded: bool,
+    pub has_estimated: bool,
+}
+
+/// 批量 ReplayGain 收集（`--replaygain`）
+///
+/// 批量扫描不递归子目录，一次批处理即一个目录，按一张专辑聚合：
+/// 逐文件保留音轨增益/峰值，专辑增益由累加的门限块统一计算。
+#[derive(Debug, Default)]
+pub struct BatchReplayGain {
+    /// (文件名, 音轨增益, 音轨峰值)
+    pub tracks: Vec<(String, Option<f64>, f64)>,
+    pub album: AlbumGainAccumulator,
+}
+
+impl BatchReplayGain {
+    /// 记录一个文件的 ReplayGain 结果（未启用时忽略）
+    pub fn add(&mut self, file_path: &std::path::Path, metrics: &MetricReports) {
+        if let Some(report) = &metrics.replay_gain {
+            self.tracks.push((
+                utils::extract_filename_lossy(file_path),
+                report.track_gain_db,
+                report.track_peak,
+            ));
+            self.album.add(report);
+        }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.tracks.is_empty()
+    }
+}
+
+/// 批量削波汇总：仅记录存在削波（或 `--true-peak` 样本间过冲）的文件
+#[derive(Debug, Default)]
+pub struct BatchClipping {
+    /// (文件名, 全声道合计, 样本间过冲声道数)
+    pub files: Vec<(String, ClipStats, Option<usize>)>,
+}
+
+impl BatchClipping {
+    pub fn add(&mut self, file_path: &std::path::Path, metrics: &MetricReports) {
+        let Some(clipping) = &metrics.clipping else {
+            return;
+        };
+        let over_channels = metrics
+            .true_peak
+            .as_ref()
+            .map(TruePeakReport::over_full_scale_channels);
+        if clipping.has_clipping() || over_channels.is_some_and(|count| count > 0) {
+            self.files.push((
+                utils::extract_filename_lossy(file_path),
+                clipping.total(),
+                over_channels,
+            ));
+        }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.files.is_empty()
+    }
+}
+
+/// 结果库追加缓冲（`--store`）：每累计 [`APPEND_CHUNK_ROWS`](super::constants::result_store::APPEND_CHUNK_ROWS)
+/// 行追加一次，批处理中途中断时已落盘的结果不会丢失
+#[derive(Debug, Default)]
+pub struct BatchStore {
+    rows: Vec<StoreRow>,
+    /// 已成功追加的行数
+    appended: usize,
+}
+
+impl BatchStore {
+    /// 记录一个文件的分析结果（未启用 `--store` 或标准输入时忽略）
+    pub fn add(
+        &mut self,
+        config: &AppConfig,
+        file_path: &std::path::Path,
+        output: &AnalysisOutput,
+    ) {
+        if config.store_path.is_none() || utils::is_stdin_path(file_path) {
+            return;
+        }
+        let row_flags = if output.estimated {
+            store_flags::ESTIMATED
+        } else {
+            0
+        };
+        self.push(
+            config,
+            store_path_key(file_path),
+            &output.results,
+            &output.format,
+            output.edge_trim_report.as_ref(),
+            output.silence_filter_report.as_ref(),
+            &output.metrics,
+            row_flags,
+        );
+    }
+
+    /// 记录附加分轨结果（CUE分轨与 `--all-tracks` 的其余音轨各占一行）
+    ///
+    /// 路径键为文件路径加分轨后缀：CUE分轨为 `#NN`（轨号），其余音轨为 `#TrackN`
+    /// （音轨序号）；主结果行仍使用文件路径本身。分析失败或超出文件长度的分轨不记录。
+    pub fn add_sub_tracks(
+        &mut self,
+        config: &AppConfig,
+        file_path: &std::path::Path,
+        sub_tracks: &SubTrackResults,
+        format: &AudioFormat,
+    ) {
+        if config.store_path.is_none() || utils::is_stdin_path(file_path) {
+            return;
+        }
+        match sub_tracks {
+            SubTrackResults::Cue(tracks) => {
+                let path = store_path_key(file_path);
+                for track in tracks.iter().filter(|track| !track.results.is_empty()) {
+                    let mut track_format = format.clone();
+                    track_format.sample_count = track.frames;
+                    self.push(
+                        config,
+                        format!("{path}#{:02}", track.number),
+                        &track.results,
+                        &track_format,
+                        None,
+                        None,
+                        &MetricReports::default(),
+                        0,
+                    );
+                }
+            }
+            SubTrackResults::AudioTracks(tracks) => {
+                self.add_audio_tracks(config, file_path, tracks)
+            }
+        }
+    }
+
+    /// 记录多音轨容器中主结果以外的音轨（路径键 `#TrackN`，失败的音轨不记录）
+    pub fn add_audio_tracks(
+        &mut self,
+        config: &AppConfig,
+        file_path: &std::path::Path,
+        tracks: &[AudioTrackAnalysis],
+    ) {
+        if config.store_path.is_none() || utils::is_stdin_path(file_path) {
+            return;
+        }
+        let path = store_path_key(file_path);
+        for track in tracks {
+            let Ok(output) = &track.output else {
+                continue;
+            };
+            self.push(
+                config,
+                format!("{path}#Track{}", track.info.ordinal),
+                &output.results,
+                &output.format,
+                output.edge_trim_report.as_ref(),
+                output.silence_filter_report.as_ref(),
+                &output.metrics,
+                0,
+            );
+        }
+    }
+
+    #[allow(clippy::too_many_arguments)]
+    fn push(
+        &mut self,
+        config: &AppConfig,
+        path: String,
+        results: &[DrResult],
+        format: &AudioFormat,
+        edge_trim_report: Option<&EdgeTrimReport>,
+        silence_filter_report: Option<&SilenceFilterReport>,
+        metrics: &MetricReports,
+        mut row_flags: u32,
+    ) {
+        let aggregated =
+            formatter::compute_official_precise_dr(results, format, config.exclude_lfe);
+        if format.is_partial() {
+            row_flags |= store_flags::PARTIAL;
+        }
+        if metrics
+            .clipping
+            .as_ref()
+            .is_some_and(ClippingReport::has_clipping)
+        {
+            row_flags |= store_flags::CLIPPED;
+        }
+        if metrics
+            .true_peak
+            .as_ref()
+            .is_some_and(|report| report.over_full_scale_channels() > 0)
+        {
+            row_flags |= store_flags::TRUE_PEAK_OVER;
+        }
+        if edge_trim_report.is_some_and(|report| {
+            report.stats.leading_samples_trimmed + report.stats.trailing_samples_trimmed > 0
+        }) {
+            row_flags |= store_flags::TRIMMED;
+        }
+        if silence_filter_report.is_some_and(|report| !report.is_empty()) {
+            row_flags |= store_flags::SILENCE_FILTERED;
+        }
+        if let Some((_, _, excluded_count, excluded_lfe_count)) = aggregated {
+            if excluded_lfe_count > 0 {
+                row_flags |= store_flags::LFE_EXCLUDED;
+            }
+            if excluded_count > excluded_lfe_count {
+                row_flags |= store_flags::SILENT_EXCLUDED;
+            }
+        }
+
+        self.rows.push(StoreRow {
+            path,
+            codec: format
+                .codec_type
+                .map_or("Unknown", formatter::codec_type_to_string)
+                .to_string(),
+            sample_rate: format.sample_rate,
+            bits_per_sample: format.bits_per_sample,
+            frames: format.sample_count,
+            official_dr: aggregated.map(|(official_dr, ..)| official_dr),
+            precise_dr: aggregated.map(|(_, precise_dr, ..)| precise_dr),
+            flags: row_flags,
+            analyzed_at: std::time::SystemTime::now()
+                .duration_since(std::time::UNIX_EPOCH)
+                .map_or(0, |elapsed| elapsed.as_secs()),
+            channels: results
+                .iter()
+                .map(|result| StoreChannel {
+                    dr: result.dr_value,
+                    peak: result.peak,
+                    rms: result.rms,
+                })
+                .collect(),
+        });
+        if self.rows.len() >= super::constants::result_store::APPEND_CHUNK_ROWS {
+            self.flush(config);
+        }
+    }
+
+    /// 追加缓冲中的行（失败仅警告并丢弃该块，不影响报告与后续追加）
+    fn flush(&mut self, config: &AppConfig) {
+        let Some(store_path) = &config.store_path else {
+            return;
+        };
+        if self.rows.is_empty() {
+            return;
+        }
+        match result_store::append_rows(store_path, &self.rows) {
+            Ok(()) => self.appended += self.rows.len(),
+            Err(e) => eprintln!(
+                "[WARNING] 写入结果库失败 / Failed to append to result store {}: {e}",
+                store_path.display()
+            ),
+        }
+        self.rows.clear();
+    }
+
+    /// 追加剩余的行并输出汇总
+    pub fn commit(&mut self, config: &AppConfig) {
+        self.flush(config);
+        if let Some(store_path) = &config.store_path
+            && self.appended > 0
+        {
+            println!(
+                "结果库已追加 / Result store appended: {} → {}",
+                self.appended,
+                store_path.display()
+            );
+        }
+    }
+}
+
+/// 结果库中的路径键：规范化路径作为曲库内的唯一标识（同一文件重复分析复用 path id）
+fn store_path_key(file_path: &std::path::Path) -> String {
+    std::fs::canonicalize(file_path)
+        .unwrap_or_else(|_| file_path.to_path_buf())
+        .to_string_lossy()
+        .into_owned()
 }
 
 pub fn add_to_batch_output(
@@ -841,6 +2124,7 @@ pub fn add_to_batch_output(
     format: &AudioFormat,
     file_path: &std::path::Path,
     exclude_lfe: bool,
+    estimated: bool,
     exclusion_stats: &mut BatchExclusionStats,
 ) -> Option<BatchWarningInfo> {
     let file_name = utils::extract_filename_lossy(file_path);
@@ -851,7 +2135,7 @@ pub fn add_to_batch_output(
             // 计算静音排除数量
             let excluded_silent = excluded_count.saturating_sub(excluded_lfe_count);
 
-            // 构建标记：* = LFE, † = Silent
+            // 构建标记：* = LFE, † = Silent, ~ = 抽样估算
             let mut note = String::new();
             if excluded_lfe_count > 0 {
                 note.push_str(" *");
@@ -861,6 +2145,13 @@ pub fn add_to_batch_output(
                 note.push('†');
                 exclusion_stats.has_silent_excluded = true;
             }
+            if estimated {
+                if note.is_empty() {
+                    note.push(' ');
+                }
+                note.push('~');
+                exclusion_stats.has_estimated = true;
+            }
 
             batch_output.push_str(&format!(
                 "| {official_dr} | {precise_dr:.2} | {file_name}{note} |\n"
@@ -885,6 +2176,84 @@ pub fn add_to_batch_output(
     }
 }
 
+/// 附加分轨结果追加到批量输出（紧随该文件的常规结果行）
+pub fn add_sub_tracks_to_batch_output(
+    batch_output: &mut String,
+    sub_tracks: &SubTrackResults,
+    format: &AudioFormat,
+    file_path: &std::path::Path,
+    exclude_lfe: bool,
+) {
+    match sub_tracks {
+        SubTrackResults::Cue(tracks) => {
+            add_cue_tracks_to_batch_output(batch_output, tracks, format, file_path, exclude_lfe)
+        }
+        SubTrackResults::AudioTracks(tracks) => {
+            add_audio_tracks_to_batch_output(batch_output, tracks, file_path, exclude_lfe)
+        }
+    }
+}
+
+/// 多音轨容器其余音轨的DR追加到批量输出（每条音轨使用自身格式聚合）
+pub fn add_audio_tracks_to_batch_output(
+    batch_output: &mut String,
+    tracks: &[AudioTrackAnalysis],
+    file_path: &std::path::Path,
+    exclude_lfe: bool,
+) {
+    let file_name = utils::extract_filename_lossy(file_path);
+    for track in tracks {
+        let label = format!("{file_name} [{}]", track.info.label());
+        let aggregated = track.output.as_ref().ok().and_then(|output| {
+            formatter::compute_official_precise_dr(&output.results, &output.format, exclude_lfe)
+        });
+        match aggregated {
+            Some((official_dr, precise_dr, _, _)) => {
+                batch_output.push_str(&format!("| {official_dr} | {precise_dr:.2} | {label} |\n"))
+            }
+            None => batch_output.push_str(&format!("| - | - | {label} (failed) |\n")),
+        }
+    }
+}
+
+/// CUE镜像的逐轨与专辑DR追加到批量输出（紧随整轨行）
+///
+/// 专辑DR按 foobar2000 约定取各轨 Precise DR 的算术平均后四舍五入；
+/// 无有效声道的轨道（静音或超出文件长度）不计入专辑DR。
+pub fn add_cue_tracks_to_batch_output(
+    batch_output: &mut String,
+    tracks: &[CueTrackAnalysis],
+    format: &AudioFormat,
+    file_path: &std::path::Path,
+    exclude_lfe: bool,
+) {
+    let file_name = utils::extract_filename_lossy(file_path);
+    let mut track_precise_drs = Vec::with_capacity(tracks.len());
+
+    for track in tracks {
+        let label = match &track.title {
+            Some(title) => format!("{file_name} #{:02} {title}", track.number),
+            None => format!("{file_name} #{:02}", track.number),
+        };
+        match formatter::compute_official_precise_dr(&track.results, format, exclude_lfe) {
+            Some((official_dr, precise_dr, _, _)) => {
+                track_precise_drs.push(precise_dr);
+                batch_output.push_str(&format!("| {official_dr} | {precise_dr:.2} | {label} |\n"));
+            }
+            None => batch_output.push_str(&format!("| - | - | {label} (silent) |\n")),
+        }
+    }
+
+    if !track_precise_drs.is_empty() {
+        let album_precise = track_precise_drs.iter().sum::<f64>() / track_precise_drs.len() as f64;
+        batch_output.push_str(&format!(
+            "| {} | {album_precise:.2} | {file_name} (Album, {} tracks) |\n",
+            album_precise.round() as i32,
+            track_precise_drs.len()
+        ));
+    }
+}
+
 /// 批量处理失败文件的结果添加到批量输出
 pub fn add_failed_to_batch_output(batch_output: &mut String, file_path: &std::path::Path) {
     let file_name = utils::extract_filename_lossy(file_path);
@@ -899,6 +2268,7 @@ pub fn save_individual_result(
     config: &AppConfig,
     edge_trim_report: Option<EdgeTrimReport>,
     silence_filter_report: Option<SilenceFilterReport>,
+    metrics: &MetricReports,
 ) -> AudioResult<()> {
     let temp_config = AppConfig {
         input_path: audio_file.to_path_buf(),
@@ -917,6 +2287,18 @@ pub fn save_individual_result(
         json_output: false,      // 批量模式下单独文件不使用 JSON 格式
         auto_launched: false,    // 批量模式下的单独文件始终自动保存
         no_save: config.no_save, // 继承父配置的 no_save 设置
+        estimate: config.estimate,
+        two_phase_margin_db: config.two_phase_margin_db,
+        all_tracks: false,
+        raw_pcm: None,
+        live_span_minutes: None,
+        loudness: false,
+        true_peak: false,
+        clipping: false,
+        replay_gain: false,
+        timeline: None,
+        store_path: None,
+        query: None,
         dsd_pcm_rate: config.dsd_pcm_rate,
         dsd_gain_db: config.dsd_gain_db,
         dsd_filter: config.dsd_filter.clone(),
@@ -928,6 +2310,7 @@ pub fn save_individual_result(
         format,
         edge_trim_report,
         silence_filter_report,
+        metrics,
         true,
     ) {
         eprintln!("   [WARNING] 保存单独结果文件失败 / Failed to save individual result file: {e}");
@@ -943,3 +2326,123 @@ pub fn save_individual_result(
 
     Ok(())
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::audio::parallel_decoder::SampleBufferPool;
+    use crate::tools::constants::decoder_performance::{
+        PIPELINE_BATCH_SAMPLES, PIPELINE_RING_SLOTS,
+    };
+
+    /// 从缓冲池取缓冲区、按固定块长序列产出样本的 Mock 解码器
+    struct PooledMockDecoder {
+        pool: SampleBufferPool,
+        chunk_lens: Vec<usize>,
+        position: usize,
+        next_value: f32,
+    }
+
+    impl PooledMockDecoder {
+        fn new(chunk_lens: Vec<usize>) -> Self {
+            Self {
+                pool: SampleBufferPool::with_capacity(64),
+                chunk_lens,
+                position: 0,
+                next_value: 0.0,
+            }
+        }
+    }
+
+    impl crate::audio::StreamingDecoder for PooledMockDecoder {
+        fn next_chunk(&mut self) -> AudioResult<Option<Vec<f32>>> {
+            let Some(&len) = self.chunk_lens.get(self.position) else {
+                return Ok(None);
+            };
+            self.position += 1;
+            let mut chunk = self.pool.take(len);
+            for _ in 0..len {
+                chunk.push(self.next_value);
+                self.next_value = (self.next_value + 0.001) % 1.0;
+            }
+            Ok(Some(chunk))
+        }
+
+        fn progress(&self) -> f32 {
+            self.position as f32 / self.chunk_lens.len().max(1) as f32
+        }
+
+        fn format(&self) -> AudioFormat {
+            AudioFormat::new(48_000, 2, 32, 0)
+        }
+
+        fn reset(&mut self) -> AudioResult<()> {
+            self.position = 0;
+            Ok(())
+        }
+
+        fn recycle_buffer(&mut self, buffer: Vec<f32>) {
+            self.pool.give_back(buffer);
+        }
+    }
+
+    /// 流水线运行结果：(样本总数, chunk总数, 样本校验和, 缓冲池未命中次数)
+    fn run_pipeline(chunk_lens: Vec<usize>) -> (usize, usize, f64, usize) {
+        let mut decoder = PooledMockDecoder::new(chunk_lens);
+        let mut samples = 0usize;
+        let mut chunks = 0usize;
+        let mut checksum = 0.0f64;
+        let mut analyze = |batch: &[f32], chunk_count: usize, _progress: f32| {
+            samples += batch.len();
+            chunks += chunk_count;
+            checksum += batch
+                .iter()
+                .enumerate()
+                .map(|(i, &s)| s as f64 * (i % 7) as f64)
+                .sum::<f64>();
+        };
+        run_decode_pipeline(&mut decoder, &mut analyze).unwrap();
+        (samples, chunks, checksum, decoder.pool.misses())
+    }
+
+    #[test]
+    fn test_pipeline_returns_direct_buffers_to_decoder_pool() {
+        // 大块全部走直接转移分支：缓冲区须经回收队列回到解码器缓冲池
+        let chunk_count = 200;
+        let (samples, chunks, _, misses) =
+            run_pipeline(vec![PIPELINE_BATCH_SAMPLES + 4_464; chunk_count]);
+        assert_eq!(samples, chunk_count * (PIPELINE_BATCH_SAMPLES + 4_464));
+        assert_eq!(chunks, chunk_count);
+
+        // 预热后不再分配：未命中次数受在途缓冲区数约束（填充队列 + 回收队列 + 分析中 + 解码中），
+        // 与chunk数无关
+        let warmup_bound = PIPELINE_RING_SLOTS * 3 + 2;
+        assert!(
+            misses <= warmup_bound,
+            "pool misses {misses} exceed warm-up bound {warmup_bound}"
+        );
+    }
+
+    #[test]
+    fn test_pipeline_merged_batches_reuse_decoder_pool() {
+        // 小块走合并分支，夹杂大块走直接转移分支
+        let mut chunk_lens = Vec::new();
+        for i in 0..300 {
+            chunk_lens.push(if i % 10 == 9 {
+                PIPELINE_BATCH_SAMPLES * 2
+            } else {
+                4_096
+            });
+        }
+        let total: usize = chunk_lens.iter().sum();
+        let (samples, chunks, _, misses) = run_pipeline(chunk_lens);
+        assert_eq!(samples, total);
+        assert_eq!(chunks, 300);
+
+        let warmup_bound = PIPELINE_RING_SLOTS * 3 + 2;
+        assert!(
+            misses <= warmup_bound,
+            "pool misses {misses} exceed warm-up bound {warmup_bound}"
+        );
+    }
+}
@@ -0,0 +1,1503 @@
+//! 列式曲库结果库（`--store` 追加写入，`query` 子命令查询/导出）
+//!
+//! 批量报告是给人读的文本，逐文件 JSON 需要逐个解析；对整个曲库做统计时
+//! 两者都要解析成千上万个文件。结果库把每次分析的结果按列追加到一个目录中，
+//! 查询时只需顺序读取少量定宽列：百万行规模下打开并过滤远低于一秒
+//! （release 构建，见被忽略的测试 `bench_million_rows_open_and_select`）。
+//!
+//! ## 目录布局（全部小端、无文件头的定宽数组）
+//!
+//! | 文件 | 元素 | 内容 |
+//! |------|------|------|
+//! | `STORE` | 文本 | `MDRSTORE 1`（魔数与版本） |
+//! | `paths.str` / `paths.off` | `u8` / `u64` | 路径字典：UTF-8 拼接串与各项结束偏移，下标即 path id |
+//! | `paths.idx` | `u64` + `u32` | 路径字典的哈希索引：已索引项数 + 开放寻址槽位（path id + 1，0 为空） |
+//! | `codecs.str` / `codecs.off` | `u8` / `u64` | 编解码器名称字典 |
+//! | `path_id.u32` `codec_id.u32` | `u32` | 行 → 字典下标 |
+//! | `sample_rate.u32` `channels.u16` `bits.u16` `frames.u64` | 定宽 | 格式字段 |
+//! | `official_dr.i16` `precise_dr.f64` | 定宽 | 官方DR（无有效声道为 -1）/ 精确DR（NaN） |
+//! | `flags.u32` `analyzed_at.u64` | 定宽 | 标记位 / 分析时间（Unix 秒） |
+//! | `channel_start.u64` | `u64` | 该行在声道表中的起始下标（声道数见 `channels.u16`） |
+//! | `ch_dr.f64` `ch_peak.f64` `ch_rms.f64` | `f64` | 声道表：各声道 DR、Peak、RMS（线性） |
+//!
+//! 每列都是裸数组，可直接内存映射为对应类型的切片；读取端整列一次读入。
+//!
+//! ## 追加与恢复
+//!
+//! 批处理每分析完 64 个文件追加一块（`APPEND_CHUNK_ROWS`），每块按“字典 → 路径索引 →
+//! 声道表 → 行列”的顺序写入。中途中断只会在列尾留下半行，打开时以各行列的最短长度
+//! 为准，下次追加前截断多余字节，已提交的行不受影响。
+//! 同一路径再次分析时追加新行并复用 path id（经 `paths.idx` 查找，追加时不读入整个
+//! 路径字典），查询默认只取每个路径的最新一行。CUE分轨与多音轨容器的其余音轨以
+//! `文件路径#NN` / `文件路径#TrackN` 为路径键各占一行。
+//! 结果库为单写者设计，请勿让多个进程同时向同一目录追加。
+
+use crate::error::{AudioError, AudioResult};
+use std::collections::{BTreeMap, HashMap};
+use std::fs::{self, File, OpenOptions};
+use std::io::{self, Read, Seek, SeekFrom, Write};
+use std::path::{Path, PathBuf};
+
+/// 清单文件名与内容
+const MANIFEST_FILE: &str = "STORE";
+const MANIFEST_MAGIC: &str = "MDRSTORE";
+/// 结果库格式版本
+pub const STORE_VERSION: u32 = 1;
+
+/// 无有效声道时的官方DR占位值
+const NO_OFFICIAL_DR: i16 = -1;
+
+/// 行标记位
+pub mod flags {
+    /// 解码时跳过了损坏的音频包（部分分析）
+    pub const PARTIAL: u32 = 1 << 0;
+    /// 存在满幅削波样本（仅在启用削波统计时设置）
+    pub const CLIPPED: u32 = 1 << 1;
+    /// 真峰值超过 0 dBTP（需 `--true-peak`）
+    pub const TRUE_PEAK_OVER: u32 = 1 << 2;
+    /// 首尾边缘裁切丢弃了样本
+    pub const TRIMMED: u32 = 1 << 3;
+    /// 静音过滤剔除了窗口
+    pub const SILENCE_FILTERED: u32 = 1 << 4;
+    /// 官方DR聚合剔除了LFE声道
+    pub const LFE_EXCLUDED: u32 = 1 << 5;
+    /// 官方DR聚合剔除了静音声道
+    pub const SILENT_EXCLUDED: u32 = 1 << 6;
+    /// 结果为稀疏抽样估算（`--estimate`/`--two-phase` 采纳估算值），非完整分析
+    pub const ESTIMATED: u32 = 1 << 7;
+
+    /// 标记名称（CLI 与导出共用）
+    pub const NAMES: [(u32, &str); 8] = [
+        (PARTIAL, "partial"),
+        (CLIPPED, "clipped"),
+        (TRUE_PEAK_OVER, "true-peak-over"),
+        (TRIMMED, "trimmed"),
+        (SILENCE_FILTERED, "silence-filtered"),
+        (LFE_EXCLUDED, "lfe-excluded"),
+        (SILENT_EXCLUDED, "silent-excluded"),
+        (ESTIMATED, "estimated"),
+    ];
+
+    /// 按名称查找标记位
+    pub fn from_name(name: &str) -> Option<u32> {
+        NAMES
+            .iter()
+            .find(|(_, flag_name)| *flag_name == name)
+            .map(|(bit, _)| *bit)
+    }
+
+    /// 标记位 → 名称列表
+    pub fn names(bits: u32) -> impl Iterator<Item = &'static str> {
+        NAMES
+            .iter()
+            .filter(move |(bit, _)| bits & bit != 0)
+            .map(|(_, name)| *name)
+    }
+}
+
+/// 列文件名
+mod column {
+    pub const PATH_ID: &str = "path_id.u32";
+    pub const CODEC_ID: &str = "codec_id.u32";
+    pub const SAMPLE_RATE: &str = "sample_rate.u32";
+    pub const CHANNELS: &str = "channels.u16";
+    pub const BITS: &str = "bits.u16";
+    pub const FRAMES: &str = "frames.u64";
+    pub const OFFICIAL_DR: &str = "official_dr.i16";
+    pub const PRECISE_DR: &str = "precise_dr.f64";
+    pub const FLAGS: &str = "flags.u32";
+    pub const ANALYZED_AT: &str = "analyzed_at.u64";
+    pub const CHANNEL_START: &str = "channel_start.u64";
+
+    pub const CH_DR: &str = "ch_dr.f64";
+    pub const CH_PEAK: &str = "ch_peak.f64";
+    pub const CH_RMS: &str = "ch_rms.f64";
+
+    /// 行列（名称, 元素字节数）
+    pub const ROWS: [(&str, u64); 11] = [
+        (PATH_ID, 4),
+        (CODEC_ID, 4),
+        (SAMPLE_RATE, 4),
+        (CHANNELS, 2),
+        (BITS, 2),
+        (FRAMES, 8),
+        (OFFICIAL_DR, 2),
+        (PRECISE_DR, 8),
+        (FLAGS, 4),
+        (ANALYZED_AT, 8),
+        (CHANNEL_START, 8),
+    ];
+
+    /// 声道表列
+    pub const CHANNEL_TABLE: [&str; 3] = [CH_DR, CH_PEAK, CH_RMS];
+
+    /// 字典（名称前缀）
+    pub const PATHS: &str = "paths";
+    pub const CODECS: &str = "codecs";
+
+    /// 路径字典的哈希索引
+    pub const PATH_INDEX: &str = "paths.idx";
+}
+
+/// 路径索引最小槽位数（2 的幂）
+const PATH_INDEX_MIN_SLOTS: u64 = 1024;
+/// 路径索引文件头（已索引的字典项数）字节数
+const PATH_INDEX_HEADER: u64 = 8;
+
+/// 定宽小端列元素
+trait LeValue: Copy {
+    const SIZE: usize;
+    fn put(self, out: &mut Vec<u8>);
+    fn get(bytes: &[u8]) -> Self;
+}
+
+macro_rules! le_value {
+    ($($ty:ty),*) => {$(
+        impl LeValue for $ty {
+            const SIZE: usize = std::mem::size_of::<$ty>();
+
+            #[inline]
+            fn put(self, out: &mut Vec<u8>) {
+                out.extend_from_slice(&self.to_le_bytes());
+            }
+
+            #[inline]
+            fn get(bytes: &[u8]) -> Self {
+                <$ty>::from_le_bytes(bytes.try_into().expect("column element width"))
+            }
+        }
+    )*};
+}
+
+le_value!(u16, u32, u64, i16, f64);
+
+/// 单声道结果
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct StoreChannel {
+    pub dr: f64,
+    pub peak: f64,
+    pub rms: f64,
+}
+
+/// 待追加的一行分析结果
+#[derive(Debug, Clone, PartialEq)]
+pub struct StoreRow {
+    pub path: String,
+    pub codec: String,
+    pub sample_rate: u32,
+    pub bits_per_sample: u16,
+    /// 每声道帧数
+    pub frames: u64,
+    pub official_dr: Option<i32>,
+    pub precise_dr: Option<f64>,
+    pub flags: u32,
+    /// 分析时间（Unix 秒）
+    pub analyzed_at: u64,
+    pub channels: Vec<StoreChannel>,
+}
+
+/// 字符串字典（拼接串 + 结束偏移）
+#[derive(Debug, Default)]
+struct StringTable {
+    bytes: Vec<u8>,
+    ends: Vec<u64>,
+}
+
+impl StringTable {
+    fn len(&self) -> usize {
+        self.ends.len()
+    }
+
+    fn get(&self, id: u32) -> &str {
+        let id = id as usize;
+        let Some(&end) = self.ends.get(id) else {
+            return "";
+        };
+        let start = if id == 0 { 0 } else { self.ends[id - 1] };
+        self.bytes
+            .get(start as usize..end as usize)
+            .and_then(|raw| std::str::from_utf8(raw).ok())
+            .unwrap_or("")
+    }
+
+    fn load(dir: &Path, name: &str) -> AudioResult<Self> {
+        let ends: Vec<u64> = read_column(&dir.join(format!("{name}.off")))?;
+        let mut bytes = read_optional(&dir.join(format!("{name}.str")))?;
+        // 丢弃未提交的偏移（串未写完）与多余的串尾
+        let committed = ends.partition_point(|&end| end <= bytes.len() as u64);
+        let ends = ends[..committed].to_vec();
+        bytes.truncate(ends.last().copied().unwrap_or(0) as usize);
+        Ok(Self { bytes, ends })
+    }
+}
+
+/// 只读打开的结果库（各列已读入内存）
+#[derive(Debug)]
+pub struct ResultStore {
+    paths: StringTable,
+    codecs: StringTable,
+    path_id: Vec<u32>,
+    codec_id: Vec<u32>,
+    sample_rate: Vec<u32>,
+    channels: Vec<u16>,
+    bits: Vec<u16>,
+    frames: Vec<u64>,
+    official_dr: Vec<i16>,
+    precise_dr: Vec<f64>,
+    flags: Vec<u32>,
+    analyzed_at: Vec<u64>,
+    channel_start: Vec<u64>,
+    ch_dr: Vec<f64>,
+    ch_peak: Vec<f64>,
+    ch_rms: Vec<f64>,
+}
+
+impl ResultStore {
+    /// 打开结果库目录（忽略中断追加留下的不完整行）
+    pub fn open(dir: &Path) -> AudioResult<Self> {
+        check_manifest(dir, false)?;
+
+        let mut store = Self {
+            paths: StringTable::load(dir, column::PATHS)?,
+            codecs: StringTable::load(dir, column::CODECS)?,
+            path_id: read_column(&dir.join(column::PATH_ID))?,
+            codec_id: read_column(&dir.join(column::CODEC_ID))?,
+            sample_rate: read_column(&dir.join(column::SAMPLE_RATE))?,
+            channels: read_column(&dir.join(column::CHANNELS))?,
+            bits: read_column(&dir.join(column::BITS))?,
+            frames: read_column(&dir.join(column::FRAMES))?,
+            official_dr: read_column(&dir.join(column::OFFICIAL_DR))?,
+            precise_dr: read_column(&dir.join(column::PRECISE_DR))?,
+            flags: read_column(&dir.join(column::FLAGS))?,
+            analyzed_at: read_column(&dir.join(column::ANALYZED_AT))?,
+            channel_start: read_column(&dir.join(column::CHANNEL_START))?,
+            ch_dr: read_column(&dir.join(column::CH_DR))?,
+            ch_peak: read_column(&dir.join(column::CH_PEAK))?,
+            ch_rms: read_column(&dir.join(column::CH_RMS))?,
+        };
+
+        let channel_rows = store
+            .ch_dr
+            .len()
+            .min(store.ch_peak.len())
+            .min(store.ch_rms.len());
+        let mut rows = [
+            store.path_id.len(),
+            store.codec_id.len(),
+            store.sample_rate.len(),
+            store.channels.len(),
+            store.bits.len(),
+            store.frames.len(),
+            store.official_dr.len(),
+            store.precise_dr.len(),
+            store.flags.len(),
+            store.analyzed_at.len(),
+            store.channel_start.len(),
+        ]
+        .into_iter()
+        .min()
+        .unwrap_or(0);
+        while rows > 0 && store.channel_end(rows - 1) > channel_rows as u64 {
+            rows -= 1;
+        }
+        store.truncate(rows);
+        Ok(store)
+    }
+
+    fn truncate(&mut self, rows: usize) {
+        self.path_id.truncate(rows);
+        self.codec_id.truncate(rows);
+        self.sample_rate.truncate(rows);
+        self.channels.truncate(rows);
+        self.bits.truncate(rows);
+        self.frames.truncate(rows);
+        self.official_dr.truncate(rows);
+        self.precise_dr.truncate(rows);
+        self.flags.truncate(rows);
+        self.analyzed_at.truncate(rows);
+        self.channel_start.truncate(rows);
+    }
+
+    #[inline]
+    fn channel_end(&self, row: usize) -> u64 {
+        self.channel_start[row] + u64::from(self.channels[row])
+    }
+
+    /// 已提交的行数（含同一路径的历史行）
+    pub fn len(&self) -> usize {
+        self.path_id.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.path_id.is_empty()
+    }
+
+    /// 读取一行（导出与测试使用）
+    pub fn row(&self, row: usize) -> StoreRow {
+        let start = self.channel_start[row] as usize;
+        let end = self.channel_end(row) as usize;
+        StoreRow {
+            path: self.paths.get(self.path_id[row]).to_string(),
+            codec: self.codecs.get(self.codec_id[row]).to_string(),
+            sample_rate: self.sample_rate[row],
+            bits_per_sample: self.bits[row],
+            frames: self.frames[row],
+            official_dr: (self.official_dr[row] != NO_OFFICIAL_DR)
+                .then(|| i32::from(self.official_dr[row])),
+            precise_dr: Some(self.precise_dr[row]).filter(|dr| !dr.is_nan()),
+            flags: self.flags[row],
+            analyzed_at: self.analyzed_at[row],
+            channels: (start..end)
+                .map(|i| StoreChannel {
+                    dr: self.ch_dr[i],
+                    peak: self.ch_peak[i],
+                    rms: self.ch_rms[i],
+                })
+                .collect(),
+        }
+    }
+
+    /// 按查询条件筛选行号（升序）
+    pub fn select(&self, query: &StoreQuery) -> Vec<usize> {
+        let codec_ids: Option<Vec<bool>> = query.codec.as_ref().map(|codec| {
+            (0..self.codecs.len() as u32)
+                .map(|id| self.codecs.get(id).eq_ignore_ascii_case(codec))
+                .collect()
+        });
+        let matches = |row: usize| -> bool {
+            let official = i32::from(self.official_dr[row]);
+            query.min_dr.is_none_or(|min| official >= min)
+                && query
+                    .max_dr
+                    .is_none_or(|max| official != i32::from(NO_OFFICIAL_DR) && official <= max)
+                && query
+                    .sample_rate
+                    .is_none_or(|rate| self.sample_rate[row] == rate)
+                && query
+                    .channels
+                    .is_none_or(|channels| self.channels[row] == channels)
+                && self.flags[row] & query.required_flags == query.required_flags
+                && codec_ids.as_ref().is_none_or(|ids| {
+                    ids.get(self.codec_id[row] as usize)
+                        .copied()
+                        .unwrap_or(false)
+                })
+                && query.path_contains.as_ref().is_none_or(|needle| {
+                    self.paths.get(self.path_id[row]).contains(needle.as_str())
+                })
+        };
+
+        if query.all_history {
+            return (0..self.len()).filter(|&row| matches(row)).collect();
+        }
+
+        // 每个路径只取最新一行：倒序扫描，首次出现即最新
+        let mut seen = vec![false; self.paths.len()];
+        let mut selected: Vec<usize> = (0..self.len())
+            .rev()
+            .filter(|&row| {
+                let id = self.path_id[row] as usize;
+                match seen.get_mut(id) {
+                    Some(flag) if !*flag => {
+                        *flag = true;
+                        true
+                    }
+                    Some(_) => false,
+                    None => true,
+                }
+            })
+            .filter(|&row| matches(row))
+            .collect();
+        selected.reverse();
+        selected
+    }
+
+    /// 汇总统计：数量、时长、精确DR统计、官方DR分布、标记计数
+    pub fn summarize(&self, rows: &[usize]) -> String {
+        let mut out = String::new();
+        let hours: f64 = rows
+            .iter()
+            .filter(|&&row| self.sample_rate[row] > 0)
+            .map(|&row| self.frames[row] as f64 / f64::from(self.sample_rate[row]))
+            .sum::<f64>()
+            / 3600.0;
+        out.push_str(&format!(
+            "曲目数 / Tracks: {}    总时长 / Total duration: {hours:.1} h\n",
+            rows.len()
+        ));
+
+        let mut precise: Vec<f64> = rows
+            .iter()
+            .map(|&row| self.precise_dr[row])
+            .filter(|dr| !dr.is_nan())
+            .collect();
+        if !precise.is_empty() {
+            precise.sort_by(f64::total_cmp);
+            let mean = precise.iter().sum::<f64>() / precise.len() as f64;
+            let median = precise[precise.len() / 2];
+            out.push_str(&format!(
+                "Precise DR: 平均 / mean {mean:.2}    中位数 / median {median:.2}    范围 / range {:.2} ~ {:.2}\n",
+                precise[0],
+                precise[precise.len() - 1]
+            ));
+        }
+
+        let mut histogram: BTreeMap<i16, usize> = BTreeMap::new();
+        let mut flag_counts = [0usize; flags::NAMES.len()];
+        for &row in rows {
+            if self.official_dr[row] != NO_OFFICIAL_DR {
+                *histogram.entry(self.official_dr[row]).or_default() += 1;
+            }
+            for (count, (bit, _)) in flag_counts.iter_mut().zip(flags::NAMES) {
+                *count += usize::from(self.flags[row] & bit != 0);
+            }
+        }
+        if !histogram.is_empty() {
+            out.push_str("\n| Official DR | 曲目数 / Tracks | 占比 / Share |\n");
+            for (dr, count) in &histogram {
+                out.push_str(&format!(
+                    "| DR{dr} | {count} | {:.1}% |\n",
+                    *count as f64 * 100.0 / rows.len() as f64
+                ));
+            }
+        }
+
+        let flagged: Vec<String> = flags::NAMES
+            .iter()
+            .zip(flag_counts)
+            .filter(|(_, count)| *count > 0)
+            .map(|((_, name), count)| format!("{name}={count}"))
+            .collect();
+        if !flagged.is_empty() {
+            out.push_str(&format!("\n标记 / Flags: {}\n", flagged.join(", ")));
+        }
+        out
+    }
+
+    /// 分组聚合：每组曲目数与精确DR均值/最小/最大
+    pub fn group(&self, rows: &[usize], by: GroupBy) -> String {
+        #[derive(Default)]
+        struct Group {
+            tracks: usize,
+            measured: usize,
+            sum: f64,
+            min: f64,
+            max: f64,
+        }
+
+        // 数值分组按数值排序，文本分组按名称排序
+        let mut groups: BTreeMap<(i64, String), Group> = BTreeMap::new();
+        for &row in rows {
+            let key = match by {
+                GroupBy::Codec => (0, self.codecs.get(self.codec_id[row]).to_string()),
+                GroupBy::SampleRate => (i64::from(self.sample_rate[row]), String::new()),
+                GroupBy::Channels => (i64::from(self.channels[row]), String::new()),
+                GroupBy::Dr => (i64::from(self.official_dr[row]), String::new()),
+                GroupBy::Dir => {
+                    let path = Path::new(self.paths.get(self.path_id[row]));
+                    let dir = path.parent().unwrap_or(Path::new(""));
+                    (0, dir.display().to_string())
+                }
+            };
+            let group = groups.entry(key).or_insert_with(|| Group {
+                min: f64::INFINITY,
+                max: f64::NEG_INFINITY,
+                ..Group::default()
+            });
+            group.tracks += 1;
+            let dr = self.precise_dr[row];
+            if !dr.is_nan() {
+                group.measured += 1;
+                group.sum += dr;
+                group.min = group.min.min(dr);
+                group.max = group.max.max(dr);
+            }
+        }
+
+        let mut out = format!(
+            "| {} | 曲目数 / Tracks | 平均 / Mean DR | 最小 / Min | 最大 / Max |\n",
+            by.label()
+        );
+        for ((number, name), group) in &groups {
+            let key = match by {
+                GroupBy::Codec | GroupBy::Dir => name.clone(),
+                GroupBy::SampleRate => format!("{number} Hz"),
+                GroupBy::Channels => number.to_string(),
+                GroupBy::Dr if *number == i64::from(NO_OFFICIAL_DR) => "-".to_string(),
+                GroupBy::Dr => format!("DR{number}"),
+            };
+            if group.measured == 0 {
+                out.push_str(&format!("| {key} | {} | - | - | - |\n", group.tracks));
+            } else {
+                out.push_str(&format!(
+                    "| {key} | {} | {:.2} | {:.2} | {:.2} |\n",
+                    group.tracks,
+                    group.sum / group.measured as f64,
+                    group.min,
+                    group.max
+                ));
+            }
+        }
+        out
+    }
+
+    /// 导出为 CSV（声道列按所选行的最大声道数展开）
+    pub fn export_csv(&self, rows: &[usize], out: &mut impl Write) -> io::Result<()> {
+        let max_channels = rows
+            .iter()
+            .map(|&row| self.channels[row])
+            .max()
+            .unwrap_or(0);
+        let mut header = String::from(
+            "path,codec,sample_rate,channels,bits_per_sample,duration_sec,official_dr,precise_dr,flags,analyzed_at",
+        );
+        for ch in 1..=max_channels {
+            header.push_str(&format!(",ch{ch}_dr,ch{ch}_peak,ch{ch}_rms"));
+        }
+        writeln!(out, "{header}")?;
+
+        for &row in rows {
+            let record = self.row(row);
+            let mut line = format!(
+                "{},{},{},{},{},{},{},{},{},{}",
+                csv_field(&record.path),
+                csv_field(&record.codec),
+                record.sample_rate,
+                record.channels.len(),
+                record.bits_per_sample,
+                duration_seconds(&record),
+                record
+                    .official_dr
+                    .map_or_else(String::new, |dr| dr.to_string()),
+                record
+                    .precise_dr
+                    .map_or_else(String::new, |dr| format!("{dr:.4}")),
+                flags::names(record.flags).collect::<Vec<_>>().join("|"),
+                record.analyzed_at,
+            );
+            for ch in 0..max_channels as usize {
+                match record.channels.get(ch) {
+                    Some(c) => line.push_str(&format!(",{:.4},{},{}", c.dr, c.peak, c.rms)),
+                    None => line.push_str(",,,"),
+                }
+            }
+            writeln!(out, "{line}")?;
+        }
+        Ok(())
+    }
+
+    /// 导出为 JSON Lines（每行一个对象，声道为数组）
+    pub fn export_jsonl(&self, rows: &[usize], out: &mut impl Write) -> io::Result<()> {
+        for &row in rows {
+            let record = self.row(row);
+            let value = serde_json::json!({
+                "path": record.path,
+                "codec": record.codec,
+                "sample_rate": record.sample_rate,
+                "channels": record.channels.len(),
+                "bits_per_sample": record.bits_per_sample,
+                "duration_sec": duration_seconds(&record),
+                "official_dr": record.official_dr,
+                "precise_dr": record.precise_dr,
+                "flags": flags::names(record.flags).collect::<Vec<_>>(),
+                "analyzed_at": record.analyzed_at,
+                "channel_results": record
+                    .channels
+                    .iter()
+                    .map(|c| serde_json::json!({ "dr": c.dr, "peak": c.peak, "rms": c.rms }))
+                    .collect::<Vec<_>>(),
+            });
+            writeln!(out, "{value}")?;
+        }
+        Ok(())
+    }
+}
+
+fn duration_seconds(row: &StoreRow) -> f64 {
+    if row.sample_rate == 0 {
+        0.0
+    } else {
+        row.frames as f64 / f64::from(row.sample_rate)
+    }
+}
+
+/// CSV 字段转义（含逗号、引号或换行时加引号）
+fn csv_field(value: &str) -> String {
+    if value.contains([',', '"', '\n', '\r']) {
+        format!("\"{}\"", value.replace('"', "\"\""))
+    } else {
+        value.to_string()
+    }
+}
+
+/// 追加一批结果（目录不存在时创建）
+pub fn append_rows(dir: &Path, rows: &[StoreRow]) -> AudioResult<()> {
+    if rows.is_empty() {
+        return Ok(());
+    }
+    check_manifest(dir, true)?;
+
+    // 截断中断追加留下的半行，使所有列长度一致
+    // 路径字典可达百万项，只经索引按需读取；编解码器字典很小，整体读入
+    let mut path_dict = PathDict::open(dir)?;
+    let codecs = StringTable::load(dir, column::CODECS)?;
+    truncate_string_table(
+        dir,
+        column::CODECS,
+        codecs.len() as u64,
+        codecs.bytes.len() as u64,
+    )?;
+    let (committed_rows, channel_end) = committed_lengths(dir)?;
+    for (name, width) in column::ROWS {
+        set_column_len(&dir.join(name), committed_rows * width)?;
+    }
+    for name in column::CHANNEL_TABLE {
+        set_column_len(&dir.join(name), channel_end * 8)?;
+    }
+
+    let mut codec_dict = DictAppender::new(&codecs);
+
+    let mut path_id = Vec::with_capacity(rows.len() * 4);
+    let mut codec_id = Vec::with_capacity(rows.len() * 4);
+    let mut sample_rate = Vec::with_capacity(rows.len() * 4);
+    let mut channels = Vec::with_capacity(rows.len() * 2);
+    let mut bits = Vec::with_capacity(rows.len() * 2);
+    let mut frames = Vec::with_capacity(rows.len() * 8);
+    let mut official_dr = Vec::with_capacity(rows.len() * 2);
+    let mut precise_dr = Vec::with_capacity(rows.len() * 8);
+    let mut row_flags = Vec::with_capacity(rows.len() * 4);
+    let mut analyzed_at = Vec::with_capacity(rows.len() * 8);
+    let mut channel_start = Vec::with_capacity(rows.len() * 8);
+    let mut ch_dr = Vec::new();
+    let mut ch_peak = Vec::new();
+    let mut ch_rms = Vec::new();
+
+    let mut next_channel = channel_end;
+    for row in rows {
+        let channel_count = u16::try_from(row.channels.len()).map_err(|_| {
+            AudioError::InvalidInput(format!(
+                "Too many channels for result store / 声道数超出结果库上限: {}",
+                row.channels.len()
+            ))
+        })?;
+        path_dict.id(&row.path)?.put(&mut path_id);
+        codec_dict.id(&row.codec).put(&mut codec_id);
+        row.sample_rate.put(&mut sample_rate);
+        channel_count.put(&mut channels);
+        row.bits_per_sample.put(&mut bits);
+        row.frames.put(&mut frames);
+        row.official_dr
+            .and_then(|dr| i16::try_from(dr).ok())
+            .unwrap_or(NO_OFFICIAL_DR)
+            .put(&mut official_dr);
+        row.precise_dr.unwrap_or(f64::NAN).put(&mut precise_dr);
+        row.flags.put(&mut row_flags);
+        row.analyzed_at.put(&mut analyzed_at);
+        next_channel.put(&mut channel_start);
+        for channel in &row.channels {
+            channel.dr.put(&mut ch_dr);
+            channel.peak.put(&mut ch_peak);
+            channel.rms.put(&mut ch_rms);
+        }
+        next_channel += u64::from(channel_count);
+    }
+
+    // 提交顺序：字典 → 声道表 → 行列（行列最后写入，半行在打开时被忽略）
+    path_dict.commit()?;
+    codec_dict.commit(dir, column::CODECS)?;
+    append_bytes(&dir.join(column::CH_DR), &ch_dr)?;
+    append_bytes(&dir.join(column::CH_PEAK), &ch_peak)?;
+    append_bytes(&dir.join(column::CH_RMS), &ch_rms)?;
+    for (name, bytes) in [
+        (column::PATH_ID, &path_id),
+        (column::CODEC_ID, &codec_id),
+        (column::SAMPLE_RATE, &sample_rate),
+        (column::CHANNELS, &channels),
+        (column::BITS, &bits),
+        (column::FRAMES, &frames),
+        (column::OFFICIAL_DR, &official_dr),
+        (column::PRECISE_DR, &precise_dr),
+        (column::FLAGS, &row_flags),
+        (column::ANALYZED_AT, &analyzed_at),
+        (column::CHANNEL_START, &channel_start),
+    ] {
+        append_bytes(&dir.join(name), bytes)?;
+    }
+    Ok(())
+}
+
+/// 字典追加器：复用已有下标，新字符串在提交时追加
+struct DictAppender<'a> {
+    existing: HashMap<&'a str, u32>,
+    added: HashMap<String, u32>,
+    next_id: u32,
+    end: u64,
+    bytes: Vec<u8>,
+    ends: Vec<u8>,
+}
+
+impl<'a> DictAppender<'a> {
+    fn new(table: &'a StringTable) -> Self {
+        let existing = (0..table.len() as u32)
+            .map(|id| (table.get(id), id))
+            .collect();
+        Self {
+            existing,
+            added: HashMap::new(),
+            next_id: table.len() as u32,
+            end: table.bytes.len() as u64,
+            bytes: Vec::new(),
+            ends: Vec::new(),
+        }
+    }
+
+    fn id(&mut self, value: &str) -> u32 {
+        if let Some(&id) = self.existing.get(value) {
+            return id;
+        }
+        if let Some(&id) = self.added.get(value) {
+            return id;
+        }
+        let id = self.next_id;
+        self.next_id += 1;
+        self.bytes.extend_from_slice(value.as_bytes());
+        self.end += value.len() as u64;
+        self.end.put(&mut self.ends);
+        self.added.insert(value.to_string(), id);
+        id
+    }
+
+    fn commit(&self, dir: &Path, name: &str) -> AudioResult<()> {
+        append_bytes(&dir.join(format!("{name}.str")), &self.bytes)?;
+        append_bytes(&dir.join(format!("{name}.off")), &self.ends)
+    }
+}
+
+/// 路径字典追加器：经持久化哈希索引（`paths.idx`）查找已有路径
+///
+/// 索引是开放寻址（线性探测）哈希表：`u64` 文件头记录已索引的字典项数，其后是
+/// `u32` 槽位（path id + 1，0 为空），槽位数为 2 的幂且不低于字典项数的两倍。
+/// 查找只读取探测到的槽位与候选字典项并逐字节比对，追加一块的开销与字典规模无关。
+///
+/// 新字典项提交后才写槽位，最后更新文件头；中断时残留的槽位可能指向尚未提交或
+/// 后来被其他路径复用的 id，比对会将其排除，文件头落后的部分在下次追加时补齐。
+struct PathDict {
+    dir: PathBuf,
+    offsets: File,
+    strings: File,
+    index: File,
+    slots: u64,
+    /// 已提交（且已索引）的字典项数与串长度
+    committed: u64,
+    end: u64,
+    added: HashMap<String, u32>,
+    bytes: Vec<u8>,
+    ends: Vec<u8>,
+}
+
+impl PathDict {
+    fn open(dir: &Path) -> AudioResult<Self> {
+        let (committed, end) = committed_dict_len(dir, column::PATHS)?;
+        truncate_string_table(dir, column::PATHS, committed, end)?;
+        let open = |name: String| {
+            OpenOptions::new()
+                .read(true)
+                .append(true)
+                .create(true)
+                .open(dir.join(name))
+        };
+        let index = OpenOptions::new()
+            .read(true)
+            .write(true)
+            .create(true)
+            .truncate(false)
+            .open(dir.join(column::PATH_INDEX))?;
+        let slots = file_len(&dir.join(column::PATH_INDEX))?.saturating_sub(PATH_INDEX_HEADER) / 4;
+        let mut dict = Self {
+            dir: dir.to_path_buf(),
+            offsets: open(format!("{}.off", column::PATHS))?,
+            strings: open(format!("{}.str", column::PATHS))?,
+            index,
+            slots,
+            committed,
+            end,
+            added: HashMap::new(),
+            bytes: Vec::new(),
+            ends: Vec::new(),
+        };
+        dict.sync_index()?;
+        Ok(dict)
+    }
+
+    fn id(&mut self, value: &str) -> AudioResult<u32> {
+        if let Some(&id) = self.added.get(value) {
+            return Ok(id);
+        }
+        let mask = self.slots - 1;
+        let mut slot = path_hash(value.as_bytes()) & mask;
+        loop {
+            let stored = self.read_slot(slot)?;
+            if stored == 0 {
+                break;
+            }
+            let id = stored - 1;
+            if u64::from(id) < self.committed && self.entry(id)? == value.as_bytes() {
+                return Ok(id);
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        let id = u32::try_from(self.committed + self.added.len() as u64).map_err(|_| {
+            AudioError::InvalidInput(
+                "Too many paths for result store / 路径数超出结果库上限".into(),
+            )
+        })?;
+        self.bytes.extend_from_slice(value.as_bytes());
+        self.end += value.len() as u64;
+        self.end.put(&mut self.ends);
+        self.added.insert(value.to_string(), id);
+        Ok(id)
+    }
+
+    /// 追加新字典项并写入索引
+    fn commit(&mut self) -> AudioResult<()> {
+        if self.added.is_empty() {
+            return Ok(());
+        }
+        self.strings.write_all(&self.bytes)?;
+        self.offsets.write_all(&self.ends)?;
+        let total = self.committed + self.added.len() as u64;
+        if total * 2 > self.slots {
+            self.committed = total;
+            return self.rebuild_index();
+        }
+        let added = std::mem::take(&mut self.added);
+        for (value, id) in &added {
+            self.insert(path_hash(value.as_bytes()), *id)?;
+        }
+        self.committed = total;
+        self.write_header()
+    }
+
+    /// 使索引覆盖全部已提交的字典项（缺失、损坏、过小或落后过多时重建）
+    fn sync_index(&mut self) -> AudioResult<()> {
+        let mut header = [0u8; PATH_INDEX_HEADER as usize];
+        let indexed = if self.slots.is_power_of_two() && self.slots >= PATH_INDEX_MIN_SLOTS {
+            self.index.seek(SeekFrom::Start(0))?;
+            self.index.read_exact(&mut header)?;
+            Some(u64::from_le_bytes(header))
+        } else {
+            None
+        };
+        match indexed {
+            Some(indexed)
+                if indexed <= self.committed
+                    && self.committed * 2 <= self.slots
+                    && self.committed - indexed <= self.slots / 8 =>
+            {
+                for id in indexed..self.committed {
+                    let hash = path_hash(&self.entry(id as u32)?);
+                    self.insert(hash, id as u32)?;
+                }
+                if indexed < self.committed {
+                    self.write_header()?;
+                }
+                Ok(())
+            }
+            _ => self.rebuild_index(),
+        }
+    }
+
+    /// 整体读入路径字典重建索引（仅在索引扩容或修复时发生）
+    fn rebuild_index(&mut self) -> AudioResult<()> {
+        let entries = self.committed as usize;
+        let slots = (self.committed * 2)
+            .next_power_of_two()
+            .max(PATH_INDEX_MIN_SLOTS);
+        let offsets: Vec<u64> = read_column(&self.dir.join(format!("{}.off", column::PATHS)))?;
+        let strings = read_optional(&self.dir.join(format!("{}.str", column::PATHS)))?;
+
+        let mask = slots - 1;
+        let mut table = vec![0u32; slots as usize];
+        let mut start = 0;
+        for (id, &end) in offsets[..entries].iter().enumerate() {
+            let mut slot = path_hash(&strings[start as usize..end as usize]) & mask;
+            while table[slot as usize] != 0 {
+                slot = (slot + 1) & mask;
+            }
+            table[slot as usize] = id as u32 + 1;
+            start = end;
+        }
+
+        // 文件头先写 0：重写中断时下次打开会再次重建
+        let mut bytes = Vec::with_capacity((PATH_INDEX_HEADER + slots * 4) as usize);
+        0u64.put(&mut bytes);
+        for stored in table {
+            stored.put(&mut bytes);
+        }
+        self.index.set_len(0)?;
+        self.index.seek(SeekFrom::Start(0))?;
+        self.index.write_all(&bytes)?;
+        self.slots = slots;
+        self.write_header()
+    }
+
+    fn insert(&mut self, hash: u64, id: u32) -> AudioResult<()> {
+        let mask = self.slots - 1;
+        let mut slot = hash & mask;
+        while self.read_slot(slot)? != 0 {
+            slot = (slot + 1) & mask;
+        }
+        self.index
+            .seek(SeekFrom::Start(PATH_INDEX_HEADER + slot * 4))?;
+        self.index.write_all(&(id + 1).to_le_bytes())?;
+        Ok(())
+    }
+
+    fn write_header(&mut self) -> AudioResult<()> {
+        self.index.seek(SeekFrom::Start(0))?;
+        self.index.write_all(&self.committed.to_le_bytes())?;
+        Ok(())
+    }
+
+    fn read_slot(&mut self, slot: u64) -> AudioResult<u32> {
+        let mut buf = [0u8; 4];
+        self.index
+            .seek(SeekFrom::Start(PATH_INDEX_HEADER + slot * 4))?;
+        self.index.read_exact(&mut buf)?;
+        Ok(u32::from_le_bytes(buf))
+    }
+
+    /// 读取单个已提交的字典项
+    fn entry(&mut self, id: u32) -> AudioResult<Vec<u8>> {
+        let mut buf = [0u8; 16];
+        let (start, end) = if id == 0 {
+            self.offsets.seek(SeekFrom::Start(0))?;
+            self.offsets.read_exact(&mut buf[..8])?;
+            (0, u64::get(&buf[..8]))
+        } else {
+            self.offsets
+                .seek(SeekFrom::Start((u64::from(id) - 1) * 8))?;
+            self.offsets.read_exact(&mut buf)?;
+            (u64::get(&buf[..8]), u64::get(&buf[8..]))
+        };
+        let mut value = vec![0u8; end.saturating_sub(start) as usize];
+        self.strings.seek(SeekFrom::Start(start))?;
+        self.strings.read_exact(&mut value)?;
+        Ok(value)
+    }
+}
+
+/// 路径哈希（FNV-1a 64 位，跨平台与版本稳定，索引落盘后不可更换）
+fn path_hash(bytes: &[u8]) -> u64 {
+    bytes.iter().fold(0xcbf2_9ce4_8422_2325, |hash, &byte| {
+        (hash ^ u64::from(byte)).wrapping_mul(0x0100_0000_01b3)
+    })
+}
+
+/// 校验（或创建）清单文件
+fn check_manifest(dir: &Path, create: bool) -> AudioResult<()> {
+    let manifest = dir.join(MANIFEST_FILE);
+    match fs::read_to_string(&manifest) {
+        Ok(content) => {
+            let mut fields = content.split_whitespace();
+            if fields.next() != Some(MANIFEST_MAGIC) {
+                return Err(AudioError::FormatError(format!(
+                    "Not a result store / 不是结果库目录: {}",
+                    dir.display()
+                )));
+            }
+            let version = fields.next().and_then(|v| v.parse::<u32>().ok());
+            if version != Some(STORE_VERSION) {
+                return Err(AudioError::FormatError(format!(
+                    "Unsupported result store version / 不支持的结果库版本: {}",
+                    version.map_or_else(|| "?".to_string(), |v| v.to_string())
+                )));
+            }
+            Ok(())
+        }
+        Err(e) if e.kind() == io::ErrorKind::NotFound && create => {
+            fs::create_dir_all(dir)?;
+            fs::write(&manifest, format!("{MANIFEST_MAGIC} {STORE_VERSION}\n"))?;
+            Ok(())
+        }
+        Err(e) if e.kind() == io::ErrorKind::NotFound => Err(AudioError::InvalidInput(format!(
+            "Result store not found / 结果库不存在: {}",
+            dir.display()
+        ))),
+        Err(e) => Err(e.into()),
+    }
+}
+
+/// 读取整列（文件不存在视为空列，忽略不足一个元素的尾部字节）
+fn read_column<T: LeValue>(path: &Path) -> AudioResult<Vec<T>> {
+    let bytes = read_optional(path)?;
+    Ok(bytes.chunks_exact(T::SIZE).map(T::get).collect())
+}
+
+fn read_optional(path: &Path) -> AudioResult<Vec<u8>> {
+    match fs::read(path) {
+        Ok(bytes) => Ok(bytes),
+        Err(e) if e.kind() == io::ErrorKind::NotFound => Ok(Vec::new()),
+        Err(e) => Err(e.into()),
+    }
+}
+
+fn file_len(path: &Path) -> AudioResult<u64> {
+    match fs::metadata(path) {
+        Ok(meta) => Ok(meta.len()),
+        Err(e) if e.kind() == io::ErrorKind::NotFound => Ok(0),
+        Err(e) => Err(e.into()),
+    }
+}
+
+/// 读取列中单个元素（追加时只需最后一行，避免整列读入）
+fn read_element<T: LeValue>(path: &Path, index: u64) -> AudioResult<T> {
+    let mut file = File::open(path)?;
+    file.seek(SeekFrom::Start(index * T::SIZE as u64))?;
+    let mut buf = [0u8; 8];
+    file.read_exact(&mut buf[..T::SIZE])?;
+    Ok(T::get(&buf[..T::SIZE]))
+}
+
+/// 已提交的行数与声道表长度（与 `ResultStore::open` 的规则一致）
+fn committed_lengths(dir: &Path) -> AudioResult<(u64, u64)> {
+    let mut rows = u64::MAX;
+    for (name, width) in column::ROWS {
+        rows = rows.min(file_len(&dir.join(name))? / width);
+    }
+    let mut channel_rows = u64::MAX;
+    for name in column::CHANNEL_TABLE {
+        channel_rows = channel_rows.min(file_len(&dir.join(name))? / 8);
+    }
+    while rows > 0 {
+        let start: u64 = read_element(&dir.join(column::CHANNEL_START), rows - 1)?;
+        let count: u16 = read_element(&dir.join(column::CHANNELS), rows - 1)?;
+        let end = start + u64::from(count);
+        if end <= channel_rows {
+            return Ok((rows, end));
+        }
+        rows -= 1;
+    }
+    Ok((0, 0))
+}
+
+/// 已提交的字典项数与串长度（与 `StringTable::load` 的规则一致，只读取尾部偏移）
+fn committed_dict_len(dir: &Path, name: &str) -> AudioResult<(u64, u64)> {
+    let offsets = dir.join(format!("{name}.off"));
+    let string_len = file_len(&dir.join(format!("{name}.str")))?;
+    let mut entries = file_len(&offsets)? / 8;
+    while entries > 0 {
+        let end: u64 = read_element(&offsets, entries - 1)?;
+        if end <= string_len {
+            return Ok((entries, end));
+        }
+        entries -= 1;
+    }
+    Ok((0, 0))
+}
+
+fn truncate_string_table(dir: &Path, name: &str, entries: u64, bytes: u64) -> AudioResult<()> {
+    set_column_len(&dir.join(format!("{name}.str")), bytes)?;
+    set_column_len(&dir.join(format!("{name}.off")), entries * 8)
+}
+
+fn set_column_len(path: &Path, len: u64) -> AudioResult<()> {
+    if file_len(path)? > len {
+        OpenOptions::new().write(true).open(path)?.set_len(len)?;
+    }
+    Ok(())
+}
+
+fn append_bytes(path: &Path, bytes: &[u8]) -> AudioResult<()> {
+    let mut file = OpenOptions::new().create(true).append(true).open(path)?;
+    file.write_all(bytes)?;
+    Ok(())
+}
+
+/// 分组维度
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum GroupBy {
+    Codec,
+    SampleRate,
+    Channels,
+    Dr,
+    /// 所在目录（通常即专辑）
+    Dir,
+}
+
+impl GroupBy {
+    pub const NAMES: [&'static str; 5] = ["codec", "sample-rate", "channels", "dr", "dir"];
+
+    pub fn from_name(name: &str) -> Option<Self> {
+        match name {
+            "codec" => Some(Self::Codec),
+            "sample-rate" => Some(Self::SampleRate),
+            "channels" => Some(Self::Channels),
+            "dr" => Some(Self::Dr),
+            "dir" => Some(Self::Dir),
+            _ => None,
+        }
+    }
+
+    fn label(self) -> &'static str {
+        match self {
+            Self::Codec => "编解码器 / Codec",
+            Self::SampleRate => "采样率 / Sample rate",
+            Self::Channels => "声道 / Channels",
+            Self::Dr => "Official DR",
+            Self::Dir => "目录 / Directory",
+        }
+    }
+}
+
+/// 导出格式
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ExportFormat {
+    Csv,
+    Jsonl,
+}
+
+/// `query` 子命令参数
+#[derive(Debug, Clone, Default)]
+pub struct StoreQuery {
+    /// 结果库目录
+    pub store_dir: PathBuf,
+    /// 官方DR下限/上限（含）
+    pub min_dr: Option<i32>,
+    pub max_dr: Option<i32>,
+    /// 编解码器名称（不区分大小写）
+    pub codec: Option<String>,
+    pub sample_rate: Option<u32>,
+    pub channels: Option<u16>,
+    /// 路径子串（区分大小写）
+    pub path_contains: Option<String>,
+    /// 必须同时具备的标记位
+    pub required_flags: u32,
+    /// 包含同一路径的历史行（默认只取最新一行）
+    pub all_history: bool,
+    pub group_by: Option<GroupBy>,
+    pub export: Option<ExportFormat>,
+    /// 导出文件（默认标准输出）
+    pub output_path: Option<PathBuf>,
+}
+
+/// 执行 `query` 子命令
+pub fn run_query(query: &StoreQuery) -> AudioResult<()> {
+    let started = std::time::Instant::now();
+    let store = ResultStore::open(&query.store_dir)?;
+    let rows = store.select(query);
+
+    if let Some(format) = query.export {
+        let write = |out: &mut dyn Write| -> io::Result<()> {
+            let mut out = io::BufWriter::new(out);
+            match format {
+                ExportFormat::Csv => store.export_csv(&rows, &mut out)?,
+                ExportFormat::Jsonl => store.export_jsonl(&rows, &mut out)?,
+            }
+            out.flush()
+        };
+        match &query.output_path {
+            Some(path) => {
+                write(&mut File::create(path)?)?;
+                println!(
+                    "已导出 / Exported {} 行 / rows → {}",
+                    rows.len(),
+                    path.display()
+                );
+            }
+            None => write(&mut io::stdout().lock())?,
+        }
+        return Ok(());
+    }
+
+    let report = match query.group_by {
+        Some(by) => store.group(&rows, by),
+        None => store.summarize(&rows),
+    };
+    print!("{report}");
+    println!(
+        "\n查询 / Queried {} 行中的 / of {} rows in {:.0} ms",
+        rows.len(),
+        store.len(),
+        started.elapsed().as_secs_f64() * 1000.0
+    );
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn temp_store(name: &str) -> PathBuf {
+        let dir =
+            std::env::temp_dir().join(format!("macinmeter_store_{name}_{}", std::process::id()));
+        let _ = fs::remove_dir_all(&dir);
+        dir
+    }
+
+    fn row(path: &str, codec: &str, official: i32, flags: u32, channels: usize) -> StoreRow {
+        StoreRow {
+            path: path.to_string(),
+            codec: codec.to_string(),
+            sample_rate: 44100,
+            bits_per_sample: 16,
+            frames: 44100 * 180,
+            official_dr: Some(official),
+            precise_dr: Some(official as f64 + 0.25),
+            flags,
+            analyzed_at: 1_700_000_000,
+            channels: (0..channels)
+                .map(|ch| StoreChannel {
+                    dr: official as f64 + ch as f64 * 0.5,
+                    peak: 0.9,
+                    rms: 0.1 + ch as f64 * 0.01,
+                })
+                .collect(),
+        }
+    }
+
+    #[test]
+    fn test_append_round_trip_and_latest_row() {
+        let dir = temp_store("round_trip");
+        let first = [
+            row("/music/a/01.flac", "FLAC", 12, 0, 2),
+            row("/music/a/02.flac", "FLAC", 9, flags::CLIPPED, 2),
+        ];
+        append_rows(&dir, &first).unwrap();
+        // 第二批：复用路径（重新分析）与新增多声道曲目
+        let mut reanalyzed = row("/music/a/02.flac", "FLAC", 10, 0, 2);
+        reanalyzed.precise_dr = None;
+        reanalyzed.official_dr = None;
+        append_rows(
+            &dir,
+            &[reanalyzed.clone(), row("/music/b/x.m4a", "AAC", 7, 0, 6)],
+        )
+        .unwrap();
+
+        let store = ResultStore::open(&dir).unwrap();
+        assert_eq!(store.len(), 4);
+        assert_eq!(store.paths.len(), 3);
+        assert_eq!(store.row(0), first[0]);
+        assert_eq!(store.row(2), reanalyzed);
+        assert_eq!(store.row(3).channels.len(), 6);
+
+        let latest = store.select(&StoreQuery::default());
+        assert_eq!(latest, [0, 2, 3]);
+        let history = store.select(&StoreQuery {
+            all_history: true,
+            ..StoreQuery::default()
+        });
+        assert_eq!(history, [0, 1, 2, 3]);
+        fs::remove_dir_all(&dir).ok();
+    }
+
+    #[test]
+    fn test_torn_append_is_ignored_and_repaired() {
+        let dir = temp_store("torn");
+        append_rows(&dir, &[row("/m/1.flac", "FLAC", 11, 0, 2)]).unwrap();
+        // 模拟中断：部分行列与声道表多出半行
+        append_bytes(&dir.join(column::PATH_ID), &[0, 0]).unwrap();
+        append_bytes(&dir.join(column::CH_DR), &1.0f64.to_le_bytes()).unwrap();
+        assert_eq!(ResultStore::open(&dir).unwrap().len(), 1);
+
+        append_rows(&dir, &[row("/m/2.flac", "FLAC", 8, 0, 2)]).unwrap();
+        let store = ResultStore::open(&dir).unwrap();
+        assert_eq!(store.len(), 2);
+        assert_eq!(store.row(1), row("/m/2.flac", "FLAC", 8, 0, 2));
+        fs::remove_dir_all(&dir).ok();
+    }
+
+    #[test]
+    fn test_filters_and_aggregates() {
+        let dir = temp_store("query");
+        append_rows(
+            &dir,
+            &[
+                row("/lib/rock/1.flac", "FLAC", 6, flags::CLIPPED, 2),
+                row(
+                    "/lib/rock/2.mp3",
+                    "MP3",
+                    8,
+                    flags::CLIPPED | flags::PARTIAL,
+                    2,
+                ),
+                row("/lib/jazz/1.flac", "FLAC", 14, 0, 2),
+            ],
+        )
+        .unwrap();
+        let store = ResultStore::open(&dir).unwrap();
+
+        let select = |query: StoreQuery| store.select(&query);
+        assert_eq!(
+            select(StoreQuery {
+                max_dr: Some(8),
+                ..StoreQuery::default()
+            }),
+            [0, 1]
+        );
+        assert_eq!(
+            select(StoreQuery {
+                codec: Some("flac".to_string()),
+                min_dr: Some(7),
+                ..StoreQuery::default()
+            }),
+            [2]
+        );
+        assert_eq!(
+            select(StoreQuery {
+                required_flags: flags::CLIPPED | flags::PARTIAL,
+                ..StoreQuery::default()
+            }),
+            [1]
+        );
+        assert_eq!(
+            select(StoreQuery {
+                path_contains: Some("/rock/".to_string()),
+                ..StoreQuery::default()
+            }),
+            [0, 1]
+        );
+
+        let all = select(StoreQuery::default());
+        let summary = store.summarize(&all);
+        assert!(summary.contains("| DR14 | 1 | 33.3% |"));
+        assert!(summary.contains("clipped=2"));
+        let by_dir = store.group(&all, GroupBy::Dir);
+        assert!(by_dir.contains("| /lib/rock | 2 | 7.25 | 6.25 | 8.25 |"));
+        fs::remove_dir_all(&dir).ok();
+    }
+
+    #[test]
+    fn test_csv_and_jsonl_export() {
+        let dir = temp_store("export");
+        append_rows(
+            &dir,
+            &[
+                row("/lib/a, b.flac", "FLAC", 10, flags::TRIMMED, 1),
+                row("/lib/c.flac", "FLAC", 12, 0, 2),
+            ],
+        )
+        .unwrap();
+        let store = ResultStore::open(&dir).unwrap();
+        let rows = store.select(&StoreQuery::default());
+
+        let mut csv = Vec::new();
+        store.export_csv(&rows, &mut csv).unwrap();
+        let csv = String::from_utf8(csv).unwrap();
+        let lines: Vec<&str> = csv.lines().collect();
+        assert!(lines[0].ends_with("ch2_dr,ch2_peak,ch2_rms"));
+        assert!(lines[1].starts_with("\"/lib/a, b.flac\",FLAC,44100,1,16,180,10,10.2500,trimmed,"));
+        assert!(lines[1].ends_with(",,,"));
+
+        let mut jsonl = Vec::new();
+        store.export_jsonl(&rows, &mut jsonl).unwrap();
+        let jsonl = String::from_utf8(jsonl).unwrap();
+        let second: serde_json::Value =
+            serde_json::from_str(jsonl.lines().nth(1).unwrap()).unwrap();
+        assert_eq!(second["official_dr"], 12);
+        assert_eq!(second["channel_results"].as_array().unwrap().len(), 2);
+        assert_eq!(second["flags"].as_array().unwrap().len(), 0);
+        fs::remove_dir_all(&dir).ok();
+    }
+
+    #[test]
+    fn test_path_index_survives_growth_and_repair() {
+        let dir = temp_store("path_index");
+        // 600 个路径按 64 行一块追加：跨越最小容量，触发一次扩容重建
+        let rows: Vec<StoreRow> = (0..600)
+            .map(|i| row(&format!("/lib/{}/{i:03}.flac", i / 12), "FLAC", 10, 0, 2))
+            .collect();
+        for chunk in rows.chunks(64) {
+            append_rows(&dir, chunk).unwrap();
+        }
+        assert_eq!(
+            file_len(&dir.join(column::PATH_INDEX)).unwrap(),
+            PATH_INDEX_HEADER + 2048 * 4
+        );
+        append_rows(&dir, &rows[..100]).unwrap();
+
+        // 索引文件头落后（提交中断）、越界或索引丢失：补齐/重建后仍复用原 id
+        let index = dir.join(column::PATH_INDEX);
+        for header in [590u64, 0, 10_000] {
+            let mut file = OpenOptions::new().write(true).open(&index).unwrap();
+            file.write_all(&header.to_le_bytes()).unwrap();
+            append_rows(&dir, &rows[595..]).unwrap();
+        }
+        fs::remove_file(&index).unwrap();
+        append_rows(&dir, &[rows[7].clone(), row("/new.flac", "FLAC", 9, 0, 2)]).unwrap();
+
+        let store = ResultStore::open(&dir).unwrap();
+        assert_eq!(store.paths.len(), 601);
+        assert_eq!(store.len(), 600 + 100 + 3 * 5 + 2);
+        assert_eq!(store.path_id[store.len() - 2], 7);
+        assert_eq!(store.select(&StoreQuery::default()).len(), 601);
+        fs::remove_dir_all(&dir).ok();
+    }
+
+    /// 百万行规模：追加一块只经索引查找，打开 + 过滤远低于一秒
+    ///
+    /// 包含硬性时间门限，已标记为 #[ignore]。使用以下命令手动执行：
+    /// `cargo test --release bench_million_rows -- --ignored --nocapture`
+    #[test]
+    #[ignore]
+    fn bench_million_rows_open_and_select() {
+        let dir = temp_store("million");
+        let make_row = |n: usize| {
+            let mut track = row(
+                &format!("/lib/artist{}/album{}/{:02}.flac", n / 1000, n / 10, n % 10),
+                if n.is_multiple_of(3) { "MP3" } else { "FLAC" },
+                (n % 20) as i32,
+                if n.is_multiple_of(7) {
+                    flags::CLIPPED
+                } else {
+                    0
+                },
+                2,
+            );
+            track.analyzed_at = n as u64;
+            track
+        };
+        for batch in 0..10 {
+            let rows: Vec<StoreRow> = (batch * 100_000..(batch + 1) * 100_000)
+                .map(make_row)
+                .collect();
+            append_rows(&dir, &rows).unwrap();
+        }
+
+        // 满库后按批处理的粒度追加（一半为重新分析的已有路径）
+        let start = std::time::Instant::now();
+        let chunk: Vec<StoreRow> = (0..64)
+            .map(|i| make_row(i * 15_625 + i % 2 * 2_000_000))
+            .collect();
+        append_rows(&dir, &chunk).unwrap();
+        let append = start.elapsed();
+
+        let start = std::time::Instant::now();
+        let store = ResultStore::open(&dir).unwrap();
+        let open = start.elapsed();
+        let start = std::time::Instant::now();
+        let selected = store.select(&StoreQuery {
+            codec: Some("flac".to_string()),
+            max_dr: Some(8),
+            path_contains: Some("album7".to_string()),
+            ..StoreQuery::default()
+        });
+        let select = start.elapsed();
+        println!(
+            "append 64: {append:?}, open: {open:?}, select ({}): {select:?}",
+            selected.len()
+        );
+
+        assert_eq!(store.len(), 1_000_064);
+        assert_eq!(store.paths.len(), 1_000_032);
+        assert!(!selected.is_empty());
+        assert!(append.as_millis() < 100, "append 64 rows took {append:?}");
+        assert!(
+            (open + select).as_millis() < 1000,
+            "open + select took {:?}",
+            open + select
+        );
+        fs::remove_dir_all(&dir).ok();
+    }
+}
@@ -240,20 +240,45 @@ pub fn finalize_and_write_batch_output(
     is_single_file: bool,
     mut batch_warnings: Vec<super::processor::BatchWarningInfo>,
     exclusion_stats: &super::processor::BatchExclusionStats,
+    replay_gain: &super::processor::BatchReplayGain,
+    clipping: &super::processor::BatchClipping,
 ) -> AudioResult<()> {
     if !is_single_file {
         // 多文件模式：生成批量输出文件
 
-        // 添加排除标记脚注（在表格结束后、警告之前）
-        if exclusion_stats.has_lfe_excluded || exclusion_stats.has_silent_excluded {
+        // 添加行标记脚注（在表格结束后、警告之前）
+        let mut markers = Vec::new();
+        if exclusion_stats.has_lfe_excluded {
+            markers.push("*LFE excluded");
+        }
+        if exclusion_stats.has_silent_excluded {
+            markers.push("†Silent channels excluded");
+        }
+        if exclusion_stats.has_estimated {
+            markers.push("~Estimated from sampled windows / 抽样估算");
+        }
+        if !markers.is_empty() {
             batch_output.push('\n');
-            if exclusion_stats.has_lfe_excluded && exclusion_stats.has_silent_excluded {
-                batch_output.push_str("*LFE excluded / †Silent channels excluded\n");
-            } else if exclusion_stats.has_lfe_excluded {
-                batch_output.push_str("*LFE excluded\n");
-            } else {
-                batch_output.push_str("†Silent channels excluded\n");
-            }
+            batch_output.push_str(&markers.join(" / "));
+            batch_output.push('\n');
+        }
+
+        if let Some(margin_db) = config.two_phase_margin_db {
+            batch_output.push_str(&format!(
+                "\nTwo-phase (--two-phase={margin_db}): estimates within {margin_db} dB of a DR boundary were re-analyzed exactly / 两阶段：距DR边界 {margin_db} dB 以内的估算结果已完整复核\n"
+            ));
+        } else if config.estimate {
+            batch_output.push_str(
+                "\nEstimated from sampled 3s windows (--estimate); short or unseekable files were analyzed in full / 基于抽样3秒窗口估算，短文件或不可定位文件为完整分析\n",
+            );
+        }
+
+        if !replay_gain.is_empty() {
+            batch_output.push_str(&format_replay_gain_section(replay_gain));
+        }
+
+        if !clipping.is_empty() {
+            batch_output.push_str(&format_clipping_section(clipping, processed_count));
         }
 
         // 边界风险预警（精简为 5 列）
@@ -356,6 +381,74 @@ pub fn finalize_and_write_batch_output(
     Ok(())
 }
 
+/// 格式化批量 ReplayGain 2.0 区块：逐文件音轨增益/峰值 + 专辑增益/峰值
+fn format_replay_gain_section(replay_gain: &super::processor::BatchReplayGain) -> String {
+    let mut table = Table::new();
+    table
+        .load_preset(ASCII_MARKDOWN)
+        .set_content_arrangement(ContentArrangement::Dynamic)
+        .set_header(vec!["Track Gain", "Track Peak", "File"]);
+    for column in 0..2 {
+        table
+            .column_mut(column)
+            .expect("numeric column exists")
+            .set_cell_alignment(CellAlignment::Right);
+    }
+
+    let format_gain =
+        |gain: Option<f64>| gain.map_or_else(|| "-".to_string(), |gain| format!("{gain:+.2} dB"));
+    for (file_name, gain, peak) in &replay_gain.tracks {
+        table.add_row(vec![
+            format_gain(*gain),
+            format!("{peak:.6}"),
+            file_name.clone(),
+        ]);
+    }
+
+    let album = replay_gain.album.finish();
+    format!(
+        "\n### ReplayGain 2.0 (-18 LUFS)\n\n{table}\n\nAlbum ({} tracks): gain {}, peak {:.6}\n\n",
+        replay_gain.album.track_count(),
+        format_gain(album.gain_db),
+        album.peak
+    )
+}
+
+/// 格式化批量削波区块：仅列出存在削波或样本间过冲的文件
+fn format_clipping_section(
+    clipping: &super::processor::BatchClipping,
+    processed_count: usize,
+) -> String {
+    let mut table = Table::new();
+    table
+        .load_preset(ASCII_MARKDOWN)
+        .set_content_arrangement(ContentArrangement::Dynamic)
+        .set_header(vec!["Clipped", "Runs", "Longest", "ISP Ch", "File"]);
+    for column in 0..4 {
+        table
+            .column_mut(column)
+            .expect("numeric column exists")
+            .set_cell_alignment(CellAlignment::Right);
+    }
+
+    for (file_name, stats, over_channels) in &clipping.files {
+        table.add_row(vec![
+            stats.clipped_samples.to_string(),
+            stats.clip_runs.to_string(),
+            stats.longest_run.to_string(),
+            over_channels.map_or_else(|| "-".to_string(), |count| count.to_string()),
+            file_name.clone(),
+        ]);
+    }
+
+    format!(
+        "\n### 削波 / Clipping ({}/{processed_count} files)\n\n{table}\n\n\
+         Runs: >= {} consecutive full-scale samples; ISP Ch: channels above 0 dBTP (--true-peak)\n\n",
+        clipping.files.len(),
+        crate::tools::constants::dr_analysis::CLIP_RUN_MIN_SAMPLES,
+    )
+}
+
 /// 显示批量处理完成信息（精简版）
 pub fn show_batch_completion_info(
     output_path: &std::path::Path,
@@ -54,6 +54,12 @@ pub mod path {
             .to_string()
     }
 
+    /// 是否为标准输入占位路径 `-`
+    #[inline]
+    pub fn is_stdin_path(path: &Path) -> bool {
+        path.as_os_str() == "-"
+    }
+
     /// 获取父目录，如果不存在则返回当前目录
     #[inline]
     pub fn get_parent_dir(path: &Path) -> &Path {
@@ -412,6 +418,6 @@ pub use audio::{linear_to_db, linear_to_db_string};
 pub use parallel::effective_parallel_degree;
 pub use path::{
     extract_extension_uppercase, extract_file_stem, extract_file_stem_string, extract_filename,
-    extract_filename_lossy, get_parent_dir, sanitize_filename,
+    extract_filename_lossy, get_parent_dir, is_stdin_path, sanitize_filename,
 };
 pub use performance::{optimize_for_performance, set_high_priority, setup_rayon_high_priority};
@@ -222,16 +222,16 @@ async fn analyze_audio(
     tauri::async_runtime::spawn_blocking(move || {
         let config = options.to_app_config(path);
         let analysis_target = config.input_path.clone();
-        let (results, format, trim_report, silence_report) =
+        let output =
             analyze_file(&analysis_target, &config).map_err(AnalyzeCommandError::from_audio_error)?;
 
         Ok(build_analyze_response(
             &config,
             &analysis_target,
-            results,
-            format,
-            trim_report,
-            silence_report,
+            output.results,
+            output.format,
+            output.edge_trim_report,
+            output.silence_filter_report,
         ))
     })
     .await
@@ -748,16 +748,16 @@ fn analyze_single_file(file: PathBuf, options: &UiAnalyzeOptions) -> DirectoryAn
     let config = options.to_app_config(file.clone());
 
     match analyze_file(&file, &config) {
-        Ok((results, format, trim_report, silence_report)) => DirectoryAnalysisEntry {
+        Ok(output) => DirectoryAnalysisEntry {
             path: path_display,
             file_name,
             analysis: Some(build_analyze_response(
                 &config,
                 &file,
-                results,
-                format,
-                trim_report,
-                silence_report,
+                output.results,
+                output.format,
+                output.edge_trim_report,
+                output.silence_filter_report,
             )),
             error: None,
         },
@@ -807,6 +807,18 @@ impl UiAnalyzeOptions {
             dsd_gain_db: 6.0,
             dsd_filter: "teac".to_string(),
             no_save: true,
+            estimate: false,
+            two_phase_margin_db: None,
+            all_tracks: false,
+            raw_pcm: None,
+            live_span_minutes: None,
+            loudness: false,
+            true_peak: false,
+            clipping: false,
+            replay_gain: false,
+            timeline: None,
+            store_path: None,
+            query: None,
         }
     }
 }
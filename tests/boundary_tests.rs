@@ -5,8 +5,8 @@
 mod audio_test_fixtures;
 
 use audio_test_fixtures::AudioTestFixtures;
-use macinmeter_dr_tool::AudioError;
 use macinmeter_dr_tool::tools::{AppConfig, processor::process_audio_file_streaming};
+use macinmeter_dr_tool::{AnalysisOutput, AudioError};
 use std::path::PathBuf;
 
 fn log(msg_zh: impl AsRef<str>, msg_en: impl AsRef<str>) {
@@ -42,6 +42,18 @@ fn default_test_config() -> AppConfig {
         dsd_gain_db: 6.0,
         dsd_filter: "teac".to_string(),
         no_save: false,
+        estimate: false,
+        two_phase_margin_db: None,
+        all_tracks: false,
+        raw_pcm: None,
+        live_span_minutes: None,
+        loudness: false,
+        true_peak: false,
+        clipping: false,
+        replay_gain: false,
+        timeline: None,
+        store_path: None,
+        query: None,
     }
 }
 
@@ -137,7 +149,10 @@ fn test_tiny_duration_audio() {
 
     // 10ms文件可以被解码，但应该返回有限的DR值（0-40dB）
     match result {
-        Ok((dr_results, _format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            ..
+        }) => {
             assert!(
                 !dr_results.is_empty(),
                 "处理成功应该返回DR结果 / Successful processing should return DR results",
@@ -189,7 +204,10 @@ fn test_silence_handling() {
     let result = process_audio_file_streaming(&path, &config);
 
     match result {
-        Ok((dr_results, _format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            ..
+        }) => {
             assert!(
                 !dr_results.is_empty(),
                 "处理成功应该返回DR结果 / Successful processing should return DR results",
@@ -238,7 +256,10 @@ fn test_full_scale_clipping() {
     let result = process_audio_file_streaming(&path, &config);
 
     match result {
-        Ok((dr_results, _format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            ..
+        }) => {
             if let Some(dr) = dr_results.first() {
                 log(
                     format!("削波文件处理成功: DR={:.2}", dr.dr_value),
@@ -269,7 +290,10 @@ fn test_edge_value_patterns() {
     let result = process_audio_file_streaming(&path, &config);
 
     match result {
-        Ok((dr_results, _format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            ..
+        }) => {
             if let Some(dr) = dr_results.first() {
                 log(
                     format!("边缘值文件处理成功: DR={:.2}", dr.dr_value),
@@ -304,7 +328,11 @@ fn test_high_sample_rate() {
     let result = process_audio_file_streaming(&path, &config);
 
     match result {
-        Ok((dr_results, format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            format,
+            ..
+        }) => {
             if let Some(dr) = dr_results.first() {
                 log(
                     format!("高采样率文件处理成功: DR={:.2}", dr.dr_value),
@@ -351,7 +379,11 @@ fn test_3_channels_support() {
 
     // 3声道文件应该被正确处理（基于foobar2000多声道支持）
     match result {
-        Ok((dr_results, format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            format,
+            ..
+        }) => {
             log(
                 "3声道文件处理成功",
                 "3-channel signal processed successfully",
@@ -399,6 +431,39 @@ fn test_3_channels_support() {
     }
 }
 
+#[test]
+fn test_channel_parallel_analysis_matches_serial() {
+    // 并行解码开启时窗口分析扇出到线程池，结果必须与串行逐位一致
+    let fixtures = setup_fixtures();
+
+    for name in ["3_channels.wav", "high_sample_rate.wav"] {
+        let path = fixtures.get_path(name);
+        let serial_config = default_test_config();
+        let parallel_config = AppConfig {
+            parallel_decoding: true,
+            ..default_test_config()
+        };
+
+        let AnalysisOutput {
+            results: serial, ..
+        } = process_audio_file_streaming(&path, &serial_config)
+            .unwrap_or_else(|e| panic!("{name} serial analysis failed / 串行分析失败: {e:?}"));
+        let AnalysisOutput {
+            results: parallel, ..
+        } = process_audio_file_streaming(&path, &parallel_config)
+            .unwrap_or_else(|e| panic!("{name} parallel analysis failed / 并行分析失败: {e:?}"));
+
+        assert_eq!(
+            serial, parallel,
+            "{name}: 声道并行分析结果应与串行一致 / channel-parallel results should match serial"
+        );
+        log(
+            format!("  {name}: 声道并行与串行结果一致"),
+            format!("  {name}: channel-parallel results match serial"),
+        );
+    }
+}
+
 // ========== 异常文件测试 ==========
 
 #[test]
@@ -484,7 +549,11 @@ fn test_truncated_wav() {
     // - 当预期样本 > 实际样本时，应标记 is_partial() == true
     // 当前的测试文件可能不足以触发这些条件，因此标记为 #[ignore]
     match result {
-        Ok((dr_results, format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            format,
+            ..
+        }) => {
             log(
                 format!("截断文件处理结果: is_partial={}", format.is_partial()),
                 format!("Truncated file result: is_partial={}", format.is_partial()),
@@ -547,7 +616,10 @@ fn test_multiple_files_stress() {
         );
 
         match process_audio_file_streaming(&path, &config) {
-            Ok((dr_results, _, _, _)) => {
+            Ok(AnalysisOutput {
+                results: dr_results,
+                ..
+            }) => {
                 if let Some(dr) = dr_results.first() {
                     log(
                         format!("  DR={:.2}", dr.dr_value),
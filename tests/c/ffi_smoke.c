@@ -0,0 +1,86 @@
+/*
+ * C ABI 冒烟测试：以 C 调用方身份编译 include/macinmeter_dr.h 并链接 cdylib。
+ * C ABI smoke test: compiles include/macinmeter_dr.h as a C caller and links the cdylib.
+ *
+ * 由 tests/ffi_c_abi_tests.rs 编译运行；布局与常量行由 Rust 侧比对。
+ * Built and run by tests/ffi_c_abi_tests.rs, which compares the layout/constant lines.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "macinmeter_dr.h"
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            fprintf(stderr, "CHECK failed at line %d: %s\n", __LINE__, #cond); \
+            return 1;                                                       \
+        }                                                                   \
+    } while (0)
+
+#define FRAMES 44100
+
+int main(void) {
+    printf("MmDrChannelResult %zu %zu %zu %zu %zu %zu %zu %zu\n", sizeof(MmDrChannelResult),
+           offsetof(MmDrChannelResult, channel), offsetof(MmDrChannelResult, dr_value),
+           offsetof(MmDrChannelResult, rms), offsetof(MmDrChannelResult, peak),
+           offsetof(MmDrChannelResult, primary_peak), offsetof(MmDrChannelResult, secondary_peak),
+           offsetof(MmDrChannelResult, sample_count));
+    printf("MmDrSummary %zu %zu %zu %zu %zu %zu %zu %zu\n", sizeof(MmDrSummary),
+           offsetof(MmDrSummary, official_dr), offsetof(MmDrSummary, precise_dr),
+           offsetof(MmDrSummary, sample_rate), offsetof(MmDrSummary, channels),
+           offsetof(MmDrSummary, bits_per_sample), offsetof(MmDrSummary, frame_count),
+           offsetof(MmDrSummary, is_partial));
+    printf("MmDrFileOptions %zu %zu %zu %zu\n", sizeof(MmDrFileOptions),
+           offsetof(MmDrFileOptions, parallel_decoding),
+           offsetof(MmDrFileOptions, parallel_threads), offsetof(MmDrFileOptions, exclude_lfe));
+    printf("codes %u %d %d %d %d %d %d %d %d %d %d %d\n", MM_DR_ABI_VERSION, MM_DR_OK,
+           MM_DR_ERR_NULL_POINTER, MM_DR_ERR_INVALID_INPUT, MM_DR_ERR_FORMAT, MM_DR_ERR_DECODING,
+           MM_DR_ERR_CALCULATION, MM_DR_ERR_IO, MM_DR_ERR_RESOURCE, MM_DR_ERR_BUFFER_TOO_SMALL,
+           MM_DR_ERR_SESSION_FINISHED, MM_DR_ERR_PANIC);
+
+    CHECK(mm_dr_abi_version() == MM_DR_ABI_VERSION);
+
+    /* 推送式会话：16 位立体声锯齿波 + 周期性尖峰 */
+    static int16_t samples[FRAMES * 2];
+    for (size_t i = 0; i < FRAMES * 2; i++) {
+        samples[i] = (int16_t)((i / 2) % 1000 == 0 ? 30000 : (int)((i / 2) % 200) * 20 - 2000);
+    }
+
+    MmDrSession *session = mm_dr_session_create(44100, 2);
+    CHECK(session != NULL);
+    CHECK(mm_dr_session_push_i16(session, samples, FRAMES * 2) == MM_DR_OK);
+    CHECK(mm_dr_session_push_i16(session, samples, 3) == MM_DR_ERR_INVALID_INPUT);
+
+    MmDrChannelResult results[MM_DR_MAX_CHANNELS];
+    MmDrSummary summary;
+    size_t count = 0;
+    CHECK(mm_dr_session_finish(session, results, 1, &count, &summary) ==
+          MM_DR_ERR_BUFFER_TOO_SMALL);
+    CHECK(count == 2);
+    CHECK(mm_dr_session_finish(session, results, MM_DR_MAX_CHANNELS, &count, &summary) ==
+          MM_DR_OK);
+    CHECK(count == 2);
+    CHECK(results[1].channel == 1);
+    CHECK(results[0].dr_value > 0.0);
+    CHECK(results[0].sample_count == FRAMES);
+    CHECK(summary.channels == 2);
+    CHECK(summary.sample_rate == 44100);
+    CHECK(summary.bits_per_sample == 16);
+    CHECK(summary.frame_count == FRAMES);
+    CHECK(mm_dr_session_push_i16(session, samples, 2) == MM_DR_ERR_SESSION_FINISHED);
+    mm_dr_session_destroy(session);
+
+    /* 文件接口：不存在的路径返回错误码与错误信息 */
+    MmDrFileOptions options = {1, 0, 0};
+    int32_t code = mm_dr_analyze_file("/nonexistent/macinmeter_smoke.flac", &options, results,
+                                      MM_DR_MAX_CHANNELS, &count, NULL);
+    CHECK(code < 0);
+    char message[256];
+    CHECK(mm_dr_last_error_message(message, sizeof message) > 0);
+    CHECK(message[0] != '\0');
+
+    printf("ok\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+//! C ABI 冒烟测试
+//!
+//! 用系统 C 编译器把 `tests/c/ffi_smoke.c`（`include/macinmeter_dr.h` 的调用方）编译并链接到
+//! 本次测试构建出的 cdylib，运行后比对结构体布局与常量，头文件与 `src/ffi.rs` 不一致时失败。
+//!
+//! 编译器取 `CC` 环境变量，默认 `cc`；非 Unix 平台或找不到编译器时跳过。
+
+use macinmeter_dr_tool::ffi::*;
+use std::mem::{offset_of, size_of};
+use std::path::{Path, PathBuf};
+use std::process::Command;
+
+/// 在测试可执行文件附近查找 cdylib（target/<profile>/deps 或 target/<profile>）
+fn find_cdylib() -> Option<PathBuf> {
+    let name = format!(
+        "{}macinmeter_dr_tool{}",
+        std::env::consts::DLL_PREFIX,
+        std::env::consts::DLL_SUFFIX
+    );
+    let exe = std::env::current_exe().ok()?;
+    exe.ancestors()
+        .skip(1)
+        .take(2)
+        .map(|dir| dir.join(&name))
+        .find(|path| path.exists())
+}
+
+fn expected_layout() -> Vec<String> {
+    vec![
+        format!(
+            "MmDrChannelResult {} {} {} {} {} {} {} {}",
+            size_of::<MmDrChannelResult>(),
+            offset_of!(MmDrChannelResult, channel),
+            offset_of!(MmDrChannelResult, dr_value),
+            offset_of!(MmDrChannelResult, rms),
+            offset_of!(MmDrChannelResult, peak),
+            offset_of!(MmDrChannelResult, primary_peak),
+            offset_of!(MmDrChannelResult, secondary_peak),
+            offset_of!(MmDrChannelResult, sample_count),
+        ),
+        format!(
+            "MmDrSummary {} {} {} {} {} {} {} {}",
+            size_of::<MmDrSummary>(),
+            offset_of!(MmDrSummary, official_dr),
+            offset_of!(MmDrSummary, precise_dr),
+            offset_of!(MmDrSummary, sample_rate),
+            offset_of!(MmDrSummary, channels),
+            offset_of!(MmDrSummary, bits_per_sample),
+            offset_of!(MmDrSummary, frame_count),
+            offset_of!(MmDrSummary, is_partial),
+        ),
+        format!(
+            "MmDrFileOptions {} {} {} {}",
+            size_of::<MmDrFileOptions>(),
+            offset_of!(MmDrFileOptions, parallel_decoding),
+            offset_of!(MmDrFileOptions, parallel_threads),
+            offset_of!(MmDrFileOptions, exclude_lfe),
+        ),
+        format!(
+            "codes {MM_DR_ABI_VERSION} {MM_DR_OK} {MM_DR_ERR_NULL_POINTER} {MM_DR_ERR_INVALID_INPUT} \
+             {MM_DR_ERR_FORMAT} {MM_DR_ERR_DECODING} {MM_DR_ERR_CALCULATION} {MM_DR_ERR_IO} \
+             {MM_DR_ERR_RESOURCE} {MM_DR_ERR_BUFFER_TOO_SMALL} {MM_DR_ERR_SESSION_FINISHED} \
+             {MM_DR_ERR_PANIC}"
+        ),
+        "ok".to_string(),
+    ]
+}
+
+#[test]
+fn test_c_header_compiles_links_and_matches_abi() {
+    if !cfg!(unix) {
+        println!("跳过：仅在 Unix 平台编译 C 冒烟测试 / Skipped: C smoke test runs on Unix only");
+        return;
+    }
+    let Some(library) = find_cdylib() else {
+        panic!("未找到 cdylib / cdylib not found next to the test executable");
+    };
+    let library_dir = library.parent().unwrap();
+
+    let root = Path::new(env!("CARGO_MANIFEST_DIR"));
+    let executable = Path::new(env!("CARGO_TARGET_TMPDIR")).join("ffi_smoke");
+    let compiler = std::env::var("CC").unwrap_or_else(|_| "cc".to_string());
+    let compiled = match Command::new(&compiler)
+        .args(["-std=c99", "-Wall", "-Wextra", "-Werror", "-I"])
+        .arg(root.join("include"))
+        .arg(root.join("tests/c/ffi_smoke.c"))
+        .arg(&library)
+        .arg(format!("-Wl,-rpath,{}", library_dir.display()))
+        .arg("-o")
+        .arg(&executable)
+        .output()
+    {
+        Ok(output) => output,
+        Err(e) => {
+            println!("跳过：无法启动 C 编译器 {compiler} / Skipped: cannot run C compiler: {e}");
+            return;
+        }
+    };
+    assert!(
+        compiled.status.success(),
+        "C 冒烟测试编译失败 / C smoke test failed to compile:\n{}",
+        String::from_utf8_lossy(&compiled.stderr)
+    );
+
+    let run = Command::new(&executable).output().unwrap();
+    let stdout = String::from_utf8_lossy(&run.stdout);
+    assert!(
+        run.status.success(),
+        "C 冒烟测试失败 / C smoke test failed:\n{stdout}\n{}",
+        String::from_utf8_lossy(&run.stderr)
+    );
+    let lines: Vec<&str> = stdout.lines().collect();
+    assert_eq!(
+        lines,
+        expected_layout(),
+        "头文件与 src/ffi.rs 的 ABI 不一致"
+    );
+}
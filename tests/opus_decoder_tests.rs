@@ -2,6 +2,7 @@
 //!
 //! 测试SongbirdOpusDecoder的功能和正确性
 
+use macinmeter_dr_tool::AnalysisOutput;
 use macinmeter_dr_tool::audio::{SongbirdOpusDecoder, StreamingDecoder};
 use macinmeter_dr_tool::tools::{AppConfig, processor::process_audio_file_streaming};
 use std::path::PathBuf;
@@ -35,6 +36,18 @@ fn default_test_config() -> AppConfig {
         dsd_gain_db: 6.0,
         dsd_filter: "teac".to_string(),
         no_save: false,
+        estimate: false,
+        two_phase_margin_db: None,
+        all_tracks: false,
+        raw_pcm: None,
+        live_span_minutes: None,
+        loudness: false,
+        true_peak: false,
+        clipping: false,
+        replay_gain: false,
+        timeline: None,
+        store_path: None,
+        query: None,
     }
 }
 
@@ -273,7 +286,11 @@ fn test_opus_dr_calculation() {
     let result = process_audio_file_streaming(&path, &config);
 
     match result {
-        Ok((dr_results, format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            format,
+            ..
+        }) => {
             log("Opus文件DR计算成功", "Opus DR calculation succeeded");
             log(
                 format!(
@@ -346,7 +363,11 @@ fn test_ogg_opus_compatibility() {
     let result = process_audio_file_streaming(&path, &config);
 
     match result {
-        Ok((dr_results, format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            format,
+            ..
+        }) => {
             log("OGG文件处理成功", "OGG file processed successfully");
             log(
                 format!(
@@ -443,7 +464,10 @@ fn test_opus_decoding_performance() {
     let elapsed = start.elapsed();
 
     match result {
-        Ok((dr_results, _format, _, _)) => {
+        Ok(AnalysisOutput {
+            results: dr_results,
+            ..
+        }) => {
             let file_size = std::fs::metadata(&path).unwrap().len();
             let throughput_mbps = (file_size as f64 / 1_048_576.0) / elapsed.as_secs_f64();
 
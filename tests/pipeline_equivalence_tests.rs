@@ -0,0 +1,174 @@
+//! 解码→分析流水线等价性测试
+//!
+//! 同一固件分别走流水线与 `DR_DISABLE_PIPELINE=1` 串行循环，要求 DR/Peak/RMS/样本数逐位一致。
+//! 固件样本经重分块解码器回放，同时覆盖"小块合并成批"与"大块直接转移"两个分支。
+//!
+//! 环境变量为进程级状态：本文件只含一个测试函数，串行切换开关，避免与其他测试竞争。
+//! 开关仅在 Debug 构建生效（`decode_pipeline_enabled`），Release 下两次运行均走流水线。
+
+mod audio_test_fixtures;
+
+use audio_test_fixtures::{ensure_fixtures_generated, fixture_path};
+use macinmeter_dr_tool::audio::{AudioFormat, StreamingDecoder, UniversalDecoder};
+use macinmeter_dr_tool::tools::constants::decoder_performance::PIPELINE_BATCH_SAMPLES;
+use macinmeter_dr_tool::tools::{AppConfig, processor::process_streaming_decoder};
+use macinmeter_dr_tool::{AnalysisOutput, AudioResult, DrResult};
+use std::path::PathBuf;
+
+fn test_config() -> AppConfig {
+    AppConfig {
+        input_path: PathBuf::from("."),
+        verbose: false,
+        output_path: None,
+        parallel_decoding: false,
+        parallel_batch_size: 64,
+        parallel_threads: 4,
+        parallel_files: None,
+        silence_filter_threshold_db: None,
+        edge_trim_threshold_db: None,
+        edge_trim_min_run_ms: None,
+        exclude_lfe: false,
+        show_rms_peak: false,
+        compact_output: false,
+        json_output: false,
+        auto_launched: false,
+        dsd_pcm_rate: Some(352_800),
+        dsd_gain_db: 6.0,
+        dsd_filter: "teac".to_string(),
+        no_save: true,
+        estimate: false,
+        two_phase_margin_db: None,
+        all_tracks: false,
+        raw_pcm: None,
+        live_span_minutes: None,
+        loudness: false,
+        true_peak: false,
+        clipping: false,
+        replay_gain: false,
+        timeline: None,
+        store_path: None,
+        query: None,
+    }
+}
+
+/// 按给定块长序列（循环使用）回放固件样本的解码器
+struct RechunkingDecoder {
+    samples: Vec<f32>,
+    format: AudioFormat,
+    chunk_lens: Vec<usize>,
+    position: usize,
+    chunk_index: usize,
+}
+
+impl RechunkingDecoder {
+    fn new(samples: Vec<f32>, format: AudioFormat, chunk_lens: Vec<usize>) -> Self {
+        Self {
+            samples,
+            format,
+            chunk_lens,
+            position: 0,
+            chunk_index: 0,
+        }
+    }
+}
+
+impl StreamingDecoder for RechunkingDecoder {
+    fn next_chunk(&mut self) -> AudioResult<Option<Vec<f32>>> {
+        if self.position >= self.samples.len() {
+            return Ok(None);
+        }
+        let channels = self.format.channels as usize;
+        let len = self.chunk_lens[self.chunk_index % self.chunk_lens.len()];
+        // 块长按帧对齐，保证每块都是完整的交错帧
+        let len = (len / channels).max(1) * channels;
+        let end = (self.position + len).min(self.samples.len());
+        let chunk = self.samples[self.position..end].to_vec();
+        self.position = end;
+        self.chunk_index += 1;
+        Ok(Some(chunk))
+    }
+
+    fn progress(&self) -> f32 {
+        self.position as f32 / self.samples.len().max(1) as f32
+    }
+
+    fn format(&self) -> AudioFormat {
+        self.format.clone()
+    }
+
+    fn reset(&mut self) -> AudioResult<()> {
+        self.position = 0;
+        self.chunk_index = 0;
+        Ok(())
+    }
+}
+
+/// 完整解码固件，返回交错样本与格式
+fn decode_fixture(name: &str) -> (Vec<f32>, AudioFormat) {
+    ensure_fixtures_generated();
+    let mut decoder = UniversalDecoder::new()
+        .create_streaming(fixture_path(name))
+        .expect("无法打开固件 / failed to open fixture");
+    let format = decoder.format();
+    let mut samples = Vec::new();
+    while let Some(chunk) = decoder.next_chunk().expect("解码失败 / decode failed") {
+        samples.extend_from_slice(&chunk);
+    }
+    (samples, format)
+}
+
+fn analyze(samples: &[f32], format: &AudioFormat, chunk_lens: &[usize]) -> Vec<DrResult> {
+    let mut decoder = RechunkingDecoder::new(samples.to_vec(), format.clone(), chunk_lens.to_vec());
+    let AnalysisOutput { results, .. } = process_streaming_decoder(&mut decoder, &test_config())
+        .expect("分析失败 / analysis failed");
+    results
+}
+
+fn set_pipeline_disabled(disabled: bool) {
+    // SAFETY: 本测试二进制只有这一个测试函数，设置环境变量时没有其他线程读取它
+    unsafe {
+        if disabled {
+            std::env::set_var("DR_DISABLE_PIPELINE", "1");
+        } else {
+            std::env::remove_var("DR_DISABLE_PIPELINE");
+        }
+    }
+}
+
+#[test]
+fn test_pipeline_matches_serial_loop() {
+    let (samples, format) = decode_fixture("high_sample_rate.wav");
+    assert!(
+        samples.len() > PIPELINE_BATCH_SAMPLES * 4,
+        "固件过短，无法覆盖直接转移分支 / fixture too short for the direct-move branch"
+    );
+
+    let patterns: [(&str, Vec<usize>); 3] = [
+        // 全部小块：合并成批分支
+        ("merged", vec![4_096]),
+        // 全部大块：直接转移分支
+        ("direct", vec![PIPELINE_BATCH_SAMPLES + 8_192]),
+        // 交替：空批次遇大块走直接转移，未满批次后的大块仍并入批次
+        (
+            "mixed",
+            vec![PIPELINE_BATCH_SAMPLES * 2, 1_000, 70_000, 512],
+        ),
+    ];
+
+    for (name, chunk_lens) in &patterns {
+        set_pipeline_disabled(true);
+        let serial = analyze(&samples, &format, chunk_lens);
+        set_pipeline_disabled(false);
+        let pipelined = analyze(&samples, &format, chunk_lens);
+
+        assert_eq!(serial.len(), pipelined.len(), "{name}: 声道数不一致");
+        for (s, p) in serial.iter().zip(&pipelined) {
+            assert_eq!(s.channel, p.channel, "{name}");
+            assert_eq!(s.sample_count, p.sample_count, "{name}: sample_count");
+            assert_eq!(s.dr_value.to_bits(), p.dr_value.to_bits(), "{name}: DR");
+            assert_eq!(s.peak.to_bits(), p.peak.to_bits(), "{name}: Peak");
+            assert_eq!(s.rms.to_bits(), p.rms.to_bits(), "{name}: RMS");
+        }
+        println!("  {name}: 流水线与串行结果逐位一致 / pipeline matches serial loop bit for bit");
+    }
+}
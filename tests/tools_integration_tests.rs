@@ -2,6 +2,7 @@
 //!
 //! 测试CLI、文件扫描、格式化输出等工具模块的集成功能。
 
+use macinmeter_dr_tool::AnalysisOutput;
 use macinmeter_dr_tool::tools::{self, AppConfig};
 use std::path::{Path, PathBuf};
 
@@ -34,6 +35,18 @@ fn base_config() -> AppConfig {
         dsd_gain_db: 6.0,
         dsd_filter: "teac".to_string(),
         no_save: false,
+        estimate: false,
+        two_phase_margin_db: None,
+        all_tracks: false,
+        raw_pcm: None,
+        live_span_minutes: None,
+        loudness: false,
+        true_peak: false,
+        clipping: false,
+        replay_gain: false,
+        timeline: None,
+        store_path: None,
+        query: None,
     }
 }
 
@@ -504,7 +517,11 @@ fn test_batch_vs_single_dr_consistency_wav() {
 
     let single_result = tools::process_single_audio_file(&test_file, &single_config);
     assert!(single_result.is_ok(), "单文件处理应该成功");
-    let (single_dr_results, single_format, _, _) = single_result.unwrap();
+    let AnalysisOutput {
+        results: single_dr_results,
+        format: single_format,
+        ..
+    } = single_result.unwrap();
 
     let single_official_dr =
         tools::compute_official_precise_dr(&single_dr_results, &single_format, false);
@@ -525,7 +542,11 @@ fn test_batch_vs_single_dr_consistency_wav() {
     // 手动调用批量处理逻辑（模拟只处理这一个文件）
     let batch_result = tools::process_single_audio_file(&test_file, &batch_config);
     assert!(batch_result.is_ok(), "批量处理应该成功");
-    let (batch_dr_results, batch_format, _, _) = batch_result.unwrap();
+    let AnalysisOutput {
+        results: batch_dr_results,
+        format: batch_format,
+        ..
+    } = batch_result.unwrap();
 
     let batch_official_dr =
         tools::compute_official_precise_dr(&batch_dr_results, &batch_format, false);
@@ -608,8 +629,11 @@ fn test_batch_vs_single_dr_consistency_mp3() {
     single_config.parallel_files = None;
     single_config.output_path = None;
 
-    let (single_dr_results, single_format, _, _) =
-        tools::process_single_audio_file(&test_file, &single_config).expect("单文件处理应该成功");
+    let AnalysisOutput {
+        results: single_dr_results,
+        format: single_format,
+        ..
+    } = tools::process_single_audio_file(&test_file, &single_config).expect("单文件处理应该成功");
 
     let (single_official, single_precise, _, _) =
         tools::compute_official_precise_dr(&single_dr_results, &single_format, false)
@@ -627,8 +651,11 @@ fn test_batch_vs_single_dr_consistency_mp3() {
     batch_config.parallel_files = Some(1);
     batch_config.output_path = None;
 
-    let (batch_dr_results, batch_format, _, _) =
-        tools::process_single_audio_file(&test_file, &batch_config).expect("批量处理应该成功");
+    let AnalysisOutput {
+        results: batch_dr_results,
+        format: batch_format,
+        ..
+    } = tools::process_single_audio_file(&test_file, &batch_config).expect("批量处理应该成功");
 
     let (batch_official, batch_precise, _, _) =
         tools::compute_official_precise_dr(&batch_dr_results, &batch_format, false)
@@ -686,8 +713,11 @@ fn test_batch_vs_single_dr_consistency_flac() {
     single_config.parallel_files = None;
     single_config.output_path = None;
 
-    let (single_dr_results, single_format, _, _) =
-        tools::process_single_audio_file(&test_file, &single_config).expect("单文件处理应该成功");
+    let AnalysisOutput {
+        results: single_dr_results,
+        format: single_format,
+        ..
+    } = tools::process_single_audio_file(&test_file, &single_config).expect("单文件处理应该成功");
 
     let (single_official, single_precise, _, _) =
         tools::compute_official_precise_dr(&single_dr_results, &single_format, false)
@@ -705,8 +735,11 @@ fn test_batch_vs_single_dr_consistency_flac() {
     batch_config.parallel_files = Some(1);
     batch_config.output_path = None;
 
-    let (batch_dr_results, batch_format, _, _) =
-        tools::process_single_audio_file(&test_file, &batch_config).expect("批量处理应该成功");
+    let AnalysisOutput {
+        results: batch_dr_results,
+        format: batch_format,
+        ..
+    } = tools::process_single_audio_file(&test_file, &batch_config).expect("批量处理应该成功");
 
     let (batch_official, batch_precise, _, _) =
         tools::compute_official_precise_dr(&batch_dr_results, &batch_format, false)
@@ -804,7 +837,11 @@ fn test_batch_vs_single_dr_consistency_multiple_formats() {
             continue;
         }
 
-        let (single_dr_results, single_format, _, _) = single_result.unwrap();
+        let AnalysisOutput {
+            results: single_dr_results,
+            format: single_format,
+            ..
+        } = single_result.unwrap();
         let single_official_dr =
             tools::compute_official_precise_dr(&single_dr_results, &single_format, false);
         if single_official_dr.is_none() {
@@ -824,8 +861,11 @@ fn test_batch_vs_single_dr_consistency_multiple_formats() {
         batch_config.parallel_files = Some(1);
         batch_config.output_path = None;
 
-        let (batch_dr_results, batch_format, _, _) =
-            tools::process_single_audio_file(&test_file, &batch_config).expect("批量处理应该成功");
+        let AnalysisOutput {
+            results: batch_dr_results,
+            format: batch_format,
+            ..
+        } = tools::process_single_audio_file(&test_file, &batch_config).expect("批量处理应该成功");
 
         let (batch_official, batch_precise, _, _) =
             tools::compute_official_precise_dr(&batch_dr_results, &batch_format, false)
@@ -880,3 +920,414 @@ fn test_batch_vs_single_dr_consistency_multiple_formats() {
     assert!(tested_count > 0, "至少应该测试一个格式");
     assert_eq!(passed_count, tested_count, "所有测试格式都应该通过");
 }
+
+// ============================================================================
+// CUE分轨测试
+// ============================================================================
+
+/// 写入立体声16位正弦WAV（带周期性尖峰，保证窗口峰值稳定）
+fn write_sine_wav(path: &Path, seconds: u32, amplitude: f64, freq_hz: f64) {
+    use hound::{SampleFormat, WavSpec, WavWriter};
+
+    let spec = WavSpec {
+        channels: 2,
+        sample_rate: 44100,
+        bits_per_sample: 16,
+        sample_format: SampleFormat::Int,
+    };
+    let mut writer = WavWriter::create(path, spec).expect("无法创建WAV文件");
+    for sample in sine_samples(44100 * seconds as usize, amplitude, freq_hz) {
+        writer.write_sample(sample).expect("无法写入样本");
+    }
+    writer.finalize().expect("无法完成写入");
+}
+
+/// 立体声正弦样本（交错），每0.5秒一个满幅尖峰
+fn sine_samples(frames: usize, amplitude: f64, freq_hz: f64) -> Vec<i16> {
+    (0..frames)
+        .flat_map(|n| {
+            let t = n as f64 / 44100.0;
+            let mut value = amplitude * (2.0 * std::f64::consts::PI * freq_hz * t).sin();
+            if n % 22050 == 0 {
+                value = 0.99;
+            }
+            let sample = (value * i16::MAX as f64) as i16;
+            [sample, sample]
+        })
+        .collect()
+}
+
+/// 验证CUE整轨镜像的逐轨DR与分轨后单独分析一致，专辑DR为各轨均值
+#[test]
+fn test_cue_image_per_track_matches_split_files() {
+    let dir = std::env::temp_dir().join(format!("macinmeter_cue_test_{}", std::process::id()));
+    std::fs::create_dir_all(&dir).unwrap();
+
+    // 分轨文件：第1轨7秒（INDEX 01 对齐到 1/75 秒），第2轨5秒且响度不同
+    let track1 = dir.join("track1.wav");
+    let track2 = dir.join("track2.wav");
+    write_sine_wav(&track1, 7, 0.5, 440.0);
+    write_sine_wav(&track2, 5, 0.05, 1000.0);
+
+    // 整轨镜像 = 两轨首尾相接
+    let image = dir.join("Album.wav");
+    {
+        let spec = hound::WavReader::open(&track1).unwrap().spec();
+        let mut writer = hound::WavWriter::create(&image, spec).unwrap();
+        for part in [&track1, &track2] {
+            let mut reader = hound::WavReader::open(part).unwrap();
+            for sample in reader.samples::<i16>() {
+                writer.write_sample(sample.unwrap()).unwrap();
+            }
+        }
+        writer.finalize().unwrap();
+    }
+    std::fs::write(
+        dir.join("Album.cue"),
+        "FILE \"Album.wav\" WAVE\n  TRACK 01 AUDIO\n    TITLE \"One\"\n    INDEX 01 00:00:00\n  TRACK 02 AUDIO\n    TITLE \"Two\"\n    INDEX 01 00:07:00\n",
+    )
+    .unwrap();
+
+    let mut config = base_config();
+    config.parallel_decoding = false;
+    assert!(tools::probe_sub_tracks(&track1, &config).is_none());
+    let probed = tools::probe_sub_tracks(&image, &config);
+    assert!(matches!(probed, Some(tools::SubTrackSource::Cue(_))));
+
+    let (
+        AnalysisOutput {
+            results: image_results,
+            format,
+            ..
+        },
+        sub_tracks,
+    ) = tools::process_batch_audio_file(&image, &config, probed).expect("整轨镜像分析应该成功");
+    let Some(tools::SubTrackResults::Cue(cue_tracks)) = sub_tracks else {
+        panic!("应检测到CUE分轨表");
+    };
+    assert_eq!(cue_tracks.len(), 2);
+    assert_eq!(cue_tracks[1].title.as_deref(), Some("Two"));
+    assert_eq!(image_results.len(), 2);
+
+    let mut track_precise = Vec::new();
+    let mut split_frames = Vec::new();
+    for (track, split_file) in cue_tracks.iter().zip([&track1, &track2]) {
+        let AnalysisOutput {
+            results: split_results,
+            format: split_format,
+            ..
+        } = tools::process_single_audio_file(split_file, &config).unwrap();
+        let (_, split_dr, _, _) =
+            tools::compute_official_precise_dr(&split_results, &split_format, false).unwrap();
+        let (_, track_dr, _, _) =
+            tools::compute_official_precise_dr(&track.results, &format, false).unwrap();
+        assert!(
+            (split_dr - track_dr).abs() < 1e-9,
+            "第{}轨DR应与分轨文件一致: {track_dr} vs {split_dr}",
+            track.number
+        );
+        track_precise.push(track_dr);
+        split_frames.push(split_format.sample_count);
+    }
+
+    let mut batch_output = String::new();
+    tools::add_cue_tracks_to_batch_output(&mut batch_output, &cue_tracks, &format, &image, false);
+    let album_dr = (track_precise[0] + track_precise[1]) / 2.0;
+    assert!(batch_output.contains("Album.wav #01 One"));
+    assert!(batch_output.contains(&format!("{album_dr:.2} | Album.wav (Album, 2 tracks)")));
+
+    // 结果库：每个CUE分轨以 `#NN` 后缀各占一行，时长为该轨帧数
+    config.store_path = Some(dir.join("store"));
+    let mut store = tools::BatchStore::default();
+    store.add_sub_tracks(
+        &config,
+        &image,
+        &tools::SubTrackResults::Cue(cue_tracks),
+        &format,
+    );
+    store.commit(&config);
+    let store = tools::ResultStore::open(&dir.join("store")).unwrap();
+    assert_eq!(store.len(), 2);
+    for (index, suffix) in ["#01", "#02"].into_iter().enumerate() {
+        let row = store.row(index);
+        assert!(row.path.ends_with(&format!("Album.wav{suffix}")));
+        assert_eq!(row.frames, split_frames[index]);
+        assert!((row.precise_dr.unwrap() - track_precise[index]).abs() < 1e-9);
+    }
+
+    let _ = std::fs::remove_dir_all(&dir);
+}
+
+/// EBML 元素（尺寸统一编码为8字节 vint，便于一次写出）
+fn ebml(id: &[u8], payload: &[u8]) -> Vec<u8> {
+    let mut element = id.to_vec();
+    element.push(0x01);
+    element.extend_from_slice(&(payload.len() as u64).to_be_bytes()[1..]);
+    element.extend_from_slice(payload);
+    element
+}
+
+fn ebml_uint(id: &[u8], value: u64) -> Vec<u8> {
+    ebml(id, &value.to_be_bytes())
+}
+
+fn crc8(data: &[u8]) -> u8 {
+    data.iter().fold(0u8, |mut crc, &byte| {
+        crc ^= byte;
+        for _ in 0..8 {
+            crc = if crc & 0x80 != 0 {
+                (crc << 1) ^ 0x07
+            } else {
+                crc << 1
+            };
+        }
+        crc
+    })
+}
+
+fn crc16(data: &[u8]) -> u16 {
+    data.iter().fold(0u16, |mut crc, &byte| {
+        crc ^= (byte as u16) << 8;
+        for _ in 0..8 {
+            crc = if crc & 0x8000 != 0 {
+                (crc << 1) ^ 0x8005
+            } else {
+                crc << 1
+            };
+        }
+        crc
+    })
+}
+
+/// 44.1kHz/16bit 立体声 FLAC 帧（固定4096帧块，VERBATIM 子帧）
+fn flac_verbatim_frame(frame_number: u8, interleaved: &[i16]) -> Vec<u8> {
+    // 块大小码12=4096，采样率码9=44.1kHz，双声道独立编码，16bit；帧号<128时UTF-8编码为单字节
+    let mut frame = vec![0xFF, 0xF8, 0xC9, 0x18, frame_number];
+    frame.push(crc8(&frame));
+    for channel in 0..2 {
+        frame.push(0x02);
+        for sample in interleaved.iter().skip(channel).step_by(2) {
+            frame.extend_from_slice(&sample.to_be_bytes());
+        }
+    }
+    let crc = crc16(&frame);
+    frame.extend_from_slice(&crc.to_be_bytes());
+    frame
+}
+
+/// 写出最小 Matroska 多音轨容器：第1条为无法解码的 DTS 音轨，第2/3条为 FLAC 音轨
+fn write_multi_track_mkv(path: &Path, flac_tracks: [&[i16]; 2]) {
+    const BLOCK_FRAMES: usize = 4096;
+    let total_frames = flac_tracks[0].len() / 2;
+
+    let mut streaminfo = Vec::with_capacity(34);
+    streaminfo.extend_from_slice(&(BLOCK_FRAMES as u16).to_be_bytes());
+    streaminfo.extend_from_slice(&(BLOCK_FRAMES as u16).to_be_bytes());
+    streaminfo.extend_from_slice(&[0; 6]);
+    let packed = (44100u64 << 44) | (1 << 41) | (15 << 36) | total_frames as u64;
+    streaminfo.extend_from_slice(&packed.to_be_bytes());
+    streaminfo.extend_from_slice(&[0; 16]);
+    let mut flac_private = b"fLaC".to_vec();
+    flac_private.extend_from_slice(&[0x80, 0x00, 0x00, 34]);
+    flac_private.extend_from_slice(&streaminfo);
+
+    let audio = [
+        ebml(&[0xB5], &44100f64.to_be_bytes()),
+        ebml_uint(&[0x9F], 2),
+        ebml_uint(&[0x62, 0x64], 16),
+    ]
+    .concat();
+    let track_entry = |number: u64, codec_id: &str, language: &str, private: &[u8]| {
+        let mut entry = [
+            ebml_uint(&[0xD7], number),
+            ebml_uint(&[0x73, 0xC5], number),
+            ebml_uint(&[0x83], 2),
+            ebml(&[0x86], codec_id.as_bytes()),
+            ebml(&[0x22, 0xB5, 0x9C], language.as_bytes()),
+            ebml(&[0xE1], &audio),
+        ]
+        .concat();
+        if !private.is_empty() {
+            entry.extend(ebml(&[0x63, 0xA2], private));
+        }
+        ebml(&[0xAE], &entry)
+    };
+    let tracks = [
+        track_entry(1, "A_DTS", "eng", &[]),
+        track_entry(2, "A_FLAC", "eng", &flac_private),
+        track_entry(3, "A_FLAC", "jpn", &flac_private),
+    ]
+    .concat();
+
+    let mut cluster = ebml_uint(&[0xE7], 0);
+    for block in 0..total_frames / BLOCK_FRAMES {
+        let timecode = (block * BLOCK_FRAMES * 1000 / 44100) as i16;
+        let range = block * BLOCK_FRAMES * 2..(block + 1) * BLOCK_FRAMES * 2;
+        for (track_number, samples) in [(2u8, flac_tracks[0]), (3u8, flac_tracks[1])] {
+            let mut simple_block = vec![0x80 | track_number];
+            simple_block.extend_from_slice(&timecode.to_be_bytes());
+            simple_block.push(0x80);
+            simple_block.extend(flac_verbatim_frame(block as u8, &samples[range.clone()]));
+            cluster.extend(ebml(&[0xA3], &simple_block));
+        }
+    }
+
+    let header = [
+        ebml_uint(&[0x42, 0x86], 1),
+        ebml_uint(&[0x42, 0xF7], 1),
+        ebml_uint(&[0x42, 0xF2], 4),
+        ebml_uint(&[0x42, 0xF3], 8),
+        ebml(&[0x42, 0x82], b"matroska"),
+        ebml_uint(&[0x42, 0x87], 4),
+        ebml_uint(&[0x42, 0x85], 2),
+    ]
+    .concat();
+    let segment = [
+        ebml(
+            &[0x15, 0x49, 0xA9, 0x66],
+            &ebml_uint(&[0x2A, 0xD7, 0xB1], 1_000_000),
+        ),
+        ebml(&[0x16, 0x54, 0xAE, 0x6B], &tracks),
+        ebml(&[0x1F, 0x43, 0xB6, 0x75], &cluster),
+    ]
+    .concat();
+    let file = [
+        ebml(&[0x1A, 0x45, 0xDF, 0xA3], &header),
+        ebml(&[0x18, 0x53, 0x80, 0x67], &segment),
+    ]
+    .concat();
+    std::fs::write(path, file).unwrap();
+}
+
+/// 验证 `--all-tracks`：单次解复用的逐轨DR与各音轨单独分析一致，
+/// 音轨按其在容器全部音频轨道中的位置编号，无法解码的第1条音轨作为失败行保留
+#[test]
+fn test_all_tracks_multi_track_container() {
+    let dir = std::env::temp_dir().join(format!(
+        "macinmeter_multi_track_test_{}",
+        std::process::id()
+    ));
+    std::fs::create_dir_all(&dir).unwrap();
+
+    // 76个4096帧块（约7秒），两条音轨响度不同
+    let frames = 4096 * 76;
+    let loud = sine_samples(frames, 0.5, 440.0);
+    let quiet = sine_samples(frames, 0.05, 1000.0);
+    let container = dir.join("Movie.mkv");
+    write_multi_track_mkv(&container, [&loud, &quiet]);
+
+    let mut reference_drs = Vec::new();
+    for (name, samples) in [("loud.wav", &loud), ("quiet.wav", &quiet)] {
+        let path = dir.join(name);
+        let spec = hound::WavSpec {
+            channels: 2,
+            sample_rate: 44100,
+            bits_per_sample: 16,
+            sample_format: hound::SampleFormat::Int,
+        };
+        let mut writer = hound::WavWriter::create(&path, spec).unwrap();
+        for &sample in samples.iter() {
+            writer.write_sample(sample).unwrap();
+        }
+        writer.finalize().unwrap();
+
+        let AnalysisOutput {
+            results, format, ..
+        } = tools::process_single_audio_file(&path, &base_config()).unwrap();
+        let (_, precise_dr, _, _) =
+            tools::compute_official_precise_dr(&results, &format, false).unwrap();
+        reference_drs.push(precise_dr);
+    }
+
+    let mut config = base_config();
+    config.all_tracks = true;
+    config.timeline = Some(macinmeter_dr_tool::processing::TimelineFormat::Binary);
+    let probed = tools::probe_sub_tracks(&container, &config);
+    assert!(matches!(
+        probed,
+        Some(tools::SubTrackSource::AudioTracks(_))
+    ));
+
+    let (
+        AnalysisOutput {
+            results: main_results,
+            format: main_format,
+            ..
+        },
+        sub_tracks,
+    ) = tools::process_batch_audio_file(&container, &config, probed)
+        .expect("首条音轨失败不应丢弃其余音轨");
+    let Some(tools::SubTrackResults::AudioTracks(tracks)) = sub_tracks else {
+        panic!("应检测到多音轨容器");
+    };
+
+    // 主结果为第一条分析成功的音轨（第2条），其余音轨按序号保留
+    let (_, main_dr, _, _) =
+        tools::compute_official_precise_dr(&main_results, &main_format, false).unwrap();
+    assert!(
+        (main_dr - reference_drs[0]).abs() < 1e-9,
+        "第2条音轨DR应与单独分析一致: {main_dr} vs {}",
+        reference_drs[0]
+    );
+
+    assert_eq!(tracks.len(), 2);
+    assert_eq!(tracks[0].info.ordinal, 1);
+    assert!(tracks[0].output.is_err(), "DTS音轨无法解码，应为失败行");
+    assert_eq!(tracks[1].info.ordinal, 3);
+    let AnalysisOutput {
+        results, format, ..
+    } = tracks[1].output.as_ref().expect("第3条音轨应分析成功");
+    let (_, track_dr, _, _) = tools::compute_official_precise_dr(results, format, false).unwrap();
+    assert!(
+        (track_dr - reference_drs[1]).abs() < 1e-9,
+        "第3条音轨DR应与单独分析一致: {track_dr} vs {}",
+        reference_drs[1]
+    );
+
+    let sub_tracks = tools::SubTrackResults::AudioTracks(tracks);
+    let mut batch_output = String::new();
+    tools::add_sub_tracks_to_batch_output(
+        &mut batch_output,
+        &sub_tracks,
+        &main_format,
+        &container,
+        false,
+    );
+    let rows: Vec<&str> = batch_output.lines().collect();
+    assert_eq!(rows.len(), 2);
+    assert!(rows[0].starts_with("| - | - | Movie.mkv [Track 1") && rows[0].ends_with("(failed) |"));
+    assert!(rows[1].contains(&format!("{track_dr:.2} | Movie.mkv [Track 3")));
+
+    // 结果库：主结果行使用文件路径，其余音轨以 `#TrackN` 后缀各占一行，失败音轨不记录
+    config.store_path = Some(dir.join("store"));
+    let mut store = tools::BatchStore::default();
+    store.add(
+        &config,
+        &container,
+        &main_results,
+        &main_format,
+        None,
+        None,
+        &Default::default(),
+    );
+    store.add_sub_tracks(&config, &container, &sub_tracks, &main_format);
+    store.commit(&config);
+    let store = tools::ResultStore::open(&dir.join("store")).unwrap();
+    assert_eq!(store.len(), 2);
+    assert!(store.row(0).path.ends_with("Movie.mkv"));
+    let track_row = store.row(1);
+    assert!(track_row.path.ends_with("Movie.mkv#Track3"));
+    assert!((track_row.precise_dr.unwrap() - track_dr).abs() < 1e-9);
+
+    // 每条分析成功的音轨各有一份时间线
+    assert!(!dir.join("Movie_Track1_DR_Timeline.drtl").exists());
+    for ordinal in [2, 3] {
+        let timeline = std::fs::read(dir.join(format!("Movie_Track{ordinal}_DR_Timeline.drtl")))
+            .expect("应逐轨保存时间线");
+        let timeline =
+            macinmeter_dr_tool::processing::WindowTimeline::from_binary(&timeline).unwrap();
+        assert_eq!(timeline.channels.len(), 2);
+    }
+
+    let _ = std::fs::remove_dir_all(&dir);
+}